@@ -0,0 +1,323 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Replays every row of a csv or binary dataset as raw data of a model and measures
+ * the inference cycle run by AIModel::pushData. Rows are given to the model
+ * directly, so columns of the dataset should be the invoke input of the model.
+ * Binary datasets, converted by tools/aifw_dataset, are read in batches of rows.
+ */
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <memory>
+#include "aifw/aifw.h"
+#include "aifw/aifw_log.h"
+#include "aifw/aifw_csv_reader.h"
+#include "aifw/aifw_dataset_reader.h"
+#include "aifw/AIModel.h"
+
+#ifndef CONFIG_EXAMPLES_AIFW_BENCH_MAX_SAMPLES
+#define CONFIG_EXAMPLES_AIFW_BENCH_MAX_SAMPLES 1024
+#endif
+
+#define BENCH_BATCH_ROWS 32
+
+#ifdef CONFIG_AIFW_PROFILING
+#define BENCH_MAX_OPS CONFIG_AIFW_PROFILING_MAX_OPS
+#endif
+
+using namespace aifw;
+
+struct bench_result_s {
+	uint32_t *samples;
+	uint32_t count;
+	uint32_t skipped;
+	uint32_t errors;
+	uint32_t dropped;
+};
+
+static uint32_t bench_now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)ts.tv_sec * 1000000 + (uint32_t)ts.tv_nsec / 1000;
+}
+
+static int compare_us(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+	return (x > y) - (x < y);
+}
+
+/* Nearest rank percentile of sorted samples */
+static uint32_t percentile(const uint32_t *sorted, uint32_t count, uint32_t pct)
+{
+	uint32_t rank = (count * pct + 99) / 100;
+	return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void push_row(AIModel *model, void *row, uint16_t columns, struct bench_result_s *result)
+{
+	uint32_t start = bench_now_us();
+	AIFW_RESULT res = model->pushData(row, columns);
+	uint32_t elapsed = bench_now_us() - start;
+	if (!result) {
+		return;
+	}
+	/* AIFW_INFERENCE_PROCEEDING means no inference cycle completed, e.g. the row was only appended to the data buffer, so it is not a latency sample */
+	if (res < AIFW_OK) {
+		result->errors++;
+	} else if (res == AIFW_INFERENCE_PROCEEDING) {
+		result->skipped++;
+	} else if (result->count < CONFIG_EXAMPLES_AIFW_BENCH_MAX_SAMPLES) {
+		result->samples[result->count++] = elapsed;
+	} else {
+		result->dropped++;
+	}
+}
+
+/* Pushes every row of the csv dataset once, measuring them unless result is NULL */
+static int replay_csv(AIModel *model, const char *path, bool header, float *row, uint16_t columns, struct bench_result_s *result)
+{
+	void *handle = NULL;
+	AIFW_RESULT res = csvInit(&handle, path, FLOAT32, header);
+	if (res != AIFW_OK) {
+		printf("Opening dataset %s failed, ret: %d\n", path, res);
+		return -1;
+	}
+	while ((res = readCSVData(handle, row)) == AIFW_OK) {
+		push_row(model, row, columns, result);
+	}
+	csvDeinit(&handle);
+	if (res != AIFW_SOURCE_EOF) {
+		printf("Reading dataset %s failed, ret: %d\n", path, res);
+		return -1;
+	}
+	return 0;
+}
+
+/* Pushes every row of the binary dataset once, rows of a batch are given in place */
+static int replay_dataset(AIModel *model, void *handle, uint16_t columns, struct bench_result_s *result)
+{
+	void *rows;
+	uint16_t count;
+	AIFW_RESULT res = rewindDataset(handle);
+	while (res == AIFW_OK && (res = readDatasetRows(handle, &rows, &count)) == AIFW_OK) {
+		for (uint16_t i = 0; i < count; i++) {
+			push_row(model, (float *)rows + i * columns, columns, result);
+		}
+	}
+	if (res != AIFW_SOURCE_EOF) {
+		printf("Reading binary dataset failed, ret: %d\n", res);
+		return -1;
+	}
+	return 0;
+}
+
+static bool is_binary_dataset(const char *path)
+{
+	uint32_t magic = 0;
+	FILE *fp = fopen(path, "r");
+	if (!fp) {
+		return false;
+	}
+	size_t size = fread(&magic, 1, sizeof(magic), fp);
+	fclose(fp);
+	return size == sizeof(magic) && magic == AIFW_DATASET_MAGIC;
+}
+
+static void print_latency(struct bench_result_s *result)
+{
+	uint64_t total = 0;
+	uint32_t i;
+
+	if (result->count == 0) {
+		printf("No inference cycle measured, skipped %u errors %u\n", result->skipped, result->errors);
+		return;
+	}
+	qsort(result->samples, result->count, sizeof(uint32_t), compare_us);
+	for (i = 0; i < result->count; i++) {
+		total += result->samples[i];
+	}
+	printf("cycles %u skipped %u errors %u dropped %u\n", result->count, result->skipped, result->errors, result->dropped);
+	printf("%8s %8s %8s %8s %8s %8s\n", "min_us", "avg_us", "p50_us", "p90_us", "p99_us", "max_us");
+	printf("%8u %8u %8u %8u %8u %8u\n", result->samples[0], (uint32_t)(total / result->count), percentile(result->samples, result->count, 50), percentile(result->samples, result->count, 90), percentile(result->samples, result->count, 99), result->samples[result->count - 1]);
+}
+
+#ifdef CONFIG_AIFW_PROFILING
+static void print_time(const char *name, const AIProfileTime *time)
+{
+	uint32_t avg = time->count ? (uint32_t)(time->totalUs / time->count) : 0;
+	printf("%-24s %8u %8u %8u %10llu\n", name, time->count, avg, time->maxUs, (unsigned long long)time->totalUs);
+}
+
+static void print_profile(AIModel *model)
+{
+	static const char *const stage_names[AIFW_PROFILE_STAGE_MAX] = { "parse", "pre_process", "invoke", "post_process" };
+	AIModelProfile profile;
+	AIProfileTime ops[BENCH_MAX_OPS];
+	uint16_t count = BENCH_MAX_OPS;
+	int i;
+
+	if (model->getProfile(&profile) != AIFW_OK) {
+		printf("Reading profile failed\n");
+		return;
+	}
+	printf("\n%-24s %8s %8s %8s %10s\n", "stage", "count", "avg_us", "max_us", "total_us");
+	for (i = 0; i < AIFW_PROFILE_STAGE_MAX; i++) {
+		print_time(stage_names[i], &profile.stages[i]);
+	}
+	if (profile.arenaSize > 0) {
+		printf("tensor arena: used %u of %u bytes\n", profile.arenaUsedBytes, profile.arenaSize);
+	}
+
+	AIFW_RESULT res = model->getOpProfile(ops, &count);
+	if (res == AIFW_NOT_SUPPORTED) {
+		printf("operators are not profiled by the engine\n");
+		return;
+	} else if (res != AIFW_OK) {
+		printf("Reading operator profile failed, ret: %d\n", res);
+		return;
+	}
+	printf("\n%-24s %8s %8s %8s %10s\n", "operator", "count", "avg_us", "max_us", "total_us");
+	for (i = 0; i < count; i++) {
+		print_time(ops[i].name, &ops[i]);
+	}
+}
+#endif /* CONFIG_AIFW_PROFILING */
+
+static void show_usage(const char *name)
+{
+	printf("Usage: %s [-n loops] [-w warmup] [-H] <manifest json> <dataset>\n", name);
+	printf(" -n    times the dataset is replayed and measured, default 1\n");
+	printf(" -w    times the dataset is replayed before measuring, default 0\n");
+	printf(" -H    first line of the csv dataset is a header\n");
+	printf(" dataset is either a csv file or a binary dataset converted by tools/aifw_dataset\n");
+}
+
+extern "C" int aifw_bench_main(int argc, char *argv[])
+{
+	struct bench_result_s result = { NULL, 0, 0, 0, 0 };
+	int loops = 1;
+	int warmup = 0;
+	bool header = false;
+	uint16_t columns = 0;
+	void *handle = NULL;
+	void *dataset_handle = NULL;
+	float *row = NULL;
+	int ret = -1;
+	int opt;
+	int i;
+
+	optind = 1;
+	while ((opt = getopt(argc, argv, "n:w:H")) != -1) {
+		switch (opt) {
+		case 'n':
+			loops = atoi(optarg);
+			break;
+		case 'w':
+			warmup = atoi(optarg);
+			break;
+		case 'H':
+			header = true;
+			break;
+		default:
+			show_usage(argv[0]);
+			return -1;
+		}
+	}
+	if (argc - optind != 2 || loops < 1 || warmup < 0) {
+		show_usage(argv[0]);
+		return -1;
+	}
+	const char *manifest = argv[optind];
+	const char *dataset = argv[optind + 1];
+
+	std::shared_ptr<AIModel> model = std::make_shared<AIModel>();
+	AIFW_RESULT res = model->loadModel(manifest);
+	if (res != AIFW_OK) {
+		printf("Loading model from %s failed, ret: %d\n", manifest, res);
+		return -1;
+	}
+
+	if (is_binary_dataset(dataset)) {
+		CSV_VALUE_DATA_TYPE_E type;
+		res = datasetInit(&dataset_handle, dataset, BENCH_BATCH_ROWS);
+		if (res != AIFW_OK || getDatasetInfo(dataset_handle, &type, &columns, NULL) != AIFW_OK || type != FLOAT32) {
+			printf("Binary dataset %s can't be replayed, ret: %d, values should be float32\n", dataset, res);
+			goto done;
+		}
+	} else {
+		res = csvInit(&handle, dataset, FLOAT32, header);
+		if (res != AIFW_OK) {
+			printf("Opening dataset %s failed, ret: %d\n", dataset, res);
+			return -1;
+		}
+		res = getColumnCount(handle, &columns);
+		csvDeinit(&handle);
+		if (res != AIFW_OK || columns == 0) {
+			printf("Reading columns of dataset %s failed, ret: %d\n", dataset, res);
+			return -1;
+		}
+		row = (float *)malloc(columns * sizeof(float));
+		if (!row) {
+			printf("Memory allocation failed\n");
+			goto done;
+		}
+	}
+
+	result.samples = (uint32_t *)malloc(CONFIG_EXAMPLES_AIFW_BENCH_MAX_SAMPLES * sizeof(uint32_t));
+	if (!result.samples) {
+		printf("Memory allocation failed\n");
+		goto done;
+	}
+
+	for (i = 0; i < warmup + loops; i++) {
+		struct bench_result_s *measure = i < warmup ? NULL : &result;
+#ifdef CONFIG_AIFW_PROFILING
+		if (i == warmup) {
+			model->resetProfile();
+		}
+#endif
+		int ret_replay = dataset_handle ? replay_dataset(model.get(), dataset_handle, columns, measure) : replay_csv(model.get(), dataset, header, row, columns, measure);
+		if (ret_replay != 0) {
+			goto done;
+		}
+	}
+
+	printf("model %s, dataset %s, %u columns\n", manifest, dataset, columns);
+	print_latency(&result);
+#ifdef CONFIG_AIFW_PROFILING
+	print_profile(model.get());
+#endif
+	ret = 0;
+
+done:
+	if (dataset_handle) {
+		datasetDeinit(&dataset_handle);
+	}
+	free(result.samples);
+	free(row);
+	return ret;
+}
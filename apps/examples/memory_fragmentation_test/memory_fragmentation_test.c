@@ -27,6 +27,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#if defined(CONFIG_MM_HEAP_STATS) && defined(CONFIG_FS_PROCFS)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 /* The number of memory sizes we are handling.
  * Here, we have 12 different memory sizes: 2^4, 2^5, ... , 2^(MAX_SIZE_EXPONENT + 3)
@@ -196,6 +200,30 @@ static void memory_cleanup(int num_alloc[], struct alloc_list list[])
 	}
 }
 
+#if defined(CONFIG_MM_HEAP_STATS) && defined(CONFIG_FS_PROCFS)
+/* Print the fragmentation and allocation latency of the heaps */
+static void print_heapstats(const char *when)
+{
+	char buf[128];
+	ssize_t nread;
+	int fd;
+
+	fd = open("/proc/heapstats", O_RDONLY);
+	if (fd < 0) {
+		printf("Failed to open /proc/heapstats\n");
+		return;
+	}
+
+	printf("\nHeap statistics %s:\n", when);
+	while ((nread = read(fd, buf, sizeof(buf) - 1)) > 0) {
+		buf[nread] = '\0';
+		printf("%s", buf);
+	}
+
+	close(fd);
+}
+#endif
+
 static void print_usage(void)
 {
 	printf("Usage: memfrag param1 param2 repeat\n");
@@ -286,6 +314,10 @@ static int memory_fragmentation_test(int argc, char *argv[])
 		return 0;
 	}
 
+#if defined(CONFIG_MM_HEAP_STATS) && defined(CONFIG_FS_PROCFS)
+	print_heapstats("after the initial allocation and free");
+#endif
+
 	/* Repeat a cycle of allocation and free a given number of times */
 	for (i = 0; i < r; ++i) {
 		/* memory allocation according to 'num_free' */
@@ -320,6 +352,9 @@ static int memory_fragmentation_test(int argc, char *argv[])
 			printf("%d		%d			%d\n", 1 << (i + 4), num_free[i], num_alloc[i]);
 		}
 	}
+#if defined(CONFIG_MM_HEAP_STATS) && defined(CONFIG_FS_PROCFS)
+	print_heapstats("after the repeated allocation and free");
+#endif
 	printf("\nPlease, use 'heapinfo' to see how the heap memory is fragmented in detail.\n");
 
 	return 0;
@@ -0,0 +1,45 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include "tc_common.h"
+
+int utc_aifw_utils_main(void);
+
+extern "C"
+{
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int utc_aifw_main(int argc, char *argv[])
+#endif
+{
+	if (testcase_state_handler(TC_START, "AIFW UTC") == -1) {
+		return -1;
+	}
+
+	utc_aifw_utils_main();
+
+	(void)testcase_state_handler(TC_END, "AIFW UTC");
+	return 0;
+}
+}
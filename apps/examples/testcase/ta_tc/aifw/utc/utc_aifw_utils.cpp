@@ -0,0 +1,189 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <math.h>
+#include "aifw/aifw.h"
+#include "aifw/aifw_utils.h"
+#include "tc_common.h"
+
+#define TEST_SCALE 0.5f
+#define TEST_ZERO_POINT 10
+
+static void utc_aifw_quantizeData_int8_p(void)
+{
+	const float values[6] = {0.0f, 1.0f, -1.0f, 0.74f, 0.76f, -5.0f};
+	const int8_t expected[6] = {10, 12, 8, 11, 12, 0};
+	int8_t data[6] = {0};
+	AITensor tensor = {AIFW_DATA_INT8, TEST_SCALE, TEST_ZERO_POINT, 6, data};
+
+	AIFW_RESULT res = quantizeData(values, NULL, NULL, 6, &tensor);
+	TC_ASSERT_EQ("quantizeData", res, AIFW_OK);
+	for (int i = 0; i < 6; i++) {
+		TC_ASSERT_EQ("quantizeData", data[i], expected[i]);
+	}
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_aifw_quantizeData_saturation_p(void)
+{
+	/* Values out of range of the type are clamped, not wrapped */
+	const float values[4] = {1000.0f, -1000.0f, 58.5f, -69.5f};
+	const int8_t expected8[4] = {INT8_MAX, INT8_MIN, INT8_MAX, INT8_MIN};
+	int8_t data8[4] = {0};
+	AITensor tensor8 = {AIFW_DATA_INT8, TEST_SCALE, TEST_ZERO_POINT, 4, data8};
+	AIFW_RESULT res = quantizeData(values, NULL, NULL, 4, &tensor8);
+	TC_ASSERT_EQ("quantizeData", res, AIFW_OK);
+	for (int i = 0; i < 4; i++) {
+		TC_ASSERT_EQ("quantizeData", data8[i], expected8[i]);
+	}
+
+	const float values16[2] = {1.0e6f, -1.0e6f};
+	int16_t data16[2] = {0};
+	AITensor tensor16 = {AIFW_DATA_INT16, TEST_SCALE, 0, 2, data16};
+	res = quantizeData(values16, NULL, NULL, 2, &tensor16);
+	TC_ASSERT_EQ("quantizeData", res, AIFW_OK);
+	TC_ASSERT_EQ("quantizeData", data16[0], INT16_MAX);
+	TC_ASSERT_EQ("quantizeData", data16[1], INT16_MIN);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_aifw_quantizeData_float32_p(void)
+{
+	const float values[3] = {1.25f, -3.5f, 100.0f};
+	float data[4] = {0.0f, 0.0f, 0.0f, 7.0f};
+	AITensor tensor = {AIFW_DATA_FLOAT32, 0.0f, 0, 4, data};
+
+	/* Float values are copied as they are, values after count are left alone */
+	AIFW_RESULT res = quantizeData(values, NULL, NULL, 3, &tensor);
+	TC_ASSERT_EQ("quantizeData", res, AIFW_OK);
+	for (int i = 0; i < 3; i++) {
+		TC_ASSERT("quantizeData", data[i] == values[i]);
+	}
+	TC_ASSERT("quantizeData", data[3] == 7.0f);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_aifw_quantizeData_normalize_p(void)
+{
+	/* (value - mean) / std is applied to each value before it is quantized */
+	const float values[4] = {3.0f, 10.0f, -2.0f, 5.0f};
+	const float meanVals[4] = {1.0f, 10.0f, 0.0f, 5.0f};
+	const float stdValues[4] = {2.0f, 1.0f, 0.5f, 1.0f};
+	const int8_t expected[4] = {12, 10, 2, 10};
+	int8_t data[4] = {0};
+	AITensor tensor = {AIFW_DATA_INT8, TEST_SCALE, TEST_ZERO_POINT, 4, data};
+
+	AIFW_RESULT res = quantizeData(values, meanVals, stdValues, 4, &tensor);
+	TC_ASSERT_EQ("quantizeData", res, AIFW_OK);
+	for (int i = 0; i < 4; i++) {
+		TC_ASSERT_EQ("quantizeData", data[i], expected[i]);
+	}
+
+	/* Float tensor gets the same normalized values, as normalizeData gives */
+	float normalized[4] = {3.0f, 10.0f, -2.0f, 5.0f};
+	float data32[4] = {0.0f};
+	AITensor tensor32 = {AIFW_DATA_FLOAT32, 0.0f, 0, 4, data32};
+	res = quantizeData(values, meanVals, stdValues, 4, &tensor32);
+	TC_ASSERT_EQ("quantizeData", res, AIFW_OK);
+	normalizeData(normalized, (float *)meanVals, (float *)stdValues, 4);
+	for (int i = 0; i < 4; i++) {
+		TC_ASSERT_LEQ("quantizeData", fabsf(data32[i] - normalized[i]), 1.0e-5f);
+	}
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_aifw_quantizeData_n(void)
+{
+	const float values[4] = {0.0f};
+	int8_t data[2] = {0};
+	AITensor tensor = {AIFW_DATA_INT8, TEST_SCALE, 0, 2, data};
+
+	TC_ASSERT_EQ("quantizeData", quantizeData(NULL, NULL, NULL, 2, &tensor), AIFW_INVALID_ARG);
+	TC_ASSERT_EQ("quantizeData", quantizeData(values, NULL, NULL, 2, NULL), AIFW_INVALID_ARG);
+	TC_ASSERT_EQ("quantizeData", quantizeData(values, NULL, NULL, 4, &tensor), AIFW_NOT_ENOUGH_SPACE);
+	tensor.data = NULL;
+	TC_ASSERT_EQ("quantizeData", quantizeData(values, NULL, NULL, 2, &tensor), AIFW_INVALID_ARG);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_aifw_dequantizeData_p(void)
+{
+	int8_t data8[3] = {10, 12, -118};
+	AITensor tensor8 = {AIFW_DATA_INT8, TEST_SCALE, TEST_ZERO_POINT, 3, data8};
+	float values[3];
+	AIFW_RESULT res = dequantizeData(&tensor8, values, 3);
+	TC_ASSERT_EQ("dequantizeData", res, AIFW_OK);
+	TC_ASSERT("dequantizeData", values[0] == 0.0f);
+	TC_ASSERT("dequantizeData", values[1] == 1.0f);
+	TC_ASSERT("dequantizeData", values[2] == -64.0f);
+
+	/* Difference of a value and zero point does not fit in int16_t */
+	int16_t data16[2] = {INT16_MAX, INT16_MIN};
+	AITensor tensor16 = {AIFW_DATA_INT16, 1.0f, -100, 2, data16};
+	res = dequantizeData(&tensor16, values, 2);
+	TC_ASSERT_EQ("dequantizeData", res, AIFW_OK);
+	TC_ASSERT("dequantizeData", values[0] == (float)INT16_MAX + 100);
+	TC_ASSERT("dequantizeData", values[1] == (float)INT16_MIN + 100);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_aifw_dequantizeData_n(void)
+{
+	int8_t data[2] = {0};
+	AITensor tensor = {AIFW_DATA_INT8, TEST_SCALE, 0, 2, data};
+	float values[4];
+
+	TC_ASSERT_EQ("dequantizeData", dequantizeData(NULL, values, 2), AIFW_INVALID_ARG);
+	TC_ASSERT_EQ("dequantizeData", dequantizeData(&tensor, NULL, 2), AIFW_INVALID_ARG);
+	TC_ASSERT_EQ("dequantizeData", dequantizeData(&tensor, values, 4), AIFW_INVALID_ARG);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_aifw_quantizeData_round_trip_p(void)
+{
+	/* Error of a value in range is at most half of the scale */
+	float values[64];
+	float result[64];
+	int16_t data[64];
+	AITensor tensor = {AIFW_DATA_INT16, 0.01f, -3, 64, data};
+	for (int i = 0; i < 64; i++) {
+		values[i] = (i - 32) * 0.377f;
+	}
+	AIFW_RESULT res = quantizeData(values, NULL, NULL, 64, &tensor);
+	TC_ASSERT_EQ("quantizeData", res, AIFW_OK);
+	res = dequantizeData(&tensor, result, 64);
+	TC_ASSERT_EQ("dequantizeData", res, AIFW_OK);
+	for (int i = 0; i < 64; i++) {
+		TC_ASSERT_LEQ("dequantizeData", fabsf(result[i] - values[i]), 0.005f + 1.0e-6f);
+	}
+	TC_SUCCESS_RESULT();
+}
+
+int utc_aifw_utils_main(void)
+{
+	utc_aifw_quantizeData_int8_p();
+	utc_aifw_quantizeData_saturation_p();
+	utc_aifw_quantizeData_float32_p();
+	utc_aifw_quantizeData_normalize_p();
+	utc_aifw_quantizeData_n();
+	utc_aifw_dequantizeData_p();
+	utc_aifw_dequantizeData_n();
+	utc_aifw_quantizeData_round_trip_p();
+	return 0;
+}
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "tc_common.h"
+#include "../../../../../../framework/src/media/utils/frame_index.h"
+
+/* MPEG-1 Layer III, 128 kbps, 44100 Hz, frames of 1152 samples and 417 bytes */
+#define TEST_SAMPLE_RATE 44100
+#define TEST_FRAME_SAMPLES 1152
+#define TEST_FRAME_SIZE 417
+#define TEST_FRAMES 60
+#define TEST_INTERVAL_MS 100
+
+/* Seek target is in the middle of frame 38, which plays from 992 to 1018 msec */
+#define TEST_SEEK_MSEC 1000
+/* Last entry before the target is frame 36 at 940 msec */
+#define TEST_ENTRY_MSEC 940
+#define TEST_ENTRY_OFFSET (36 * TEST_FRAME_SIZE)
+
+/* Decoder outputs 16 bit stereo, also for a multichannel source */
+#define TEST_OUTPUT_CHANNELS 2
+#define TEST_SOURCE_CHANNELS 6
+#define TEST_SAMPLE_WIDTH sizeof(int16_t)
+
+static bool make_index(frame_index_t *index)
+{
+	if (!frame_index_init(index, TEST_INTERVAL_MS, TEST_FRAMES)) {
+		return false;
+	}
+	/* Frames are recorded in order while decoding, as the input handler does */
+	for (uint32_t i = 0; i < TEST_FRAMES; i++) {
+		uint32_t msec = (uint32_t)((uint64_t)i * TEST_FRAME_SAMPLES * 1000 / TEST_SAMPLE_RATE);
+		frame_index_add(index, msec, i * TEST_FRAME_SIZE);
+	}
+	return true;
+}
+
+static void utc_media_frame_index_lookup_p(void)
+{
+	frame_index_t index;
+	frame_index_entry_t entry;
+
+	TC_ASSERT("utc_media_frame_index_lookup", make_index(&index));
+	bool found = frame_index_lookup(&index, TEST_SEEK_MSEC, &entry);
+	frame_index_free(&index);
+
+	TC_ASSERT("utc_media_frame_index_lookup", found);
+	TC_ASSERT_EQ("utc_media_frame_index_lookup", entry.msec, TEST_ENTRY_MSEC);
+	TC_ASSERT_EQ("utc_media_frame_index_lookup", entry.offset, TEST_ENTRY_OFFSET);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_frame_index_lookup_n(void)
+{
+	frame_index_t index;
+	frame_index_entry_t entry;
+
+	TC_ASSERT("utc_media_frame_index_lookup", frame_index_init(&index, TEST_INTERVAL_MS, TEST_FRAMES));
+	/* Empty index has no entry, seek decodes from the start of source */
+	bool found = frame_index_lookup(&index, TEST_SEEK_MSEC, &entry);
+	frame_index_free(&index);
+
+	TC_ASSERT("utc_media_frame_index_lookup", !found);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_frame_index_skip_bytes_p(void)
+{
+	size_t frameBytes = TEST_OUTPUT_CHANNELS * TEST_SAMPLE_WIDTH;
+	/* 60 msec from the entry to the target are 2646 PCM frames */
+	size_t expected = 2646 * frameBytes;
+
+	size_t skip = frame_index_skip_bytes(TEST_ENTRY_MSEC, TEST_SEEK_MSEC, TEST_SAMPLE_RATE, frameBytes);
+	TC_ASSERT_EQ("utc_media_frame_index_skip_bytes", skip, expected);
+	TC_ASSERT_EQ("utc_media_frame_index_skip_bytes", skip % frameBytes, 0);
+
+	/* Bytes are counted in the layout of the decoder output, not of the source */
+	size_t sourceSkip = frame_index_skip_bytes(TEST_ENTRY_MSEC, TEST_SEEK_MSEC, TEST_SAMPLE_RATE, TEST_SOURCE_CHANNELS * TEST_SAMPLE_WIDTH);
+	TC_ASSERT_NEQ("utc_media_frame_index_skip_bytes", skip, sourceSkip);
+
+	/* Target at the indexed frame drops nothing */
+	TC_ASSERT_EQ("utc_media_frame_index_skip_bytes", frame_index_skip_bytes(TEST_ENTRY_MSEC, TEST_ENTRY_MSEC, TEST_SAMPLE_RATE, frameBytes), 0);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_frame_index_skip_bytes_n(void)
+{
+	/* Target before the start of decoding can't be reached by dropping PCM */
+	size_t skip = frame_index_skip_bytes(TEST_SEEK_MSEC, TEST_ENTRY_MSEC, TEST_SAMPLE_RATE, TEST_OUTPUT_CHANNELS * TEST_SAMPLE_WIDTH);
+	TC_ASSERT_EQ("utc_media_frame_index_skip_bytes", skip, 0);
+	TC_SUCCESS_RESULT();
+}
+
+int utc_media_frame_index_main(void)
+{
+	utc_media_frame_index_lookup_p();
+	utc_media_frame_index_lookup_n();
+	utc_media_frame_index_skip_bytes_p();
+	utc_media_frame_index_skip_bytes_n();
+	return 0;
+}
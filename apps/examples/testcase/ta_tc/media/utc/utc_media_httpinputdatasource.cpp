@@ -0,0 +1,290 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <media/HttpInputDataSource.h>
+#include "tc_common.h"
+
+/* Test server answers requests of the data source on the loopback interface */
+#define TEST_HTTP_PORT 18080
+#define TEST_HTTP_URL "http://127.0.0.1:18080/stream.mp3"
+
+/* MPEG-1 Layer III, 128 kbps, 44100 Hz, stereo, frames of 417 bytes */
+#define TEST_MP3_FRAME_SIZE 417
+#define TEST_MP3_FRAMES 8
+#define TEST_MP3_SIZE (TEST_MP3_FRAME_SIZE * TEST_MP3_FRAMES)
+
+enum test_response_e {
+	TEST_RESPONSE_RANGE,     /* 206 with the requested range */
+	TEST_RESPONSE_FULL,      /* 200 with the whole stream, range is ignored */
+	TEST_RESPONSE_NOT_FOUND, /* 404 with an error page */
+	TEST_RESPONSE_REDIRECT,  /* 302 with the stream as its body, not followed */
+};
+
+static unsigned char g_stream[TEST_MP3_SIZE];
+static enum test_response_e g_response;
+static int g_listenfd = -1;
+static pthread_t g_server;
+static int g_requests;
+
+static void make_stream(void)
+{
+	for (int i = 0; i < TEST_MP3_SIZE; i++) {
+		g_stream[i] = (unsigned char)(i % TEST_MP3_FRAME_SIZE);
+	}
+	for (int i = 0; i < TEST_MP3_FRAMES; i++) {
+		unsigned char *frame = g_stream + i * TEST_MP3_FRAME_SIZE;
+		frame[0] = 0xFF;
+		frame[1] = 0xFB;
+		frame[2] = 0x90;
+		frame[3] = 0x00;
+	}
+}
+
+static bool send_all(int fd, const void *data, size_t size)
+{
+	const char *p = (const char *)data;
+	while (size > 0) {
+		ssize_t sent = send(fd, p, size, 0);
+		if (sent <= 0) {
+			return false;
+		}
+		p += sent;
+		size -= (size_t)sent;
+	}
+	return true;
+}
+
+/* Reads the request header, start and end of its range are -1 if it has none */
+static bool read_request(int fd, long *start, long *end)
+{
+	char request[512];
+	size_t len = 0;
+	*start = -1;
+	*end = -1;
+	while (len < sizeof(request) - 1) {
+		ssize_t ret = recv(fd, request + len, sizeof(request) - 1 - len, 0);
+		if (ret <= 0) {
+			return false;
+		}
+		len += (size_t)ret;
+		request[len] = '\0';
+		if (strstr(request, "\r\n\r\n")) {
+			break;
+		}
+	}
+	const char *range = strstr(request, "Range: bytes=");
+	if (range) {
+		char *next;
+		*start = strtol(range + strlen("Range: bytes="), &next, 10);
+		if (*next == '-' && next[1] >= '0' && next[1] <= '9') {
+			*end = strtol(next + 1, NULL, 10);
+		}
+	}
+	return true;
+}
+
+static void respond(int fd)
+{
+	long start;
+	long end;
+	char header[256];
+
+	if (!read_request(fd, &start, &end)) {
+		return;
+	}
+	g_requests++;
+
+	if (g_response == TEST_RESPONSE_NOT_FOUND) {
+		static const char page[] = "<html>not found</html>";
+		snprintf(header, sizeof(header), "HTTP/1.1 404 Not Found\r\nContent-Type: audio/mpeg\r\nContent-Length: %d\r\nConnection: close\r\n\r\n", (int)strlen(page));
+		send_all(fd, header, strlen(header));
+		send_all(fd, page, strlen(page));
+		return;
+	}
+
+	if (g_response == TEST_RESPONSE_REDIRECT) {
+		snprintf(header, sizeof(header), "HTTP/1.1 302 Found\r\nLocation: /moved.mp3\r\nContent-Type: audio/mpeg\r\nContent-Length: %d\r\nConnection: close\r\n\r\n", TEST_MP3_SIZE);
+		send_all(fd, header, strlen(header));
+		send_all(fd, g_stream, TEST_MP3_SIZE);
+		return;
+	}
+
+	if (g_response == TEST_RESPONSE_FULL || start < 0) {
+		snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\nContent-Type: audio/mpeg\r\nContent-Length: %d\r\nConnection: close\r\n\r\n", TEST_MP3_SIZE);
+		send_all(fd, header, strlen(header));
+		send_all(fd, g_stream, TEST_MP3_SIZE);
+		return;
+	}
+
+	if (start >= TEST_MP3_SIZE) {
+		snprintf(header, sizeof(header), "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */%d\r\nContent-Length: 0\r\nConnection: close\r\n\r\n", TEST_MP3_SIZE);
+		send_all(fd, header, strlen(header));
+		return;
+	}
+	if (end < 0 || end >= TEST_MP3_SIZE) {
+		end = TEST_MP3_SIZE - 1;
+	}
+	snprintf(header, sizeof(header), "HTTP/1.1 206 Partial Content\r\nContent-Type: audio/mpeg\r\nAccept-Ranges: bytes\r\nContent-Range: bytes %ld-%ld/%d\r\nContent-Length: %ld\r\nConnection: close\r\n\r\n", start, end, TEST_MP3_SIZE, end - start + 1);
+	send_all(fd, header, strlen(header));
+	send_all(fd, g_stream + start, (size_t)(end - start + 1));
+}
+
+static void *server_main(void *arg)
+{
+	int fd;
+	while ((fd = accept(g_listenfd, NULL, NULL)) >= 0) {
+		respond(fd);
+		close(fd);
+	}
+	return NULL;
+}
+
+static bool start_server(enum test_response_e response)
+{
+	struct sockaddr_in addr;
+	int on = 1;
+
+	g_response = response;
+	g_requests = 0;
+	g_listenfd = socket(AF_INET, SOCK_STREAM, 0);
+	if (g_listenfd < 0) {
+		printf("fail to create socket, errno : %d\n", get_errno());
+		return false;
+	}
+	setsockopt(g_listenfd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(TEST_HTTP_PORT);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (bind(g_listenfd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(g_listenfd, 2) < 0) {
+		printf("fail to listen on port %d, errno : %d\n", TEST_HTTP_PORT, get_errno());
+		close(g_listenfd);
+		g_listenfd = -1;
+		return false;
+	}
+	if (pthread_create(&g_server, NULL, server_main, NULL) != 0) {
+		close(g_listenfd);
+		g_listenfd = -1;
+		return false;
+	}
+	return true;
+}
+
+static void stop_server(void)
+{
+	/* accept() fails once the socket is shut down, so the server thread exits */
+	shutdown(g_listenfd, SHUT_RDWR);
+	close(g_listenfd);
+	pthread_join(g_server, NULL);
+	g_listenfd = -1;
+}
+
+/* Reads the whole stream and compares it with what the server sent */
+static bool read_stream(media::stream::HttpInputDataSource &source)
+{
+	unsigned char buf[256];
+	size_t total = 0;
+	ssize_t len;
+	while (total < TEST_MP3_SIZE && (len = source.read(buf, sizeof(buf))) > 0) {
+		if (total + (size_t)len > TEST_MP3_SIZE || memcmp(buf, g_stream + total, (size_t)len) != 0) {
+			return false;
+		}
+		total += (size_t)len;
+	}
+	return total == TEST_MP3_SIZE;
+}
+
+static void utc_media_HttpInputDataSource_open_p(void)
+{
+	TC_ASSERT("utc_media_HttpInputDataSource_open", start_server(TEST_RESPONSE_RANGE));
+	media::stream::HttpInputDataSource source(TEST_HTTP_URL);
+
+	bool opened = source.open();
+	bool complete = opened && read_stream(source);
+	source.close();
+	stop_server();
+
+	TC_ASSERT("utc_media_HttpInputDataSource_open", opened);
+	TC_ASSERT_EQ("utc_media_HttpInputDataSource_open", source.getSampleRate(), 44100);
+	TC_ASSERT_EQ("utc_media_HttpInputDataSource_open", source.getChannels(), 2);
+	TC_ASSERT("utc_media_HttpInputDataSource_open", complete);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_HttpInputDataSource_open_range_ignored_p(void)
+{
+	/* Server answers a range request with the whole stream, it is downloaded in one request */
+	TC_ASSERT("utc_media_HttpInputDataSource_open_range_ignored", start_server(TEST_RESPONSE_FULL));
+	media::stream::HttpInputDataSource source(TEST_HTTP_URL);
+
+	bool opened = source.open();
+	bool complete = opened && read_stream(source);
+	source.close();
+	stop_server();
+
+	TC_ASSERT("utc_media_HttpInputDataSource_open_range_ignored", opened);
+	TC_ASSERT("utc_media_HttpInputDataSource_open_range_ignored", complete);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_HttpInputDataSource_open_n(void)
+{
+	/* Error response fails open, even with an audio content type */
+	TC_ASSERT("utc_media_HttpInputDataSource_open", start_server(TEST_RESPONSE_NOT_FOUND));
+	media::stream::HttpInputDataSource source(TEST_HTTP_URL);
+
+	bool opened = source.open();
+	source.close();
+	stop_server();
+
+	TC_ASSERT("utc_media_HttpInputDataSource_open", !opened);
+	TC_ASSERT_EQ("utc_media_HttpInputDataSource_open", g_requests, 1);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_HttpInputDataSource_open_redirect_n(void)
+{
+	/* Body of a redirection is not the stream, even if it looks like one */
+	TC_ASSERT("utc_media_HttpInputDataSource_open_redirect", start_server(TEST_RESPONSE_REDIRECT));
+	media::stream::HttpInputDataSource source(TEST_HTTP_URL);
+
+	bool opened = source.open();
+	source.close();
+	stop_server();
+
+	TC_ASSERT("utc_media_HttpInputDataSource_open_redirect", !opened);
+	TC_SUCCESS_RESULT();
+}
+
+int utc_media_HttpInputDataSource_main(void)
+{
+	make_stream();
+	utc_media_HttpInputDataSource_open_p();
+	utc_media_HttpInputDataSource_open_range_ignored_p();
+	utc_media_HttpInputDataSource_open_n();
+	utc_media_HttpInputDataSource_open_redirect_n();
+	return 0;
+}
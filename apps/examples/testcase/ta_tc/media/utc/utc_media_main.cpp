@@ -46,6 +46,10 @@ int utc_media_FocusManager_main(void);
 #ifdef CONFIG_MEDIA_PLAYER
 int utc_media_MediaPlayer_main(void);
 int utc_media_FileInputDataSource_main(void);
+int utc_media_frame_index_main(void);
+#if defined(CONFIG_ENABLE_CURL) && defined(CONFIG_CODEC_MP3)
+int utc_media_HttpInputDataSource_main(void);
+#endif
 #endif
 #ifdef CONFIG_MEDIA_RECORDER
 int utc_media_mediarecorder_main(void);
@@ -77,6 +81,10 @@ int utc_media_main(int argc, char *argv[])
 #ifdef CONFIG_MEDIA_PLAYER
 	utc_media_MediaPlayer_main();
 	utc_media_FileInputDataSource_main();
+	utc_media_frame_index_main();
+#if defined(CONFIG_ENABLE_CURL) && defined(CONFIG_CODEC_MP3)
+	utc_media_HttpInputDataSource_main();
+#endif
 	unlink("/tmp/record_opus.opus");
 	unlink("/tmp/record_wav.wav");
 #endif
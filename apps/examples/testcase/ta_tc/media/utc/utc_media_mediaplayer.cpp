@@ -81,6 +81,59 @@ void EmptyObserver::cvAsyncWait()
 	cvAsync.wait(lock);
 }
 
+/* Records the callbacks of a player going through its queued sources */
+class GaplessObserver : public EmptyObserver
+{
+public:
+	GaplessObserver() : nStarted(0), nChanged(0), nFinished(0), nErrors(0), nChangedBeforeFinished(0) {}
+	void onPlaybackStarted(media::MediaPlayer &mediaPlayer) override;
+	void onPlaybackFinished(media::MediaPlayer &mediaPlayer) override;
+	void onPlaybackError(media::MediaPlayer &mediaPlayer, media::player_error_t error) override;
+	void onPlaybackSourceChanged(media::MediaPlayer &mediaPlayer) override;
+	bool waitFinished(int sec);
+	int nStarted;
+	int nChanged;
+	int nFinished;
+	int nErrors;
+	int nChangedBeforeFinished;
+private:
+	std::mutex mtx;
+	std::condition_variable cvFinished;
+};
+
+void GaplessObserver::onPlaybackStarted(media::MediaPlayer &mediaPlayer)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	nStarted++;
+}
+
+void GaplessObserver::onPlaybackFinished(media::MediaPlayer &mediaPlayer)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	nChangedBeforeFinished = nChanged;
+	nFinished++;
+	cvFinished.notify_one();
+}
+
+void GaplessObserver::onPlaybackError(media::MediaPlayer &mediaPlayer, media::player_error_t error)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	nErrors++;
+	cvFinished.notify_one();
+}
+
+void GaplessObserver::onPlaybackSourceChanged(media::MediaPlayer &mediaPlayer)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	nChanged++;
+}
+
+bool GaplessObserver::waitFinished(int sec)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	return cvFinished.wait_for(lock, std::chrono::seconds(sec), [this] { return nFinished > 0 || nErrors > 0; });
+}
+
 static void SetUp(void)
 {
 	char *dummyData = new char[4096];
@@ -641,6 +694,89 @@ static void utc_media_MediaPlayer_isPlaying_n(void)
 	TC_SUCCESS_RESULT();
 }
 
+static void utc_media_MediaPlayer_setNextDataSource_p(void)
+{
+	media::MediaPlayer mp;
+	std::unique_ptr<media::stream::FileInputDataSource> source = std::move(std::unique_ptr<media::stream::FileInputDataSource>(new media::stream::FileInputDataSource(dummyfilepath)));
+	std::unique_ptr<media::stream::FileInputDataSource> next = std::move(std::unique_ptr<media::stream::FileInputDataSource>(new media::stream::FileInputDataSource(dummyfilepath)));
+	std::unique_ptr<media::stream::FileInputDataSource> last = std::move(std::unique_ptr<media::stream::FileInputDataSource>(new media::stream::FileInputDataSource(dummyfilepath)));
+	auto observer = std::make_shared<GaplessObserver>();
+	mp.create();
+	mp.setObserver(observer);
+	mp.setDataSource(std::move(source));
+	mp.prepare();
+
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_setNextDataSource", mp.setNextDataSource(std::move(next)), media::PLAYER_OK, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_setNextDataSource", mp.setNextDataSource(std::move(last)), media::PLAYER_OK, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_setNextDataSource", mp.start(), media::PLAYER_OK, goto cleanup);
+
+	/* The queued sources follow without stopping: the playback starts and finishes once,
+	 * after it changed to each of them.
+	 */
+	TC_ASSERT_CLEANUP("utc_media_MediaPlayer_setNextDataSource", observer->waitFinished(10), goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_setNextDataSource", observer->nErrors, 0, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_setNextDataSource", observer->nFinished, 1, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_setNextDataSource", observer->nStarted, 1, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_setNextDataSource", observer->nChangedBeforeFinished, 2, goto cleanup);
+
+	TC_SUCCESS_RESULT();
+cleanup:
+	mp.unprepare();
+	mp.destroy();
+}
+
+static void utc_media_MediaPlayer_setNextDataSource_n(void)
+{
+	/* setNextDataSource without setDataSource */
+	{
+		media::MediaPlayer mp;
+		std::unique_ptr<media::stream::FileInputDataSource> next = std::move(std::unique_ptr<media::stream::FileInputDataSource>(new media::stream::FileInputDataSource(dummyfilepath)));
+		mp.create();
+
+		TC_ASSERT_NEQ("utc_media_MediaPlayer_setNextDataSource", mp.setNextDataSource(std::move(next)), media::PLAYER_OK);
+
+		mp.destroy();
+	}
+
+	/* setNextDataSource with nullptr */
+	{
+		media::MediaPlayer mp;
+		std::unique_ptr<media::stream::FileInputDataSource> source = std::move(std::unique_ptr<media::stream::FileInputDataSource>(new media::stream::FileInputDataSource(dummyfilepath)));
+		mp.create();
+		mp.setDataSource(std::move(source));
+		mp.prepare();
+
+		TC_ASSERT_NEQ("utc_media_MediaPlayer_setNextDataSource", mp.setNextDataSource(nullptr), media::PLAYER_OK);
+
+		mp.unprepare();
+		mp.destroy();
+	}
+
+	/* Next source which fails to open is skipped, and the playback finishes with the current one */
+	{
+		media::MediaPlayer mp;
+		std::unique_ptr<media::stream::FileInputDataSource> source = std::move(std::unique_ptr<media::stream::FileInputDataSource>(new media::stream::FileInputDataSource(dummyfilepath)));
+		std::unique_ptr<media::stream::FileInputDataSource> next = std::move(std::unique_ptr<media::stream::FileInputDataSource>(new media::stream::FileInputDataSource("/tmp/nonexistent.raw")));
+		auto observer = std::make_shared<GaplessObserver>();
+		mp.create();
+		mp.setObserver(observer);
+		mp.setDataSource(std::move(source));
+		mp.prepare();
+		mp.setNextDataSource(std::move(next));
+		mp.start();
+
+		bool finished = observer->waitFinished(10);
+		mp.unprepare();
+		mp.destroy();
+
+		TC_ASSERT("utc_media_MediaPlayer_setNextDataSource", finished);
+		TC_ASSERT_EQ("utc_media_MediaPlayer_setNextDataSource", observer->nFinished, 1);
+		TC_ASSERT_EQ("utc_media_MediaPlayer_setNextDataSource", observer->nChanged, 0);
+	}
+
+	TC_SUCCESS_RESULT();
+}
+
 static void utc_media_MediaPlayer_operator_equal_p(void)
 {
 	media::MediaPlayer mp;
@@ -705,6 +841,9 @@ int utc_media_MediaPlayer_main(void)
 	utc_media_MediaPlayer_isPlaying_p();
 	utc_media_MediaPlayer_isPlaying_n();
 
+	utc_media_MediaPlayer_setNextDataSource_p();
+	utc_media_MediaPlayer_setNextDataSource_n();
+
 	utc_media_MediaPlayer_operator_equal_p();
 	utc_media_MediaPlayer_operator_equal_n();
 
@@ -30,6 +30,9 @@
 #if defined(CONFIG_TASH) && !defined(CONFIG_BUILTIN_APPS)
 #include <apps/shell/tash.h>
 #else
+#ifdef CONFIG_EXAMPLES_TESTCASE_AIFW_UTC
+#define TC_AIFW_STACK       4096
+#endif
 #if defined(CONFIG_EXAMPLES_TESTCASE_ARASTORAGE_UTC) || defined(CONFIG_EXAMPLES_TESTCASE_ARASTORAGE_ITC)
 #define TC_ARASTORAGE_STACK       4096
 #endif
@@ -107,6 +110,7 @@ extern int tc_ttrace_main(int argc, char *argv[]);
 extern int tc_tcp_tls_main(int agrc, char *agrv[]);
 
 /* TinyAra Public API Test Case as ta_tc */
+extern int utc_aifw_main(int argc, char *argv[]);
 extern int utc_arastorage_main(int argc, char *argv[]);
 extern int itc_arastorage_main(int argc, char *argv[]);
 extern int utc_audio_main(int argc, char *argv[]);
@@ -138,6 +142,9 @@ extern int utc_libcxx_main(int argc, char *argv[]);
 
 #if defined(CONFIG_TASH) && !defined(CONFIG_BUILTIN_APPS)
 static const tash_cmdlist_t tc_cmds[] = {
+#ifdef CONFIG_EXAMPLES_TESTCASE_AIFW_UTC
+	{"aifw_utc", utc_aifw_main, TASH_EXECMD_ASYNC},
+#endif
 #ifdef CONFIG_EXAMPLES_TESTCASE_ARASTORAGE_UTC
 	{"arastorage_utc", utc_arastorage_main, TASH_EXECMD_ASYNC},
 #endif
@@ -286,6 +293,12 @@ int tc_main(int argc, char *argv[])
 #else							// !CONFIG_TASH
 	int pid;
 
+#ifdef CONFIG_EXAMPLES_TESTCASE_AIFW_UTC
+	pid = task_create("aifwutc", SCHED_PRIORITY_DEFAULT, TC_AIFW_STACK, utc_aifw_main, argv);
+	if (pid < 0) {
+		printf("AIFW utc is not started, err = %d\n", pid);
+	}
+#endif
 #ifdef CONFIG_EXAMPLES_TESTCASE_ARASTORAGE_UTC
 	pid = task_create("arastorageutc", SCHED_PRIORITY_DEFAULT, TC_ARASTORAGE_STACK, utc_arastorage_main, argv);
 	if (pid < 0) {
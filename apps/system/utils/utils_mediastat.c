@@ -0,0 +1,57 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <media/media_stats.h>
+
+#define MEDIASTAT_BUFLEN 1536
+
+int utils_mediastat(int argc, char **args)
+{
+	char *buf;
+
+	if (argc > 2 || (argc == 2 && strncmp(args[1], "-r", strlen("-r") + 1))) {
+		printf("\nUsage: mediastat [-r]\n");
+		printf("Print per-stage statistics of the media pipeline\n");
+		printf("Options:\n");
+		printf(" -r    Print and then clear the statistics\n");
+		return ERROR;
+	}
+
+	/* Table is too large for the stack of a shell command */
+	buf = (char *)malloc(MEDIASTAT_BUFLEN);
+	if (buf == NULL) {
+		printf("Failed to allocate memory for media statistics\n");
+		return ERROR;
+	}
+	if (media_stats_print(buf, MEDIASTAT_BUFLEN) < 0) {
+		printf("Failed to get media statistics\n");
+		free(buf);
+		return ERROR;
+	}
+	printf("%s", buf);
+	free(buf);
+
+	if (argc == 2) {
+		media_stats_reset();
+	}
+
+	return OK;
+}
@@ -18,6 +18,7 @@
 #define LUCI_INTERPRETER_INTERPRETER_H
 
 #include "luci_interpreter/core/Tensor.h"
+#include "luci_interpreter/KernelProfiler.h"
 
 #ifdef USE_STATIC_ALLOC
 #include "luci_interpreter/InterpreterConfigure.h"
@@ -57,6 +58,9 @@ public:
 
   void interpret();
 
+  // Kernels executed by interpret() are reported to profiler, nullptr stops it
+  void setKernelProfiler(KernelProfiler *profiler);
+
 private:
   // _default_memory_manager should be before _runtime_module due to
   // the order of deletion in the destructor
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024 Samsung Electronics Co., Ltd. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LUCI_INTERPRETER_KERNEL_PROFILER_H
+#define LUCI_INTERPRETER_KERNEL_PROFILER_H
+
+namespace luci_interpreter
+{
+
+// Receives every kernel executed by Interpreter::interpret(), including kernels of subgraphs.
+// name is the builtin operator name, a static string.
+class KernelProfiler
+{
+public:
+  virtual ~KernelProfiler() = default;
+
+  virtual void beginKernel(const char *name) = 0;
+  virtual void endKernel(const char *name) = 0;
+};
+
+} // namespace luci_interpreter
+
+#endif // LUCI_INTERPRETER_KERNEL_PROFILER_H
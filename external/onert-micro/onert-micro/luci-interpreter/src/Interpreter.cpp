@@ -63,6 +63,11 @@ Interpreter::~Interpreter() = default;
 
 void Interpreter::interpret() { _runtime_module.execute(); }
 
+void Interpreter::setKernelProfiler(KernelProfiler *profiler)
+{
+  _runtime_module.setKernelProfiler(profiler);
+}
+
 int32_t Interpreter::getNumOfInputTensors()
 {
   auto *runtime_graph = _runtime_module.getMainGraph();
@@ -424,6 +424,7 @@ void RuntimeGraph::execute()
 
   const auto operators_size = _reader->operators().size();
   const auto operators = _reader->operators();
+  auto *profiler = _runtime_module->getKernelProfiler();
 
   for (uint32_t i = 0; i < operators_size; ++i)
   {
@@ -434,8 +435,14 @@ void RuntimeGraph::execute()
 
     allocate(i);
 
+    if (profiler != nullptr)
+      profiler->beginKernel(circle::EnumNameBuiltinOperator(opcode));
+
     kernel_executor.execute_kernel(op, opcode, this);
 
+    if (profiler != nullptr)
+      profiler->endKernel(circle::EnumNameBuiltinOperator(opcode));
+
     deallocate(i);
   }
 }
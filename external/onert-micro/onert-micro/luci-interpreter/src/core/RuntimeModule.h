@@ -19,6 +19,7 @@
 
 #include "core/RuntimeGraph.h"
 #include "luci_interpreter/core/reader/CircleMicroReader.h"
+#include "luci_interpreter/KernelProfiler.h"
 
 #include <memory>
 #include <vector>
@@ -55,9 +56,15 @@ public:
 
   void selectSubgraph(uint32_t index) { _circle_reader.select_subgraph(index); }
 
+  void setKernelProfiler(KernelProfiler *profiler) { _kernel_profiler = profiler; }
+
+  KernelProfiler *getKernelProfiler() const { return _kernel_profiler; }
+
 private:
   std::vector<BaseRuntimeGraph> _graphs;
 
+  KernelProfiler *_kernel_profiler = nullptr;
+
   CircleReader _circle_reader;
 };
 
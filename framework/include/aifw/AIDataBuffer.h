@@ -27,11 +27,38 @@
 namespace aifw {
 
 class AIModel;
-class AIDataBufferNode;
+
+/**
+ * @brief Consecutive rows of the data buffer in chronological order, oldest row first.
+ * Row r of the span starts at data + r * stride of the window.
+ */
+struct AIDataBufferSpan {
+	const void *data;
+	uint16_t rows;
+};
+
+/**
+ * @brief View of the latest rows of the data buffer without copying them.
+ * Rows may wrap around the end of the ring storage, so they are described by up to two spans.
+ * span[0] holds the oldest rows, span[1] the following ones and its rows field is 0 if rows did not wrap.
+ * Values have the type and quantization of the data buffer, see AIFW_DATA_TYPE.
+ * Last values of rows which are stored as float in an integer data buffer, e.g. invoke output, are not part of the view, rowSize excludes them.
+ * The view is valid until the next write or clear operation on the data buffer.
+ */
+struct AIDataBufferWindow {
+	AIDataBufferSpan span[2];
+	uint16_t stride;
+	uint16_t rowSize;
+	AIFW_DATA_TYPE type;
+	float scale;
+	int32_t zeroPoint;
+};
 
 /**
  * @class AIDataBuffer
- * @brief This class creates a doubly linked list and provides API to perform operations on that list.
+ * @brief This class stores rows of values in one contiguous ring and provides API to perform operations on those rows.
+ * Values are stored as float, or quantized to int16 or int8 with a scale and a zero point of the buffer.
+ * Float values are converted when they are written or read.
  */
 class AIDataBuffer
 {
@@ -84,19 +111,57 @@ public:
 	 */
 	AIFW_RESULT clear(uint16_t offset, uint16_t count);
 
+	/**
+	 * @brief Gives a view of the latest rows of data buffer in chronological order without copying them.
+	 * @param [out] window: View of the rows, see AIDataBufferWindow.
+	 * @param [in] rows: Number of latest rows in the view.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT getWindow(AIDataBufferWindow *window, uint16_t rows);
+
+	/**
+	 * @brief Read columns startCol to endCol of the latest rows in chronological order into consecutive memory.
+	 * It is meant to fill an invoke input of a model which takes a sliding window of rows.
+	 * @param [out] buffer: Output buffer to copy data, its size is rows * (endCol - startCol) values.
+	 * @param [in] startCol: Column from where reading values from each row will start.
+	 * @param [in] endCol: Column upto which values will be read from each row.
+	 * @param [in] rows: Number of latest rows to read.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT readWindow(float *buffer, uint16_t startCol, uint16_t endCol, uint16_t rows);
+
+	/**
+	 * @brief Read columns startCol to endCol of the latest rows in chronological order into a tensor, e.g. the input tensor of a quantized model.
+	 * Values are copied as they are if the tensor has type and quantization of the data buffer, otherwise they are converted to the type of the tensor.
+	 * Columns stored as float in an integer data buffer can not be read this way, they are read by readData.
+	 * When meanVals and stdVals are given, values are normalized while they are converted, see quantizeData().
+	 * @param [in,out] tensor: Tensor to fill from its first value, its count should be at least rows * (endCol - startCol).
+	 * @param [in] startCol: Column from where reading values from each row will start.
+	 * @param [in] endCol: Column upto which values will be read from each row.
+	 * @param [in] rows: Number of latest rows to read.
+	 * @param [in] meanVals: Mean values of columns startCol to endCol, NULL to skip normalization.
+	 * @param [in] stdVals: Standard deviation values of columns startCol to endCol, NULL to skip normalization.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT readWindow(AITensor *tensor, uint16_t startCol, uint16_t endCol, uint16_t rows, const float *meanVals = NULL, const float *stdVals = NULL);
+
 	friend class AIModel;
 private:
 	/**
-	 * @brief Creates a doubly linked list with node count equal to row and node size equal to size.
-	 * @param [in] row: Number of rows/nodes needed in streaming buffer.
-	 * @param [in] size: Number of values in a single row/node.
+	 * @brief Allocates storage for row rows of size values each.
+	 * @param [in] row: Number of rows needed in streaming buffer.
+	 * @param [in] size: Number of values in a single row.
+	 * @param [in] type: Type of stored values.
+	 * @param [in] scale: Quantization scale of stored values, unused for AIFW_DATA_FLOAT32.
+	 * @param [in] zeroPoint: Quantization zero point of stored values, unused for AIFW_DATA_FLOAT32.
+	 * @param [in] floatCount: Number of last values of a row stored as float whatever the type is, e.g. invoke output which has its own range.
 	 * @return: AIFW_RESULT enum object. Before returning any error, it releases all the memory allocated.
 	 */
-	AIFW_RESULT init(uint16_t row, uint16_t size);
+	AIFW_RESULT init(uint16_t row, uint16_t size, AIFW_DATA_TYPE type, float scale, int32_t zeroPoint, uint16_t floatCount = 0);
 
 	/**
 	 * @brief Modifies the streaming buffer.
-	 * It compares row and size with previous set value of row and size and according to that it modifies the existing nodes or create more nodes or both.
+	 * It compares row and size with previous set value of row and size, storage is reallocated only if more rows or wider rows are needed.
 	 * @param [in] row: Number of rows needed in the streaming buffer.
 	 * @param [in] size: Number of values in a single row.
 	 * @return: AIFW_RESULT enum object. In case of any error, previously allocated memory is not released.
@@ -105,13 +170,13 @@ private:
 
 	/**
 	 * @brief Deinitializes the streaming buffer.
-	 * It clears the memory allocated to doubly linked list and resets class member variables.
+	 * It releases the storage and resets class member variables.
 	 */
 	void deinit(void);
 
 	/**
 	 * @brief Writes a row into streaming buffer.
-	 * Last node is detached and attached at the starting of the linked list. Values are then written in that node.
+	 * The oldest row is recycled as the latest row and values are written in that row.
 	 * @param [in] buffer: Input buffer from which data values are copied.
 	 * @param [in] size: Number of values in input buffer.
 	 * @return: AIFW_RESULT enum object.
@@ -135,24 +200,90 @@ private:
 	AIFW_RESULT deleteData(uint16_t row);
 
 	/**
-	 * @brief Clears the memory allocated to the list with head pointer equal to ptr.
-	 * @param [in] ptr: Pointer to the head of list.
+	 * @brief Gives address of a row in the ring storage.
+	 * @param [in] row: Index of row, 0 being latest row.
+	 * @return: Pointer to the first value of the row.
 	 */
-	void clearMemory(AIDataBufferNode *ptr);
+	uint8_t *getRow(uint16_t row);
 
 	/**
-	 * @brief Insert count number of nodes in a doubly linked list.
-	 * @param [in] count: Number of nodes in the list.
-	 * @param [in] size: Number of values in a single node.
+	 * @brief Gives address of the values of a row stored as float in an integer data buffer.
+	 * @param [in] row: Index of row, 0 being latest row.
+	 * @return: Pointer to the first float value of the row.
+	 */
+	float *getFloatRow(uint16_t row);
+
+	/**
+	 * @brief Sets count values to real value 0, i.e. zero point for quantized values.
+	 * @param [out] ptr: Pointer to the first value.
+	 * @param [in] count: Number of values.
+	 */
+	void clearValues(uint8_t *ptr, size_t count);
+
+	/**
+	 * @brief Stores float values with the type of the data buffer.
+	 * @param [out] ptr: Pointer to the first stored value.
+	 * @param [in] buffer: Float values.
+	 * @param [in] count: Number of values.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT storeValues(uint8_t *ptr, const float *buffer, uint16_t count);
+
+	/**
+	 * @brief Loads stored values as float values.
+	 * @param [out] buffer: Float values.
+	 * @param [in] ptr: Pointer to the first stored value.
+	 * @param [in] count: Number of values.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT loadValues(float *buffer, const uint8_t *ptr, uint16_t count);
+
+	/**
+	 * @brief Stores float values into columns of a row, whether they are stored with the type of the data buffer or as float.
+	 * @param [in] row: Index of row, 0 being latest row.
+	 * @param [in] col: First column to store.
+	 * @param [in] buffer: Float values.
+	 * @param [in] count: Number of values.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT storeColumns(uint16_t row, uint16_t col, const float *buffer, uint16_t count);
+
+	/**
+	 * @brief Loads columns of a row as float values, whether they are stored with the type of the data buffer or as float.
+	 * @param [out] buffer: Float values.
+	 * @param [in] row: Index of row, 0 being latest row.
+	 * @param [in] col: First column to load.
+	 * @param [in] count: Number of values.
 	 * @return: AIFW_RESULT enum object.
 	 */
-	AIFW_RESULT createList(uint16_t count, uint16_t size);
+	AIFW_RESULT loadColumns(float *buffer, uint16_t row, uint16_t col, uint16_t count);
+
+	/**
+	 * @brief Fills a view of the latest rows, lock should be held by caller.
+	 * @param [out] window: View of the rows.
+	 * @param [in] rows: Number of latest rows in the view, it should not exceed row count.
+	 */
+	void fillWindow(AIDataBufferWindow *window, uint16_t rows);
+
+	/**
+	 * @brief Removes count rows starting from row offset, newer rows move into their place and emptied rows become the oldest ones.
+	 * @param [in] offset: Index of first row to remove.
+	 * @param [in] count: Number of rows to remove.
+	 */
+	void removeRows(uint16_t offset, uint16_t count);
 
-	AIDataBufferNode *mStart;
-	AIDataBufferNode *mEnd;
+	uint8_t *mData;
+	float *mFloatData;
+	AIFW_DATA_TYPE mType;
+	float mScale;
+	int32_t mZeroPoint;
+	uint8_t mValueSize;
+	uint16_t mStride;
+	uint16_t mHead;
 	uint16_t mMaxRows;
 	uint16_t mRowSize;
 	uint16_t mRowCount;
+	uint16_t mFloatCount;
 	pthread_mutex_t mLock;
 };
 
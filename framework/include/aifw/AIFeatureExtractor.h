@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/**
+ * @file aifw/AIFeatureExtractor.h
+ * @brief Incremental log-mel and MFCC features of PCM audio for voice models.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "aifw/aifw.h"
+
+namespace aifw {
+
+/**
+ * @brief Parameters of the feature extraction.
+ * sampleRate: Sample rate of PCM in Hz, e.g. 16000
+ * frameLength: Samples in one analysis frame, e.g. 400 for 25 msec at 16kHz
+ * frameShift: Samples between starts of consecutive frames, e.g. 160 for 10 msec at 16kHz
+ * fftLength: Power of two not less than frameLength, from 32 to 4096
+ * melBands: Number of triangular mel filters
+ * mfccCount: Number of cepstral coefficients of a frame, 0 to give log-mel energies instead
+ * lowFrequency: Lower edge of the first mel filter in Hz
+ * highFrequency: Upper edge of the last mel filter in Hz, 0 for half of sampleRate
+ * preEmphasis: Pre-emphasis coefficient, e.g. 0.97, 0 to disable it
+ * contextFrames: Number of latest feature frames kept for readFeatures
+ */
+struct AIFeatureConfig {
+	uint32_t sampleRate;
+	uint16_t frameLength;
+	uint16_t frameShift;
+	uint16_t fftLength;
+	uint16_t melBands;
+	uint16_t mfccCount;
+	float lowFrequency;
+	float highFrequency;
+	float preEmphasis;
+	uint16_t contextFrames;
+};
+
+/**
+ * @class AIFeatureExtractor
+ * @brief Computes features of overlapped frames of PCM as samples arrive.
+ * Samples are kept in a ring of one frame. Every frameShift samples, the frame is windowed (Hann), transformed by a real FFT,
+ * and its power spectrum goes through the mel filterbank, a log and optionally a DCT. Features of the latest contextFrames frames
+ * are kept in a ring, to be copied into the input of a model. All buffers are allocated by init, nothing is allocated per frame.
+ * FFT of CMSIS-DSP is used when EXTERNAL_CMSIS_DSP is enabled, a portable radix-2 FFT otherwise.
+ */
+class AIFeatureExtractor
+{
+public:
+	/**
+	 * @brief Construct the AIFeatureExtractor class instance.
+	 */
+	AIFeatureExtractor();
+
+	/**
+	 * @brief AIFeatureExtractor destructor.
+	 */
+	~AIFeatureExtractor();
+
+	/**
+	 * @brief Allocates buffers and computes window, filterbank and DCT tables for config.
+	 * @param [in] config: Parameters of the feature extraction.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT init(const AIFeatureConfig &config);
+
+	/**
+	 * @brief Releases all buffers.
+	 */
+	void deinit(void);
+
+	/**
+	 * @brief Drops samples and features collected so far, e.g. at the start of a new utterance.
+	 */
+	void reset(void);
+
+	/**
+	 * @brief Gives number of values in features of one frame, melBands or mfccCount.
+	 */
+	uint16_t getFeatureCount(void);
+
+	/**
+	 * @brief Gives number of frames whose features are kept, at most contextFrames.
+	 */
+	uint16_t getFrameCount(void);
+
+	/**
+	 * @brief Adds 16 bits mono PCM samples and computes features of every frame completed by them.
+	 * @param [in] pcm: Samples.
+	 * @param [in] count: Number of samples.
+	 * @param [out] frames: Number of frames computed, can be NULL.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT pushSamples(const int16_t *pcm, uint32_t count, uint16_t *frames);
+
+	/**
+	 * @brief Copies features of the latest frames in chronological order, oldest frame first, e.g. into invoke input of a model.
+	 * @param [out] features: Output buffer of frames * getFeatureCount() values.
+	 * @param [in] frames: Number of latest frames to copy, at most contextFrames.
+	 * @return: AIFW_OK, AIFW_INFERENCE_PROCEEDING while less than frames frames are computed, or error.
+	 */
+	AIFW_RESULT readFeatures(float *features, uint16_t frames);
+
+private:
+	void computeFrame(void);
+	void powerSpectrum(void);
+	void fft(float *data);
+
+	AIFeatureConfig mConfig;
+	uint16_t mFeatureCount;
+	/* Ring of the latest frameLength samples after pre-emphasis */
+	float *mSamples;
+	uint16_t mSampleWrite;
+	uint16_t mSamplesToFrame;
+	float mLastSample;
+	float *mWindow;
+	/* FFT input and output, fftLength values each */
+	float *mFftIn;
+	float *mFftOut;
+	/* Power of bins 0 to fftLength / 2 */
+	float *mPower;
+	/* Filter b has weights mMelWeights[mMelOffset[b]...] for bins mMelStart[b] onwards */
+	uint16_t *mMelStart;
+	uint16_t *mMelLength;
+	uint16_t *mMelOffset;
+	float *mMelWeights;
+	float *mLogMel;
+	/* mfccCount x melBands DCT-II matrix */
+	float *mDct;
+	/* Ring of features of the latest contextFrames frames */
+	float *mFeatures;
+	uint16_t mFeatureWrite;
+	uint16_t mFrameCount;
+	/* CMSIS-DSP instance, or twiddles and bit reversal of the portable FFT */
+	void *mFftInstance;
+	float *mTwiddle;
+	uint16_t *mBitReverse;
+};
+
+} /* namespace aifw */
@@ -127,6 +127,29 @@ public:
 	 */
 	uint32_t getModelCode(void);
 
+#ifdef CONFIG_AIFW_PROFILING
+	/**
+	 * @brief: Gives time taken by every stage of inference cycles since model creation or resetProfile, and usage of tensor arena.
+	 * Only successful stages are measured.
+	 * @param [out] profile: Profile of the model.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT getProfile(AIModelProfile *profile);
+
+	/**
+	 * @brief: Gives time taken by every operator type of the model in invoke, since model load or resetProfile.
+	 * @param [out] ops: Array filled with one entry per operator type.
+	 * @param [in,out] count: Capacity of ops as input, number of entries filled as output.
+	 * @return: AIFW_RESULT enum object. AIFW_NOT_SUPPORTED if the engine can not measure operators.
+	 */
+	AIFW_RESULT getOpProfile(AIProfileTime *ops, uint16_t *count);
+
+	/**
+	 * @brief: Clears time measured so far.
+	 */
+	void resetProfile(void);
+#endif /* CONFIG_AIFW_PROFILING */
+
 private:
 	/**
 	 * @brief It constructs AIDataBuffer object and initializes it.
@@ -140,6 +163,13 @@ private:
 	 */
 	AIFW_RESULT invoke(void);
 
+	/**
+	 * @brief It fills input tensors of the engine in place from AIDataBuffer, or through data processor.
+	 * Values are converted to the type of the tensors on the way, so a quantized model needs no float invoke input.
+	 * @return: AIFW_RESULT enum object. AIFW_NOT_SUPPORTED if invoke input has to be prepared as float values.
+	 */
+	AIFW_RESULT fillInputTensors(void);
+
 	/**
 	 * @brief It loads manifest information from file specified by scriptPath and fills it into mModelAttribute's member variables.
 	 * @param [in] path: Manifest file path.
@@ -147,6 +177,14 @@ private:
 	 */
 	AIFW_RESULT setModelAttributes(const char *path);
 
+	/**
+	 * @brief It gives address of model file to use it in place, when file system of the file is XIP capable.
+	 * @param [in] file: Model file path.
+	 * @param [out] model: Address of model file content, aligned to 16 bytes.
+	 * @return: AIFW_OK when model can be used in place, AIFW_NOT_SUPPORTED when it should be read into RAM.
+	 */
+	AIFW_RESULT getModelAddress(const char *file, const unsigned char **model);
+
 	/**
 	 * @brief It frees memory allocated to mModelAttribute's member variables.
 	 */
@@ -181,9 +219,13 @@ private:
 	uint16_t mOutputSetCount;
 
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+	AITensor *mInputTensors;
 	float *mParsedData;
 	float *mPostProcessedData;
 	std::shared_ptr<AIProcessHandler> mDataProcessor;
+#ifdef CONFIG_AIFW_PROFILING
+	AIModelProfile mProfile;
+#endif
 };
 
 } /* namespace aifw */
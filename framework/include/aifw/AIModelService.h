@@ -59,6 +59,25 @@ public:
 	 */
 	AIFW_RESULT setInterval(uint16_t interval);
 
+#ifdef CONFIG_AIFW_MODEL_SCHEDULER
+	/**
+	 * @brief Sets priority of data collection of this service on the model scheduler worker.
+	 * When several services are due at the same time, the one with the highest priority runs first.
+	 * Services with the same priority run in order of their deadline, which is the end of their current interval.
+	 * Default priority is 0.
+	 * @param [in] priority: Higher value runs first.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT setPriority(uint8_t priority);
+
+	/**
+	 * @brief Gives count of data collections skipped because the scheduler worker was busy after their deadline.
+	 * @param [out] missed: Count of skipped intervals since prepare.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT getMissedCount(uint32_t *missed);
+#endif /* CONFIG_AIFW_MODEL_SCHEDULER */
+
 	/**
 	 * @brief mInterval > 0 : It starts the timer as per mInterval which is set in prepare API.
 	 * 		  After this, application will start recieving data collection callback after time interval specified by mInterval.
@@ -87,6 +106,7 @@ public:
 	 * @brief It calls prepare function of AIInferenceHandler which attaches data processing logic(if required) in each model and loads the models.
 	 * It then retrieves inference interval of model set from AIInferenceHandler.
 	 * If inference interval > 0, it allocate memory to timer structure and create/initialize the timer. It does not start the timer.
+	 * With CONFIG_AIFW_MODEL_SCHEDULER, the service is registered on the model scheduler worker instead of a timer.
 	 * @return: AIFW_RESULT enum object.
 	 */
 	AIFW_RESULT prepare(void);
@@ -126,6 +146,10 @@ private:
 	AIFW_RESULT freeTimer(void);
 
 	uint16_t mInterval;
+#ifdef CONFIG_AIFW_MODEL_SCHEDULER
+	uint8_t mPriority;
+	bool mScheduled;
+#endif
 	bool mServiceRunning;
 	std::shared_ptr<AIInferenceHandler> mInferenceHandler;
 	CollectRawDataListener mCollectRawDataCallback;
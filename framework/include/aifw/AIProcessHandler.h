@@ -81,6 +81,23 @@ public:
 	virtual AIFW_RESULT preProcessData(std::shared_ptr<AIDataBuffer> buffer, uint16_t countInputSets, float **invokeInput, AIModelAttribute *modelAttribute) = 0;
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 
+	/**
+	 * @brief Performs preprocessing on data stored in AIDataBuffer and writes it straight into input tensors of the model.
+	 * It is called instead of preProcessData when the engine lets input tensors be filled in place, e.g. int8 or int16 tensors of a quantized model.
+	 * Values can be quantized into a tensor by quantizeData(), and rows can be copied or converted by AIDataBuffer::readWindow().
+	 * @param [in] buffer: Pointer of AIDataBuffer, same as in preProcessData.
+	 * @param [in] countInputSets: Number of inputs to model.
+	 * @param [in,out] invokeInput: Input tensors of the model with their type, quantization, count and values.
+	 * @param [in] modelAttribute: Contains AIModelAttribute value of current AI Model.
+	 * @return: AIFW_RESULT enum object. On success, AIFW_OK is returned.
+	 * 			AIFW_NOT_SUPPORTED, returned by default implementation, makes AIFW call preProcessData and convert its float output.
+	 * 			On failure, a negative value is returned.
+	 */
+	virtual AIFW_RESULT preProcessTensorData(std::shared_ptr<AIDataBuffer> buffer, uint16_t countInputSets, AITensor *invokeInput, AIModelAttribute *modelAttribute)
+	{
+		return AIFW_NOT_SUPPORTED;
+	}
+
 	/**
 	 * @brief Performs postprocessing on data stored in AIDataBuffer after invoke. Postprocessed data will not be updated on AIDataBuffer.
 	 * @param [in] buffer: Pointer of AIDataBuffer. At this point of time, latest row includes parsed raw data as well as invoke output.
@@ -54,8 +54,74 @@ typedef enum _AIFW_RESULT {
 	AIFW_INVALID_ATTRIBUTE = -12,	/* Invalid argument in manifest file */
 	AIFW_CSV_EMPTY_LINE = -13,	/* CSV has empty line or empty field */
 	AIFW_SOURCE_EOF = -14,	/* End Of File or End of Source data */
+	AIFW_NOT_SUPPORTED = -15,	/* Operation is not supported by the implementation */
 } AIFW_RESULT;
 
+/**
+ * Types of values stored in AI data buffer or in model tensors.
+ * Integer types hold linearly quantized values: real value = scale * (quantized value - zeroPoint).
+ */
+typedef enum _AIFW_DATA_TYPE {
+	AIFW_DATA_FLOAT32 = 0,	/* 32 bits float, not quantized */
+	AIFW_DATA_INT16 = 1,	/* 16 bits signed integer, quantized */
+	AIFW_DATA_INT8 = 2,	/* 8 bits signed integer, quantized */
+} AIFW_DATA_TYPE;
+
+/**
+ * @brief This structure describes values of a model tensor or any typed array.
+ * type: Type of values
+ * scale: Quantization scale, unused for AIFW_DATA_FLOAT32
+ * zeroPoint: Quantization zero point, unused for AIFW_DATA_FLOAT32
+ * count: Number of values
+ * data: Pointer to values
+ */
+struct AITensor {
+	AIFW_DATA_TYPE type;
+	float scale;
+	int32_t zeroPoint;
+	uint16_t count;
+	void *data;
+};
+
+/**
+ * Stages of an inference cycle measured by AI Framework profiling.
+ */
+typedef enum _AIFW_PROFILE_STAGE {
+	AIFW_PROFILE_PARSE = 0,	/* Parsing of raw data and writing it to AI data buffer */
+	AIFW_PROFILE_PRE_PROCESS = 1,	/* Filling of model input, pre processing included */
+	AIFW_PROFILE_INVOKE = 2,	/* Engine invoke */
+	AIFW_PROFILE_POST_PROCESS = 3,	/* Writing of model output to AI data buffer, post processing included */
+	AIFW_PROFILE_STAGE_MAX
+} AIFW_PROFILE_STAGE;
+
+/**
+ * @brief This structure holds time taken by a profiled stage or operator, in microseconds.
+ * name: Name of operator, NULL for a stage
+ * count: Number of times it was measured
+ * lastUs: Time of the last run
+ * maxUs: Longest time of a run
+ * totalUs: Sum of time of all runs
+ */
+struct AIProfileTime {
+	const char *name;
+	uint32_t count;
+	uint32_t lastUs;
+	uint32_t maxUs;
+	uint64_t totalUs;
+};
+
+/**
+ * @brief This structure holds profile of a model.
+ * stages: Time taken by every stage of inference cycles, indexed by AIFW_PROFILE_STAGE
+ * arenaUsedBytes: Bytes of tensor arena used once the model is loaded, 0 if engine does not report it
+ * arenaSize: Size of tensor arena, 0 if engine does not report it
+ */
+struct AIModelProfile {
+	struct AIProfileTime stages[AIFW_PROFILE_STAGE_MAX];
+	uint32_t arenaUsedBytes;
+	uint32_t arenaSize;
+};
+
 /**
  * @brief: AI Framework calls this function to collect the raw data and pass it for inference.
  * This callback is called when timer expires. Time interval is set in 'inferenceInterval' field of AIModelAttribute structure.
@@ -92,6 +158,10 @@ typedef void (*InferenceResultListener)(AIFW_RESULT res, void *values, uint16_t
  * inferenceResultCount: Number of primitive data values sent to application after inference of a modelset
  * MeanVals: List of mean values used in normalization
  * STDVals: List of standard deviation values used in normalization
+ * dataBufferType: Type of values stored in AI data buffer, AIFW_DATA_FLOAT32 by default
+ * dataBufferScale: Quantization scale of AI data buffer values when dataBufferType is an integer type
+ * dataBufferZeroPoint: Quantization zero point of AI data buffer values when dataBufferType is an integer type
+ * xipModel: 1 when file based AI Model is used in place from an XIP file system, e.g. romfs on flash, instead of being copied to RAM
  */
 struct AIModelAttribute {
 	uint32_t crc32;
@@ -111,6 +181,10 @@ struct AIModelAttribute {
 	uint16_t inferenceResultCount;
 	float *meanVals;
 	float *stdVals;
+	AIFW_DATA_TYPE dataBufferType;
+	float dataBufferScale;
+	int32_t dataBufferZeroPoint;
+	uint8_t xipModel;
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,123 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/**
+ * @file aifw/aifw_dataset_reader.h
+ * @brief APIs to convert a csv file into a binary dataset and to read it in batches of rows.
+ *
+ * A binary dataset is a header followed by rows of fixed size. Every row holds columnCount values
+ * of the same type, stored as they are in memory of the device (little endian), so rows of a batch
+ * are given to the application without any parsing.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "aifw/aifw.h"
+#include "aifw/aifw_csv_reader.h"
+
+/* "AIDS" in a little endian file */
+#define AIFW_DATASET_MAGIC 0x53444941
+#define AIFW_DATASET_VERSION 1
+
+/**
+ * @struct _AIFW_DATASET_HEADER_S
+ * @brief Header at the start of a binary dataset file.
+ * magic: AIFW_DATASET_MAGIC
+ * version: AIFW_DATASET_VERSION
+ * headerSize: Offset of the first row in the file
+ * dataType: CSV_VALUE_DATA_TYPE_E type of all values
+ * valueSize: Size of one value in bytes
+ * columnCount: Number of values in one row
+ * rowCount: Number of rows in the file
+ */
+typedef struct _AIFW_DATASET_HEADER_S {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t headerSize;
+	uint8_t dataType;
+	uint8_t valueSize;
+	uint16_t columnCount;
+	uint32_t rowCount;
+} AIFW_DATASET_HEADER_S;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Converts a csv file into a binary dataset. Blank lines of csv are skipped as in readCSVData.
+ * Csv is rejected if any line has an empty value or a column count other than its first line.
+ * Dataset file is not created, or removed, when conversion fails.
+ * @param [in] csvFile: Name of csv file to read.
+ * @param [in] datasetFile: Name of binary dataset file to create.
+ * @param [in] dataType: Data type of column data values.
+ * @param [in] hasHeader: false(header is not present in csv) or true(header is present in csv)
+ * @param [out] rowCount: Number of rows written, can be NULL.
+ * @return: AIFW_RESULT enum object.
+ */
+AIFW_RESULT csvToDataset(const char *csvFile, const char *datasetFile, CSV_VALUE_DATA_TYPE_E dataType, bool hasHeader, uint32_t *rowCount);
+
+/**
+ * @brief Initialize the binary dataset reader.
+ * Opens the dataset file, checks its header and allocates a buffer for batchRows rows.
+ * @param [out] datasetHandle: Void double pointer to the dataset handle, passed to further APIs.
+ * @param [in] filename: Name of binary dataset file to open.
+ * @param [in] batchRows: Maximum number of rows given by one readDatasetRows call.
+ * @return: AIFW_RESULT enum object.
+ */
+AIFW_RESULT datasetInit(void **datasetHandle, const char *filename, uint16_t batchRows);
+
+/**
+ * @brief De-init the binary dataset reader. Closes the file and clears the allocated memory.
+ * @param [in] handle: Void double pointer to the dataset handle.
+ * @return: AIFW_RESULT enum object.
+ */
+AIFW_RESULT datasetDeinit(void **handle);
+
+/**
+ * @brief Get type and dimensions of a binary dataset.
+ * @param [in] handle: Void pointer to the dataset handle.
+ * @param [out] dataType: Data type of values, can be NULL.
+ * @param [out] columnCount: Number of values in one row, can be NULL.
+ * @param [out] rowCount: Number of rows in the dataset, can be NULL.
+ * @return: AIFW_RESULT enum object.
+ */
+AIFW_RESULT getDatasetInfo(void *handle, CSV_VALUE_DATA_TYPE_E *dataType, uint16_t *columnCount, uint32_t *rowCount);
+
+/**
+ * @brief Reads next batch of rows with a single read of the file.
+ * Rows are given in place in the buffer of the reader, they are valid until the next call.
+ * @param [in] handle: Void pointer to the dataset handle.
+ * @param [out] rows: Pointer to the first row of the batch. Row i starts columnCount values after row i - 1.
+ * @param [out] rowCount: Number of rows in the batch, at most batchRows given in datasetInit.
+ * @return: AIFW_OK, AIFW_SOURCE_EOF when all rows are read, or error.
+ */
+AIFW_RESULT readDatasetRows(void *handle, void **rows, uint16_t *rowCount);
+
+/**
+ * @brief Reads the dataset again from its first row.
+ * @param [in] handle: Void pointer to the dataset handle.
+ * @return: AIFW_RESULT enum object.
+ */
+AIFW_RESULT rewindDataset(void *handle);
+
+#ifdef __cplusplus
+}
+#endif
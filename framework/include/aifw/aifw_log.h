@@ -28,7 +28,10 @@
 #include <stdio.h>
 #include <string.h>
 
+#if defined(CONFIG_AIFW_LOGE) || defined(CONFIG_AIFW_LOGI) || defined(CONFIG_AIFW_LOGV)
+/* Name of the file logging, only referenced by enabled logs */
 static const char *file_name = 0;
+#endif
 #define TAG "[AIFW]"
 #define TAG_AIFW_UTILS "[AIFW_UTILS]"
 #define _FILE_NAME file_name ? file_name : (file_name = strrchr(__FILE__, '/') ? (char *)(strrchr(__FILE__, '/') + 1) : __FILE__)
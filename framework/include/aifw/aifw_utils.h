@@ -35,6 +35,34 @@
  */
 void normalizeData(float dataValues[], float meanVals[], float stdValues[], uint16_t countOfValues);
 
+/**
+ * @brief: Utility function to normalize and quantize the data in a single pass
+ * It can write straight into a quantized model input tensor, without an intermediate float buffer.
+ * @param [in] dataValues: Data to be normalized and quantized
+ * @param [in] meanVals: Mean values to use in normalization, NULL to skip normalization
+ * @param [in] stdValues: Standard deviation values to use in normalization, NULL to skip normalization
+ * @param [in] countOfValues: number of values. Parameter 1~3 all have same count of values.
+ * @param [in,out] output: Tensor to fill from its first value, its type, scale and zeroPoint are used. Values out of range of the type are saturated.
+ * @return: AIFW_RESULT enum object.
+ */
+AIFW_RESULT quantizeData(const float dataValues[], const float meanVals[], const float stdValues[], uint16_t countOfValues, AITensor *output);
+
+/**
+ * @brief: Utility function to convert typed values to float values
+ * @param [in] input: Tensor to read from its first value, its type, scale and zeroPoint are used.
+ * @param [out] dataValues: Buffer to store float values
+ * @param [in] countOfValues: number of values
+ * @return: AIFW_RESULT enum object.
+ */
+AIFW_RESULT dequantizeData(const AITensor *input, float dataValues[], uint16_t countOfValues);
+
+/**
+ * @brief: Utility function to get size in bytes of a value of given type
+ * @param [in] type: Type of value
+ * @return: Size of a value, 0 for an unknown type.
+ */
+uint8_t getDataTypeSize(AIFW_DATA_TYPE type);
+
 /**
  * @brief: Utility function to get mse value from the predicted value
  * @param [in] realValues: Actual values
@@ -114,9 +114,21 @@ public:
 	 */
 	int seekTo(off_t offset) override;
 
+	/**
+	 * @brief Gets the frame index of the file, it is loaded from "<path>.idx" if saved before
+	 * @details @b #include <media/FileInputDataSource.h>
+	 * @return Pointer to the frame index, nullptr if not supported
+	 * @since TizenRT v5.0
+	 */
+	struct frame_index_s *getFrameIndex() override;
+
 private:
+	void openFrameIndex();
+	void closeFrameIndex();
+
 	std::string mDataPath;
 	FILE *mFp;
+	struct frame_index_s *mFrameIndex;
 };
 } // namespace stream
 } // namespace media
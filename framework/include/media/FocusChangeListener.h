@@ -36,6 +36,8 @@ static const int FOCUS_GAIN = 1;
 static const int FOCUS_GAIN_TRANSIENT = 2;
 static const int FOCUS_LOSS = 3;
 static const int FOCUS_LOSS_TRANSIENT = 4;
+/* Focus is lost for a while, but playback may go on at a lower level (since TizenRT v5.0) */
+static const int FOCUS_LOSS_TRANSIENT_CAN_DUCK = 5;
 
 /**
  * @class 
@@ -35,7 +35,9 @@
 #include <curl/easy.h>
 #include <pthread.h>
 #include <thread>
+#include <chrono>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include <string>
 
@@ -51,6 +53,9 @@ class StreamBufferWriter;
  * @class
  * @brief This class is http input data structure
  * @details @b #include <media/HttpInputDataSource.h>
+ * If the server accepts byte ranges, the stream is downloaded in ranges sized
+ * from the measured bitrate, an interrupted download resumes from where it stopped,
+ * and the source is seekable.
  * @since TizenRT v2.0
  */
 class HttpInputDataSource : public InputDataSource, public BufferObserverInterface
@@ -119,6 +124,16 @@ public:
 	 * @since TizenRT v2.0
 	 */
 	ssize_t read(unsigned char *buf, size_t size) override;
+	/**
+	 * @brief Seek to 'offset' of the http stream
+	 * @details @b #include <media/HttpInputDataSource.h>
+	 * Data already downloaded is skipped in place, otherwise download restarts
+	 * from offset with a range request. The server should accept byte ranges.
+	 * param[in] offset byte position from the beginning of stream
+	 * @return 0 on success, On failure, it returns negative value.
+	 * @since TizenRT v5.0
+	 */
+	int seekTo(off_t offset) override;
 
 public:
 	/**
@@ -132,6 +147,10 @@ private:
 	static size_t HeaderCallback(char *data, size_t size, size_t nmemb, void *userp);
 	static size_t WriteCallback(char *data, size_t size, size_t nmemb, void *userp);
 	static void *workerMain(void *arg);
+	bool startWorker();
+	void stopWorker();
+	size_t getRangeSize();
+	void updateReadRate(size_t len);
 
 private:
 	std::string mContentType;
@@ -141,6 +160,19 @@ private:
 	std::condition_variable mCondv;
 	bool mIsHeaderReceived;
 	bool mIsDataReceived;
+	/* Total length of the stream, -1 if it is unknown */
+	off_t mContentLength;
+	bool mAcceptRanges;
+	long mStatusCode;
+	/* Stream position requested by current download */
+	off_t mRequestOffset;
+	/* Stream position of the next byte downloaded, and of the next byte read */
+	off_t mDownloadOffset;
+	off_t mReadOffset;
+	/* Bytes per second consumed by reader, 0 before it is measured */
+	std::atomic<size_t> mReadRate;
+	size_t mReadBytes;
+	std::chrono::steady_clock::time_point mReadStart;
 	std::shared_ptr<HttpStream> mHttpStream;
 	std::shared_ptr<StreamBuffer> mStreamBuffer;
 	std::shared_ptr<StreamBufferReader> mBufferReader;
@@ -32,6 +32,8 @@
 #include <memory>
 #include <media/DataSource.h>
 
+struct frame_index_s;
+
 namespace media {
 namespace stream {
 
@@ -84,6 +86,14 @@ public:
 	 */
 	virtual int seekTo(off_t offset) { return -1; }
 
+	/**
+	 * @brief Gets the frame index which maps playback time to offset of compressed frames
+	 * @details @b #include <media/InputDataSource.h>
+	 * @return Pointer to the frame index, nullptr if source does not keep it
+	 * @since TizenRT v5.0
+	 */
+	virtual struct frame_index_s *getFrameIndex() { return nullptr; }
+
 };
 
 } // namespace stream
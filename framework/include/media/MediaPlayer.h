@@ -191,6 +191,18 @@ public:
 	 */
 	player_result_t setVolume(uint8_t);
 
+	/**
+	 * @brief Set the gain of the player
+	 * @details @b #include <media/MediaPlayer.h>
+	 * This function is a synchronous API
+	 * Samples of this player are scaled in software, on top of the volume of the output,
+	 * so players sharing the output can be balanced.
+	 * @param[in] gain The gain in percent of the source level, from 0 to 100
+	 * @return The result of the setGain operation
+	 * @since TizenRT v5.0
+	 */
+	player_result_t setGain(uint8_t gain);
+
 	/**
 	 * @brief Set the DataSource of input data
 	 * @details @b #include <media/MediaPlayer.h>
@@ -249,6 +261,32 @@ public:
 	 */
 	player_result_t setLooping(bool loop);
 
+	/**
+	 * @brief Queue a data source to be played after the current one
+	 * @details @b #include <media/MediaPlayer.h>
+	 * This function is a synchronous API
+	 * The first queued source is opened and buffered while the current one is playing,
+	 * and playback moves on to it at end of stream without closing the audio output.
+	 * onPlaybackSourceChanged() is called on each move, onPlaybackFinished() after the last source.
+	 * Queued sources are dropped by unprepare().
+	 * param[in] source unique_ptr of InputDataSource
+	 * @return The result of the setNextDataSource operation
+	 * @since TizenRT v5.0
+	 */
+	player_result_t setNextDataSource(std::unique_ptr<stream::InputDataSource> source);
+
+	/**
+	 * @brief Move playback position of MediaPlayer
+	 * @details @b #include <media/MediaPlayer.h>
+	 * This function is a synchronous API
+	 * It is available in ready, playing and paused state, for audio decoded without container.
+	 * With CONFIG_MEDIA_FRAME_INDEX, decoding resumes from the nearest frame recorded before.
+	 * param[in] msec playback position in milliseconds
+	 * @return The result of the seekTo operation
+	 * @since TizenRT v5.0
+	 */
+	player_result_t seekTo(unsigned int msec);
+
 private:
 	std::shared_ptr<MediaPlayerImpl> mPMpImpl;
 	uint64_t mId;
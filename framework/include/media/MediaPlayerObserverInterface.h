@@ -134,6 +134,12 @@ public:
 	 * @since TizenRT v2.0
 	 */
 	virtual void onAsyncPrepared(MediaPlayer &mediaPlayer, player_error_t error) {}
+	/**
+	 * @brief informs the user the playback moved on to the next data source without stopping
+	 * @details @b #include <media/MediaPlayerObserverInterface.h>
+	 * @since TizenRT v5.0
+	 */
+	virtual void onPlaybackSourceChanged(MediaPlayer &mediaPlayer) {}
 };
 } // namespace media
 
@@ -31,6 +31,7 @@
 
 #include <memory>
 #include <pthread.h>
+#include <sys/uio.h>
 #include <media/DataSource.h>
 #include <media/BufferObserverInterface.h>
 
@@ -90,6 +91,18 @@ public:
 	 */
 	virtual ssize_t write(unsigned char *buf, size_t size) = 0;
 
+	/**
+	 * @brief Puts the stream data gathered from several buffers at once
+	 * @details @b #include <media/OutputDataSource.h>
+	 * Data sources which can take all buffers in one operation, e.g. a socket, should override it.
+	 * Default implementation calls write() for each buffer.
+	 * @param[in] iov The buffers to be written, in order
+	 * @param[in] iovcnt The number of buffers
+	 * @return if error occurred before anything is written, it returns -1, else written size returns
+	 * @since TizenRT v5.0
+	 */
+	virtual ssize_t writev(const struct iovec *iov, int iovcnt);
+
 	/**
 	 * @brief Register current recorder to get data souce state and other infomations.
 	 * @details @b #include <media/OutputDataSource.h>
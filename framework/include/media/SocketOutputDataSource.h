@@ -124,7 +124,19 @@ public:
 	 */
 	ssize_t write(unsigned char* buf, size_t size) override;
 
+	/**
+	 * @brief Puts the data of several buffers with one sendmsg
+	 * @details @b #include <media/SocketOutputDataSource.h>
+	 * @param[in] iov The buffers to be written, in order
+	 * @param[in] iovcnt The number of buffers
+	 * @return if error occurred before anything is written, it returns -1, else written size returns
+	 * @since TizenRT v5.0
+	 */
+	ssize_t writev(const struct iovec *iov, int iovcnt) override;
+
 private:
+	ssize_t sendAll(const unsigned char *buf, size_t size);
+
 	std::string mIpAddr;
 	uint16_t mPort;
 	int mSockFd;
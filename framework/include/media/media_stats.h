@@ -0,0 +1,257 @@
+/* ****************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/**
+ * @ingroup MEDIA
+ * @{
+ */
+
+/**
+ * @file media/media_stats.h
+ * @brief Per-stage counters of the media pipeline, enabled by CONFIG_MEDIA_PIPELINE_STATS
+ */
+
+#ifndef __MEDIA_STATS_H
+#define __MEDIA_STATS_H
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief Stages of the media pipeline which are measured.
+ * @since TizenRT v5.0
+ */
+enum media_stats_stage_e {
+	MEDIA_STATS_SOURCE,  /**< Reading from input data source */
+	MEDIA_STATS_DECODE,  /**< Decoding a frame, time per decoded frame */
+	MEDIA_STATS_BUFFER,  /**< Stream buffer between input handler and playback */
+	MEDIA_STATS_OUTPUT,  /**< Writing PCM frames to the output audio card */
+	MEDIA_STATS_SINK,    /**< Writing recorded data to output data source */
+	MEDIA_STATS_CAPTURE, /**< Reading PCM frames from the input audio card */
+	MEDIA_STATS_ENCODE,  /**< Encoding captured PCM, on the encoder worker of the recorder */
+	MEDIA_STATS_STAGE_MAX
+};
+
+typedef enum media_stats_stage_e media_stats_stage_t;
+
+/**
+ * @brief Counters of a stage.
+ * @since TizenRT v5.0
+ */
+struct media_stats_stage_s {
+	uint32_t calls;       /**< Number of operations, e.g. reads or decoded frames */
+	uint32_t frames;      /**< PCM frames produced or consumed */
+	uint64_t bytes;       /**< Bytes moved */
+	uint64_t total_us;    /**< Time spent in the operations */
+	uint32_t max_us;      /**< Longest operation */
+	uint32_t level;       /**< Current occupancy in bytes of the queue after the stage */
+	uint32_t high_water;  /**< Highest occupancy in bytes of the queue after the stage */
+	uint32_t xruns;       /**< Underruns or overruns of the stage */
+};
+
+/**
+ * @brief Latency from a start request to the first frame written to the audio card.
+ * @since TizenRT v5.0
+ */
+struct media_stats_latency_s {
+	uint32_t count;       /**< Number of measured starts */
+	uint32_t last_us;     /**< Latency of the last start */
+	uint32_t max_us;      /**< Longest latency */
+};
+
+/**
+ * @brief Counters of the command queue of a media worker.
+ * @since TizenRT v5.0
+ */
+struct media_stats_queue_s {
+	const char *name;         /**< Name of the worker thread */
+	uint32_t depth;           /**< Commands queued now */
+	uint32_t max_depth;       /**< Most commands queued at once */
+	uint32_t max_latency_us;  /**< Longest wait of a command from queuing to dispatch */
+	uint32_t overflows;       /**< Commands queued while the ring was full */
+	uint32_t drops;           /**< Commands lost, because the ring and its overflow slots were full */
+};
+
+/**
+ * @brief Callback to read the counters of a registered queue
+ * @since TizenRT v5.0
+ */
+typedef void (*media_stats_queue_cb_t)(void *arg, struct media_stats_queue_s *stats);
+
+#ifdef CONFIG_MEDIA_PIPELINE_STATS
+/**
+ * @brief Get a timestamp to be passed to media_stats_record()
+ * @details @b #include <media/media_stats.h>
+ * @return monotonic time in microseconds
+ * @since TizenRT v5.0
+ */
+uint32_t media_stats_now(void);
+
+/**
+ * @brief Account an operation of a stage which started at a timestamp
+ * @details @b #include <media/media_stats.h>
+ * @param[in] stage stage of the operation
+ * @param[in] start timestamp got by media_stats_now() before the operation
+ * @param[in] bytes bytes moved by the operation
+ * @param[in] frames PCM frames moved by the operation
+ * @since TizenRT v5.0
+ */
+void media_stats_record(media_stats_stage_t stage, uint32_t start, size_t bytes, unsigned int frames);
+
+/**
+ * @brief Update the occupancy of the queue after a stage, the high-water mark follows it
+ * @details @b #include <media/media_stats.h>
+ * @param[in] stage stage feeding the queue
+ * @param[in] level occupancy in bytes
+ * @since TizenRT v5.0
+ */
+void media_stats_set_level(media_stats_stage_t stage, size_t level);
+
+/**
+ * @brief Count an underrun or an overrun of a stage
+ * @details @b #include <media/media_stats.h>
+ * @param[in] stage stage which ran out of data or space
+ * @since TizenRT v5.0
+ */
+void media_stats_xrun(media_stats_stage_t stage);
+
+/**
+ * @brief Mark a start request, latency is measured up to the next media_stats_mark_output()
+ * @details @b #include <media/media_stats.h>
+ * @since TizenRT v5.0
+ */
+void media_stats_mark_start(void);
+
+/**
+ * @brief Mark frames written to the audio card, completes a pending latency measurement
+ * @details @b #include <media/media_stats.h>
+ * @since TizenRT v5.0
+ */
+void media_stats_mark_output(void);
+
+/**
+ * @brief Get a snapshot of the counters of a stage
+ * @details @b #include <media/media_stats.h>
+ * @param[in] stage stage to be read
+ * @param[out] stats counters of the stage
+ * @return 0 on success, otherwise a negative value
+ * @since TizenRT v5.0
+ */
+int media_stats_get(media_stats_stage_t stage, struct media_stats_stage_s *stats);
+
+/**
+ * @brief Get a snapshot of the start latency
+ * @details @b #include <media/media_stats.h>
+ * @param[out] latency start latency
+ * @return 0 on success, otherwise a negative value
+ * @since TizenRT v5.0
+ */
+int media_stats_get_latency(struct media_stats_latency_s *latency);
+
+/**
+ * @brief Register the command queue of a worker, its counters are printed with the stages
+ * @details @b #include <media/media_stats.h>
+ * @param[in] name name of the worker, it should stay valid until unregistered
+ * @param[in] cb callback to read the counters, it is called with arg
+ * @param[in] arg argument of cb, it identifies the queue
+ * @return 0 on success, otherwise a negative value
+ * @since TizenRT v5.0
+ */
+int media_stats_register_queue(const char *name, media_stats_queue_cb_t cb, void *arg);
+
+/**
+ * @brief Unregister a queue registered with arg
+ * @details @b #include <media/media_stats.h>
+ * @param[in] arg argument given at registration
+ * @since TizenRT v5.0
+ */
+void media_stats_unregister_queue(void *arg);
+
+/**
+ * @brief Get a snapshot of the counters of registered queues
+ * @details @b #include <media/media_stats.h>
+ * @param[out] queues array to be filled
+ * @param[in] count number of entries of the array
+ * @return number of entries filled, otherwise a negative value
+ * @since TizenRT v5.0
+ */
+int media_stats_get_queues(struct media_stats_queue_s *queues, int count);
+
+/**
+ * @brief Clear all counters of stages and the start latency
+ * @details Counters of worker queues are kept by the queues and are not cleared.
+ * @b #include <media/media_stats.h>
+ * @since TizenRT v5.0
+ */
+void media_stats_reset(void);
+
+/**
+ * @brief Format all counters as a table
+ * @details @b #include <media/media_stats.h>
+ * @param[out] buf buffer to be filled, always terminated
+ * @param[in] size size of the buffer
+ * @return length of the whole table, which may be larger than size like snprintf()
+ * @since TizenRT v5.0
+ */
+int media_stats_print(char *buf, size_t size);
+#else
+static inline uint32_t media_stats_now(void)
+{
+	return 0;
+}
+
+static inline void media_stats_record(media_stats_stage_t stage, uint32_t start, size_t bytes, unsigned int frames)
+{
+}
+
+static inline void media_stats_set_level(media_stats_stage_t stage, size_t level)
+{
+}
+
+static inline void media_stats_xrun(media_stats_stage_t stage)
+{
+}
+
+static inline void media_stats_mark_start(void)
+{
+}
+
+static inline void media_stats_mark_output(void)
+{
+}
+
+static inline int media_stats_register_queue(const char *name, media_stats_queue_cb_t cb, void *arg)
+{
+	return 0;
+}
+
+static inline void media_stats_unregister_queue(void *arg)
+{
+}
+#endif
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
+#endif
+/** @} */ // end of MEDIA group
@@ -17,8 +17,15 @@
  ****************************************************************************/
 
 #include "aifw/aifw_log.h"
+#include "aifw/aifw_utils.h"
 #include "aifw/AIDataBuffer.h"
-#include "include/AIDataBufferNode.h"
+
+#if defined(CONFIG_AIFW_DATA_BUFFER_ALIGNMENT) && (CONFIG_AIFW_DATA_BUFFER_ALIGNMENT > 0)
+#define ROW_ALIGN_BYTES CONFIG_AIFW_DATA_BUFFER_ALIGNMENT
+#endif
+
+/* Number of values converted at once through a float array on stack */
+#define CONVERT_CHUNK_VALUES 32
 #define _UNLOCK                                    \
 	{                                              \
 		int status = pthread_mutex_unlock(&mLock); \
@@ -54,8 +61,29 @@
 
 namespace aifw {
 
+/* Number of values from the start of a row to the start of the next one, every row starts aligned if alignment is configured. */
+static uint32_t getStride(uint16_t size, uint8_t valueSize)
+{
+#ifdef ROW_ALIGN_BYTES
+	uint32_t alignValues = (ROW_ALIGN_BYTES > valueSize) ? (ROW_ALIGN_BYTES / valueSize) : 1;
+	return ((uint32_t)size + alignValues - 1) / alignValues * alignValues;
+#else
+	return size;
+#endif
+}
+
+static uint8_t *allocRows(uint16_t row, uint16_t stride, uint8_t valueSize)
+{
+	size_t bytes = (size_t)row * stride * valueSize;
+#ifdef ROW_ALIGN_BYTES
+	return (uint8_t *)memalign(ROW_ALIGN_BYTES, bytes);
+#else
+	return (uint8_t *)malloc(bytes);
+#endif
+}
+
 AIDataBuffer::AIDataBuffer() :
-	mStart(NULL), mEnd(NULL), mMaxRows(0), mRowSize(0), mRowCount(0), mLock(PTHREAD_MUTEX_INITIALIZER)
+	mData(NULL), mFloatData(NULL), mType(AIFW_DATA_FLOAT32), mScale(0), mZeroPoint(0), mValueSize(sizeof(float)), mStride(0), mHead(0), mMaxRows(0), mRowSize(0), mRowCount(0), mFloatCount(0), mLock(PTHREAD_MUTEX_INITIALIZER)
 {
 	AIFW_LOGV("AIDataBuffer Constructor");
 }
@@ -66,16 +94,53 @@ AIDataBuffer::~AIDataBuffer()
 	deinit();
 }
 
-AIFW_RESULT AIDataBuffer::init(uint16_t row, uint16_t size)
+AIFW_RESULT AIDataBuffer::init(uint16_t row, uint16_t size, AIFW_DATA_TYPE type, float scale, int32_t zeroPoint, uint16_t floatCount)
 {
+	uint8_t valueSize = getDataTypeSize(type);
+	if (valueSize == 0 || (type != AIFW_DATA_FLOAT32 && scale <= 0)) {
+		AIFW_LOGE("Invalid argument - type %d scale %f", type, scale);
+		return AIFW_INVALID_ARG;
+	}
+	/* Float values of a float data buffer are stored with the others */
+	if (type == AIFW_DATA_FLOAT32 || floatCount > size) {
+		floatCount = 0;
+	}
+	uint32_t stride = getStride(size - floatCount, valueSize);
+	if (row == 0 || stride == 0 || stride > UINT16_MAX) {
+		AIFW_LOGE("Invalid argument - row %d size %d", row, size);
+		return AIFW_INVALID_ARG;
+	}
 	_LOCK
-	AIFW_RESULT ret = createList(row, size);
-	if (ret == AIFW_OK) {
-		mMaxRows = row;
-		mRowSize = size;
+	uint8_t *data = allocRows(row, (uint16_t)stride, valueSize);
+	float *floatData = floatCount ? (float *)malloc((size_t)row * floatCount * sizeof(float)) : NULL;
+	if (!data || (floatCount && !floatData)) {
+		AIFW_LOGE("buffer allocation failed with errno %d, error message: %s", errno, strerror(errno));
+		free(data);
+		free(floatData);
+		_UNLOCK
+		return AIFW_NO_MEM;
+	}
+	free(mData);
+	free(mFloatData);
+	mData = data;
+	mFloatData = floatData;
+	mFloatCount = floatCount;
+	mType = type;
+	mScale = scale;
+	mZeroPoint = zeroPoint;
+	mValueSize = valueSize;
+	mStride = (uint16_t)stride;
+	mMaxRows = row;
+	mRowSize = size;
+	/* First write moves head to slot 0. */
+	mHead = row - 1;
+	mRowCount = 0;
+	clearValues(mData, (size_t)mMaxRows * mStride);
+	if (mFloatData) {
+		memset(mFloatData, 0, (size_t)mMaxRows * mFloatCount * sizeof(float));
 	}
 	_UNLOCK
-	return ret;
+	return AIFW_OK;
 }
 
 AIFW_RESULT AIDataBuffer::reinit(uint16_t row, uint16_t size)
@@ -83,29 +148,50 @@ AIFW_RESULT AIDataBuffer::reinit(uint16_t row, uint16_t size)
 	if (row == mMaxRows && size == mRowSize) {
 		return AIFW_OK;
 	}
+	/* Number of values stored as float does not change, it is part of size */
+	if (size < mFloatCount) {
+		AIFW_LOGE("Invalid argument - size %d float values %d", size, mFloatCount);
+		return AIFW_INVALID_ARG;
+	}
+	uint16_t typedSize = size - mFloatCount;
 	_LOCK
-	if (size != mRowSize) {
-		AIDataBufferNode *tempNode = mStart;
-		float *tempPtr = nullptr;
-		while (tempNode) {
-			tempPtr = (float *)realloc(tempNode->mData, size * sizeof(float));
-			if (!tempPtr) {
-				AIFW_LOGE("node creation failed with errno %d, error message: %s", errno, strerror(errno));
-				_UNLOCK
-				return AIFW_NO_MEM;
-			}
-			tempNode->mData = tempPtr;
-			tempNode = tempNode->mNext;
+	if (row > mMaxRows || typedSize > mStride) {
+		uint16_t maxRows = (row > mMaxRows) ? row : mMaxRows;
+		uint32_t stride = getStride(typedSize, mValueSize);
+		if (stride == 0 || stride > UINT16_MAX) {
+			AIFW_LOGE("Invalid argument - size %d", size);
+			_UNLOCK
+			return AIFW_INVALID_ARG;
 		}
-	}
-	if (row > mMaxRows) {
-		AIFW_RESULT ret = createList(row - mMaxRows, size);
-		if (ret == AIFW_OK) {
-			mMaxRows = row;
-			mRowSize = size;
+		uint8_t *data = allocRows(maxRows, (uint16_t)stride, mValueSize);
+		float *floatData = mFloatCount ? (float *)malloc((size_t)maxRows * mFloatCount * sizeof(float)) : NULL;
+		if (!data || (mFloatCount && !floatData)) {
+			AIFW_LOGE("buffer allocation failed with errno %d, error message: %s", errno, strerror(errno));
+			free(data);
+			free(floatData);
+			_UNLOCK
+			return AIFW_NO_MEM;
 		}
-		_UNLOCK
-		return ret;
+		clearValues(data, (size_t)maxRows * stride);
+		if (floatData) {
+			memset(floatData, 0, (size_t)maxRows * mFloatCount * sizeof(float));
+		}
+		/* Keep filled rows in place of latest rows, newest row goes to the last slot. */
+		uint16_t oldTypedSize = mRowSize - mFloatCount;
+		uint16_t copySize = (typedSize < oldTypedSize) ? typedSize : oldTypedSize;
+		for (uint16_t i = 0; i < mRowCount; i++) {
+			memcpy(data + (size_t)(maxRows - 1 - i) * stride * mValueSize, getRow(i), copySize * mValueSize);
+			if (floatData) {
+				memcpy(floatData + (size_t)(maxRows - 1 - i) * mFloatCount, getFloatRow(i), mFloatCount * sizeof(float));
+			}
+		}
+		free(mData);
+		free(mFloatData);
+		mData = data;
+		mFloatData = floatData;
+		mStride = (uint16_t)stride;
+		mMaxRows = maxRows;
+		mHead = maxRows - 1;
 	}
 	mRowSize = size;
 	_UNLOCK
@@ -114,33 +200,134 @@ AIFW_RESULT AIDataBuffer::reinit(uint16_t row, uint16_t size)
 
 void AIDataBuffer::deinit(void)
 {
-	clearMemory(mStart);
-	mStart = NULL;
-	mEnd = NULL;
+	free(mData);
+	mData = NULL;
+	free(mFloatData);
+	mFloatData = NULL;
+	mFloatCount = 0;
+	mStride = 0;
+	mHead = 0;
 	mRowSize = 0;
 	mMaxRows = 0;
 	mRowCount = 0;
 }
 
-void AIDataBuffer::clearMemory(AIDataBufferNode *ptr)
+uint8_t *AIDataBuffer::getRow(uint16_t row)
+{
+	uint16_t slot = (mHead >= row) ? (mHead - row) : (mHead + mMaxRows - row);
+	return mData + (size_t)slot * mStride * mValueSize;
+}
+
+float *AIDataBuffer::getFloatRow(uint16_t row)
+{
+	uint16_t slot = (mHead >= row) ? (mHead - row) : (mHead + mMaxRows - row);
+	return mFloatData + (size_t)slot * mFloatCount;
+}
+
+void AIDataBuffer::clearValues(uint8_t *ptr, size_t count)
+{
+	/* Empty value is real 0, which is the zero point of quantized values */
+	switch (mType) {
+	case AIFW_DATA_INT16:
+		for (size_t i = 0; i < count; i++) {
+			((int16_t *)ptr)[i] = (int16_t)mZeroPoint;
+		}
+		break;
+	case AIFW_DATA_INT8:
+		memset(ptr, (int8_t)mZeroPoint, count);
+		break;
+	default:
+		memset(ptr, 0, count * mValueSize);
+		break;
+	}
+}
+
+AIFW_RESULT AIDataBuffer::storeValues(uint8_t *ptr, const float *buffer, uint16_t count)
+{
+	if (mType == AIFW_DATA_FLOAT32) {
+		memcpy(ptr, buffer, count * sizeof(float));
+		return AIFW_OK;
+	}
+	AITensor values = { mType, mScale, mZeroPoint, count, ptr };
+	return quantizeData(buffer, NULL, NULL, count, &values);
+}
+
+AIFW_RESULT AIDataBuffer::loadValues(float *buffer, const uint8_t *ptr, uint16_t count)
+{
+	if (mType == AIFW_DATA_FLOAT32) {
+		memcpy(buffer, ptr, count * sizeof(float));
+		return AIFW_OK;
+	}
+	AITensor values = { mType, mScale, mZeroPoint, count, (void *)ptr };
+	return dequantizeData(&values, buffer, count);
+}
+
+AIFW_RESULT AIDataBuffer::storeColumns(uint16_t row, uint16_t col, const float *buffer, uint16_t count)
+{
+	/* Columns from typedSize on are stored as float */
+	uint16_t typedSize = mRowSize - mFloatCount;
+	if (col < typedSize) {
+		uint16_t n = (count < typedSize - col) ? count : (typedSize - col);
+		AIFW_RESULT res = storeValues(getRow(row) + col * mValueSize, buffer, n);
+		if (res != AIFW_OK) {
+			return res;
+		}
+		buffer += n;
+		col += n;
+		count -= n;
+	}
+	if (count > 0) {
+		memcpy(getFloatRow(row) + (col - typedSize), buffer, count * sizeof(float));
+	}
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIDataBuffer::loadColumns(float *buffer, uint16_t row, uint16_t col, uint16_t count)
+{
+	uint16_t typedSize = mRowSize - mFloatCount;
+	if (col < typedSize) {
+		uint16_t n = (count < typedSize - col) ? count : (typedSize - col);
+		AIFW_RESULT res = loadValues(buffer, getRow(row) + col * mValueSize, n);
+		if (res != AIFW_OK) {
+			return res;
+		}
+		buffer += n;
+		col += n;
+		count -= n;
+	}
+	if (count > 0) {
+		memcpy(buffer, getFloatRow(row) + (col - typedSize), count * sizeof(float));
+	}
+	return AIFW_OK;
+}
+
+void AIDataBuffer::removeRows(uint16_t offset, uint16_t count)
 {
-	AIDataBufferNode *current = ptr;
-	AIDataBufferNode *temp = ptr;
-	while (current) {
-		temp = current->mNext;
-		delete current;
-		current = temp;
+	/* Newer rows are moved over removed ones, so latest rows which are read the most keep their order. */
+	for (int i = offset - 1; i >= 0; i--) {
+		memcpy(getRow(i + count), getRow(i), (mRowSize - mFloatCount) * mValueSize);
+		if (mFloatCount) {
+			memcpy(getFloatRow(i + count), getFloatRow(i), mFloatCount * sizeof(float));
+		}
 	}
+	for (uint16_t i = 0; i < count; i++) {
+		clearValues(getRow(i), mStride);
+		if (mFloatCount) {
+			memset(getFloatRow(i), 0, mFloatCount * sizeof(float));
+		}
+	}
+	mHead = (mHead >= count) ? (mHead - count) : (mHead + mMaxRows - count);
+	mRowCount -= count;
 }
 
 AIFW_RESULT AIDataBuffer::clear(void)
 {
 	_LOCK
-	AIDataBufferNode *current = mStart;
-	while (current) {
-		current->mIsEmpty = true;
-		memset(current->mData, '\0', mRowSize * sizeof(float));
-		current = current->mNext;
+	if (mData) {
+		clearValues(mData, (size_t)mMaxRows * mStride);
+	}
+	if (mFloatData) {
+		memset(mFloatData, 0, (size_t)mMaxRows * mFloatCount * sizeof(float));
 	}
 	mRowCount = 0;
 	_UNLOCK
@@ -158,82 +345,11 @@ AIFW_RESULT AIDataBuffer::clear(uint16_t offset, uint16_t count)
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	AIDataBufferNode *current = mStart;
-	uint16_t i = 0;
-	while (i < offset) {
-		current = current->mNext;
-		i++;
-	}
-	AIDataBufferNode *firstNode = current;
-	AIDataBufferNode *prevToFirstNode = firstNode->mPrev;
-
-	i = 0;
-	while (i < count - 1) {
-		current->mIsEmpty = true;
-		memset(current->mData, '\0', mRowSize * sizeof(float));
-		current = current->mNext;
-		i++;
-	}
-	current->mIsEmpty = true;
-	memset(current->mData, '\0', mRowSize * sizeof(float));
-	mRowCount -= count;
-	AIDataBufferNode *lastNode = current;
-	AIDataBufferNode *nextToLastNode = lastNode->mNext;
-
-	if (!nextToLastNode) {
-		_UNLOCK;
-		return AIFW_OK;
-	} else if (!prevToFirstNode) {
-		mStart = nextToLastNode;
-	} else {
-		prevToFirstNode->mNext = nextToLastNode;
-	}
-	nextToLastNode->mPrev = prevToFirstNode;
-	lastNode->mNext = NULL;
-	firstNode->mPrev = mEnd;
-	mEnd->mNext = firstNode;
-	mEnd = lastNode;
+	removeRows(offset, count);
 	_UNLOCK
 	return AIFW_OK;
 }
 
-AIFW_RESULT AIDataBuffer::createList(uint16_t count, uint16_t size)
-{
-	AIDataBufferNode *newNode = nullptr;
-	AIDataBufferNode *firstNode = nullptr;
-	AIDataBufferNode *lastNode = nullptr;
-	for (uint16_t i = 0; i < count; i++) {
-		newNode = new AIDataBufferNode(size);
-		if (!newNode || !newNode->mData) {
-			AIFW_LOGE("node creation failed with errno %d, error message: %s", errno, strerror(errno));
-			if (newNode) {
-				delete newNode;
-			}
-			clearMemory(firstNode);
-			return AIFW_NO_MEM;
-		}
-		if (firstNode == NULL) {
-			firstNode = newNode;
-			lastNode = newNode;
-		} else {
-			lastNode->mNext = newNode;
-			newNode->mPrev = lastNode;
-			lastNode = newNode;
-		}
-	}
-	if (!mStart) {
-		mStart = firstNode;
-		mEnd = lastNode;
-		return AIFW_OK;
-	}
-	mEnd->mNext = firstNode;
-	if (firstNode) {
-		firstNode->mPrev = mEnd;
-		mEnd = lastNode;
-	}
-	return AIFW_OK;
-}
-
 AIFW_RESULT AIDataBuffer::readData(float *buffer, uint16_t row)
 {
 	if (buffer == NULL) {
@@ -245,16 +361,10 @@ AIFW_RESULT AIDataBuffer::readData(float *buffer, uint16_t row)
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	uint16_t temp = 0;
-	AIDataBufferNode *tempNode = mStart;
-	while (temp < row) {
-		tempNode = tempNode->mNext;
-		++temp;
-	}
-	memcpy(buffer, tempNode->mData, mRowSize * sizeof(float));
+	AIFW_RESULT res = loadColumns(buffer, row, 0, mRowSize);
 	DUMP_BUFFER("buffer read done, values: ", mRowSize, buffer, 0)
 	_UNLOCK;
-	return AIFW_OK;
+	return res;
 }
 
 AIFW_RESULT AIDataBuffer::readData(float *buffer, uint16_t startCol, uint16_t endCol, uint16_t row)
@@ -276,18 +386,126 @@ AIFW_RESULT AIDataBuffer::readData(float *buffer, uint16_t startCol, uint16_t en
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	uint16_t temp = 0;
-	AIDataBufferNode *tempNode = mStart;
-	while (temp < row) {
-		tempNode = tempNode->mNext;
-		++temp;
-	}
-	memcpy(buffer, (tempNode->mData + startCol), (endCol - startCol) * sizeof(float));
+	AIFW_RESULT res = loadColumns(buffer, row, startCol, endCol - startCol);
 	DUMP_BUFFER("buffer read done, values: ", endCol - startCol, buffer, 0)
 	_UNLOCK;
+	return res;
+}
+
+void AIDataBuffer::fillWindow(AIDataBufferWindow *window, uint16_t rows)
+{
+	/* Slot of the oldest row of the window, rows after it are newer until the end of storage. */
+	uint16_t first = (mHead + 1 >= rows) ? (mHead + 1 - rows) : (mHead + 1 + mMaxRows - rows);
+	uint16_t tail = mMaxRows - first;
+	window->span[0].data = mData + (size_t)first * mStride * mValueSize;
+	if (rows <= tail) {
+		window->span[0].rows = rows;
+		window->span[1].data = NULL;
+		window->span[1].rows = 0;
+	} else {
+		window->span[0].rows = tail;
+		window->span[1].data = mData;
+		window->span[1].rows = rows - tail;
+	}
+	window->stride = mStride;
+	window->rowSize = mRowSize - mFloatCount;
+	window->type = mType;
+	window->scale = mScale;
+	window->zeroPoint = mZeroPoint;
+}
+
+AIFW_RESULT AIDataBuffer::getWindow(AIDataBufferWindow *window, uint16_t rows)
+{
+	if (window == NULL) {
+		AIFW_LOGE("Invalid argument - window");
+		return AIFW_INVALID_ARG;
+	}
+	if (rows == 0 || rows > mRowCount) {
+		AIFW_LOGE("Invalid argument - rows %d row count %d", rows, mRowCount);
+		return AIFW_INVALID_ARG;
+	}
+	_LOCK
+	fillWindow(window, rows);
+	_UNLOCK
 	return AIFW_OK;
 }
 
+AIFW_RESULT AIDataBuffer::readWindow(float *buffer, uint16_t startCol, uint16_t endCol, uint16_t rows)
+{
+	if (buffer == NULL) {
+		AIFW_LOGE("Invalid argument - input buffer");
+		return AIFW_INVALID_ARG;
+	}
+	/* Caller provides room for the whole window, count only bounds it to the limit of a tensor. */
+	uint32_t count = (uint32_t)(endCol > startCol ? endCol - startCol : 0) * rows;
+	AITensor tensor = { AIFW_DATA_FLOAT32, 0, 0, (uint16_t)(count < UINT16_MAX ? count : UINT16_MAX), buffer };
+	return readWindow(&tensor, startCol, endCol, rows);
+}
+
+AIFW_RESULT AIDataBuffer::readWindow(AITensor *tensor, uint16_t startCol, uint16_t endCol, uint16_t rows, const float *meanVals, const float *stdVals)
+{
+	if (tensor == NULL || tensor->data == NULL) {
+		AIFW_LOGE("Invalid argument - input buffer");
+		return AIFW_INVALID_ARG;
+	}
+	if (startCol > endCol) {
+		AIFW_LOGE("Invalid argument - start and end column offset, %d %d", startCol, endCol);
+		return AIFW_INVALID_ARG;
+	}
+	if (endCol > mRowSize - mFloatCount) {
+		AIFW_LOGE("Invalid argument - end column offset exceed columns of window, %d", endCol);
+		return AIFW_INVALID_ARG;
+	}
+	if (rows == 0 || rows > mRowCount) {
+		AIFW_LOGE("Invalid argument - rows %d row count %d", rows, mRowCount);
+		return AIFW_INVALID_ARG;
+	}
+	uint16_t count = endCol - startCol;
+	if ((uint32_t)count * rows > tensor->count) {
+		AIFW_LOGE("Window of %d values exceeds tensor count %d", count * rows, tensor->count);
+		return AIFW_NOT_ENOUGH_SPACE;
+	}
+	/* Stored values are copied as they are when they have the type and quantization of the tensor and need no normalization. */
+	bool normalize = meanVals && stdVals;
+	bool same = !normalize && (tensor->type == mType) && (mType == AIFW_DATA_FLOAT32 || (tensor->scale == mScale && tensor->zeroPoint == mZeroPoint));
+	uint8_t outSize = getDataTypeSize(tensor->type);
+	uint8_t *out = (uint8_t *)tensor->data;
+	AIDataBufferWindow window;
+	AIFW_RESULT res = AIFW_OK;
+	_LOCK
+	fillWindow(&window, rows);
+	for (uint16_t s = 0; s < 2 && res == AIFW_OK; s++) {
+		const uint8_t *src = (const uint8_t *)window.span[s].data;
+		if (same && count == window.stride) {
+			/* Rows are packed, the whole span is copied at once. */
+			memcpy(out, src, (size_t)window.span[s].rows * count * mValueSize);
+			out += (size_t)window.span[s].rows * count * mValueSize;
+			continue;
+		}
+		for (uint16_t r = 0; r < window.span[s].rows && res == AIFW_OK; r++) {
+			const uint8_t *values = src + ((size_t)r * window.stride + startCol) * mValueSize;
+			if (same) {
+				memcpy(out, values, count * mValueSize);
+				out += count * mValueSize;
+				continue;
+			}
+			/* Convert and normalize through float in chunks, there is no float copy of the whole window. */
+			float chunk[CONVERT_CHUNK_VALUES];
+			for (uint16_t done = 0; done < count && res == AIFW_OK; done += CONVERT_CHUNK_VALUES) {
+				uint16_t n = (count - done < CONVERT_CHUNK_VALUES) ? (count - done) : CONVERT_CHUNK_VALUES;
+				res = loadValues(chunk, values + done * mValueSize, n);
+				if (res == AIFW_OK) {
+					AITensor part = { tensor->type, tensor->scale, tensor->zeroPoint, n, out };
+					res = normalize ? quantizeData(chunk, meanVals + done, stdVals + done, n, &part) : quantizeData(chunk, NULL, NULL, n, &part);
+				}
+				out += n * outSize;
+			}
+		}
+	}
+	_UNLOCK
+	return res;
+}
+
 AIFW_RESULT AIDataBuffer::writeData(float *buffer, uint16_t size)
 {
 	if (buffer == NULL) {
@@ -300,24 +518,14 @@ AIFW_RESULT AIDataBuffer::writeData(float *buffer, uint16_t size)
 	}
 	DUMP_BUFFER("buffer write operation, values: ", size, buffer, 0)
 	_LOCK
-	if (mStart != mEnd) {
-		AIDataBufferNode *last = mEnd;
-		mEnd = last->mPrev;
-		mEnd->mNext = NULL;
-		last->mPrev = NULL;
-		last->mNext = mStart;
-		mStart->mPrev = last;
-		mStart = last;
-	}
-	memcpy(mStart->mData, buffer, size * sizeof(float));
-	DUMP_BUFFER("buffer write operation done, values: ", size, mStart->mData, 0)
-	mStart->mIsEmpty = false;
+	mHead = (mHead + 1 == mMaxRows) ? 0 : (mHead + 1);
+	AIFW_RESULT res = storeColumns(0, 0, buffer, size);
 	if (mRowCount < mMaxRows) {
 		++mRowCount;
 	}
 	AIFW_LOGV("mRowCount: %d", mRowCount);
 	_UNLOCK
-	return AIFW_OK;
+	return res;
 }
 
 AIFW_RESULT AIDataBuffer::writeData(float *buffer, uint16_t size, uint16_t offset)
@@ -332,11 +540,10 @@ AIFW_RESULT AIDataBuffer::writeData(float *buffer, uint16_t size, uint16_t offse
 	}
 	DUMP_BUFFER("buffer write operation, values: ", size, buffer, 0)
 	_LOCK
-	memcpy((mStart->mData + offset), buffer, size * sizeof(float));
-	DUMP_BUFFER("buffer write operation done, values: ", size, mStart->mData, offset)
+	AIFW_RESULT res = storeColumns(0, offset, buffer, size);
 	AIFW_LOGI("resultData Written");
 	_UNLOCK
-	return AIFW_OK;
+	return res;
 }
 
 AIFW_RESULT AIDataBuffer::deleteData(uint16_t row)
@@ -346,30 +553,7 @@ AIFW_RESULT AIDataBuffer::deleteData(uint16_t row)
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	AIDataBufferNode *current = mStart;
-	uint16_t i = 0;
-	while (i < row) {
-		current = current->mNext;
-		i++;
-	}
-	memset(current->mData, 0, mRowSize * sizeof(float));
-	current->mIsEmpty = true;
-	mRowCount--;
-	AIDataBufferNode *nextToCurrent = current->mNext;
-	AIDataBufferNode *prevToCurrent = current->mPrev;
-	if (nextToCurrent == NULL) {
-		_UNLOCK
-		return AIFW_OK;
-	} else if (prevToCurrent == NULL) {
-		mStart = nextToCurrent;
-	} else {
-		prevToCurrent->mNext = nextToCurrent;
-	}
-	nextToCurrent->mPrev = prevToCurrent;
-	current->mNext = NULL;
-	current->mPrev = mEnd;
-	mEnd->mNext = current;
-	mEnd = current;
+	removeRows(row, 1);
 	_UNLOCK
 	return AIFW_OK;
 }
@@ -380,4 +564,3 @@ uint16_t AIDataBuffer::getRowCount()
 }
 
 } // namespace aifw
-
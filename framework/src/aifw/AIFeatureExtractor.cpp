@@ -0,0 +1,442 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "tinyara/config.h"
+#include <math.h>
+#include <string.h>
+#include "aifw/aifw_log.h"
+#include "aifw/AIFeatureExtractor.h"
+#ifdef CONFIG_EXTERNAL_CMSIS_DSP
+#include <cmsis_dsp/Include/arm_math.h>
+#endif
+
+#define FFT_MIN_LENGTH 32
+#define FFT_MAX_LENGTH 4096
+/* Floor of mel energies, so that log of a silent band stays finite */
+#define MEL_ENERGY_FLOOR 1e-10f
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define DELETE_ARRAY(array)      \
+	{                        \
+		delete[] array;  \
+		array = NULL;    \
+	}
+
+namespace aifw {
+
+static float hzToMel(float hz)
+{
+	return 2595.0f * log10f(1.0f + hz / 700.0f);
+}
+
+static float melToHz(float mel)
+{
+	return 700.0f * (powf(10.0f, mel / 2595.0f) - 1.0f);
+}
+
+/* Weight of bin frequency f in the triangular filter of edges left, center and right */
+static float melWeight(float f, float left, float center, float right)
+{
+	if (f <= left || f >= right) {
+		return 0.0f;
+	}
+	if (f <= center) {
+		return (f - left) / (center - left);
+	}
+	return (right - f) / (right - center);
+}
+
+AIFeatureExtractor::AIFeatureExtractor() :
+	mFeatureCount(0), mSamples(NULL), mSampleWrite(0), mSamplesToFrame(0), mLastSample(0.0f), mWindow(NULL),
+	mFftIn(NULL), mFftOut(NULL), mPower(NULL), mMelStart(NULL), mMelLength(NULL), mMelOffset(NULL), mMelWeights(NULL), mLogMel(NULL),
+	mDct(NULL), mFeatures(NULL), mFeatureWrite(0), mFrameCount(0), mFftInstance(NULL), mTwiddle(NULL), mBitReverse(NULL)
+{
+	memset(&mConfig, 0, sizeof(mConfig));
+}
+
+AIFeatureExtractor::~AIFeatureExtractor()
+{
+	deinit();
+}
+
+AIFW_RESULT AIFeatureExtractor::init(const AIFeatureConfig &config)
+{
+	float highFrequency = config.highFrequency > 0 ? config.highFrequency : config.sampleRate / 2.0f;
+	if (config.sampleRate == 0 || config.frameLength == 0 || config.frameShift == 0 || config.contextFrames == 0 || config.melBands == 0) {
+		AIFW_LOGE("Invalid feature config, rate %u frame %d shift %d context %d bands %d", config.sampleRate, config.frameLength, config.frameShift, config.contextFrames, config.melBands);
+		return AIFW_INVALID_ARG;
+	}
+	if (config.fftLength < FFT_MIN_LENGTH || config.fftLength > FFT_MAX_LENGTH || (config.fftLength & (config.fftLength - 1)) || config.frameLength > config.fftLength) {
+		AIFW_LOGE("FFT length %d should be a power of two from %d to %d, not less than frame length %d", config.fftLength, FFT_MIN_LENGTH, FFT_MAX_LENGTH, config.frameLength);
+		return AIFW_INVALID_ARG;
+	}
+	if (config.mfccCount > config.melBands || config.lowFrequency < 0 || config.lowFrequency >= highFrequency || highFrequency > config.sampleRate / 2.0f) {
+		AIFW_LOGE("Invalid filterbank, mfcc %d bands %d from %f to %f Hz", config.mfccCount, config.melBands, config.lowFrequency, highFrequency);
+		return AIFW_INVALID_ARG;
+	}
+	deinit();
+	mConfig = config;
+	mConfig.highFrequency = highFrequency;
+	mFeatureCount = config.mfccCount > 0 ? config.mfccCount : config.melBands;
+
+	uint16_t bins = config.fftLength / 2 + 1;
+	uint16_t bands = config.melBands;
+	mSamples = new float[config.frameLength];
+	mWindow = new float[config.frameLength];
+	mFftIn = new float[config.fftLength];
+	mPower = new float[bins];
+	mMelStart = new uint16_t[bands];
+	mMelLength = new uint16_t[bands];
+	mMelOffset = new uint16_t[bands];
+	mLogMel = new float[bands];
+	mFeatures = new float[config.contextFrames * mFeatureCount];
+	if (!mSamples || !mWindow || !mFftIn || !mPower || !mMelStart || !mMelLength || !mMelOffset || !mLogMel || !mFeatures) {
+		AIFW_LOGE("Memory allocation failed for feature extractor");
+		deinit();
+		return AIFW_NO_MEM;
+	}
+
+	/* Periodic Hann window */
+	for (uint16_t i = 0; i < config.frameLength; i++) {
+		mWindow[i] = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / config.frameLength);
+	}
+	/* Samples beyond the frame are zero padding of the FFT */
+	memset(mFftIn, 0, config.fftLength * sizeof(float));
+
+	/* Filter b spans mel points b to b + 2, equally spaced between low and high frequency */
+	float lowMel = hzToMel(config.lowFrequency);
+	float melStep = (hzToMel(highFrequency) - lowMel) / (bands + 1);
+	float binHz = (float)config.sampleRate / config.fftLength;
+	uint32_t weights = 0;
+	for (uint16_t b = 0; b < bands; b++) {
+		float left = melToHz(lowMel + b * melStep);
+		float center = melToHz(lowMel + (b + 1) * melStep);
+		float right = melToHz(lowMel + (b + 2) * melStep);
+		mMelStart[b] = 0;
+		mMelLength[b] = 0;
+		for (uint16_t k = 0; k < bins; k++) {
+			if (melWeight(k * binHz, left, center, right) > 0.0f) {
+				if (mMelLength[b] == 0) {
+					mMelStart[b] = k;
+				}
+				mMelLength[b] = k - mMelStart[b] + 1;
+			}
+		}
+		if (mMelLength[b] == 0) {
+			AIFW_LOGE("Mel band %d from %f to %f Hz has no FFT bin, FFT length %d is too short", b, left, right, config.fftLength);
+			deinit();
+			return AIFW_INVALID_ARG;
+		}
+		mMelOffset[b] = weights;
+		weights += mMelLength[b];
+	}
+	mMelWeights = new float[weights];
+	if (!mMelWeights) {
+		AIFW_LOGE("Memory allocation failed for %u mel weights", weights);
+		deinit();
+		return AIFW_NO_MEM;
+	}
+	for (uint16_t b = 0; b < bands; b++) {
+		float left = melToHz(lowMel + b * melStep);
+		float center = melToHz(lowMel + (b + 1) * melStep);
+		float right = melToHz(lowMel + (b + 2) * melStep);
+		for (uint16_t i = 0; i < mMelLength[b]; i++) {
+			mMelWeights[mMelOffset[b] + i] = melWeight((mMelStart[b] + i) * binHz, left, center, right);
+		}
+	}
+
+	/* Orthonormal DCT-II of log-mel energies */
+	if (config.mfccCount > 0) {
+		mDct = new float[config.mfccCount * bands];
+		if (!mDct) {
+			AIFW_LOGE("Memory allocation failed for DCT matrix");
+			deinit();
+			return AIFW_NO_MEM;
+		}
+		for (uint16_t i = 0; i < config.mfccCount; i++) {
+			float scale = sqrtf((i == 0 ? 1.0f : 2.0f) / bands);
+			for (uint16_t b = 0; b < bands; b++) {
+				mDct[i * bands + b] = scale * cosf((float)M_PI * i * (b + 0.5f) / bands);
+			}
+		}
+	}
+
+#ifdef CONFIG_EXTERNAL_CMSIS_DSP
+	arm_rfft_fast_instance_f32 *instance = new arm_rfft_fast_instance_f32;
+	mFftOut = new float[config.fftLength];
+	if (!instance || !mFftOut) {
+		delete instance;
+		AIFW_LOGE("Memory allocation failed for FFT");
+		deinit();
+		return AIFW_NO_MEM;
+	}
+	mFftInstance = instance;
+	if (arm_rfft_fast_init_f32(instance, config.fftLength) != ARM_MATH_SUCCESS) {
+		AIFW_LOGE("CMSIS-DSP real FFT of length %d is not supported", config.fftLength);
+		deinit();
+		return AIFW_NOT_SUPPORTED;
+	}
+#else
+	/* Real FFT of length N runs as a complex FFT of N / 2 points, twiddles are exp(-2 pi k / N) for k below N / 2 */
+	uint16_t points = config.fftLength / 2;
+	mTwiddle = new float[points * 2];
+	mBitReverse = new uint16_t[points];
+	if (!mTwiddle || !mBitReverse) {
+		AIFW_LOGE("Memory allocation failed for FFT");
+		deinit();
+		return AIFW_NO_MEM;
+	}
+	for (uint16_t k = 0; k < points; k++) {
+		mTwiddle[2 * k] = cosf(2.0f * (float)M_PI * k / config.fftLength);
+		mTwiddle[2 * k + 1] = sinf(2.0f * (float)M_PI * k / config.fftLength);
+	}
+	uint16_t bits = 0;
+	while ((1 << bits) < points) {
+		bits++;
+	}
+	for (uint16_t i = 0; i < points; i++) {
+		uint16_t reversed = 0;
+		for (uint16_t b = 0; b < bits; b++) {
+			reversed |= ((i >> b) & 1) << (bits - 1 - b);
+		}
+		mBitReverse[i] = reversed;
+	}
+#endif
+	reset();
+	AIFW_LOGV("Feature extractor: frame %d shift %d fft %d bands %d mfcc %d, %u weights", config.frameLength, config.frameShift, config.fftLength, bands, config.mfccCount, weights);
+	return AIFW_OK;
+}
+
+void AIFeatureExtractor::deinit(void)
+{
+	DELETE_ARRAY(mSamples);
+	DELETE_ARRAY(mWindow);
+	DELETE_ARRAY(mFftIn);
+	DELETE_ARRAY(mFftOut);
+	DELETE_ARRAY(mPower);
+	DELETE_ARRAY(mMelStart);
+	DELETE_ARRAY(mMelLength);
+	DELETE_ARRAY(mMelOffset);
+	DELETE_ARRAY(mMelWeights);
+	DELETE_ARRAY(mLogMel);
+	DELETE_ARRAY(mDct);
+	DELETE_ARRAY(mFeatures);
+	DELETE_ARRAY(mTwiddle);
+	DELETE_ARRAY(mBitReverse);
+#ifdef CONFIG_EXTERNAL_CMSIS_DSP
+	delete (arm_rfft_fast_instance_f32 *)mFftInstance;
+#endif
+	mFftInstance = NULL;
+	mFeatureCount = 0;
+}
+
+void AIFeatureExtractor::reset(void)
+{
+	mSampleWrite = 0;
+	mSamplesToFrame = mConfig.frameLength;
+	mLastSample = 0.0f;
+	mFeatureWrite = 0;
+	mFrameCount = 0;
+}
+
+uint16_t AIFeatureExtractor::getFeatureCount(void)
+{
+	return mFeatureCount;
+}
+
+uint16_t AIFeatureExtractor::getFrameCount(void)
+{
+	return mFrameCount;
+}
+
+AIFW_RESULT AIFeatureExtractor::pushSamples(const int16_t *pcm, uint32_t count, uint16_t *frames)
+{
+	if (!pcm) {
+		AIFW_LOGE("PCM is NULL");
+		return AIFW_INVALID_ARG;
+	}
+	if (!mSamples) {
+		AIFW_LOGE("Feature extractor is not initialized");
+		return AIFW_ERROR;
+	}
+	uint16_t computed = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		float sample = pcm[i] / 32768.0f;
+		mSamples[mSampleWrite] = sample - mConfig.preEmphasis * mLastSample;
+		mLastSample = sample;
+		if (++mSampleWrite == mConfig.frameLength) {
+			mSampleWrite = 0;
+		}
+		if (--mSamplesToFrame == 0) {
+			computeFrame();
+			mSamplesToFrame = mConfig.frameShift;
+			computed++;
+		}
+	}
+	if (frames) {
+		*frames = computed;
+	}
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIFeatureExtractor::readFeatures(float *features, uint16_t frames)
+{
+	if (!features || frames == 0 || frames > mConfig.contextFrames) {
+		AIFW_LOGE("Invalid argument, features %p frames %d of %d", features, frames, mConfig.contextFrames);
+		return AIFW_INVALID_ARG;
+	}
+	if (frames > mFrameCount) {
+		AIFW_LOGV("%d of %d frames computed", mFrameCount, frames);
+		return AIFW_INFERENCE_PROCEEDING;
+	}
+	/* Latest frames may wrap around the end of the ring */
+	uint16_t first = (mFeatureWrite + mConfig.contextFrames - frames) % mConfig.contextFrames;
+	uint16_t head = mConfig.contextFrames - first < frames ? mConfig.contextFrames - first : frames;
+	memcpy(features, mFeatures + first * mFeatureCount, head * mFeatureCount * sizeof(float));
+	memcpy(features + head * mFeatureCount, mFeatures, (frames - head) * mFeatureCount * sizeof(float));
+	return AIFW_OK;
+}
+
+/* Windowed frame of the sample ring, oldest sample first, into the FFT input */
+void AIFeatureExtractor::computeFrame(void)
+{
+	uint16_t length = mConfig.frameLength;
+	uint16_t oldest = mSampleWrite;
+	uint16_t head = length - oldest;
+	for (uint16_t i = 0; i < head; i++) {
+		mFftIn[i] = mSamples[oldest + i] * mWindow[i];
+	}
+	for (uint16_t i = head; i < length; i++) {
+		mFftIn[i] = mSamples[i - head] * mWindow[i];
+	}
+	powerSpectrum();
+
+	uint16_t bands = mConfig.melBands;
+	for (uint16_t b = 0; b < bands; b++) {
+		const float *power = mPower + mMelStart[b];
+		const float *weight = mMelWeights + mMelOffset[b];
+		float energy = 0.0f;
+		for (uint16_t i = 0; i < mMelLength[b]; i++) {
+			energy += power[i] * weight[i];
+		}
+		mLogMel[b] = logf(energy > MEL_ENERGY_FLOOR ? energy : MEL_ENERGY_FLOOR);
+	}
+
+	float *out = mFeatures + mFeatureWrite * mFeatureCount;
+	if (mDct) {
+		for (uint16_t i = 0; i < mConfig.mfccCount; i++) {
+			const float *row = mDct + i * bands;
+			float sum = 0.0f;
+			for (uint16_t b = 0; b < bands; b++) {
+				sum += row[b] * mLogMel[b];
+			}
+			out[i] = sum;
+		}
+	} else {
+		memcpy(out, mLogMel, bands * sizeof(float));
+	}
+	if (++mFeatureWrite == mConfig.contextFrames) {
+		mFeatureWrite = 0;
+	}
+	if (mFrameCount < mConfig.contextFrames) {
+		mFrameCount++;
+	}
+}
+
+#ifdef CONFIG_EXTERNAL_CMSIS_DSP
+void AIFeatureExtractor::powerSpectrum(void)
+{
+	uint16_t half = mConfig.fftLength / 2;
+	/* Input is overwritten by the transform, samples beyond the frame are padded again */
+	arm_rfft_fast_f32((arm_rfft_fast_instance_f32 *)mFftInstance, mFftIn, mFftOut, 0);
+	memset(mFftIn + mConfig.frameLength, 0, (mConfig.fftLength - mConfig.frameLength) * sizeof(float));
+	/* Real parts of DC and Nyquist bins are packed in the first complex value */
+	mPower[0] = mFftOut[0] * mFftOut[0];
+	mPower[half] = mFftOut[1] * mFftOut[1];
+	arm_cmplx_mag_squared_f32(mFftOut + 2, mPower + 1, half - 1);
+}
+#else
+/* In place radix-2 complex FFT of fftLength / 2 interleaved points */
+void AIFeatureExtractor::fft(float *data)
+{
+	uint16_t points = mConfig.fftLength / 2;
+	for (uint16_t i = 0; i < points; i++) {
+		uint16_t j = mBitReverse[i];
+		if (j > i) {
+			float re = data[2 * i];
+			float im = data[2 * i + 1];
+			data[2 * i] = data[2 * j];
+			data[2 * i + 1] = data[2 * j + 1];
+			data[2 * j] = re;
+			data[2 * j + 1] = im;
+		}
+	}
+	for (uint16_t len = 2; len <= points; len <<= 1) {
+		uint16_t half = len / 2;
+		/* Twiddle of a butterfly of size len is exp(-2 pi j / len), entry j * N / len of the table */
+		uint16_t step = mConfig.fftLength / len;
+		for (uint16_t start = 0; start < points; start += len) {
+			for (uint16_t j = 0; j < half; j++) {
+				float wr = mTwiddle[2 * j * step];
+				float wi = -mTwiddle[2 * j * step + 1];
+				float *a = data + 2 * (start + j);
+				float *b = data + 2 * (start + j + half);
+				float vr = b[0] * wr - b[1] * wi;
+				float vi = b[0] * wi + b[1] * wr;
+				b[0] = a[0] - vr;
+				b[1] = a[1] - vi;
+				a[0] += vr;
+				a[1] += vi;
+			}
+		}
+	}
+}
+
+void AIFeatureExtractor::powerSpectrum(void)
+{
+	uint16_t half = mConfig.fftLength / 2;
+	/* Even and odd samples are real and imaginary parts of the complex input */
+	fft(mFftIn);
+	const float *z = mFftIn;
+	mPower[0] = (z[0] + z[1]) * (z[0] + z[1]);
+	mPower[half] = (z[0] - z[1]) * (z[0] - z[1]);
+	/* X[k] = E[k] + exp(-2 pi k / N) O[k], E and O being transforms of even and odd samples taken from Z[k] and Z[N / 2 - k] */
+	for (uint16_t k = 1; k < half; k++) {
+		float a = z[2 * k];
+		float b = z[2 * k + 1];
+		float c = z[2 * (half - k)];
+		float d = z[2 * (half - k) + 1];
+		float er = 0.5f * (a + c);
+		float ei = 0.5f * (b - d);
+		float odr = 0.5f * (b + d);
+		float odi = -0.5f * (a - c);
+		float wr = mTwiddle[2 * k];
+		float wi = -mTwiddle[2 * k + 1];
+		float xr = er + wr * odr - wi * odi;
+		float xi = ei + wr * odi + wi * odr;
+		mPower[k] = xr * xr + xi * xi;
+	}
+	/* Transform ran in place, samples beyond the frame are padded again */
+	memset(mFftIn + mConfig.frameLength, 0, (mConfig.fftLength - mConfig.frameLength) * sizeof(float));
+}
+#endif
+
+} /* namespace aifw */
@@ -25,6 +25,7 @@
 #define MANIFEST_KEY_MODEL_TYPE "modeltype"
 #define MANIFEST_KEY_MODEL_NAME "modelname"
 #define MANIFEST_KEY_MODEL_PATH "modelfile"
+#define MANIFEST_KEY_XIP "xip"
 #define MANIFEST_KEY_INVOKE_INPUT_COUNT "invokeinputcount"
 #define MANIFEST_KEY_INVOKE_OUTPUT_COUNT "invokeoutputcount"
 #define MANIFEST_KEY_WINDOW_SIZE "windowsize"
@@ -40,6 +41,10 @@
 #define MANIFEST_KEY_MODELS "models"
 #define MANIFEST_KEY_INFERENCE_INTERVAL "inferenceinterval"
 #define MANIFEST_KEY_MODEL_CODE "modelcode"
+#define MANIFEST_KEY_DATA_BUFFER "databuffer"
+#define MANIFEST_KEY_DATA_TYPE "type"
+#define MANIFEST_KEY_SCALE "scale"
+#define MANIFEST_KEY_ZERO_POINT "zeropoint"
 
 #define NULL_STRING "(null)"
 
@@ -85,9 +90,13 @@ AIFW_RESULT AIManifestParser::readData(AIModelAttribute *modelAttribute)
 	modelAttribute->features = NULL;
 	modelAttribute->meanVals = NULL;
 	modelAttribute->stdVals = NULL;
+	modelAttribute->dataBufferType = AIFW_DATA_FLOAT32;
+	modelAttribute->dataBufferScale = 0;
+	modelAttribute->dataBufferZeroPoint = 0;
+	modelAttribute->xipModel = 0;
 
 	AIFW_RESULT ret = AIFW_OK;
-	cJSON *version, *modelfile, *features, *maxrowsdatabuffer, *rawdatacount, *windowsize, *invokeinputcount, *invokeoutputcount, *postprocessresultcount, *inferenceresultcount, *crc, *preprocess, *meanVals, *stdVals, *inferenceinterval, *modelcode;
+	cJSON *version, *modelfile, *features, *maxrowsdatabuffer, *rawdatacount, *windowsize, *invokeinputcount, *invokeoutputcount, *postprocessresultcount, *inferenceresultcount, *crc, *preprocess, *meanVals, *stdVals, *inferenceinterval, *modelcode, *databuffer, *xip;
 	uint16_t len;
 	char *file;
 	//	Get AI version
@@ -126,6 +135,12 @@ AIFW_RESULT AIManifestParser::readData(AIModelAttribute *modelAttribute)
 	file = modelfile->valuestring;
 	strncpy(modelAttribute->modelPath, file, AIFW_MAX_FILEPATH_LEN);
 
+	//	Get whether model file is used in place, false if not given
+	xip = cJSON_GetObjectItem(this->mJSON.get(), MANIFEST_KEY_XIP);
+	if (xip && xip->type == cJSON_True) {
+		modelAttribute->xipModel = 1;
+	}
+
 	//	Get Features
 	features = cJSON_GetObjectItem(this->mJSON.get(), MANIFEST_KEY_FEATURES);
 	if (!features) {
@@ -271,6 +286,37 @@ AIFW_RESULT AIManifestParser::readData(AIModelAttribute *modelAttribute)
 		}
 	}
 
+	// Get type of data buffer values, float if not given
+	databuffer = cJSON_GetObjectItem(this->mJSON.get(), MANIFEST_KEY_DATA_BUFFER);
+	if (databuffer) {
+		cJSON *datatype = cJSON_GetObjectItem(databuffer, MANIFEST_KEY_DATA_TYPE);
+		cJSON *scale = cJSON_GetObjectItem(databuffer, MANIFEST_KEY_SCALE);
+		cJSON *zeropoint = cJSON_GetObjectItem(databuffer, MANIFEST_KEY_ZERO_POINT);
+		if (!datatype || !datatype->valuestring) {
+			AIFW_LOGE("No data buffer type in the manifest!");
+			ret = AIFW_INVALID_ATTRIBUTE;
+			goto cleanup;
+		}
+		if (strcmp(datatype->valuestring, "int8") == 0) {
+			modelAttribute->dataBufferType = AIFW_DATA_INT8;
+		} else if (strcmp(datatype->valuestring, "int16") == 0) {
+			modelAttribute->dataBufferType = AIFW_DATA_INT16;
+		} else if (strcmp(datatype->valuestring, "float32") != 0) {
+			AIFW_LOGE("Data buffer type %s in the manifest is not supported", datatype->valuestring);
+			ret = AIFW_INVALID_ATTRIBUTE;
+			goto cleanup;
+		}
+		if (modelAttribute->dataBufferType != AIFW_DATA_FLOAT32) {
+			if (!scale || scale->valuedouble <= 0) {
+				AIFW_LOGE("No valid data buffer scale in the manifest!");
+				ret = AIFW_INVALID_ATTRIBUTE;
+				goto cleanup;
+			}
+			modelAttribute->dataBufferScale = scale->valuedouble;
+			modelAttribute->dataBufferZeroPoint = zeropoint ? zeropoint->valueint : 0;
+		}
+	}
+
 	// get inference interval
 	inferenceinterval = cJSON_GetObjectItem(this->mJSON.get(), MANIFEST_KEY_INFERENCE_INTERVAL);
 	if (!inferenceinterval) {
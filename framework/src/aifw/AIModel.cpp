@@ -17,8 +17,12 @@
  ****************************************************************************/
 
 #include "tinyara/config.h"
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <tinyara/fs/ioctl.h>
 #include "aifw/aifw.h"
 #include "aifw/aifw_log.h"
+#include "aifw/aifw_utils.h"
 #ifdef CONFIG_AIFW_USE_ONERT_MICRO
 #include "include/ONERTM.h"
 #elif CONFIG_AIFW_USE_TFMICRO
@@ -29,15 +33,31 @@
 #include "aifw/AIProcessHandler.h"
 #include "aifw/AIModel.h"
 
+/* Alignment required for a model used in place */
+#define AIFW_XIP_MODEL_ALIGN 16
+#ifdef CONFIG_AIFW_PROFILING
+#include "include/AIProfiler.h"
+
+/* Time of a stage is measured from the end of the previous one */
+#define PROFILE_START uint32_t profileMark = getProfileTimeUs();
+#define PROFILE_STAGE(stage) profileMark = addProfileTime(&mProfile.stages[stage], profileMark);
+#else
+#define PROFILE_START
+#define PROFILE_STAGE(stage)
+#endif
+
 namespace aifw {
 
 AIModel::AIModel(void) :
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	mInvokeResult(NULL), mInputSizeList(NULL), mOutputSizeList(NULL), mInputSetCount(0), mOutputSetCount(0),
 #endif
-	mInvokeInput(NULL), mInvokeOutput(NULL), mParsedData(NULL), mPostProcessedData(NULL), mDataProcessor(nullptr), mBuffer(nullptr)
+	mInvokeInput(NULL), mInvokeOutput(NULL), mInputTensors(NULL), mParsedData(NULL), mPostProcessedData(NULL), mDataProcessor(nullptr), mBuffer(nullptr)
 {
 	memset(&mModelAttribute, '\0', sizeof(AIModelAttribute));
+#ifdef CONFIG_AIFW_PROFILING
+	memset(&mProfile, '\0', sizeof(AIModelProfile));
+#endif
 #ifdef CONFIG_AIFW_USE_ONERT_MICRO
 	mAIEngine = std::make_shared<ONERTM>();
 	AIFW_LOGE("Model Engine is OneRT");
@@ -54,9 +74,12 @@ AIModel::AIModel(std::shared_ptr<AIProcessHandler> dataProcessor) :
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	mInvokeResult(NULL), mInputSizeList(NULL), mOutputSizeList(NULL), mInputSetCount(0), mOutputSetCount(0),
 #endif
-	mInvokeInput(NULL), mInvokeOutput(NULL), mParsedData(NULL), mPostProcessedData(NULL), mDataProcessor(dataProcessor), mBuffer(nullptr)
+	mInvokeInput(NULL), mInvokeOutput(NULL), mInputTensors(NULL), mParsedData(NULL), mPostProcessedData(NULL), mDataProcessor(dataProcessor), mBuffer(nullptr)
 {
 	memset(&mModelAttribute, '\0', sizeof(AIModelAttribute));
+#ifdef CONFIG_AIFW_PROFILING
+	memset(&mProfile, '\0', sizeof(AIModelProfile));
+#endif
 #ifdef CONFIG_AIFW_USE_ONERT_MICRO
 	mAIEngine = std::make_shared<ONERTM>();
 	AIFW_LOGE("Model Engine is OneRT");
@@ -130,6 +153,11 @@ AIModel::~AIModel()
 	}
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 
+	if (mInputTensors) {
+		delete[] mInputTensors;
+		mInputTensors = NULL;
+	}
+
 	if (mParsedData) {
 		delete[] mParsedData;
 		mParsedData = NULL;
@@ -149,11 +177,14 @@ AIFW_RESULT AIModel::createDataBuffer(void)
 		AIFW_LOGE("model data buffer Memory Allocation failed.");
 		return AIFW_NO_MEM;
 	}
+	uint16_t rowSize;
 	if (mDataProcessor) {
-		res = mBuffer->init(mModelAttribute.maxRowsDataBuffer, (mModelAttribute.rawDataCount + mModelAttribute.invokeOutputCount));
+		rowSize = mModelAttribute.rawDataCount + mModelAttribute.invokeOutputCount;
 	} else {
-		res = mBuffer->init(mModelAttribute.maxRowsDataBuffer, (mModelAttribute.invokeInputCount + mModelAttribute.invokeOutputCount));
+		rowSize = mModelAttribute.invokeInputCount + mModelAttribute.invokeOutputCount;
 	}
+	/* Invoke output is kept as float at the end of each row, it is not in the range of the buffer scale */
+	res = mBuffer->init(mModelAttribute.maxRowsDataBuffer, rowSize, mModelAttribute.dataBufferType, mModelAttribute.dataBufferScale, mModelAttribute.dataBufferZeroPoint, mModelAttribute.invokeOutputCount);
 	if (res != AIFW_OK) {
 		AIFW_LOGE("model data buffer initialization failed.");
 		return res;
@@ -210,6 +241,25 @@ AIFW_RESULT AIModel::allocateMemory(void)
 	}
 	AIFW_LOGD("model input memory allocated");
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+	/* Input tensors are filled in place if the engine allows it for all inputs */
+#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	uint16_t inputSetCount = 1;
+#else
+	uint16_t inputSetCount = mInputSetCount;
+#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+	AITensor tensor;
+	uint16_t tensorCount = 0;
+	while (tensorCount < inputSetCount && mAIEngine->getInputTensor(tensorCount, &tensor) == AIFW_OK) {
+		tensorCount++;
+	}
+	if (tensorCount == inputSetCount) {
+		mInputTensors = new AITensor[inputSetCount];
+		if (!mInputTensors) {
+			AIFW_LOGE("Memory Allocation failed - model input tensors");
+			return AIFW_NO_MEM;
+		}
+		AIFW_LOGD("model input tensors are filled in place");
+	}
 	if (mDataProcessor) {
 		mParsedData = new float[mModelAttribute.rawDataCount];
 		if (!mParsedData) {
@@ -246,7 +296,11 @@ AIFW_RESULT AIModel::fillModelAttribute(const AIModelAttribute &modelAttribute)
 		modelAttribute.postProcessResultCount,
 		modelAttribute.inferenceResultCount,
 		NULL,
-		NULL
+		NULL,
+		modelAttribute.dataBufferType,
+		modelAttribute.dataBufferScale,
+		modelAttribute.dataBufferZeroPoint,
+		modelAttribute.xipModel
 	};
 
 	if (!modelAttribute.version) {
@@ -294,6 +348,30 @@ AIFW_RESULT AIModel::fillModelAttribute(const AIModelAttribute &modelAttribute)
 	return AIFW_OK;
 }
 
+/* Gives address of the model file on an XIP file system, e.g. romfs on flash, so that it is used without copy to RAM */
+AIFW_RESULT AIModel::getModelAddress(const char *file, const unsigned char **model)
+{
+	void *address = NULL;
+	int fd = open(file, O_RDONLY);
+	if (fd < 0) {
+		AIFW_LOGE("File %s open operation failed errno : %d", file, errno);
+		return AIFW_ERROR_FILE_ACCESS;
+	}
+	int ret = ioctl(fd, FIOC_MMAP, (unsigned long)&address);
+	close(fd);
+	if (ret < 0 || !address) {
+		AIFW_LOGI("File system of %s is not XIP capable, model is read into RAM", file);
+		return AIFW_NOT_SUPPORTED;
+	}
+	/* Flatbuffer tables of the model are read in place, so the start should keep the alignment of a RAM copy */
+	if ((uintptr_t)address & (AIFW_XIP_MODEL_ALIGN - 1)) {
+		AIFW_LOGI("Model %s at %p is not %d bytes aligned, model is read into RAM", file, address, AIFW_XIP_MODEL_ALIGN);
+		return AIFW_NOT_SUPPORTED;
+	}
+	*model = (const unsigned char *)address;
+	return AIFW_OK;
+}
+
 AIFW_RESULT AIModel::loadModel(const char *scriptPath)
 {
 	AIFW_LOGV("Lets try loading file based model");
@@ -309,7 +387,12 @@ AIFW_RESULT AIModel::loadModel(const char *scriptPath)
 	AIFW_LOGV("json file parsed, filename: %s", scriptPath);
 	const char *file = mModelAttribute.modelPath;
 	if (strlen(file) > 0) {
-		res = mAIEngine->loadModel(file);
+		if (mModelAttribute.xipModel && getModelAddress(file, &mModelAttribute.model) == AIFW_OK) {
+			AIFW_LOGV("model file %s used in place at %p", file, mModelAttribute.model);
+			res = mAIEngine->loadModel(mModelAttribute.model);
+		} else {
+			res = mAIEngine->loadModel(file);
+		}
 		if (res != AIFW_OK) {
 			AIFW_LOGE("Load model failed, model file: %s, error: %d", file, res);
 			return res;
@@ -366,12 +449,54 @@ AIFW_RESULT AIModel::loadModel(const AIModelAttribute &modelAttribute)
 	return res;
 }
 
+AIFW_RESULT AIModel::fillInputTensors(void)
+{
+	if (!mInputTensors) {
+		return AIFW_NOT_SUPPORTED;
+	}
+#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	uint16_t inputSetCount = 1;
+	uint16_t *inputSizeList = &mModelAttribute.invokeInputCount;
+#else
+	uint16_t inputSetCount = mInputSetCount;
+	uint16_t *inputSizeList = mInputSizeList;
+#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+	AIFW_RESULT res;
+	/* Tensor memory may move between invokes, so it is described again each time */
+	for (uint16_t i = 0; i < inputSetCount; i++) {
+		res = mAIEngine->getInputTensor(i, &mInputTensors[i]);
+		if (res != AIFW_OK) {
+			return res;
+		}
+	}
+	if (mDataProcessor) {
+		return mDataProcessor->preProcessTensorData(mBuffer, inputSetCount, mInputTensors, &mModelAttribute);
+	}
+	/* Mean and std values of the manifest, one per invoke input value, are applied while the tensors are quantized */
+	bool normalize = mModelAttribute.meanVals && mModelAttribute.stdVals;
+	uint16_t inputOffset = 0;
+	for (uint16_t i = 0; i < inputSetCount; i++) {
+		if (normalize && inputOffset + inputSizeList[i] <= mModelAttribute.invokeInputCount) {
+			res = mBuffer->readWindow(&mInputTensors[i], inputOffset, inputOffset + inputSizeList[i], 1, mModelAttribute.meanVals + inputOffset, mModelAttribute.stdVals + inputOffset);
+		} else {
+			res = mBuffer->readWindow(&mInputTensors[i], inputOffset, inputOffset + inputSizeList[i], 1);
+		}
+		if (res != AIFW_OK) {
+			return res;
+		}
+		inputOffset += inputSizeList[i];
+	}
+	return AIFW_OK;
+}
+
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 AIFW_RESULT AIModel::invoke(void)
 {
 	AIFW_RESULT res;
+	PROFILE_START
 	int outputOffset = 0; /* to write 2d output in 1d buffer. */
-	float **invokeResult = new float *[mOutputSetCount];
+	/* Released on every return, invoke is skipped often while preProcessData collects data */
+	std::unique_ptr<float *[]> invokeResult(new float *[mOutputSetCount]);
 	for (uint16_t i = 0; i < mInputSetCount; i++) {
 		memset(mInvokeInput[i], '\0', mInputSizeList[i] * sizeof(float));
 	}
@@ -381,26 +506,41 @@ AIFW_RESULT AIModel::invoke(void)
 	if (mDataProcessor) {
 		AIFW_LOGV("data processor is set");
 		memset(mPostProcessedData, '\0', mModelAttribute.postProcessResultCount * sizeof(float));
-		res = mDataProcessor->preProcessData(mBuffer, mInputSetCount, mInvokeInput, &mModelAttribute);
-		if (res != AIFW_OK) {
-			AIFW_LOGE("preProcessData failed, error: %d", res);
-			return res;
-		}
+		float **invokeInput = NULL;
+		res = fillInputTensors();
+		if (res == AIFW_NOT_SUPPORTED) {
+			res = mDataProcessor->preProcessData(mBuffer, mInputSetCount, mInvokeInput, &mModelAttribute);
+			/* AIFW_INFERENCE_PROCEEDING means more data is needed, e.g. frames of a feature extractor, invoke will be skipped */
+			if (res == AIFW_INFERENCE_PROCEEDING) {
+				AIFW_LOGV("preProcessData proceeding, invoke skipped");
+				return res;
+			}
+			if (res != AIFW_OK) {
+				AIFW_LOGE("preProcessData failed, error: %d", res);
+				return res;
+			}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input\n");
-		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			printf("inputset [%d]: ", i);
-			for (uint16_t j = 0; j < mInputSizeList[i]; j++) {
-				printf("%f,", mInvokeInput[i][j]);
+			printf("invoke Input\n");
+			for (uint16_t i = 0; i < mInputSetCount; i++) {
+				printf("inputset [%d]: ", i);
+				for (uint16_t j = 0; j < mInputSizeList[i]; j++) {
+					printf("%f,", mInvokeInput[i][j]);
+				}
+				printf("\n");
 			}
-			printf("\n");
-		}
 #endif
-		res = mAIEngine->invoke(mInvokeInput, invokeResult);
+			invokeInput = mInvokeInput;
+		} else if (res != AIFW_OK) {
+			AIFW_LOGE("pre-processing to input tensors failed, error: %d", res);
+			return res;
+		}
+		PROFILE_STAGE(AIFW_PROFILE_PRE_PROCESS)
+		res = mAIEngine->invoke(invokeInput, invokeResult.get());
 		if (res != AIFW_OK) {
 			AIFW_LOGE("Engine Invoke failed.");
 			return AIFW_ERROR;
 		}
+		PROFILE_STAGE(AIFW_PROFILE_INVOKE)
 		AIFW_LOGV("invoke completed fine");
 		for (uint16_t i = 0; i < mOutputSetCount; i++) {
 			for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
@@ -429,34 +569,48 @@ AIFW_RESULT AIModel::invoke(void)
 		if (res < AIFW_OK) {
 			AIFW_LOGE("data post processing failed, error: %d", res);
 		}
+		PROFILE_STAGE(AIFW_PROFILE_POST_PROCESS)
 		AIFW_LOGV("pre-process, invoke and post-process completed OK");
 		return res;
 	} else {
 		AIFW_LOGV("No data processor case");
-		int inputOffset = 0;  /* to read 2d input from 1d buffer. */
-		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			res = mBuffer->readData(mInvokeInput[i], inputOffset, inputOffset+mInputSizeList[i], 0);
-			inputOffset += mInputSizeList[i];
-			if (res != AIFW_OK) {
-				AIFW_LOGE("Reading Data from the buffer failed, error: %d", res);
-				return res;
+		float **invokeInput = NULL;
+		res = fillInputTensors();
+		if (res == AIFW_NOT_SUPPORTED) {
+			int inputOffset = 0;  /* to read 2d input from 1d buffer. */
+			for (uint16_t i = 0; i < mInputSetCount; i++) {
+				res = mBuffer->readData(mInvokeInput[i], inputOffset, inputOffset+mInputSizeList[i], 0);
+				if (res != AIFW_OK) {
+					AIFW_LOGE("Reading Data from the buffer failed, error: %d", res);
+					return res;
+				}
+				if (mModelAttribute.meanVals && mModelAttribute.stdVals && inputOffset + mInputSizeList[i] <= mModelAttribute.invokeInputCount) {
+					normalizeData(mInvokeInput[i], mModelAttribute.meanVals + inputOffset, mModelAttribute.stdVals + inputOffset, mInputSizeList[i]);
+				}
+				inputOffset += mInputSizeList[i];
 			}
-		}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input\n");
-		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			printf("inputset [%d]: ", i);
-			for (uint16_t j = 0; j < mInputSizeList[i]; j++) {
-				printf("%f,", mInvokeInput[i][j]);
+			printf("invoke Input\n");
+			for (uint16_t i = 0; i < mInputSetCount; i++) {
+				printf("inputset [%d]: ", i);
+				for (uint16_t j = 0; j < mInputSizeList[i]; j++) {
+					printf("%f,", mInvokeInput[i][j]);
+				}
+				printf("\n");
 			}
-			printf("\n");
-		}
 #endif
-		res = mAIEngine->invoke(mInvokeInput, invokeResult);
+			invokeInput = mInvokeInput;
+		} else if (res != AIFW_OK) {
+			AIFW_LOGE("Reading Data from the buffer to input tensors failed, error: %d", res);
+			return res;
+		}
+		PROFILE_STAGE(AIFW_PROFILE_PRE_PROCESS)
+		res = mAIEngine->invoke(invokeInput, invokeResult.get());
 		if (res != AIFW_OK) {
 			AIFW_LOGE("Engine Invoke failed.");
 			return AIFW_ERROR;
 		}
+		PROFILE_STAGE(AIFW_PROFILE_INVOKE)
 		AIFW_LOGV("invoke completed fine");
 		for (uint16_t i = 0; i < mOutputSetCount; i++) {
 			for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
@@ -481,6 +635,7 @@ AIFW_RESULT AIModel::invoke(void)
 				return res;
 			}
 		}
+		PROFILE_STAGE(AIFW_PROFILE_POST_PROCESS)
 		AIFW_LOGV("read data, invoke and write data completed OK");
 		return res;
 	}
@@ -489,6 +644,7 @@ AIFW_RESULT AIModel::invoke(void)
 AIFW_RESULT AIModel::invoke(void)
 {
 	AIFW_RESULT res;
+	PROFILE_START
 	float *invokeResult = nullptr;
 	memset(mInvokeInput, '\0', mModelAttribute.invokeInputCount * sizeof(float));
 	memset(mInvokeOutput, '\0', mModelAttribute.invokeOutputCount * sizeof(float));
@@ -496,23 +652,38 @@ AIFW_RESULT AIModel::invoke(void)
 		AIFW_LOGV("data processor is set");
 		memset(mPostProcessedData, '\0', mModelAttribute.postProcessResultCount * sizeof(float));
 
-		res = mDataProcessor->preProcessData(mBuffer, mInvokeInput, &mModelAttribute);
-		if (res != AIFW_OK) {
-			AIFW_LOGE("preProcessData failed, error: %d", res);
-			return res;
-		}
+		float *invokeInput = NULL;
+		res = fillInputTensors();
+		if (res == AIFW_NOT_SUPPORTED) {
+			res = mDataProcessor->preProcessData(mBuffer, mInvokeInput, &mModelAttribute);
+			/* AIFW_INFERENCE_PROCEEDING means more data is needed, e.g. frames of a feature extractor, invoke will be skipped */
+			if (res == AIFW_INFERENCE_PROCEEDING) {
+				AIFW_LOGV("preProcessData proceeding, invoke skipped");
+				return res;
+			}
+			if (res != AIFW_OK) {
+				AIFW_LOGE("preProcessData failed, error: %d", res);
+				return res;
+			}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input: ");
-		for (uint16_t i = 0; i < mModelAttribute.invokeInputCount; i++) {
-			printf("%f,", mInvokeInput[i]);
-		}
-		printf("\n");
+			printf("invoke Input: ");
+			for (uint16_t i = 0; i < mModelAttribute.invokeInputCount; i++) {
+				printf("%f,", mInvokeInput[i]);
+			}
+			printf("\n");
 #endif
-		invokeResult = (float *)mAIEngine->invoke(mInvokeInput);
+			invokeInput = mInvokeInput;
+		} else if (res != AIFW_OK) {
+			AIFW_LOGE("pre-processing to input tensor failed, error: %d", res);
+			return res;
+		}
+		PROFILE_STAGE(AIFW_PROFILE_PRE_PROCESS)
+		invokeResult = (float *)mAIEngine->invoke(invokeInput);
 		if (!invokeResult) {
 			AIFW_LOGE("Engine Invoke failed.");
 			return AIFW_ERROR;
 		}
+		PROFILE_STAGE(AIFW_PROFILE_INVOKE)
 		AIFW_LOGV("invoke completed fine");
 		for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
 			mInvokeOutput[i] = invokeResult[i];
@@ -533,27 +704,41 @@ AIFW_RESULT AIModel::invoke(void)
 		if (res < AIFW_OK) {
 			AIFW_LOGE("data post processing failed, error: %d", res);
 		}
+		PROFILE_STAGE(AIFW_PROFILE_POST_PROCESS)
 		AIFW_LOGV("pre-process, invoke and post-process completed OK");
 		return res;
 	} else {
 		AIFW_LOGV("No data processor case");
-		res = mBuffer->readData(mInvokeInput, 0, mModelAttribute.invokeInputCount, 0);
-		if (res != AIFW_OK) {
-			AIFW_LOGE("Reading Data from the buffer failed, error: %d", res);
-			return res;
-		}
+		float *invokeInput = NULL;
+		res = fillInputTensors();
+		if (res == AIFW_NOT_SUPPORTED) {
+			res = mBuffer->readData(mInvokeInput, 0, mModelAttribute.invokeInputCount, 0);
+			if (res != AIFW_OK) {
+				AIFW_LOGE("Reading Data from the buffer failed, error: %d", res);
+				return res;
+			}
+			if (mModelAttribute.meanVals && mModelAttribute.stdVals) {
+				normalizeData(mInvokeInput, mModelAttribute.meanVals, mModelAttribute.stdVals, mModelAttribute.invokeInputCount);
+			}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input: ");
-		for (uint16_t i = 0; i < mModelAttribute.invokeInputCount; i++) {
-			printf("%f,", mInvokeInput[i]);
-		}
-		printf("\n");
+			printf("invoke Input: ");
+			for (uint16_t i = 0; i < mModelAttribute.invokeInputCount; i++) {
+				printf("%f,", mInvokeInput[i]);
+			}
+			printf("\n");
 #endif
-		invokeResult = (float *)mAIEngine->invoke(mInvokeInput);
+			invokeInput = mInvokeInput;
+		} else if (res != AIFW_OK) {
+			AIFW_LOGE("Reading Data from the buffer to input tensor failed, error: %d", res);
+			return res;
+		}
+		PROFILE_STAGE(AIFW_PROFILE_PRE_PROCESS)
+		invokeResult = (float *)mAIEngine->invoke(invokeInput);
 		if (!invokeResult) {
 			AIFW_LOGE("Engine Invoke failed.");
 			return AIFW_ERROR;
 		}
+		PROFILE_STAGE(AIFW_PROFILE_INVOKE)
 		AIFW_LOGV("invoke completed fine");
 		for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
 			mInvokeOutput[i] = invokeResult[i];
@@ -570,6 +755,7 @@ AIFW_RESULT AIModel::invoke(void)
 			AIFW_LOGE("Writing invoke result to the buffer failed, error: %d", res);
 			return res;
 		}
+		PROFILE_STAGE(AIFW_PROFILE_POST_PROCESS)
 		AIFW_LOGV("read data, invoke and write data completed OK");
 		return res;
 	}
@@ -583,6 +769,7 @@ AIFW_RESULT AIModel::pushData(void *data, uint16_t count)
 		return AIFW_INVALID_ARG;
 	}
 	AIFW_RESULT res;
+	PROFILE_START
 	if (mDataProcessor) {
 		memset(mParsedData, '\0', mModelAttribute.rawDataCount * sizeof(float));
 		res = mDataProcessor->parseData(data, count, mParsedData, &mModelAttribute);
@@ -605,6 +792,7 @@ AIFW_RESULT AIModel::pushData(void *data, uint16_t count)
 			return res;
 		}
 
+		PROFILE_STAGE(AIFW_PROFILE_PARSE)
 		/* So we will skip invoke */
 		if (proceeding) {
 			return AIFW_INFERENCE_PROCEEDING;
@@ -619,6 +807,7 @@ AIFW_RESULT AIModel::pushData(void *data, uint16_t count)
 			AIFW_LOGE("Writing Data to the buffer failed, error: %d", res);
 			return res;
 		}
+		PROFILE_STAGE(AIFW_PROFILE_PARSE)
 	}
 
 	res = invoke();
@@ -720,5 +909,34 @@ uint32_t AIModel::getModelCode()
 	return mModelAttribute.modelCode;
 }
 
+#ifdef CONFIG_AIFW_PROFILING
+AIFW_RESULT AIModel::getProfile(AIModelProfile *profile)
+{
+	if (!profile) {
+		AIFW_LOGE("profile argument is null");
+		return AIFW_INVALID_ARG;
+	}
+	memcpy(profile, &mProfile, sizeof(AIModelProfile));
+	profile->arenaUsedBytes = 0;
+	profile->arenaSize = 0;
+	AIFW_RESULT res = mAIEngine->getArenaUsage(&profile->arenaUsedBytes, &profile->arenaSize);
+	if (res != AIFW_OK && res != AIFW_NOT_SUPPORTED) {
+		return res;
+	}
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModel::getOpProfile(AIProfileTime *ops, uint16_t *count)
+{
+	return mAIEngine->getOpProfile(ops, count);
+}
+
+void AIModel::resetProfile(void)
+{
+	memset(mProfile.stages, '\0', sizeof(mProfile.stages));
+	mAIEngine->resetProfile();
+}
+#endif /* CONFIG_AIFW_PROFILING */
+
 } /* namespace aifw */
 
@@ -0,0 +1,318 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "tinyara/config.h"
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <errno.h>
+#include "aifw/aifw_log.h"
+#include "aifw/AIModelService.h"
+#include "include/AIModelScheduler.h"
+
+#ifndef CONFIG_AIFW_MODEL_SCHEDULER_STACKSIZE
+#define CONFIG_AIFW_MODEL_SCHEDULER_STACKSIZE 8192
+#endif
+
+#ifndef CONFIG_AIFW_MODEL_SCHEDULER_PRIORITY
+#define CONFIG_AIFW_MODEL_SCHEDULER_PRIORITY 100
+#endif
+
+namespace aifw {
+
+static AIModelScheduler gScheduler;
+
+static uint64_t getTimeMs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+AIModelScheduler *AIModelScheduler::getInstance(void)
+{
+	return &gScheduler;
+}
+
+AIModelScheduler::AIModelScheduler() :
+	mWorkerRunning(false), mServices(NULL), mCurrent(NULL)
+{
+	pthread_mutex_init(&mLock, NULL);
+	pthread_cond_init(&mCond, NULL);
+}
+
+AIModelScheduler::~AIModelScheduler()
+{
+	pthread_cond_destroy(&mCond);
+	pthread_mutex_destroy(&mLock);
+}
+
+AIScheduledService *AIModelScheduler::find(AIModelService *service)
+{
+	for (AIScheduledService *entry = mServices; entry; entry = entry->next) {
+		if (entry->service == service) {
+			return entry;
+		}
+	}
+	return NULL;
+}
+
+/* Gives the due service to run now, or NULL and the time of the next due period in wakeup (0 when nothing is started) */
+AIScheduledService *AIModelScheduler::pickNext(uint64_t now, uint64_t *wakeup)
+{
+	AIScheduledService *next = NULL;
+	*wakeup = 0;
+	for (AIScheduledService *entry = mServices; entry; entry = entry->next) {
+		if (!entry->running) {
+			continue;
+		}
+		if (entry->due > now) {
+			if (*wakeup == 0 || entry->due < *wakeup) {
+				*wakeup = entry->due;
+			}
+			continue;
+		}
+		if (!next || entry->priority > next->priority || (entry->priority == next->priority && entry->due + entry->interval < next->due + next->interval)) {
+			next = entry;
+		}
+	}
+	return next;
+}
+
+void AIModelScheduler::run(void)
+{
+	pthread_mutex_lock(&mLock);
+	while (mServices) {
+		uint64_t now = getTimeMs();
+		uint64_t wakeup;
+		AIScheduledService *entry = pickNext(now, &wakeup);
+		if (!entry) {
+			if (wakeup == 0) {
+				pthread_cond_wait(&mCond, &mLock);
+			} else {
+				/* Condition waits on realtime clock, periods are kept on monotonic clock */
+				struct timespec abstime;
+				uint64_t wait = wakeup - now;
+				clock_gettime(CLOCK_REALTIME, &abstime);
+				abstime.tv_sec += wait / 1000;
+				abstime.tv_nsec += (wait % 1000) * 1000000;
+				if (abstime.tv_nsec >= 1000000000) {
+					abstime.tv_sec++;
+					abstime.tv_nsec -= 1000000000;
+				}
+				pthread_cond_timedwait(&mCond, &mLock, &abstime);
+			}
+			continue;
+		}
+		/* Periods whose deadline passed while the worker was busy are skipped, following ones stay on the same grid */
+		if (now >= entry->due + entry->interval) {
+			uint32_t missed = (uint32_t)((now - entry->due) / entry->interval);
+			entry->missed += missed;
+			entry->due += (uint64_t)missed * entry->interval;
+			AIFW_LOGI("Service %p missed %u periods of %u msec", entry->service, missed, entry->interval);
+		}
+		entry->due += entry->interval;
+		CollectRawDataListener listener = entry->service->getCollectRawDataCallback();
+		mCurrent = entry;
+		pthread_mutex_unlock(&mLock);
+		if (listener) {
+			listener();
+		}
+		pthread_mutex_lock(&mLock);
+		mCurrent = NULL;
+		pthread_cond_broadcast(&mCond);
+	}
+	mWorkerRunning = false;
+	pthread_mutex_unlock(&mLock);
+	AIFW_LOGV("Model scheduler worker exits");
+}
+
+void *AIModelScheduler::workerMain(void *arg)
+{
+	((AIModelScheduler *)arg)->run();
+	return NULL;
+}
+
+/* Called with mLock held */
+AIFW_RESULT AIModelScheduler::startWorker(void)
+{
+	pthread_attr_t attr;
+	struct sched_param sparam;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_AIFW_MODEL_SCHEDULER_STACKSIZE);
+	sparam.sched_priority = CONFIG_AIFW_MODEL_SCHEDULER_PRIORITY;
+	pthread_attr_setschedparam(&attr, &sparam);
+	int ret = pthread_create(&mWorker, &attr, workerMain, (void *)this);
+	pthread_attr_destroy(&attr);
+	if (ret != 0) {
+		AIFW_LOGE("Model scheduler worker creation failed, ret: %d", ret);
+		return AIFW_ERROR;
+	}
+	pthread_setname_np(mWorker, "aifw_scheduler");
+	/* Worker exits by itself when no service is left */
+	pthread_detach(mWorker);
+	mWorkerRunning = true;
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::registerService(AIModelService *service, uint16_t interval, uint8_t priority)
+{
+	if (!service || interval == 0) {
+		AIFW_LOGE("Invalid argument, service: %p interval: %d", service, interval);
+		return AIFW_INVALID_ARG;
+	}
+	pthread_mutex_lock(&mLock);
+	if (find(service)) {
+		pthread_mutex_unlock(&mLock);
+		AIFW_LOGE("Service %p already registered", service);
+		return AIFW_ERROR;
+	}
+	AIScheduledService *entry = new AIScheduledService();
+	if (!entry) {
+		pthread_mutex_unlock(&mLock);
+		AIFW_LOGE("Memory allocation failed for scheduled service");
+		return AIFW_NO_MEM;
+	}
+	entry->service = service;
+	entry->interval = interval;
+	entry->priority = priority;
+	entry->next = mServices;
+	mServices = entry;
+	if (!mWorkerRunning) {
+		AIFW_RESULT res = startWorker();
+		if (res != AIFW_OK) {
+			mServices = entry->next;
+			delete entry;
+			pthread_mutex_unlock(&mLock);
+			return res;
+		}
+	}
+	pthread_mutex_unlock(&mLock);
+	AIFW_LOGV("Service %p registered, interval %d msec priority %d", service, interval, priority);
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::unregisterService(AIModelService *service)
+{
+	pthread_mutex_lock(&mLock);
+	AIScheduledService **link = &mServices;
+	while (*link && (*link)->service != service) {
+		link = &(*link)->next;
+	}
+	AIScheduledService *entry = *link;
+	if (!entry) {
+		pthread_mutex_unlock(&mLock);
+		AIFW_LOGE("Service %p not registered", service);
+		return AIFW_INVALID_ARG;
+	}
+	*link = entry->next;
+	/* Listener of the service may be running, it is waited for unless it is the caller itself */
+	while (mCurrent == entry && !pthread_equal(pthread_self(), mWorker)) {
+		pthread_cond_wait(&mCond, &mLock);
+	}
+	delete entry;
+	pthread_cond_broadcast(&mCond);
+	pthread_mutex_unlock(&mLock);
+	AIFW_LOGV("Service %p unregistered", service);
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::startService(AIModelService *service)
+{
+	pthread_mutex_lock(&mLock);
+	AIScheduledService *entry = find(service);
+	if (!entry) {
+		pthread_mutex_unlock(&mLock);
+		AIFW_LOGE("Service %p not registered", service);
+		return AIFW_INVALID_ARG;
+	}
+	entry->running = true;
+	entry->due = getTimeMs() + entry->interval;
+	pthread_cond_broadcast(&mCond);
+	pthread_mutex_unlock(&mLock);
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::stopService(AIModelService *service)
+{
+	pthread_mutex_lock(&mLock);
+	AIScheduledService *entry = find(service);
+	if (!entry) {
+		pthread_mutex_unlock(&mLock);
+		AIFW_LOGE("Service %p not registered", service);
+		return AIFW_INVALID_ARG;
+	}
+	entry->running = false;
+	pthread_mutex_unlock(&mLock);
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::setInterval(AIModelService *service, uint16_t interval)
+{
+	if (interval == 0) {
+		AIFW_LOGE("Invalid interval=%d", interval);
+		return AIFW_INVALID_ARG;
+	}
+	pthread_mutex_lock(&mLock);
+	AIScheduledService *entry = find(service);
+	if (!entry) {
+		pthread_mutex_unlock(&mLock);
+		AIFW_LOGE("Service %p not registered", service);
+		return AIFW_INVALID_ARG;
+	}
+	if (entry->running) {
+		entry->due = entry->due - entry->interval + interval;
+	}
+	entry->interval = interval;
+	pthread_cond_broadcast(&mCond);
+	pthread_mutex_unlock(&mLock);
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::setPriority(AIModelService *service, uint8_t priority)
+{
+	pthread_mutex_lock(&mLock);
+	AIScheduledService *entry = find(service);
+	if (!entry) {
+		pthread_mutex_unlock(&mLock);
+		AIFW_LOGE("Service %p not registered", service);
+		return AIFW_INVALID_ARG;
+	}
+	entry->priority = priority;
+	pthread_mutex_unlock(&mLock);
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::getMissedCount(AIModelService *service, uint32_t *missed)
+{
+	if (!missed) {
+		return AIFW_INVALID_ARG;
+	}
+	pthread_mutex_lock(&mLock);
+	AIScheduledService *entry = find(service);
+	if (!entry) {
+		pthread_mutex_unlock(&mLock);
+		AIFW_LOGE("Service %p not registered", service);
+		return AIFW_INVALID_ARG;
+	}
+	*missed = entry->missed;
+	pthread_mutex_unlock(&mLock);
+	return AIFW_OK;
+}
+
+} /* namespace aifw */
@@ -23,11 +23,18 @@
 #include "aifw/aifw_log.h"
 #include "aifw/AIModelService.h"
 #include "aifw/AIInferenceHandler.h"
+#ifdef CONFIG_AIFW_MODEL_SCHEDULER
+#include "include/AIModelScheduler.h"
+#endif
 
 namespace aifw {
 
 AIModelService::AIModelService(CollectRawDataListener collectRawDataCallback, std::shared_ptr<AIInferenceHandler> inferenceHandler) :
-	mInterval(0), mServiceRunning(false), mInferenceHandler(inferenceHandler), mCollectRawDataCallback(collectRawDataCallback), mTimer(NULL)
+	mInterval(0),
+#ifdef CONFIG_AIFW_MODEL_SCHEDULER
+	mPriority(0), mScheduled(false),
+#endif
+	mServiceRunning(false), mInferenceHandler(inferenceHandler), mCollectRawDataCallback(collectRawDataCallback), mTimer(NULL)
 {
 }
 
@@ -39,6 +46,16 @@ AIModelService::~AIModelService()
 
 AIFW_RESULT AIModelService::freeTimer(void)
 {
+#ifdef CONFIG_AIFW_MODEL_SCHEDULER
+	if (mScheduled) {
+		AIFW_RESULT res = AIModelScheduler::getInstance()->unregisterService(this);
+		if (res != AIFW_OK) {
+			AIFW_LOGE("Unregistering service from scheduler failed. ret: %d", res);
+			return res;
+		}
+		mScheduled = false;
+	}
+#endif
 	if (mTimer) {
 		int status = sem_wait(&(mTimer->exitSemaphore));
 		if (status != 0) {
@@ -92,6 +109,15 @@ AIFW_RESULT AIModelService::stop(void)
 		mServiceRunning = false;
 		return AIFW_OK;
 	}
+#ifdef CONFIG_AIFW_MODEL_SCHEDULER
+	ret = AIModelScheduler::getInstance()->stopService(this);
+	if (ret != AIFW_OK) {
+		AIFW_LOGE("Stopping service on scheduler failed, error: %d", ret);
+		return ret;
+	}
+	mServiceRunning = false;
+	return AIFW_OK;
+#else
 	aifw_timer_result dret = AIFW_TIMER_SUCCESS;
 	dret = aifw_timer_stop(mTimer);
 	if (dret != AIFW_TIMER_SUCCESS) {
@@ -100,11 +126,38 @@ AIFW_RESULT AIModelService::stop(void)
 	}
 	mServiceRunning = false;
 	return AIFW_OK;
+#endif /* CONFIG_AIFW_MODEL_SCHEDULER */
 }
 
 /* ToDo: Interval needs to be updated in json file so that updated value is used after device restarts */
 AIFW_RESULT AIModelService::setInterval(uint16_t interval)
 {
+#ifdef CONFIG_AIFW_MODEL_SCHEDULER
+	if (!mScheduled) {
+		AIFW_LOGE("Service not registered on scheduler yet, Ignoring request");
+		return AIFW_ERROR;
+	}
+	if (interval <= 0) {
+		AIFW_LOGE("Invalid interval=%d Ignoring request", interval);
+		return AIFW_ERROR;
+	}
+	AIFW_RESULT res = AIModelScheduler::getInstance()->setInterval(this, interval);
+	if (res != AIFW_OK) {
+		AIFW_LOGE("scheduler interval change failed=%d", res);
+		return res;
+	}
+	/* start() takes this path to start the service, the first interval starts now */
+	if (!mServiceRunning) {
+		res = AIModelScheduler::getInstance()->startService(this);
+		if (res != AIFW_OK) {
+			AIFW_LOGE("Starting service on scheduler failed=%d", res);
+			return res;
+		}
+	}
+	mInterval = interval;
+	AIFW_LOGI("Scheduler change interval success for interval=%d msec", interval);
+	return AIFW_OK;
+#else
 	aifw_timer_result ret;
 	if (!mTimer) {
 		AIFW_LOGE("Timer not created yet, Ignoring request");
@@ -122,7 +175,29 @@ AIFW_RESULT AIModelService::setInterval(uint16_t interval)
 	AIFW_LOGI("Timer change interval success for interval=%d msec", interval);
 
 	return AIFW_OK;
+#endif /* CONFIG_AIFW_MODEL_SCHEDULER */
+}
+
+#ifdef CONFIG_AIFW_MODEL_SCHEDULER
+AIFW_RESULT AIModelService::setPriority(uint8_t priority)
+{
+	mPriority = priority;
+	if (!mScheduled) {
+		/* Priority is given to the scheduler in prepare */
+		return AIFW_OK;
+	}
+	return AIModelScheduler::getInstance()->setPriority(this, priority);
+}
+
+AIFW_RESULT AIModelService::getMissedCount(uint32_t *missed)
+{
+	if (!mScheduled) {
+		AIFW_LOGE("Service not registered on scheduler");
+		return AIFW_ERROR;
+	}
+	return AIModelScheduler::getInstance()->getMissedCount(this, missed);
 }
+#endif /* CONFIG_AIFW_MODEL_SCHEDULER */
 
 AIFW_RESULT AIModelService::pushData(void *data, uint16_t count)
 {
@@ -142,6 +217,17 @@ AIFW_RESULT AIModelService::prepare(void)
 	}
 	mInterval = mInferenceHandler->getModelServiceInterval();
 	AIFW_LOGV("Timer interval %d", mInterval);
+#ifdef CONFIG_AIFW_MODEL_SCHEDULER
+	if (mInterval > 0 && !mScheduled) {
+		res = AIModelScheduler::getInstance()->registerService(this, mInterval, mPriority);
+		if (res != AIFW_OK) {
+			AIFW_LOGE("Registering service on scheduler failed. ret: %d", res);
+			return res;
+		}
+		mScheduled = true;
+		AIFW_LOGV("Service registered on scheduler");
+	}
+#else
 	if (mInterval > 0) {
 		mTimer = (aifw_timer *)calloc(1, sizeof(aifw_timer));
 		if (mTimer == NULL) {
@@ -157,6 +243,7 @@ AIFW_RESULT AIModelService::prepare(void)
 		}
 		AIFW_LOGV("Timer created OK");
 	}
+#endif /* CONFIG_AIFW_MODEL_SCHEDULER */
 	return AIFW_OK;
 }
 
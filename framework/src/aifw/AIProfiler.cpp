@@ -0,0 +1,122 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "tinyara/config.h"
+#include <string.h>
+#include <time.h>
+#include "aifw/aifw_log.h"
+#include "include/AIProfiler.h"
+
+namespace aifw {
+
+uint32_t getProfileTimeUs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)ts.tv_sec * 1000000 + (uint32_t)ts.tv_nsec / 1000;
+}
+
+uint32_t addProfileTime(AIProfileTime *time, uint32_t since)
+{
+	uint32_t now = getProfileTimeUs();
+	/* Wrapping of the clock is handled by unsigned subtraction */
+	uint32_t elapsed = now - since;
+	time->count++;
+	time->lastUs = elapsed;
+	time->totalUs += elapsed;
+	if (elapsed > time->maxUs) {
+		time->maxUs = elapsed;
+	}
+	return now;
+}
+
+AIOpProfiler::AIOpProfiler()
+{
+	reset();
+}
+
+void AIOpProfiler::reset(void)
+{
+	memset(mOps, 0, sizeof(mOps));
+	mOpCount = 0;
+	mDepth = 0;
+}
+
+AIProfileTime *AIOpProfiler::find(const char *name)
+{
+	for (uint16_t i = 0; i < mOpCount; i++) {
+		if (mOps[i].name == name || strcmp(mOps[i].name, name) == 0) {
+			return &mOps[i];
+		}
+	}
+	if (mOpCount == CONFIG_AIFW_PROFILING_MAX_OPS) {
+		return NULL;
+	}
+	mOps[mOpCount].name = name;
+	return &mOps[mOpCount++];
+}
+
+uint32_t AIOpProfiler::begin(const char *name)
+{
+	uint32_t handle = mDepth;
+	if (mDepth < AIFW_PROFILING_MAX_DEPTH) {
+		mRunning[mDepth] = name ? name : "unknown";
+		mStart[mDepth] = getProfileTimeUs();
+	}
+	mDepth++;
+	return handle;
+}
+
+void AIOpProfiler::end(uint32_t handle)
+{
+	if (handle >= mDepth) {
+		return;
+	}
+	mDepth = handle;
+	if (handle >= AIFW_PROFILING_MAX_DEPTH) {
+		return;
+	}
+	AIProfileTime *time = find(mRunning[handle]);
+	if (!time) {
+		AIFW_LOGD("Operator %s is not profiled, more than %d operator types", mRunning[handle], CONFIG_AIFW_PROFILING_MAX_OPS);
+		return;
+	}
+	addProfileTime(time, mStart[handle]);
+}
+
+void AIOpProfiler::endLast(void)
+{
+	if (mDepth > 0) {
+		end(mDepth - 1);
+	}
+}
+
+AIFW_RESULT AIOpProfiler::get(AIProfileTime *ops, uint16_t *count)
+{
+	if (!ops || !count) {
+		AIFW_LOGE("Invalid argument");
+		return AIFW_INVALID_ARG;
+	}
+	if (*count > mOpCount) {
+		*count = mOpCount;
+	}
+	memcpy(ops, mOps, *count * sizeof(AIProfileTime));
+	return AIFW_OK;
+}
+
+} /* namespace aifw */
@@ -22,11 +22,31 @@
 #include "aifw/aifw_log.h"
 #include "include/ONERTM.h"
 #include "luci_interpreter/Interpreter.h"
+#ifdef CONFIG_AIFW_PROFILING
+#include "include/AIProfiler.h"
+#endif
 
 namespace aifw {
 
+#ifdef CONFIG_AIFW_PROFILING
+/* Receives every kernel executed by the interpreter of a model, kernels of a subgraph run inside their operator */
+class ONERTMProfiler : public luci_interpreter::KernelProfiler, public AIOpProfiler
+{
+public:
+	void beginKernel(const char *name) override
+	{
+		begin(name);
+	}
+
+	void endKernel(const char *name) override
+	{
+		endLast();
+	}
+};
+#endif
+
 ONERTM::ONERTM() :
-	mBuf(NULL), mInterpreter(NULL),
+	mBuf(NULL), mModel(NULL), mInterpreter(NULL),
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	mModelInputSize(0), mModelOutputSize(0)
 #else
@@ -58,7 +78,10 @@ ONERTM::~ONERTM()
 AIFW_RESULT ONERTM::resetInferenceState(void)
 {
 	this->mInterpreter.reset();
-	this->mInterpreter = std::make_shared<luci_interpreter::Interpreter>(this->mBuf, true);
+	this->mInterpreter = std::make_shared<luci_interpreter::Interpreter>(this->mModel, true);
+#ifdef CONFIG_AIFW_PROFILING
+	this->mInterpreter->setKernelProfiler(this->mProfiler.get());
+#endif
 	return AIFW_OK;
 }
 
@@ -66,9 +89,13 @@ AIFW_RESULT ONERTM::_loadModel(void)
 {
 	AIFW_LOGV("luci_interpreter::Interpreter _loadModel\n");
 	this->mInterpreter = std::make_shared<luci_interpreter::Interpreter>(
-		this->mBuf,
+		this->mModel,
 		true);
 	AIFW_LOGV("luci_interpreter::Interpreter created\n");
+#ifdef CONFIG_AIFW_PROFILING
+	this->mProfiler = std::make_shared<ONERTMProfiler>();
+	this->mInterpreter->setKernelProfiler(this->mProfiler.get());
+#endif
 	sleep(2);
 
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
@@ -134,6 +161,7 @@ AIFW_RESULT ONERTM::loadModel(const char *file)
 	}
 	fread(this->mBuf, 1, size, fp);
 	fclose(fp);
+	this->mModel = this->mBuf;
 
 	AIFW_LOGV("GetModel from Model file");
 
@@ -144,10 +172,35 @@ AIFW_RESULT ONERTM::loadModel(const char *file)
 
 AIFW_RESULT ONERTM::loadModel(const unsigned char *model)
 {
-	this->mBuf = reinterpret_cast<char*>(const_cast<unsigned char *>(model));
+	/* Array or in place model is not owned, only a model read from file is freed */
+	this->mModel = reinterpret_cast<const char *>(model);
 	return _loadModel();
 }
 
+AIFW_RESULT ONERTM::getInputTensor(uint16_t index, AITensor *tensor)
+{
+	/* onert-micro interpreter exposes neither type nor quantization of inputs, they are always given as float data to invoke */
+	return AIFW_NOT_SUPPORTED;
+}
+
+#ifdef CONFIG_AIFW_PROFILING
+AIFW_RESULT ONERTM::getOpProfile(AIProfileTime *ops, uint16_t *count)
+{
+	if (!this->mProfiler) {
+		AIFW_LOGE("Model is not loaded");
+		return AIFW_ERROR;
+	}
+	return this->mProfiler->get(ops, count);
+}
+
+void ONERTM::resetProfile(void)
+{
+	if (this->mProfiler) {
+		this->mProfiler->reset();
+	}
+}
+#endif /* CONFIG_AIFW_PROFILING */
+
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 void ONERTM::getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList, uint16_t *outputSetCount, uint16_t **outputSizeList)
 {
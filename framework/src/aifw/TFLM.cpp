@@ -18,6 +18,8 @@
 
 #include "tinyara/config.h"
 #include <iostream>
+#include <pthread.h>
+#include <string.h>
 #include <tensorflow/lite/c/common.h>
 #include <tensorflow/lite/schema/schema_generated.h>
 #include <tensorflow/lite/micro/all_ops_resolver.h>
@@ -26,7 +28,11 @@
 #include <tensorflow/lite/micro/micro_profiler.h>
 
 #include "aifw/aifw_log.h"
+#include "aifw/aifw_utils.h"
 #include "include/TFLM.h"
+#ifdef CONFIG_AIFW_PROFILING
+#include "include/AIProfiler.h"
+#endif
 
 #ifndef CONFIG_TFLM_MEM_POOL_SIZE
 #define AIFW_TFLM_POOL_SIZE 8192
@@ -34,25 +40,87 @@
 #define AIFW_TFLM_POOL_SIZE CONFIG_TFLM_MEM_POOL_SIZE
 #endif
 
+#ifdef CONFIG_AIFW_TFLM_SHARED_ARENA
+#define ARENA_LOCK() pthread_mutex_lock(&g_ArenaLock)
+#define ARENA_UNLOCK() pthread_mutex_unlock(&g_ArenaLock)
+#else
+#define ARENA_LOCK()
+#define ARENA_UNLOCK()
+#endif
+
 namespace aifw {
 
 tflite::AllOpsResolver g_Resolver;
 tflite::MicroProfiler g_Profiler;
+#ifdef CONFIG_AIFW_TFLM_SHARED_ARENA
+/* All models are allocated by one allocator in one arena. Persistent buffers of every model are stacked at the tail,
+ * the head holding activations, inputs and outputs is shared and sized for the largest model.
+ * So a model is loaded and invoked with g_ArenaLock held, and its outputs are copied before the lock is released.
+ * Arena is released when the last model is destroyed, persistent buffers of a model are not reused before that.
+ */
+static pthread_mutex_t g_ArenaLock = PTHREAD_MUTEX_INITIALIZER;
+static uint8_t *g_SharedArena;
+static tflite::MicroAllocator *g_SharedAllocator;
+static uint16_t g_ArenaUsers;
+#endif
+
+#ifdef CONFIG_AIFW_PROFILING
+/* Receives an event for every operator invoked by the interpreter of a model */
+class TFLMProfiler : public tflite::MicroProfilerInterface, public AIOpProfiler
+{
+public:
+	uint32_t BeginEvent(const char *tag) override
+	{
+		return begin(tag);
+	}
+
+	void EndEvent(uint32_t event_handle) override
+	{
+		end(event_handle);
+	}
+};
+#endif
+
+/* Outputs are given from the tensor directly, unless they are converted to float or the arena is shared */
+static bool isOutputCopied(const TfLiteTensor *output)
+{
+#ifdef CONFIG_AIFW_TFLM_SHARED_ARENA
+	return true;
+#else
+	return output->type != kTfLiteFloat32;
+#endif
+}
+
 TFLM::TFLM() :
 	mModel(NULL), mBuf(NULL), mInterpreter(NULL), mErrorReporter(NULL),
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	mInput(NULL), mOutput(NULL), mModelInputSize(0), mModelOutputSize(0)
+	mInput(NULL), mOutput(NULL), mOutputValues(NULL), mModelInputSize(0), mModelOutputSize(0)
 #else
-	mInputList(NULL), mOutputList(NULL), mInputSizeList(NULL), mOutputSizeList(NULL)
+	mInputList(NULL), mOutputList(NULL), mOutputValuesList(NULL), mInputSizeList(NULL), mOutputSizeList(NULL)
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 {
 	this->mTensorArenaSize = AIFW_TFLM_POOL_SIZE;
 	AIFW_LOGV("Tensor Arena size: %d", this->mTensorArenaSize);
+#ifdef CONFIG_AIFW_TFLM_SHARED_ARENA
+	ARENA_LOCK();
+	if (g_ArenaUsers == 0) {
+		g_SharedArena = new uint8_t[this->mTensorArenaSize];
+		if (g_SharedArena == NULL) {
+			ARENA_UNLOCK();
+			AIFW_LOGE("shared tensor arena memory allocation failed");
+			return;
+		}
+		g_SharedAllocator = tflite::MicroAllocator::Create(g_SharedArena, this->mTensorArenaSize);
+	}
+	g_ArenaUsers++;
+	ARENA_UNLOCK();
+#else
 	std::shared_ptr<uint8_t> tensorArena(new uint8_t[this->mTensorArenaSize], std::default_delete<uint8_t[]>());
 	if (tensorArena.get() == NULL) {
 		AIFW_LOGE("tensor arena memory allocation failed");
 	}
 	this->mTensorArena = tensorArena;
+#endif /* CONFIG_AIFW_TFLM_SHARED_ARENA */
 }
 
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
@@ -61,6 +129,13 @@ void TFLM::clearMemory(void) {
 		delete[] mInputList;
 		mInputList = NULL;
 	}
+	if (this->mOutputValuesList) {
+		for (uint16_t i = 0; i < this->mOutputSetCount; i++) {
+			delete[] this->mOutputValuesList[i];
+		}
+		delete[] this->mOutputValuesList;
+		this->mOutputValuesList = NULL;
+	}
 	if (this->mOutputList) {
 		delete[] mOutputList;
 		mOutputList = NULL;
@@ -84,15 +159,33 @@ TFLM::~TFLM()
 		mBuf = NULL;
 	}
 	mErrorReporter.reset();
+#ifdef CONFIG_AIFW_TFLM_SHARED_ARENA
+	ARENA_LOCK();
+	mInterpreter.reset();
+	if (g_SharedArena && --g_ArenaUsers == 0) {
+		g_SharedAllocator = NULL;
+		delete[] g_SharedArena;
+		g_SharedArena = NULL;
+	}
+	ARENA_UNLOCK();
+#else
 	mInterpreter.reset();
+#endif
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	clearMemory();
+#else
+	if (mOutputValues) {
+		delete[] mOutputValues;
+		mOutputValues = NULL;
+	}
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 }
 
 AIFW_RESULT TFLM::resetInferenceState(void)
 {
+	ARENA_LOCK();
 	TfLiteStatus res = this->mInterpreter->Reset();
+	ARENA_UNLOCK();
 	if (res != kTfLiteOk) {
 		AIFW_LOGE("Failed to reset model state. ret: %d", res);
 		return AIFW_ERROR;
@@ -159,6 +252,21 @@ AIFW_RESULT TFLM::allocateMemory(void)
 		}
 		AIFW_LOGV("mOutputSizeList[%d] =  %d\n", i, mOutputSizeList[i]);
 	}
+	/* Quantized outputs are given to AIModel as float values converted in these buffers */
+	this->mOutputValuesList = new float *[this->mOutputSetCount]();
+	if (!this->mOutputValuesList) {
+		AIFW_LOGE("Internal Memory Allocation failed.");
+		goto mem_alloc_error;
+	}
+	for (uint16_t i = 0; i < this->mOutputSetCount; i++) {
+		if (isOutputCopied(this->mOutputList[i])) {
+			this->mOutputValuesList[i] = new float[this->mOutputSizeList[i]];
+			if (!this->mOutputValuesList[i]) {
+				AIFW_LOGE("Internal Memory Allocation failed.");
+				goto mem_alloc_error;
+			}
+		}
+	}
 	delete[] input_dims_size;
 	input_dims_size = NULL;
 	delete[] output_dims_size;
@@ -179,21 +287,46 @@ AIFW_RESULT TFLM::_loadModel(void)
 {
 	AIFW_RESULT res;
 	mErrorReporter = std::make_shared<tflite::MicroErrorReporter>();
+	tflite::MicroProfilerInterface *profiler = &g_Profiler;
+#ifdef CONFIG_AIFW_PROFILING
+	mProfiler = std::make_shared<TFLMProfiler>();
+	profiler = mProfiler.get();
+#endif
+#ifdef CONFIG_AIFW_TFLM_SHARED_ARENA
+	if (!g_SharedAllocator) {
+		AIFW_LOGE("shared tensor arena is not allocated");
+		return AIFW_NO_MEM;
+	}
+	ARENA_LOCK();
+	this->mInterpreter = std::make_shared<tflite::MicroInterpreter>(
+		this->mModel,
+		g_Resolver,
+		g_SharedAllocator,
+		nullptr,
+		profiler);
+#else
 	this->mInterpreter = std::make_shared<tflite::MicroInterpreter>(
 		this->mModel,
 		g_Resolver,
 		this->mTensorArena.get(),
 		this->mTensorArenaSize,
 		nullptr,
-		&g_Profiler);
+		profiler);
+#endif /* CONFIG_AIFW_TFLM_SHARED_ARENA */
 
 	TfLiteStatus allocate_status = this->mInterpreter->AllocateTensors();
+	ARENA_UNLOCK();
 	if (allocate_status != kTfLiteOk) {
 		this->mErrorReporter->Report("AllocateTensors() failed");
 		AIFW_LOGE("AllocateTensors() failed");
 		return AIFW_ERROR;
 	}
 	AIFW_LOGV("AllocateTensors success.");
+#ifdef CONFIG_AIFW_PROFILING
+	this->mProfiler->reset();
+#endif
+	/* With a shared arena, it is the usage by all models loaded so far */
+	AIFW_LOGI("Tensor arena used %u of %u bytes", (unsigned int)this->mInterpreter->arena_used_bytes(), (unsigned int)this->mTensorArenaSize);
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	this->mInput = this->mInterpreter->input(0);
 	this->mOutput = this->mInterpreter->output(0);
@@ -223,6 +356,14 @@ AIFW_RESULT TFLM::_loadModel(void)
 		this->mModelOutputSize *= this->mOutput->dims->data[i];
 	}
 	AIFW_LOGV("mModelInputSize = %d mModelOutputSize = %d", mModelInputSize, mModelOutputSize);
+	/* Quantized output is given to AIModel as float values converted in this buffer */
+	if (isOutputCopied(this->mOutput) && !this->mOutputValues) {
+		this->mOutputValues = new float[this->mModelOutputSize];
+		if (!this->mOutputValues) {
+			AIFW_LOGE("Memory Allocation failed - model output values");
+			return AIFW_NO_MEM;
+		}
+	}
 #else
 	res = allocateMemory();
 	if (res != AIFW_OK) {
@@ -283,6 +424,97 @@ AIFW_RESULT TFLM::loadModel(const unsigned char *model)
 	return _loadModel();
 }
 
+AIFW_RESULT TFLM::describeTensor(TfLiteTensor *tfTensor, uint16_t count, AITensor *tensor)
+{
+	switch (tfTensor->type) {
+	case kTfLiteFloat32:
+		tensor->type = AIFW_DATA_FLOAT32;
+		break;
+	case kTfLiteInt16:
+		tensor->type = AIFW_DATA_INT16;
+		break;
+	case kTfLiteInt8:
+		tensor->type = AIFW_DATA_INT8;
+		break;
+	default:
+		AIFW_LOGE("Tensor type %d is not supported", tfTensor->type);
+		return AIFW_NOT_SUPPORTED;
+	}
+	tensor->scale = tfTensor->params.scale;
+	tensor->zeroPoint = tfTensor->params.zero_point;
+	tensor->count = count;
+	tensor->data = tfTensor->data.data;
+	return AIFW_OK;
+}
+
+float *TFLM::readOutput(TfLiteTensor *output, uint16_t count, float *values)
+{
+	if (output->type == kTfLiteFloat32) {
+		if (!isOutputCopied(output)) {
+			return output->data.f;
+		}
+		memcpy(values, output->data.f, count * sizeof(float));
+		return values;
+	}
+	AITensor tensor;
+	if (!values || describeTensor(output, count, &tensor) != AIFW_OK || dequantizeData(&tensor, values, count) != AIFW_OK) {
+		AIFW_LOGE("Output conversion failed, tensor type %d", output->type);
+		return NULL;
+	}
+	return values;
+}
+
+AIFW_RESULT TFLM::getInputTensor(uint16_t index, AITensor *tensor)
+{
+#ifdef CONFIG_AIFW_TFLM_SHARED_ARENA
+	/* Tensors filled in place before invoke could be overwritten by another model meanwhile, inputs are copied in invoke */
+	return AIFW_NOT_SUPPORTED;
+#endif
+#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	if (index != 0 || !this->mInput) {
+		AIFW_LOGE("Invalid input tensor index %d", index);
+		return AIFW_INVALID_ARG;
+	}
+	return describeTensor(this->mInput, this->mModelInputSize, tensor);
+#else
+	if (index >= this->mInputSetCount || !this->mInputList) {
+		AIFW_LOGE("Invalid input tensor index %d", index);
+		return AIFW_INVALID_ARG;
+	}
+	return describeTensor(this->mInputList[index], this->mInputSizeList[index], tensor);
+#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+}
+
+#ifdef CONFIG_AIFW_PROFILING
+AIFW_RESULT TFLM::getOpProfile(AIProfileTime *ops, uint16_t *count)
+{
+	if (!this->mProfiler) {
+		AIFW_LOGE("Model is not loaded");
+		return AIFW_ERROR;
+	}
+	return this->mProfiler->get(ops, count);
+}
+
+AIFW_RESULT TFLM::getArenaUsage(uint32_t *usedBytes, uint32_t *size)
+{
+	if (!this->mInterpreter) {
+		AIFW_LOGE("Model is not loaded");
+		return AIFW_ERROR;
+	}
+	/* With a shared arena, it is the usage by all models loaded so far */
+	*usedBytes = (uint32_t)this->mInterpreter->arena_used_bytes();
+	*size = (uint32_t)this->mTensorArenaSize;
+	return AIFW_OK;
+}
+
+void TFLM::resetProfile(void)
+{
+	if (this->mProfiler) {
+		this->mProfiler->reset();
+	}
+}
+#endif /* CONFIG_AIFW_PROFILING */
+
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 void TFLM::getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList, uint16_t *outputSetCount, uint16_t **outputSizeList)
 {
@@ -297,42 +529,62 @@ void TFLM::getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList,
 /* Run inference : with input data "features" and return output data ptr(Use output dimension to parse it) */
 void *TFLM::invoke(void *inputData)
 {
-	float *value = (float *)(inputData);
-	for (int i = 0; i < this->mModelInputSize; i++) {
-		this->mInput->data.f[i] = value[i];
+	/* Values are quantized while they are copied, for a quantized model */
+	ARENA_LOCK();
+	if (inputData) {
+		AITensor input;
+		if (describeTensor(this->mInput, this->mModelInputSize, &input) != AIFW_OK || quantizeData((const float *)inputData, NULL, NULL, this->mModelInputSize, &input) != AIFW_OK) {
+			ARENA_UNLOCK();
+			AIFW_LOGE("Input conversion failed, tensor type %d", this->mInput->type);
+			return NULL;
+		}
 	}
 	AIFW_START_TIMER
 	TfLiteStatus invokeStatus = this->mInterpreter->Invoke();
 	AIFW_END_TIMER
 	if (invokeStatus != kTfLiteOk) {
+		ARENA_UNLOCK();
 		this->mErrorReporter->Report("Invoke failed");
 		AIFW_LOGE("Invoke failed");
 		return NULL;
 	}
-	return this->mOutput->data.data;
+	float *output = readOutput(this->mOutput, this->mModelOutputSize, this->mOutputValues);
+	ARENA_UNLOCK();
+	return output;
 }
 #else
 /* Run inference : with input data "features", store output data in outputData parameter and return AIFW_OK on success */
 AIFW_RESULT TFLM::invoke(void *inputData, void *outputData)
 {
+	/* Values are quantized while they are copied, for a quantized model */
 	float **value = (float **)(inputData);
-	for (uint16_t i = 0; i < this->mInputSetCount; i++) {
-		for (uint16_t j = 0; j < this->mInputSizeList[i]; j++) {
-			this->mInputList[i]->data.f[j] = value[i][j];
+	ARENA_LOCK();
+	for (uint16_t i = 0; value && i < this->mInputSetCount; i++) {
+		AITensor input;
+		if (describeTensor(this->mInputList[i], this->mInputSizeList[i], &input) != AIFW_OK || quantizeData(value[i], NULL, NULL, this->mInputSizeList[i], &input) != AIFW_OK) {
+			ARENA_UNLOCK();
+			AIFW_LOGE("Input conversion failed, tensor type %d", this->mInputList[i]->type);
+			return AIFW_ERROR;
 		}
 	}
 	AIFW_START_TIMER
 	TfLiteStatus invokeStatus = this->mInterpreter->Invoke();
 	AIFW_END_TIMER
 	if (invokeStatus != kTfLiteOk) {
+		ARENA_UNLOCK();
 		this->mErrorReporter->Report("Invoke failed");
 		AIFW_LOGE("Invoke failed");
 		return AIFW_ERROR;
 	}
 	float **outputRef = (float **)(outputData);
 	for (uint16_t i = 0; i < this->mOutputSetCount; i++) {
-		outputRef[i] = (float *)this->mOutputList[i]->data.data;
+		outputRef[i] = readOutput(this->mOutputList[i], this->mOutputSizeList[i], this->mOutputValuesList[i]);
+		if (!outputRef[i]) {
+			ARENA_UNLOCK();
+			return AIFW_ERROR;
+		}
 	}
+	ARENA_UNLOCK();
 	return AIFW_OK;
 }
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
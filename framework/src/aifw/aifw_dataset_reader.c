@@ -0,0 +1,373 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "aifw/aifw_log.h"
+#include "aifw/aifw_dataset_reader.h"
+
+/**
+ * @struct _DatasetHandle_s
+ * @brief This structure defines necessary fields of a binary dataset required in read operation.
+ */
+typedef struct _DatasetHandle_s {
+	int fd;					// File descriptor of dataset
+	AIFW_DATASET_HEADER_S header;		// Header read from dataset
+	uint32_t rowSize;			// Size of one row in bytes
+	uint32_t rowsRead;			// Number of rows read till now
+	uint16_t batchRows;			// Capacity of batch buffer in rows
+	char *batchBuffer;			// Buffer holding rows of the last batch
+} DatasetHandle;
+
+static uint8_t getValueSize(CSV_VALUE_DATA_TYPE_E type)
+{
+	switch (type) {
+	case INT8:
+	case UINT8:
+		return sizeof(int8_t);
+	case INT16:
+		return sizeof(int16_t);
+	case INT32:
+		return sizeof(int32_t);
+	case FLOAT32:
+		return sizeof(float);
+	default:
+		return 0;
+	}
+}
+
+/* Reads size bytes unless end of file comes first, gives number of bytes read or -1 */
+static ssize_t readFully(int fd, char *buffer, size_t size)
+{
+	size_t total = 0;
+	while (total < size) {
+		ssize_t ret = read(fd, buffer + total, size - total);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -1;
+		}
+		if (ret == 0) {
+			break;
+		}
+		total += ret;
+	}
+	return total;
+}
+
+static AIFW_RESULT writeFully(int fd, const void *buffer, size_t size)
+{
+	size_t total = 0;
+	while (total < size) {
+		ssize_t ret = write(fd, (const char *)buffer + total, size - total);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			AIFW_LOGE("File write operation failed errno : %d", errno);
+			return AIFW_ERROR_FILE_ACCESS;
+		}
+		total += ret;
+	}
+	return AIFW_OK;
+}
+
+/*
+ * Checks every line of csv has a value in each of columnCount columns, before any row is converted.
+ * readCSVData drops extra columns, keeps values of the previous line for missing ones and skips
+ * lines with an empty value, so a dataset of such csv would silently differ from it.
+ * Blank lines are skipped as in readCSVData. Header only gives the column count.
+ */
+static AIFW_RESULT checkColumns(const char *csvFile, bool hasHeader, uint16_t columnCount)
+{
+	FILE *fp = fopen(csvFile, "r");
+	if (!fp) {
+		AIFW_LOGE("File %s open operation failed errno : %d", csvFile, errno);
+		return AIFW_ERROR_FILE_ACCESS;
+	}
+	AIFW_RESULT res = AIFW_OK;
+	uint32_t line = 1;
+	uint32_t columns = 1;
+	bool blank = true;
+	bool emptyValue = false;
+	bool hasValue = false;
+	int c;
+	do {
+		c = fgetc(fp);
+		if (c == ',') {
+			emptyValue |= !hasValue;
+			hasValue = false;
+			blank = false;
+			columns++;
+		} else if (c == '\n' || c == EOF) {
+			emptyValue |= !hasValue;
+			if (!blank && !(hasHeader && line == 1) && (emptyValue || columns != columnCount)) {
+				AIFW_LOGE("Line %u of %s has %u columns%s, expected %d", line, csvFile, columns, emptyValue ? " with an empty value" : "", columnCount);
+				res = AIFW_ERROR;
+				break;
+			}
+			line++;
+			columns = 1;
+			blank = true;
+			emptyValue = false;
+			hasValue = false;
+		} else if (!isspace(c)) {
+			hasValue = true;
+			blank = false;
+		}
+	} while (c != EOF);
+	if (res == AIFW_OK && ferror(fp)) {
+		AIFW_LOGE("File %s read operation failed errno : %d", csvFile, errno);
+		res = AIFW_ERROR_FILE_ACCESS;
+	}
+	fclose(fp);
+	return res;
+}
+
+AIFW_RESULT csvToDataset(const char *csvFile, const char *datasetFile, CSV_VALUE_DATA_TYPE_E dataType, bool hasHeader, uint32_t *rowCount)
+{
+	if (!csvFile || !datasetFile) {
+		AIFW_LOGE("file name is null");
+		return AIFW_INVALID_ARG;
+	}
+	void *csvHandle = NULL;
+	AIFW_RESULT res = csvInit(&csvHandle, csvFile, dataType, hasHeader);
+	if (res != AIFW_OK) {
+		AIFW_LOGE("csv init failed for %s, ret: %d", csvFile, res);
+		return res;
+	}
+	AIFW_DATASET_HEADER_S header;
+	memset(&header, 0, sizeof(header));
+	header.magic = AIFW_DATASET_MAGIC;
+	header.version = AIFW_DATASET_VERSION;
+	header.headerSize = sizeof(header);
+	header.dataType = (uint8_t)dataType;
+	header.valueSize = getValueSize(dataType);
+	res = getColumnCount(csvHandle, &header.columnCount);
+	if (res != AIFW_OK || header.columnCount == 0) {
+		AIFW_LOGE("get column count failed for %s, ret: %d", csvFile, res);
+		csvDeinit(&csvHandle);
+		return res != AIFW_OK ? res : AIFW_ERROR;
+	}
+	res = checkColumns(csvFile, hasHeader, header.columnCount);
+	if (res != AIFW_OK) {
+		csvDeinit(&csvHandle);
+		return res;
+	}
+
+	uint32_t rowSize = header.columnCount * header.valueSize;
+	char *row = (char *)malloc(rowSize);
+	if (!row) {
+		AIFW_LOGE("Memory allocation failed for row of %u bytes", rowSize);
+		csvDeinit(&csvHandle);
+		return AIFW_NO_MEM;
+	}
+	int fd = open(datasetFile, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0) {
+		AIFW_LOGE("File %s open operation failed errno : %d", datasetFile, errno);
+		free(row);
+		csvDeinit(&csvHandle);
+		return AIFW_ERROR_FILE_ACCESS;
+	}
+	/* Row count is written again once all rows are converted */
+	res = writeFully(fd, &header, sizeof(header));
+	while (res == AIFW_OK) {
+		res = readCSVData(csvHandle, row);
+		if (res != AIFW_OK) {
+			break;
+		}
+		res = writeFully(fd, row, rowSize);
+		header.rowCount++;
+	}
+	if (res == AIFW_SOURCE_EOF) {
+		if (lseek(fd, 0, SEEK_SET) < 0) {
+			AIFW_LOGE("Seeking file pointer to start of file failed, errno : %d", errno);
+			res = AIFW_ERROR_FILE_ACCESS;
+		} else {
+			res = writeFully(fd, &header, sizeof(header));
+		}
+	}
+	if (close(fd) != 0 && res == AIFW_OK) {
+		AIFW_LOGE("File %s close operation failed errno : %d", datasetFile, errno);
+		res = AIFW_ERROR_FILE_ACCESS;
+	}
+	free(row);
+	csvDeinit(&csvHandle);
+	if (res != AIFW_OK) {
+		AIFW_LOGE("Conversion of %s failed after %u rows, ret: %d", csvFile, header.rowCount, res);
+		/* Partial dataset is not left behind to be read as a complete one */
+		unlink(datasetFile);
+		return res;
+	}
+	AIFW_LOGV("%u rows of %d columns written to %s", header.rowCount, header.columnCount, datasetFile);
+	if (rowCount) {
+		*rowCount = header.rowCount;
+	}
+	return AIFW_OK;
+}
+
+AIFW_RESULT datasetInit(void **datasetHandle, const char *filename, uint16_t batchRows)
+{
+	if (!datasetHandle) {
+		AIFW_LOGE("Double pointer to dataset handle is NULL.");
+		return AIFW_INVALID_ARG;
+	}
+	if (!filename) {
+		AIFW_LOGE("file name is null");
+		return AIFW_INVALID_ARG;
+	}
+	if (batchRows == 0) {
+		AIFW_LOGE("Batch of rows is empty");
+		return AIFW_INVALID_ARG;
+	}
+	DatasetHandle *handle = (DatasetHandle *)malloc(sizeof(DatasetHandle));
+	if (!handle) {
+		AIFW_LOGE("Memory allocation failed for dataset handle");
+		return AIFW_NO_MEM;
+	}
+	handle->batchBuffer = NULL;
+	handle->fd = open(filename, O_RDONLY);
+	if (handle->fd < 0) {
+		AIFW_LOGE("File %s open operation failed errno : %d", filename, errno);
+		free(handle);
+		return AIFW_ERROR_FILE_ACCESS;
+	}
+	*datasetHandle = handle;
+	AIFW_DATASET_HEADER_S *header = &handle->header;
+	if (readFully(handle->fd, (char *)header, sizeof(*header)) != sizeof(*header) || header->magic != AIFW_DATASET_MAGIC) {
+		AIFW_LOGE("%s is not a binary dataset", filename);
+		datasetDeinit(datasetHandle);
+		return AIFW_ERROR;
+	}
+	if (header->version != AIFW_DATASET_VERSION || header->headerSize < sizeof(*header) || header->columnCount == 0 || header->valueSize == 0 || header->valueSize != getValueSize((CSV_VALUE_DATA_TYPE_E)header->dataType)) {
+		AIFW_LOGE("Header of dataset %s is invalid, version %d type %d columns %d", filename, header->version, header->dataType, header->columnCount);
+		datasetDeinit(datasetHandle);
+		return AIFW_ERROR;
+	}
+	handle->rowSize = header->columnCount * header->valueSize;
+	handle->rowsRead = 0;
+	handle->batchRows = batchRows;
+	handle->batchBuffer = (char *)malloc(handle->rowSize * batchRows);
+	if (!handle->batchBuffer) {
+		AIFW_LOGE("Memory allocation failed for %d rows of %u bytes", batchRows, handle->rowSize);
+		datasetDeinit(datasetHandle);
+		return AIFW_NO_MEM;
+	}
+	if (rewindDataset(handle) != AIFW_OK) {
+		datasetDeinit(datasetHandle);
+		return AIFW_ERROR_FILE_ACCESS;
+	}
+	AIFW_LOGV("Dataset %s: %u rows of %d columns", filename, header->rowCount, header->columnCount);
+	return AIFW_OK;
+}
+
+AIFW_RESULT datasetDeinit(void **handle)
+{
+	if (!handle) {
+		AIFW_LOGE("Double pointer to dataset handle is NULL.");
+		return AIFW_INVALID_ARG;
+	}
+	DatasetHandle *datasetHandle = (DatasetHandle *)(*handle);
+	if (!datasetHandle) {
+		return AIFW_OK;
+	}
+	AIFW_RESULT res = AIFW_OK;
+	if (close(datasetHandle->fd) != 0) {
+		AIFW_LOGE("file close error errno : %d", errno);
+		res = AIFW_ERROR;
+	}
+	free(datasetHandle->batchBuffer);
+	free(datasetHandle);
+	*handle = NULL;
+	return res;
+}
+
+AIFW_RESULT getDatasetInfo(void *handle, CSV_VALUE_DATA_TYPE_E *dataType, uint16_t *columnCount, uint32_t *rowCount)
+{
+	if (!handle) {
+		AIFW_LOGE("Pointer to dataset handle is NULL");
+		return AIFW_INVALID_ARG;
+	}
+	DatasetHandle *datasetHandle = (DatasetHandle *)handle;
+	if (dataType) {
+		*dataType = (CSV_VALUE_DATA_TYPE_E)datasetHandle->header.dataType;
+	}
+	if (columnCount) {
+		*columnCount = datasetHandle->header.columnCount;
+	}
+	if (rowCount) {
+		*rowCount = datasetHandle->header.rowCount;
+	}
+	return AIFW_OK;
+}
+
+AIFW_RESULT readDatasetRows(void *handle, void **rows, uint16_t *rowCount)
+{
+	if (!handle) {
+		AIFW_LOGE("Pointer to dataset handle is NULL");
+		return AIFW_INVALID_ARG;
+	}
+	if (!rows || !rowCount) {
+		AIFW_LOGE("Output rows or row count is NULL");
+		return AIFW_INVALID_ARG;
+	}
+	DatasetHandle *datasetHandle = (DatasetHandle *)handle;
+	uint32_t remaining = datasetHandle->header.rowCount - datasetHandle->rowsRead;
+	uint16_t count = remaining < datasetHandle->batchRows ? (uint16_t)remaining : datasetHandle->batchRows;
+	*rowCount = 0;
+	if (count == 0) {
+		return AIFW_SOURCE_EOF;
+	}
+	ssize_t size = readFully(datasetHandle->fd, datasetHandle->batchBuffer, count * datasetHandle->rowSize);
+	if (size < 0) {
+		AIFW_LOGE("File read operation failed errno : %d", errno);
+		return AIFW_ERROR_FILE_ACCESS;
+	}
+	/* A truncated dataset ends at its last complete row */
+	count = size / datasetHandle->rowSize;
+	if (count == 0) {
+		AIFW_LOGE("Dataset truncated after %u of %u rows", datasetHandle->rowsRead, datasetHandle->header.rowCount);
+		datasetHandle->header.rowCount = datasetHandle->rowsRead;
+		return AIFW_SOURCE_EOF;
+	}
+	datasetHandle->rowsRead += count;
+	*rows = datasetHandle->batchBuffer;
+	*rowCount = count;
+	return AIFW_OK;
+}
+
+AIFW_RESULT rewindDataset(void *handle)
+{
+	if (!handle) {
+		AIFW_LOGE("Pointer to dataset handle is NULL");
+		return AIFW_INVALID_ARG;
+	}
+	DatasetHandle *datasetHandle = (DatasetHandle *)handle;
+	if (lseek(datasetHandle->fd, datasetHandle->header.headerSize, SEEK_SET) < 0) {
+		AIFW_LOGE("Seeking to first row failed, errno : %d", errno);
+		return AIFW_ERROR_FILE_ACCESS;
+	}
+	datasetHandle->rowsRead = 0;
+	return AIFW_OK;
+}
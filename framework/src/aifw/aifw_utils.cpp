@@ -17,6 +17,7 @@
  ****************************************************************************/
 
 #include <math.h>
+#include <string.h>
 #include "aifw/aifw_utils.h"
 #include "aifw/aifw_log.h"
 #include "aifw/aifw.h"
@@ -29,6 +30,109 @@ void normalizeData(float dataValues[], float meanVals[], float stdValues[], uint
 	}
 }
 
+template <typename T>
+static void quantizeValues(const float dataValues[], const float meanVals[], const float stdValues[], uint16_t countOfValues, float scale, int32_t zeroPoint, T minValue, T maxValue, T output[])
+{
+	float inverseScale = 1.0f / scale;
+	for (uint16_t i = 0; i < countOfValues; i++) {
+		float value = dataValues[i];
+		if (meanVals && stdValues) {
+			value = (value - meanVals[i]) / (stdValues[i] + 0.000001f);
+		}
+		value = value * inverseScale + zeroPoint;
+		/* Saturate before conversion, out of range float to integer conversion is undefined */
+		if (value <= minValue) {
+			output[i] = minValue;
+		} else if (value >= maxValue) {
+			output[i] = maxValue;
+		} else {
+			output[i] = (T)(value >= 0 ? value + 0.5f : value - 0.5f);
+		}
+	}
+}
+
+template <typename T>
+static void dequantizeValues(const T input[], float scale, int32_t zeroPoint, uint16_t countOfValues, float dataValues[])
+{
+	for (uint16_t i = 0; i < countOfValues; i++) {
+		dataValues[i] = scale * (int32_t)(input[i] - zeroPoint);
+	}
+}
+
+AIFW_RESULT quantizeData(const float dataValues[], const float meanVals[], const float stdValues[], uint16_t countOfValues, AITensor *output)
+{
+	if (!dataValues || !output || !output->data) {
+		AIFW_LOGE("[Error] Invalid argument, data %p output %p", dataValues, output);
+		return AIFW_INVALID_ARG;
+	}
+	if (countOfValues > output->count) {
+		AIFW_LOGE("[Error] count %d exceeds output count %d", countOfValues, output->count);
+		return AIFW_NOT_ENOUGH_SPACE;
+	}
+	switch (output->type) {
+	case AIFW_DATA_FLOAT32: {
+		if (!meanVals || !stdValues) {
+			memcpy(output->data, dataValues, countOfValues * sizeof(float));
+			return AIFW_OK;
+		}
+		float *values = (float *)output->data;
+		for (uint16_t i = 0; i < countOfValues; i++) {
+			values[i] = (dataValues[i] - meanVals[i]) / (stdValues[i] + 0.000001f);
+		}
+		return AIFW_OK;
+	}
+	case AIFW_DATA_INT16:
+		quantizeValues<int16_t>(dataValues, meanVals, stdValues, countOfValues, output->scale, output->zeroPoint, INT16_MIN, INT16_MAX, (int16_t *)output->data);
+		return AIFW_OK;
+	case AIFW_DATA_INT8:
+		quantizeValues<int8_t>(dataValues, meanVals, stdValues, countOfValues, output->scale, output->zeroPoint, INT8_MIN, INT8_MAX, (int8_t *)output->data);
+		return AIFW_OK;
+	default:
+		AIFW_LOGE("[Error] Unknown data type %d", output->type);
+		return AIFW_INVALID_ARG;
+	}
+}
+
+AIFW_RESULT dequantizeData(const AITensor *input, float dataValues[], uint16_t countOfValues)
+{
+	if (!input || !input->data || !dataValues) {
+		AIFW_LOGE("[Error] Invalid argument, input %p data %p", input, dataValues);
+		return AIFW_INVALID_ARG;
+	}
+	if (countOfValues > input->count) {
+		AIFW_LOGE("[Error] count %d exceeds input count %d", countOfValues, input->count);
+		return AIFW_INVALID_ARG;
+	}
+	switch (input->type) {
+	case AIFW_DATA_FLOAT32:
+		memcpy(dataValues, input->data, countOfValues * sizeof(float));
+		return AIFW_OK;
+	case AIFW_DATA_INT16:
+		dequantizeValues<int16_t>((const int16_t *)input->data, input->scale, input->zeroPoint, countOfValues, dataValues);
+		return AIFW_OK;
+	case AIFW_DATA_INT8:
+		dequantizeValues<int8_t>((const int8_t *)input->data, input->scale, input->zeroPoint, countOfValues, dataValues);
+		return AIFW_OK;
+	default:
+		AIFW_LOGE("[Error] Unknown data type %d", input->type);
+		return AIFW_INVALID_ARG;
+	}
+}
+
+uint8_t getDataTypeSize(AIFW_DATA_TYPE type)
+{
+	switch (type) {
+	case AIFW_DATA_FLOAT32:
+		return sizeof(float);
+	case AIFW_DATA_INT16:
+		return sizeof(int16_t);
+	case AIFW_DATA_INT8:
+		return sizeof(int8_t);
+	default:
+		return 0;
+	}
+}
+
 AIFW_RESULT getMSE(float *realValues, float *predValues, int count, float *result)
 {
 	if (realValues == NULL) {
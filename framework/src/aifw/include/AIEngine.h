@@ -80,18 +80,29 @@ public:
 	 */
 	virtual AIFW_RESULT loadModel(const unsigned char *model) = 0;
 
+	/**
+	 * @brief Describes an input tensor of the model, so that it can be filled in place before invoke.
+	 * Pointer to values stays valid until the next invoke.
+	 * @param [in] index: Index of the input tensor.
+	 * @param [out] tensor: Type, quantization, count and values of the input tensor.
+	 * @return: AIFW_RESULT enum object. AIFW_NOT_SUPPORTED if input tensors can not be filled in place.
+	 */
+	virtual AIFW_RESULT getInputTensor(uint16_t index, AITensor *tensor) = 0;
+
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	/**
 	 * @brief Run the inference with the given inputData.
-	 * @param [in] inputData: Input data for model invoke.
-	 * @return: Void * pointer to output result data.
+	 * @param [in] inputData: Float input data for model invoke, converted to the type of input tensor.
+	 * NULL if input tensor was already filled through getInputTensor.
+	 * @return: Void * pointer to float output result data.
 	 */
 	virtual void *invoke(void *inputData) = 0;
 #else
 	/**
 	 * @brief Run the inference with the given inputData.
-	 * @param [in] inputData: Input data for model invoke.
-	 * @param [out] outputData: Pointer to Output Data for storing output of invoke.
+	 * @param [in] inputData: Float input data for model invoke, converted to the type of input tensors.
+	 * NULL if input tensors were already filled through getInputTensor.
+	 * @param [out] outputData: Pointer to float Output Data for storing output of invoke.
 	 * @return: AIFW_RESULT enum object.
 	 */
 	virtual AIFW_RESULT invoke(void *inputData, void *outputData) = 0;
@@ -112,6 +123,37 @@ public:
 	 * @return: AIFW_RESULT enum object.
 	 */
 	virtual AIFW_RESULT resetInferenceState(void) = 0;
+
+#ifdef CONFIG_AIFW_PROFILING
+	/**
+	 * @brief Gives time taken by every operator type of the model in invoke, since load or resetProfile.
+	 * @param [out] ops: Array filled with one entry per operator type.
+	 * @param [in,out] count: Capacity of ops as input, number of entries filled as output.
+	 * @return: AIFW_RESULT enum object. AIFW_NOT_SUPPORTED if the engine can not measure operators.
+	 */
+	virtual AIFW_RESULT getOpProfile(AIProfileTime *ops, uint16_t *count)
+	{
+		return AIFW_NOT_SUPPORTED;
+	}
+
+	/**
+	 * @brief Gives usage of the tensor arena of the model.
+	 * @param [out] usedBytes: Bytes of the arena used once the model is loaded.
+	 * @param [out] size: Size of the arena.
+	 * @return: AIFW_RESULT enum object. AIFW_NOT_SUPPORTED if the engine does not use an arena.
+	 */
+	virtual AIFW_RESULT getArenaUsage(uint32_t *usedBytes, uint32_t *size)
+	{
+		return AIFW_NOT_SUPPORTED;
+	}
+
+	/**
+	 * @brief Clears time of operators measured so far.
+	 */
+	virtual void resetProfile(void)
+	{
+	}
+#endif /* CONFIG_AIFW_PROFILING */
 };
 
 } /* namespace aifw */
@@ -0,0 +1,126 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/**
+ * @file AIModelScheduler.h
+ * @brief Runs data collection of all model services on one worker thread.
+ */
+
+#pragma once
+
+#include "tinyara/config.h"
+#include <pthread.h>
+#include <stdint.h>
+#include "aifw/aifw.h"
+
+namespace aifw {
+
+class AIModelService;
+
+/**
+ * @brief Scheduling state of a model service.
+ * Deadline of a period is the start of the next one, i.e. due + interval.
+ */
+struct AIScheduledService {
+	AIModelService *service;
+	uint16_t interval;
+	uint8_t priority;
+	bool running;
+	uint64_t due;
+	uint32_t missed;
+	AIScheduledService *next;
+};
+
+/**
+ * @class AIModelScheduler
+ * @brief Calls collect raw data listener of every started model service at its interval, on one worker thread.
+ * When several services are due, the one with the highest priority runs first, then the one with the earliest deadline.
+ * Worker is created when the first service is registered and exits once the last one is unregistered.
+ */
+class AIModelScheduler
+{
+public:
+	/**
+	 * @brief Gives the scheduler shared by all model services.
+	 */
+	static AIModelScheduler *getInstance(void);
+
+	/**
+	 * @brief Adds a model service in stopped state.
+	 * @param [in] service: Model service whose collect raw data listener is called.
+	 * @param [in] interval: Period in milliseconds.
+	 * @param [in] priority: Higher value runs first when several services are due.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT registerService(AIModelService *service, uint16_t interval, uint8_t priority);
+
+	/**
+	 * @brief Removes a model service. It waits while the listener of the service is running on the worker.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT unregisterService(AIModelService *service);
+
+	/**
+	 * @brief First period of the service starts now.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT startService(AIModelService *service);
+
+	/**
+	 * @brief Listener of the service is not called anymore until it is started again.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT stopService(AIModelService *service);
+
+	/**
+	 * @brief Changes period of the service, it is used from the next period.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT setInterval(AIModelService *service, uint16_t interval);
+
+	/**
+	 * @brief Changes priority of the service.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT setPriority(AIModelService *service, uint8_t priority);
+
+	/**
+	 * @brief Gives count of periods the service missed because the worker was busy after their deadline.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT getMissedCount(AIModelService *service, uint32_t *missed);
+
+	AIModelScheduler();
+	~AIModelScheduler();
+
+private:
+	static void *workerMain(void *arg);
+	void run(void);
+	AIFW_RESULT startWorker(void);
+	AIScheduledService *find(AIModelService *service);
+	AIScheduledService *pickNext(uint64_t now, uint64_t *wakeup);
+
+	pthread_mutex_t mLock;
+	pthread_cond_t mCond;
+	pthread_t mWorker;
+	bool mWorkerRunning;
+	AIScheduledService *mServices;
+	AIScheduledService *mCurrent;
+};
+
+} /* namespace aifw */
@@ -0,0 +1,95 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/**
+ * @file AIProfiler.h
+ * @brief Time measurement of inference stages and operators.
+ */
+
+#pragma once
+
+#include "tinyara/config.h"
+#include "aifw/aifw.h"
+
+#ifndef CONFIG_AIFW_PROFILING_MAX_OPS
+#define CONFIG_AIFW_PROFILING_MAX_OPS 32
+#endif
+
+/* Operators running inside another one, e.g. in a subgraph of WHILE */
+#define AIFW_PROFILING_MAX_DEPTH 4
+
+namespace aifw {
+
+/**
+ * @brief Gives current time of monotonic clock in microseconds, it wraps around.
+ */
+uint32_t getProfileTimeUs(void);
+
+/**
+ * @brief Adds time elapsed since 'since' to 'time'.
+ * @return: Current time, so that the next stage can be measured from it.
+ */
+uint32_t addProfileTime(AIProfileTime *time, uint32_t since);
+
+/**
+ * @class AIOpProfiler
+ * @brief Accumulates time taken by operators of a model by operator name.
+ * Names should live as long as the profiler, engines give static strings.
+ */
+class AIOpProfiler
+{
+public:
+	AIOpProfiler();
+
+	/**
+	 * @brief Marks start of an operator.
+	 * @return: Handle to give to end.
+	 */
+	uint32_t begin(const char *name);
+
+	/**
+	 * @brief Marks end of the operator started with handle, operators started after it are dropped.
+	 */
+	void end(uint32_t handle);
+
+	/**
+	 * @brief Marks end of the operator started last.
+	 */
+	void endLast(void);
+
+	/**
+	 * @brief Copies time of operators measured so far.
+	 * @param [out] ops: Array filled with one entry per operator name.
+	 * @param [in,out] count: Capacity of ops as input, number of entries filled as output.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT get(AIProfileTime *ops, uint16_t *count);
+
+	void reset(void);
+
+private:
+	AIProfileTime *find(const char *name);
+
+	AIProfileTime mOps[CONFIG_AIFW_PROFILING_MAX_OPS];
+	uint16_t mOpCount;
+	const char *mRunning[AIFW_PROFILING_MAX_DEPTH];
+	uint32_t mStart[AIFW_PROFILING_MAX_DEPTH];
+	uint16_t mDepth;
+};
+
+} /* namespace aifw */
@@ -40,6 +40,10 @@ namespace luci_interpreter
 }
 namespace aifw {
 
+#ifdef CONFIG_AIFW_PROFILING
+class ONERTMProfiler;
+#endif
+
 /**
  * @class ONERTM
  * @brief Class to perform AI operations using ONERT for Microcontroller
@@ -51,6 +55,7 @@ public:
 	~ONERTM();
 	AIFW_RESULT loadModel(const char *file);
 	AIFW_RESULT loadModel(const unsigned char *model);
+	AIFW_RESULT getInputTensor(uint16_t index, AITensor *tensor);
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	void *invoke(void *inputData);
 #else
@@ -58,12 +63,20 @@ public:
 	void getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList, uint16_t *outputSetCount, uint16_t **outputSizeList);
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 	AIFW_RESULT resetInferenceState(void);
+#ifdef CONFIG_AIFW_PROFILING
+	AIFW_RESULT getOpProfile(AIProfileTime *ops, uint16_t *count);
+	void resetProfile(void);
+#endif
 
 private:
 	AIFW_RESULT _loadModel(void);
 
 	char *mBuf;
+	const char *mModel;
 	std::shared_ptr<luci_interpreter::Interpreter> mInterpreter;
+#ifdef CONFIG_AIFW_PROFILING
+	std::shared_ptr<ONERTMProfiler> mProfiler;
+#endif
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	uint16_t mModelInputSize;
 	uint16_t mModelOutputSize;
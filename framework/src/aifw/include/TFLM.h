@@ -43,6 +43,10 @@ class ErrorReporter;
 
 namespace aifw {
 
+#ifdef CONFIG_AIFW_PROFILING
+class TFLMProfiler;
+#endif
+
 /**
  * @class TFLM
  * @brief Class to perform AI operations using Tensor Flow
@@ -54,6 +58,7 @@ public:
 	~TFLM();
 	AIFW_RESULT loadModel(const char *file);
 	AIFW_RESULT loadModel(const unsigned char *model);
+	AIFW_RESULT getInputTensor(uint16_t index, AITensor *tensor);
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	void *invoke(void *inputData);
 #else
@@ -61,25 +66,37 @@ public:
 	void getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList, uint16_t *outputSetCount, uint16_t **outputSizeList);
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 	AIFW_RESULT resetInferenceState(void);
+#ifdef CONFIG_AIFW_PROFILING
+	AIFW_RESULT getOpProfile(AIProfileTime *ops, uint16_t *count);
+	AIFW_RESULT getArenaUsage(uint32_t *usedBytes, uint32_t *size);
+	void resetProfile(void);
+#endif
 
 private:
 	AIFW_RESULT _loadModel(void);
 	void clearMemory(void);
 	AIFW_RESULT allocateMemory(void);
+	AIFW_RESULT describeTensor(TfLiteTensor *tfTensor, uint16_t count, AITensor *tensor);
+	float *readOutput(TfLiteTensor *output, uint16_t count, float *values);
 	size_t mTensorArenaSize;
 	std::shared_ptr<uint8_t> mTensorArena;
 	const tflite::Model *mModel;
 	char *mBuf;
 	std::shared_ptr<tflite::MicroInterpreter> mInterpreter;
 	std::shared_ptr<tflite::ErrorReporter> mErrorReporter;
+#ifdef CONFIG_AIFW_PROFILING
+	std::shared_ptr<TFLMProfiler> mProfiler;
+#endif
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	TfLiteTensor *mInput;
 	TfLiteTensor *mOutput;
+	float *mOutputValues;
 	uint16_t mModelInputSize;
 	uint16_t mModelOutputSize;
 #else
 	TfLiteTensor **mInputList;
 	TfLiteTensor **mOutputList;
+	float **mOutputValuesList;
 	uint16_t *mInputSizeList;
 	uint16_t *mOutputSizeList;
 	uint16_t mInputSetCount;
@@ -135,6 +135,13 @@ bool Decoder::getFrame(unsigned char *buf, size_t *size, unsigned int *sampleRat
 #endif
 }
 
+#ifdef CONFIG_AUDIO_CODEC
+void Decoder::setFrameCallback(audio_decoder_frame_callback_t callback, void *user)
+{
+	audio_decoder_set_frame_callback(&mDecoder, callback, user);
+}
+#endif
+
 bool Decoder::empty()
 {
 #ifdef CONFIG_AUDIO_CODEC
@@ -153,6 +160,22 @@ size_t Decoder::getAvailSpace()
 #endif
 }
 
+/* Number of channels of PCM frames output by getFrame(), which may differ from the source */
+unsigned short Decoder::getChannels()
+{
+#ifdef CONFIG_AUDIO_CODEC
+	return mChannels;
+#else
+	return 0;
+#endif
+}
+
+/* Bytes of each PCM sample output by getFrame() */
+size_t Decoder::getSampleWidth()
+{
+	return sizeof(int16_t);
+}
+
 #ifdef CONFIG_AUDIO_CODEC
 bool Decoder::mConfig(int audioType)
 {
@@ -43,6 +43,11 @@ public:
 	bool getFrame(unsigned char *buf, size_t *size, unsigned int *sampleRate, unsigned short *channels);
 	bool empty();
 	size_t getAvailSpace();
+	unsigned short getChannels();
+	size_t getSampleWidth();
+#ifdef CONFIG_AUDIO_CODEC
+	void setFrameCallback(audio_decoder_frame_callback_t callback, void *user);
+#endif
 
 private:
 #ifdef CONFIG_AUDIO_CODEC
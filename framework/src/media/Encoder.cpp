@@ -179,4 +179,13 @@ size_t Encoder::getAvailSpace()
 #endif
 }
 
+size_t Encoder::getMaxFrameSize()
+{
+#ifdef CONFIG_AUDIO_CODEC
+	return MAX_PACKET_SIZE;
+#else
+	return 0;
+#endif
+}
+
 } // namespace media
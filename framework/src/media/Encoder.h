@@ -43,6 +43,7 @@ public:
 	bool getFrame(unsigned char *buf, size_t *size);
 	bool empty();
 	size_t getAvailSpace();
+	size_t getMaxFrameSize();
 
 private:
 #ifdef CONFIG_AUDIO_CODEC
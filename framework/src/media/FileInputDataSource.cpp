@@ -19,9 +19,15 @@
 #include <tinyara/config.h>
 #include <stdio.h>
 #include <debug.h>
+#include <sys/stat.h>
 
 #include <media/FileInputDataSource.h>
 #include <media/MediaUtils.h>
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+#include "utils/frame_index.h"
+
+#define FRAME_INDEX_SUFFIX ".idx"
+#endif
 
 namespace media {
 namespace stream {
@@ -29,21 +35,24 @@ namespace stream {
 FileInputDataSource::FileInputDataSource() :
 	InputDataSource(),
 	mDataPath(""),
-	mFp(nullptr)
+	mFp(nullptr),
+	mFrameIndex(nullptr)
 {
 }
 
 FileInputDataSource::FileInputDataSource(const std::string &dataPath) :
 	InputDataSource(),
 	mDataPath(dataPath),
-	mFp(nullptr)
+	mFp(nullptr),
+	mFrameIndex(nullptr)
 {
 }
 
 FileInputDataSource::FileInputDataSource(const FileInputDataSource &source) :
 	InputDataSource(source),
 	mDataPath(source.mDataPath),
-	mFp(source.mFp)
+	mFp(source.mFp),
+	mFrameIndex(nullptr)
 {
 }
 
@@ -97,6 +106,7 @@ bool FileInputDataSource::open()
 			break;
 		}
 
+		openFrameIndex();
 		return true;
 	}
 
@@ -108,6 +118,7 @@ bool FileInputDataSource::close()
 {
 	bool ret = true;
 	if (mFp) {
+		closeFrameIndex();
 		if (fclose(mFp) == OK) {
 			mFp = nullptr;
 			medvdbg("close success!!\n");
@@ -168,11 +179,75 @@ int FileInputDataSource::seekTo(off_t offset)
 	return fseek(mFp, offset, SEEK_SET);
 }
 
+struct frame_index_s *FileInputDataSource::getFrameIndex()
+{
+	return mFrameIndex;
+}
+
+void FileInputDataSource::openFrameIndex()
+{
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+	// Index is kept until the source is destroyed, so reopening the file reuses it.
+	if (mFrameIndex) {
+		return;
+	}
+
+	switch (getAudioType()) {
+	case AUDIO_TYPE_MP3:
+	case AUDIO_TYPE_AAC:
+	case AUDIO_TYPE_OPUS:
+		break;
+	default:
+		/* Frame index is needed only for compressed audio */
+		return;
+	}
+
+	mFrameIndex = new frame_index_t;
+	if (!frame_index_init(mFrameIndex, CONFIG_MEDIA_FRAME_INDEX_INTERVAL_MS, CONFIG_MEDIA_FRAME_INDEX_MAX_ENTRIES)) {
+		meddbg("frame index init failed\n");
+		delete mFrameIndex;
+		mFrameIndex = nullptr;
+		return;
+	}
+
+#ifdef CONFIG_MEDIA_FRAME_INDEX_SIDECAR
+	struct stat st;
+	if (stat(mDataPath.c_str(), &st) == OK) {
+		std::string indexPath = mDataPath + FRAME_INDEX_SUFFIX;
+		if (frame_index_load(mFrameIndex, indexPath.c_str(), (uint32_t)st.st_size)) {
+			medvdbg("frame index loaded, entries : %u\n", mFrameIndex->count);
+		}
+	}
+#endif
+#endif
+}
+
+void FileInputDataSource::closeFrameIndex()
+{
+#if defined(CONFIG_MEDIA_FRAME_INDEX) && defined(CONFIG_MEDIA_FRAME_INDEX_SIDECAR)
+	if (!mFrameIndex || !mFrameIndex->dirty) {
+		return;
+	}
+
+	struct stat st;
+	if (stat(mDataPath.c_str(), &st) == OK) {
+		std::string indexPath = mDataPath + FRAME_INDEX_SUFFIX;
+		frame_index_save(mFrameIndex, indexPath.c_str(), (uint32_t)st.st_size);
+	}
+#endif
+}
+
 FileInputDataSource::~FileInputDataSource()
 {
 	if (isPrepared()) {
 		close();
 	}
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+	if (mFrameIndex) {
+		frame_index_free(mFrameIndex);
+		delete mFrameIndex;
+	}
+#endif
 }
 
 } // namespace stream
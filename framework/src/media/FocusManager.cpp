@@ -16,6 +16,7 @@
  *
  ******************************************************************/
 
+#include <tinyara/config.h>
 #include <media/FocusManager.h>
 #include <debug.h>
 namespace media {
@@ -125,7 +126,14 @@ int FocusManager::insertFocusElement(std::shared_ptr<FocusRequest> focusRequest,
 	/* If the policy of request is the highest prio */
 	if (FocusRequester::compare(*focusRequester, *(*iter))) {
 		if (isTransientRequest) {
+#ifdef CONFIG_AUDIO_MIXER
+			/* Both streams can be mixed, the mixer lowers the current one while the
+			 * transient one sounds, so it doesn't have to pause.
+			 */
+			mFocusList.front()->notify(FOCUS_LOSS_TRANSIENT_CAN_DUCK);
+#else
 			mFocusList.front()->notify(FOCUS_LOSS_TRANSIENT);
+#endif
 		} else {
 			mFocusList.front()->notify(FOCUS_LOSS);
 		}
@@ -19,6 +19,7 @@
 #include <tinyara/config.h>
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 #include <stdlib.h>
 #include <debug.h>
 #include <unistd.h>
@@ -45,23 +46,78 @@
 #define CONFIG_HTTPSOURCE_DOWNLOAD_STACKSIZE 8192
 #endif
 
+#ifndef CONFIG_HTTPSOURCE_READAHEAD_MS
+#define CONFIG_HTTPSOURCE_READAHEAD_MS 2000
+#endif
+
+#ifndef CONFIG_HTTPSOURCE_RANGE_MIN_SIZE
+#define CONFIG_HTTPSOURCE_RANGE_MIN_SIZE 16384
+#endif
+
+#ifndef CONFIG_HTTPSOURCE_RANGE_MAX_SIZE
+#define CONFIG_HTTPSOURCE_RANGE_MAX_SIZE 262144
+#endif
+
+#ifndef CONFIG_HTTPSOURCE_DOWNLOAD_RETRY
+#define CONFIG_HTTPSOURCE_DOWNLOAD_RETRY 3
+#endif
+
 namespace media {
 namespace stream {
 
-// Content-Type tag
+// Http header tags
+static const std::string TAG_STATUS_LINE = "HTTP/";
 static const std::string TAG_CONTENT_TYPE = "Content-Type:";
+static const std::string TAG_CONTENT_LENGTH = "Content-Length:";
+static const std::string TAG_CONTENT_RANGE = "Content-Range:";
+static const std::string TAG_ACCEPT_RANGES = "Accept-Ranges:";
+
+static const long HTTP_OK = 200;
+static const long HTTP_PARTIAL_CONTENT = 206;
+static const long HTTP_MULTIPLE_CHOICES = 300;
+static const long HTTP_RANGE_NOT_SATISFIABLE = 416;
 
 static const std::chrono::seconds WAIT_HEADER_TIMEOUT = std::chrono::seconds(3);
 static const std::chrono::seconds WAIT_DATA_TIMEOUT = std::chrono::seconds(3);
+static const std::chrono::milliseconds READ_RATE_PERIOD = std::chrono::milliseconds(1000);
+static const useconds_t RETRY_INTERVAL_US = 200 * 1000;
+
+// Only a 2xx response carries the stream, others (redirection, client or server error) fail it
+static bool isSuccessResponse(long status)
+{
+	return status >= HTTP_OK && status < HTTP_MULTIPLE_CHOICES;
+}
+
+// Get value of the header line if the field name matches tag, field names are case-insensitive.
+static bool getHeaderValue(const std::string &header, const std::string &tag, std::string &value)
+{
+	if (strncasecmp(header.c_str(), tag.c_str(), tag.length()) != 0) {
+		return false;
+	}
+
+	auto pos = header.find_first_not_of(' ', tag.length());
+	if (pos == std::string::npos) {
+		value.clear();
+		return true;
+	}
+
+	auto end = header.find_first_of("\r\n", pos);
+	value = header.substr(pos, end - pos);
+	return true;
+}
 
 HttpInputDataSource::HttpInputDataSource(const std::string &url)
-	: InputDataSource(), mUrl(url), mThread((pthread_t)0), mIsHeaderReceived(false), mIsDataReceived(false)
+	: InputDataSource(), mUrl(url), mThread((pthread_t)0), mIsHeaderReceived(false), mIsDataReceived(false),
+	mContentLength(-1), mAcceptRanges(false), mStatusCode(0), mRequestOffset(0), mDownloadOffset(0), mReadOffset(0),
+	mReadRate(0), mReadBytes(0)
 {
 	medvdbg("url: %s\n", mUrl.c_str());
 }
 
 HttpInputDataSource::HttpInputDataSource(const HttpInputDataSource &source)
-	: InputDataSource(source), mUrl(source.mUrl), mThread((pthread_t)0), mIsHeaderReceived(source.mIsHeaderReceived), mIsDataReceived(source.mIsDataReceived)
+	: InputDataSource(source), mUrl(source.mUrl), mThread((pthread_t)0), mIsHeaderReceived(source.mIsHeaderReceived), mIsDataReceived(source.mIsDataReceived),
+	mContentLength(-1), mAcceptRanges(false), mStatusCode(0), mRequestOffset(0), mDownloadOffset(0), mReadOffset(0),
+	mReadRate(0), mReadBytes(0)
 {
 }
 
@@ -107,27 +163,27 @@ bool HttpInputDataSource::open()
 	std::unique_lock<std::mutex> lock(mMutex);
 	mIsHeaderReceived = false;
 	mIsDataReceived = false;
-
-	pthread_attr_t attr;
-	pthread_attr_init(&attr);
-	pthread_attr_setstacksize(&attr, CONFIG_HTTPSOURCE_DOWNLOAD_STACKSIZE);
-	struct sched_param sparam;
-	sparam.sched_priority = 100;
-	pthread_attr_setschedparam(&attr, &sparam);
-
-	int iRet = pthread_create(&mThread, &attr, static_cast<pthread_startroutine_t>(workerMain), this);
-	if (iRet != OK) {
-		meddbg("Fail to create download thread, err:%d\n", iRet);
+	mContentLength = -1;
+	mAcceptRanges = false;
+	mDownloadOffset = 0;
+	mReadOffset = 0;
+	mReadRate = 0;
+	mReadBytes = 0;
+
+	if (!startWorker()) {
 		return false;
 	}
-	pthread_setname_np(mThread, "HttpSourceDownloader");
 
-	// wait for Content-Type header
-	if (!mCondv.wait_for(lock, WAIT_HEADER_TIMEOUT, [=]{ return mIsHeaderReceived; })) {
+	// wait for Content-Type header, or for the download to fail
+	if (!mCondv.wait_for(lock, WAIT_HEADER_TIMEOUT, [=]{ return mIsHeaderReceived || mBufferReader->isEndOfStream(); })) {
 		meddbg("download:: wait header timeout!\n");
 		mBufferWriter->setEndOfStream();
 		return false;
 	}
+	if (!mIsHeaderReceived) {
+		meddbg("download:: failed before the stream, response %ld\n", mStatusCode);
+		return false;
+	}
 
 	auto audioType = utils::getAudioTypeFromMimeType(mContentType);
 
@@ -135,11 +191,16 @@ bool HttpInputDataSource::open()
 	case AUDIO_TYPE_MP3:
 	case AUDIO_TYPE_AAC: {
 		// wait for audio stream data
-		if (!mCondv.wait_for(lock, WAIT_DATA_TIMEOUT, [=]{ return mIsDataReceived; })) {
+		if (!mCondv.wait_for(lock, WAIT_DATA_TIMEOUT, [=]{ return mIsDataReceived || mBufferReader->isEndOfStream(); })) {
 			meddbg("download:: wait audio data timeout!\n");
 			mBufferWriter->setEndOfStream();
 			return false;
 		}
+		if (!mIsDataReceived && mBufferReader->sizeOfData() == 0) {
+			// A short stream may end before enough data, it is parsed as it is
+			meddbg("download:: failed before audio data, response %ld\n", mStatusCode);
+			return false;
+		}
 
 		size_t templen = mBufferReader->sizeOfData();
 		unsigned char *tempbuf = new unsigned char[templen];
@@ -182,14 +243,7 @@ bool HttpInputDataSource::open()
 bool HttpInputDataSource::close()
 {
 	medvdbg("HttpInputDataSource::close enter\n");
-	if (mBufferWriter) {
-		mBufferWriter->setEndOfStream();
-	}
-
-	if (mThread != (pthread_t)0) {
-		pthread_join(mThread, NULL);
-		mThread = (pthread_t)0;
-	}
+	stopWorker();
 
 	mHttpStream = nullptr;
 	mStreamBuffer = nullptr;
@@ -222,10 +276,121 @@ ssize_t HttpInputDataSource::read(unsigned char *buf, size_t size)
 		rlen = mBufferReader->read(buf, size);
 	}
 
+	mReadOffset += rlen;
+	updateReadRate(rlen);
+
 	medvdbg("read size: %d\n", rlen);
 	return rlen;
 }
 
+int HttpInputDataSource::seekTo(off_t offset)
+{
+	if (!isPrepared()) {
+		meddbg("[line:%d] Fail : HttpInputDataSource is not prepared\n", __LINE__);
+		return EOF;
+	}
+
+	off_t contentLength;
+	bool acceptRanges;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		contentLength = mContentLength;
+		acceptRanges = mAcceptRanges;
+	}
+
+	if (offset < 0 || (contentLength >= 0 && offset > contentLength)) {
+		meddbg("invalid offset %lld, content length %lld\n", (long long)offset, (long long)contentLength);
+		return EOF;
+	}
+
+	// Data of the position was downloaded already, skip in place.
+	if (offset >= mReadOffset && (size_t)(offset - mReadOffset) <= mBufferReader->sizeOfData()) {
+		mReadOffset += mBufferReader->release((size_t)(offset - mReadOffset));
+		medvdbg("seek to %lld in buffer\n", (long long)offset);
+		return OK;
+	}
+
+	if (!acceptRanges) {
+		meddbg("server does not accept byte ranges, can not seek to %lld\n", (long long)offset);
+		return EOF;
+	}
+
+	// Stop current download, and restart from the offset.
+	stopWorker();
+	mStreamBuffer->reset();
+	mDownloadOffset = offset;
+	mReadOffset = offset;
+	mReadBytes = 0;
+
+	if (!startWorker()) {
+		mBufferWriter->setEndOfStream();
+		return EOF;
+	}
+
+	medvdbg("seek to %lld, download restarted\n", (long long)offset);
+	return OK;
+}
+
+bool HttpInputDataSource::startWorker()
+{
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_HTTPSOURCE_DOWNLOAD_STACKSIZE);
+	struct sched_param sparam;
+	sparam.sched_priority = 100;
+	pthread_attr_setschedparam(&attr, &sparam);
+
+	int iRet = pthread_create(&mThread, &attr, static_cast<pthread_startroutine_t>(workerMain), this);
+	if (iRet != OK) {
+		meddbg("Fail to create download thread, err:%d\n", iRet);
+		mThread = (pthread_t)0;
+		return false;
+	}
+	pthread_setname_np(mThread, "HttpSourceDownloader");
+	return true;
+}
+
+void HttpInputDataSource::stopWorker()
+{
+	// Writer stops at end-of-stream, then download is aborted in WriteCallback.
+	if (mBufferWriter) {
+		mBufferWriter->setEndOfStream();
+	}
+
+	if (mThread != (pthread_t)0) {
+		pthread_join(mThread, NULL);
+		mThread = (pthread_t)0;
+	}
+}
+
+void HttpInputDataSource::updateReadRate(size_t len)
+{
+	auto now = std::chrono::steady_clock::now();
+	if (mReadBytes == 0) {
+		mReadStart = now;
+	}
+	mReadBytes += len;
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - mReadStart);
+	if (elapsed >= READ_RATE_PERIOD) {
+		mReadRate = mReadBytes * 1000 / elapsed.count();
+		mReadBytes = 0;
+	}
+}
+
+size_t HttpInputDataSource::getRangeSize()
+{
+	// Request enough data to keep playing for the read-ahead time at the measured bitrate.
+	size_t size = mReadRate * CONFIG_HTTPSOURCE_READAHEAD_MS / 1000;
+	if (size < CONFIG_HTTPSOURCE_RANGE_MIN_SIZE) {
+		return CONFIG_HTTPSOURCE_RANGE_MIN_SIZE;
+	}
+	if (size > CONFIG_HTTPSOURCE_RANGE_MAX_SIZE) {
+		return CONFIG_HTTPSOURCE_RANGE_MAX_SIZE;
+	}
+	return size;
+}
+
 void HttpInputDataSource::onBufferOverrun()
 {
 }
@@ -256,17 +421,39 @@ size_t HttpInputDataSource::HeaderCallback(char *data, size_t size, size_t nmemb
 
 	size_t totalsize = size * nmemb;
 	std::string header(data, totalsize);
+	std::string value;
 	medvdbg("%s\n", header.c_str());
-	auto pos = header.find(TAG_CONTENT_TYPE);
-	if (pos != std::string::npos) {
-		pos = header.find_first_not_of(' ', pos + TAG_CONTENT_TYPE.length());
-		auto end = header.find((char)0x0d, pos); // CR: 0x0d
-		source->mContentType = header.substr(pos, end - pos);
+
+	if (header.compare(0, TAG_STATUS_LINE.length(), TAG_STATUS_LINE) == 0) {
+		// Status line starts each response, e.g. "HTTP/1.1 206 Partial Content"
+		auto pos = header.find(' ');
+		source->mStatusCode = (pos != std::string::npos) ? strtol(header.c_str() + pos + 1, NULL, 10) : 0;
+	} else if (!isSuccessResponse(source->mStatusCode)) {
+		// Headers of an error or redirection response don't describe the stream
+	} else if (getHeaderValue(header, TAG_CONTENT_TYPE, value)) {
+		source->mContentType = value;
 		if (!source->mIsHeaderReceived) {
 			std::lock_guard<std::mutex> lock(source->mMutex);
 			source->mIsHeaderReceived = true;
 			source->mCondv.notify_one();
 		}
+	} else if (getHeaderValue(header, TAG_CONTENT_RANGE, value)) {
+		// "bytes <start>-<end>/<length>", length is "*" if it is unknown
+		auto pos = value.find('/');
+		std::lock_guard<std::mutex> lock(source->mMutex);
+		source->mAcceptRanges = true;
+		if (pos != std::string::npos && value[pos + 1] != '*') {
+			source->mContentLength = (off_t)strtoll(value.c_str() + pos + 1, NULL, 10);
+		}
+	} else if (getHeaderValue(header, TAG_CONTENT_LENGTH, value)) {
+		// Length of a partial response is not the length of stream
+		if (source->mStatusCode == HTTP_OK) {
+			std::lock_guard<std::mutex> lock(source->mMutex);
+			source->mContentLength = (off_t)strtoll(value.c_str(), NULL, 10);
+		}
+	} else if (getHeaderValue(header, TAG_ACCEPT_RANGES, value)) {
+		std::lock_guard<std::mutex> lock(source->mMutex);
+		source->mAcceptRanges = (strncasecmp(value.c_str(), "bytes", 5) == 0);
 	}
 
 	return totalsize;
@@ -276,7 +463,21 @@ size_t HttpInputDataSource::WriteCallback(char *data, size_t size, size_t nmemb,
 {
 	auto source = static_cast<HttpInputDataSource *>(userp);
 	size_t totalsize = size * nmemb;
-	return source->mBufferWriter->write((unsigned char *)data, totalsize);
+
+	if (!isSuccessResponse(source->mStatusCode)) {
+		// Body of an error or redirection response is not a part of the stream
+		return totalsize;
+	}
+
+	if (source->mStatusCode == HTTP_OK && source->mRequestOffset != 0) {
+		// Server ignored the range and sends stream from the beginning
+		meddbg("range request from %lld is not accepted\n", (long long)source->mRequestOffset);
+		return 0;
+	}
+
+	size_t written = source->mBufferWriter->write((unsigned char *)data, totalsize);
+	source->mDownloadOffset += written;
+	return written;
 }
 
 void *HttpInputDataSource::workerMain(void *arg)
@@ -287,12 +488,85 @@ void *HttpInputDataSource::workerMain(void *arg)
 	//mHttpStream->addHeader("Icy-MetaData:1"); // not support now
 	source->mHttpStream->setHeaderCallback(HeaderCallback, arg);
 	source->mHttpStream->setWriteCallback(WriteCallback, arg);
-	if (!source->mHttpStream->download(source->mUrl)) {
-		medwdbg("download failed or terminated!\n");
-		// TODO: send network error code to upper layer later
+
+	int retry = 0;
+	while (!source->mBufferReader->isEndOfStream()) {
+		off_t start = source->mDownloadOffset;
+		off_t end = -1;
+#ifdef CONFIG_HTTPSOURCE_RANGE_REQUEST
+		end = start + (off_t)source->getRangeSize() - 1;
+#endif
+		{
+			std::lock_guard<std::mutex> lock(source->mMutex);
+			if (source->mContentLength >= 0) {
+				if (start >= source->mContentLength) {
+					break;
+				}
+				if (end >= source->mContentLength) {
+					end = source->mContentLength - 1;
+				}
+			}
+		}
+
+		source->mRequestOffset = start;
+		source->mStatusCode = 0;
+		source->mHttpStream->setRange((start == 0 && end < 0) ? -1 : start, end);
+		bool ret = source->mHttpStream->download(source->mUrl);
+
+		if (source->mBufferReader->isEndOfStream()) {
+			// Stopped by close() or seekTo()
+			break;
+		}
+
+		if (!ret) {
+			bool acceptRanges;
+			{
+				std::lock_guard<std::mutex> lock(source->mMutex);
+				acceptRanges = source->mAcceptRanges;
+			}
+			if (source->mDownloadOffset > start) {
+				retry = 0;
+			}
+			if (!acceptRanges || ++retry > CONFIG_HTTPSOURCE_DOWNLOAD_RETRY) {
+				medwdbg("download failed or terminated!\n");
+				// TODO: send network error code to upper layer later
+				break;
+			}
+			// Resume from where it was interrupted
+			medwdbg("download interrupted at %lld, retry %d\n", (long long)source->mDownloadOffset, retry);
+			usleep(RETRY_INTERVAL_US);
+			continue;
+		}
+		retry = 0;
+
+		long status = source->mHttpStream->getResponseCode();
+		if (!isSuccessResponse(status)) {
+			if (status == HTTP_RANGE_NOT_SATISFIABLE && start > 0) {
+				// No more data after start, when the length is unknown
+				medvdbg("download finished at %lld\n", (long long)start);
+			} else {
+				meddbg("download failed at %lld, response %ld\n", (long long)start, status);
+			}
+			break;
+		}
+
+		size_t speed = source->mHttpStream->getDownloadSpeed();
+		if (speed < source->mReadRate) {
+			medwdbg("download speed %u is lower than playback rate %u bytes/s\n", speed, (size_t)source->mReadRate);
+		}
+
+		if (status != HTTP_PARTIAL_CONTENT || end < 0 || source->mDownloadOffset <= end) {
+			// Whole stream was received, or server sent less than requested at the end of stream
+			break;
+		}
 	}
 
 	source->mBufferWriter->setEndOfStream();
+	{
+		// Wake open() up if the download ended before the stream
+		std::lock_guard<std::mutex> lock(source->mMutex);
+		source->mCondv.notify_one();
+	}
 	medvdbg("download thread exit!\n");
 	return NULL;
 }
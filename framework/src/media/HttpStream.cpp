@@ -19,6 +19,7 @@
 #include <curl/curl.h>
 #include <curl/easy.h>
 #include <debug.h>
+#include <stdio.h>
 
 #include "HttpStream.h"
 
@@ -48,7 +49,7 @@ std::shared_ptr<HttpStream> HttpStream::create()
 }
 
 HttpStream::HttpStream() :
-	mCurl(nullptr), mHttpHeaders(nullptr), mInitializeFlag(false)
+	mCurl(nullptr), mHttpHeaders(nullptr), mResponseCode(0), mInitializeFlag(false)
 {
 }
 
@@ -88,6 +89,34 @@ bool HttpStream::setReadCallback(CallbackFunc callback, void *userdata)
 	return true;
 }
 
+bool HttpStream::setRange(off_t start, off_t end)
+{
+	if (start < 0) {
+		SET_OPTION(mCurl, CURLOPT_RANGE, NULL);
+		return true;
+	}
+
+	char range[48];
+	if (end < 0) {
+		snprintf(range, sizeof(range), "%lld-", (long long)start);
+	} else {
+		snprintf(range, sizeof(range), "%lld-%lld", (long long)start, (long long)end);
+	}
+	// libcurl copies the string
+	SET_OPTION(mCurl, CURLOPT_RANGE, range);
+	return true;
+}
+
+size_t HttpStream::getDownloadSpeed()
+{
+	curl_off_t speed = 0;
+	if (curl_easy_getinfo(mCurl, CURLINFO_SPEED_DOWNLOAD_T, &speed) != CURLE_OK) {
+		return 0;
+	}
+
+	return (size_t)speed;
+}
+
 bool HttpStream::init()
 {
 	if (mInitializeCount == 0) {
@@ -135,16 +164,16 @@ bool HttpStream::perform()
 		SET_OPTION(mCurl, CURLOPT_HTTPHEADER, mHttpHeaders);
 	}
 
+	mResponseCode = 0;
 	CURLcode result = curl_easy_perform(mCurl);
 	if (result != CURLE_OK) {
 		meddbg("curl_easy_perform failed, result %d - %s\n", result, curl_easy_strerror(result));
 		return false;
 	}
 
-	long response_code = 0;
-	result = curl_easy_getinfo(mCurl, CURLINFO_RESPONSE_CODE, &response_code);
+	result = curl_easy_getinfo(mCurl, CURLINFO_RESPONSE_CODE, &mResponseCode);
 	if (result != CURLE_OK) {
-		meddbg("Get response failed! result[%d] response[%ld]\n", result, response_code);
+		meddbg("Get response failed! result[%d] response[%ld]\n", result, mResponseCode);
 		return false;
 	}
 
@@ -19,6 +19,7 @@
 #ifndef __MEDIA_HTTPSTREAM_H
 #define __MEDIA_HTTPSTREAM_H
 
+#include <sys/types.h>
 #include <chrono>
 #include <string>
 #include <curl/curl.h>
@@ -66,7 +67,13 @@ public:
 	bool setReadCallback(CallbackFunc callback, void *userdata);
 
 	/*
-	 * Sets the callback for uploading local data
+	 * Sets the byte range requested by the next download, [start, end].
+	 * end < 0 requests until the end of resource, start < 0 clears the range.
+	 */
+	bool setRange(off_t start, off_t end = -1);
+
+	/*
+	 * Downloads the resource of url, response data is passed to write callback
 	 */
 	bool download(const std::string &url);
 
@@ -75,6 +82,16 @@ public:
 	 */
 	bool upload(const std::string &url);
 
+	/*
+	 * Gets the http response code of the last transfer
+	 */
+	long getResponseCode() { return mResponseCode; }
+
+	/*
+	 * Gets the average download speed of the last transfer in bytes/second
+	 */
+	size_t getDownloadSpeed();
+
 private:
 	HttpStream();
 	bool init();
@@ -85,6 +102,8 @@ private:
 	CURL *mCurl;
 	// http level headers
 	curl_slist *mHttpHeaders;
+	// response code of the last transfer
+	long mResponseCode;
 
 	bool mInitializeFlag;
 	static int mInitializeCount;
@@ -21,11 +21,13 @@
 #include <debug.h>
 #include <pthread.h>
 #include <media/MediaUtils.h>
+#include <media/media_stats.h>
 
 #include "InputHandler.h"
 #include "MediaPlayerImpl.h"
 #include "Decoder.h"
 #include "Demuxer.h"
+#include "utils/frame_index.h"
 
 namespace media {
 namespace stream {
@@ -34,7 +36,15 @@ InputHandler::InputHandler() :
 	mDecoder(nullptr),
 	mState(BUFFER_STATE_EMPTY),
 	mTotalBytes(0),
-	mIsLooping(false)
+	mIsLooping(false),
+	mSourceBufferSize(0),
+	mDecodeOffset(0),
+	mDecodeMsec(0),
+	mSkipBytes(0)
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+	, mFrameIndex(nullptr),
+	mDecodedSamples(0)
+#endif
 {
 	mWorkerStackSize = CONFIG_INPUT_DATASOURCE_STACKSIZE;
 }
@@ -95,6 +105,9 @@ bool InputHandler::open()
 bool InputHandler::close()
 {
 	bool ret = StreamHandler::close();
+	// Worker is stopped, release the staging buffer
+	mSourceBuffer.reset();
+	mSourceBufferSize = 0;
 	// Terminate buffering
 	std::unique_lock<std::mutex> lock(mMutex);
 	mCondv.notify_one();
@@ -117,6 +130,54 @@ void InputHandler::setLoop(bool loop)
 	mIsLooping = loop;
 }
 
+bool InputHandler::seekTo(unsigned int msec)
+{
+	if (!mDecoder || mDemuxer) {
+		meddbg("seek is supported only for audio decoded without demuxer\n");
+		return false;
+	}
+
+	audio_type_t audioType = mInputDataSource->getAudioType();
+	unsigned int channels = mInputDataSource->getChannels();
+	unsigned int sampleRate = mInputDataSource->getSampleRate();
+
+	stop();
+	unregisterCodec();
+
+	// Start decoding from the nearest indexed frame, or from the start of source
+	off_t offset = 0;
+	unsigned int startMsec = 0;
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+	frame_index_t *index = mInputDataSource->getFrameIndex();
+	frame_index_entry_t entry;
+	if (index && frame_index_lookup(index, msec, &entry)) {
+		offset = (off_t)entry.offset;
+		startMsec = entry.msec;
+	}
+#endif
+	medvdbg("seek to %u msec, decode from %u msec, offset %d\n", msec, startMsec, (int)offset);
+
+	if (mInputDataSource->seekTo(offset) != OK) {
+		meddbg("seek data source failed! offset : %d\n", (int)offset);
+		return false;
+	}
+	// Pre-loaded data is at the start of source, it's read from source again.
+	mPreloadBuffer = nullptr;
+
+	if (!registerCodec(audioType, channels, sampleRate)) {
+		meddbg("register codec failed!\n");
+		return false;
+	}
+
+	mDecodeOffset = offset;
+	mDecodeMsec = startMsec;
+	// Decode from the frame before target, and drop PCM frames until target.
+	// They are counted in the layout of the decoder output, not of the source.
+	mSkipBytes = frame_index_skip_bytes(startMsec, msec, sampleRate, mDecoder->getChannels() * mDecoder->getSampleWidth());
+
+	return start();
+}
+
 void InputHandler::resetWorker()
 {
 	mState = BUFFER_STATE_EMPTY;
@@ -127,27 +188,25 @@ bool InputHandler::processWorker()
 {
 	size_t size = getAvailSpace();
 	if (size > 0) {
-		auto buf = new unsigned char[size];
+		if (!mDemuxer && !mDecoder) {
+			// PCM data, read from source into stream buffer in place.
+			return readToStreamBuffer(size);
+		}
+
+		auto buf = getSourceBuffer(size);
 		if (!buf) {
 			meddbg("run out of memory! size: 0x%x\n", size);
 			return false;
 		}
 
-		ssize_t readLen = readFromSource(buf, size);
+		ssize_t readLen = readFromSourceLooping(buf, size);
 		if (readLen <= 0) {
 			// Error occurred, or inputting finished
-			if (!mIsLooping) {
-				mBufferWriter->setEndOfStream();
-				delete[] buf;
-				return false;
-
-			}
-			/* If it is looping mode, then seek to 0 and readFromSource again */
-			if (mInputDataSource->seekTo(0) == OK) {
-				readLen = readFromSource(buf, size);
-			} else {
-				meddbg("seek failed!!\n");
-			}
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+			finishFrameIndex();
+#endif
+			mBufferWriter->setEndOfStream();
+			return false;
 		}
 
 		if (readLen > size) {
@@ -156,7 +215,6 @@ bool InputHandler::processWorker()
 		}
 
 		ssize_t writeLen = writeToStreamBuffer(buf, (size_t)readLen);
-		delete[] buf;
 		if (writeLen <= 0) {
 			meddbg("write to stream buffer failed!\n");
 			mBufferWriter->setEndOfStream();
@@ -167,6 +225,59 @@ bool InputHandler::processWorker()
 	return true;
 }
 
+bool InputHandler::readToStreamBuffer(size_t size)
+{
+	rb_span_t span[2];
+	size_t acquired = mBufferWriter->acquire(span, size, false);
+	if (acquired == 0) {
+		// No space, or EOS was set
+		return true;
+	}
+
+	size_t filled = 0;
+	ssize_t readLen = 0;
+	for (int i = 0; i < 2 && span[i].len > 0; i++) {
+		readLen = readFromSourceLooping((unsigned char *)span[i].buf, span[i].len);
+		if (readLen <= 0) {
+			break;
+		}
+
+		if ((size_t)readLen > span[i].len) {
+			meddbg("WARNING!! it read more larger than available space!! readLen : %d size : %d\n", readLen, span[i].len);
+			readLen = span[i].len;
+		}
+
+		filled += (size_t)readLen;
+		if ((size_t)readLen < span[i].len) {
+			// Data source has no more data at the moment
+			break;
+		}
+	}
+
+	if (filled > 0) {
+		mBufferWriter->commit(filled);
+	}
+
+	if (readLen <= 0) {
+		// Error occurred, or inputting finished
+		mBufferWriter->setEndOfStream();
+		return false;
+	}
+
+	return true;
+}
+
+unsigned char *InputHandler::getSourceBuffer(size_t size)
+{
+	// Reuse the staging buffer for compressed data, reallocate only if it grows.
+	if (size > mSourceBufferSize) {
+		mSourceBuffer.reset(new unsigned char[size]);
+		mSourceBufferSize = mSourceBuffer ? size : 0;
+	}
+
+	return mSourceBuffer.get();
+}
+
 void InputHandler::sleepWorker()
 {
 	bool bEOS = mBufferReader->isEndOfStream();
@@ -180,17 +291,22 @@ void InputHandler::sleepWorker()
 
 void InputHandler::setBufferState(buffer_state_t state)
 {
-	if (mState != state) {
-		mState = state;
-		if (state >= BUFFER_STATE_BUFFERED) {
-			// Notify buffering done
-			std::unique_lock<std::mutex> lock(mMutex);
-			mCondv.notify_one();
-		}
-		auto mp = getPlayer();
-		if (mp) {
-			mp->notifyObserver(PLAYER_OBSERVER_COMMAND_BUFFER_STATECHANGED, (int)state);
+	// Writer and reader may change the state at once, only the one which changed it notifies.
+	buffer_state_t prev = mState;
+	do {
+		if (prev == state) {
+			return;
 		}
+	} while (!mState.compare_exchange_strong(prev, state));
+
+	if (state >= BUFFER_STATE_BUFFERED) {
+		// Notify buffering done
+		std::unique_lock<std::mutex> lock(mMutex);
+		mCondv.notify_one();
+	}
+	auto mp = getPlayer();
+	if (mp) {
+		mp->notifyObserver(PLAYER_OBSERVER_COMMAND_BUFFER_STATECHANGED, (int)state);
 	}
 }
 
@@ -204,6 +320,7 @@ void InputHandler::onBufferOverrun()
 
 void InputHandler::onBufferUnderrun()
 {
+	media_stats_xrun(MEDIA_STATS_BUFFER);
 	auto mp = getPlayer();
 	if (mp) {
 		mp->notifyObserver(PLAYER_OBSERVER_COMMAND_BUFFER_UNDERRUN);
@@ -226,6 +343,7 @@ void InputHandler::onBufferUpdated(ssize_t change, size_t current)
 	} else {
 		setBufferState(BUFFER_STATE_BUFFERING);
 	}
+	media_stats_set_level(MEDIA_STATS_BUFFER, current);
 
 	if (change > 0) {
 		mTotalBytes += change;
@@ -273,6 +391,19 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 
 		size_t usedES = 0;
 		while (1) {
+			if (mDecoder) {
+				// Decode PCM data into stream buffer in place
+				ret = decodeToStreamBuffer(buffES, sizeES, &usedES);
+				if (ret < 0) {
+					return ret;
+				}
+				if (ret == 0) {
+					// want more data
+					break;
+				}
+				continue;
+			}
+
 			unsigned char *buffPCM = buf;
 			size_t sizePCM = used;
 			ret = getPCM(buffES, sizeES, &usedES, &buffPCM, &sizePCM);
@@ -296,6 +427,56 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 	return size;
 }
 
+ssize_t InputHandler::decodeToStreamBuffer(unsigned char *buf, size_t size, size_t *used)
+{
+	rb_span_t span[2];
+	if (mBufferWriter->acquire(span, mStreamBuffer->getBufferSize()) == 0) {
+		meddbg("End of writting!\n");
+		return EOF;
+	}
+
+	// PCM samples are written in whole, so only the even part of each region is used.
+	size_t decoded = 0;
+	ssize_t ret = 0;
+	if (span[0].len < 2 && span[1].len >= 2) {
+		// A single byte is left before the wrap-around. PCM is decoded after it,
+		// then its first byte is moved into that byte, so the stream stays contiguous.
+		unsigned char *buffPCM = (unsigned char *)span[1].buf;
+		size_t sizePCM = span[1].len;
+		ret = getPCM(buf, size, used, &buffPCM, &sizePCM);
+		if (ret > 0) {
+			*(unsigned char *)span[0].buf = buffPCM[0];
+			memmove(buffPCM, buffPCM + 1, (size_t)ret - 1);
+			decoded = (size_t)ret;
+		}
+	} else {
+		for (int i = 0; i < 2 && span[i].len >= 2; i++) {
+			unsigned char *buffPCM = (unsigned char *)span[i].buf;
+			size_t sizePCM = span[i].len;
+			ret = getPCM(buf, size, used, &buffPCM, &sizePCM);
+			if (ret <= 0) {
+				break;
+			}
+
+			decoded += (size_t)ret;
+			if ((size_t)ret < span[i].len) {
+				break;
+			}
+		}
+	}
+
+	if (decoded > 0) {
+		mBufferWriter->commit(decoded);
+	}
+
+	if (ret < 0) {
+		meddbg("getPCM failed! error: %d\n", ret);
+		return ret;
+	}
+
+	return (ssize_t)decoded;
+}
+
 bool InputHandler::registerCodec(audio_type_t audioType, unsigned int channels, unsigned int sampleRate)
 {
 	if (mDecoder) {
@@ -325,6 +506,17 @@ bool InputHandler::registerCodec(audio_type_t audioType, unsigned int channels,
 			return false;
 		}
 		mDecoder = decoder;
+		mDecodeOffset = 0;
+		mDecodeMsec = 0;
+		mSkipBytes = 0;
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+		// Record frame positions, only if they are offsets in source (no container)
+		mFrameIndex = mDemuxer ? nullptr : mInputDataSource->getFrameIndex();
+		mDecodedSamples = 0;
+		if (mFrameIndex) {
+			mDecoder->setFrameCallback(onFrameDecoded, this);
+		}
+#endif
 		return true;
 	}
 	case AUDIO_TYPE_PCM:
@@ -379,21 +571,64 @@ bool InputHandler::registerCodec(audio_type_t audioType, unsigned int channels,
 void InputHandler::unregisterCodec()
 {
 	mDecoder = nullptr;
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+	mFrameIndex = nullptr;
+#endif
 }
 
 size_t InputHandler::getDecodeFrames(unsigned char *buf, size_t *size)
 {
 	unsigned int sampleRate = 0;
 	unsigned short channels = 0;
+	size_t max = *size;
 
-	if (mDecoder->getFrame(buf, size, &sampleRate, &channels)) {
+	uint32_t start = media_stats_now();
+	while (mDecoder->getFrame(buf, size, &sampleRate, &channels)) {
 		medvdbg("size : %u samplerate : %d channels : %d\n", *size, sampleRate, channels);
+		media_stats_record(MEDIA_STATS_DECODE, start, *size, channels ? *size / (channels * sizeof(short)) : 0);
+		start = media_stats_now();
+		if (mSkipBytes == 0) {
+			return *size;
+		}
+
+		// Drop PCM data before the seek target
+		if (*size <= mSkipBytes) {
+			mSkipBytes -= *size;
+			*size = max;
+			continue;
+		}
+
+		*size -= mSkipBytes;
+		memmove(buf, buf + mSkipBytes, *size);
+		mSkipBytes = 0;
 		return *size;
 	}
 
 	return 0;
 }
 
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+void InputHandler::finishFrameIndex()
+{
+	if (mFrameIndex && mDecodeOffset == 0) {
+		// Decoded from the start to the end, the whole stream is indexed.
+		frame_index_set_complete(mFrameIndex);
+	}
+	// Decoding position is not an offset in source any more (e.g. source rewound by looping)
+	mFrameIndex = nullptr;
+}
+
+void InputHandler::onFrameDecoded(void *user, size_t offset, unsigned int samples, unsigned int sampleRate)
+{
+	auto handler = static_cast<InputHandler *>(user);
+	if (handler->mFrameIndex && sampleRate > 0) {
+		uint32_t msec = handler->mDecodeMsec + (uint32_t)(handler->mDecodedSamples * 1000 / sampleRate);
+		frame_index_add(handler->mFrameIndex, msec, (uint32_t)(handler->mDecodeOffset + offset));
+	}
+	handler->mDecodedSamples += samples;
+}
+#endif
+
 ssize_t InputHandler::getElementaryStream(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect)
 {
 	if (mDemuxer) {
@@ -485,6 +720,24 @@ size_t InputHandler::fetchData(unsigned char *buf, size_t size, size_t *used, un
 	return *expect;
 }
 
+ssize_t InputHandler::readFromSourceLooping(unsigned char *buf, size_t size)
+{
+	ssize_t readLen = readFromSource(buf, size);
+	if (readLen <= 0 && mIsLooping) {
+		/* If it is looping mode, then seek to 0 and readFromSource again */
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+		finishFrameIndex();
+#endif
+		if (mInputDataSource->seekTo(0) == OK) {
+			readLen = readFromSource(buf, size);
+		} else {
+			meddbg("seek failed!!\n");
+		}
+	}
+
+	return readLen;
+}
+
 ssize_t InputHandler::readFromSource(unsigned char *buf, size_t size)
 {
 	// Read from pre-loaded buffer
@@ -497,7 +750,12 @@ ssize_t InputHandler::readFromSource(unsigned char *buf, size_t size)
 		return (ssize_t)size;
 	}
 	// Read from data source
-	return mInputDataSource->read(buf, size);
+	uint32_t start = media_stats_now();
+	ssize_t readLen = mInputDataSource->read(buf, size);
+	if (readLen > 0) {
+		media_stats_record(MEDIA_STATS_SOURCE, start, (size_t)readLen, 0);
+	}
+	return readLen;
 }
 
 bool InputHandler::probeDataSource()
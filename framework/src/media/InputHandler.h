@@ -50,6 +50,7 @@ public:
 	bool close() override;
 	ssize_t read(unsigned char *buf, size_t size);
 	void setLoop(bool loop);
+	bool seekTo(unsigned int msec);
 	void setBufferState(buffer_state_t state);
 
 	virtual void onBufferOverrun() override;
@@ -76,6 +77,14 @@ private:
 	ssize_t getPCM(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect);
 	size_t fetchData(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect);
 	ssize_t readFromSource(unsigned char *buf, size_t size);
+	ssize_t readFromSourceLooping(unsigned char *buf, size_t size);
+	bool readToStreamBuffer(size_t size);
+	ssize_t decodeToStreamBuffer(unsigned char *buf, size_t size, size_t *used);
+	unsigned char *getSourceBuffer(size_t size);
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+	void finishFrameIndex();
+	static void onFrameDecoded(void *user, size_t offset, unsigned int samples, unsigned int sampleRate);
+#endif
 
 	std::mutex mMutex;
 	std::condition_variable mCondv;
@@ -85,8 +94,19 @@ private:
 	std::shared_ptr<Demuxer> mDemuxer;
 	std::weak_ptr<MediaPlayerImpl> mPlayer;
 	std::atomic<bool> mIsLooping;
-	buffer_state_t mState;
+	std::atomic<buffer_state_t> mState;
 	size_t mTotalBytes;
+	std::unique_ptr<unsigned char[]> mSourceBuffer;
+	size_t mSourceBufferSize;
+	/* Position in source where the decoder starts, and PCM bytes to drop before the seek target */
+	off_t mDecodeOffset;
+	unsigned int mDecodeMsec;
+	size_t mSkipBytes;
+#ifdef CONFIG_MEDIA_FRAME_INDEX
+	/* Frame index being recorded, nullptr if decoding position is not an offset in source */
+	struct frame_index_s *mFrameIndex;
+	uint64_t mDecodedSamples;
+#endif
 };
 } // namespace stream
 } // namespace media
@@ -87,6 +87,11 @@ player_result_t MediaPlayer::setVolume(uint8_t vol)
 	return mPMpImpl->setVolume(vol);
 }
 
+player_result_t MediaPlayer::setGain(uint8_t gain)
+{
+	return mPMpImpl->setGain(gain);
+}
+
 player_result_t MediaPlayer::setDataSource(std::unique_ptr<stream::InputDataSource> source)
 {
 	return mPMpImpl->setDataSource(std::move(source));
@@ -117,6 +122,16 @@ player_result_t MediaPlayer::setLooping(bool loop)
 	return mPMpImpl->setLooping(loop);
 }
 
+player_result_t MediaPlayer::setNextDataSource(std::unique_ptr<stream::InputDataSource> source)
+{
+	return mPMpImpl->setNextDataSource(std::move(source));
+}
+
+player_result_t MediaPlayer::seekTo(unsigned int msec)
+{
+	return mPMpImpl->seekTo(msec);
+}
+
 MediaPlayer::~MediaPlayer()
 {
 }
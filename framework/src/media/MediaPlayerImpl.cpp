@@ -18,12 +18,14 @@
 
 #include <media/MediaPlayer.h>
 #include <media/FocusManager.h>
+#include <media/media_stats.h>
 #include "PlayerWorker.h"
 #include "MediaPlayerImpl.h"
 
 #include <debug.h>
 #include <errno.h>
 #include "audio/audio_manager.h"
+#include "utils/remix.h"
 
 namespace media {
 
@@ -37,6 +39,10 @@ MediaPlayerImpl::MediaPlayerImpl(MediaPlayer &player) : mPlayer(player)
 	mBuffer = nullptr;
 	mBufSize = 0;
 	mPlaybackFinished = false;
+	mGain = REMIX_GAIN_UNITY;
+	mInputHandler = std::make_shared<stream::InputHandler>();
+	mPrerollThread = (pthread_t)0;
+	mPrerollResult = false;
 	stream_info_t *info;
 	int ret = stream_info_create(STREAM_TYPE_MEDIA, &info);
 	if (ret != OK) {
@@ -161,13 +167,13 @@ void MediaPlayerImpl::preparePlayer(player_result_t &ret)
 		return notifySync();
 	}
 
-	if (!mInputHandler.open()) {
+	if (!mInputHandler->open()) {
 		meddbg("MediaPlayer prepare fail : open fail\n");
 		ret = PLAYER_ERROR_FILE_OPEN_FAILED;
 		return notifySync();
 	}
 
-	auto source = mInputHandler.getDataSource();
+	auto source = mInputHandler->getDataSource();
 	if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
 							 source->getPcmFormat(), mStreamInfo->id) != AUDIO_MANAGER_SUCCESS) {
 		meddbg("MediaPlayer prepare fail : set_audio_stream_out fail\n");
@@ -182,6 +188,22 @@ void MediaPlayerImpl::preparePlayer(player_result_t &ret)
 		return notifySync();
 	}
 
+#ifdef CONFIG_AUDIO_MIXER
+	res = set_mixed_stream_out_policy(mStreamInfo->id, mStreamInfo->policy);
+	if (res != AUDIO_MANAGER_SUCCESS) {
+		meddbg("MediaPlayer prepare fail : set_mixed_stream_out_policy fail. res: %d\n", res);
+		ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+		return notifySync();
+	}
+
+	res = set_mixed_stream_out_gain(mStreamInfo->id, mGain);
+	if (res != AUDIO_MANAGER_SUCCESS) {
+		meddbg("MediaPlayer prepare fail : set_mixed_stream_out_gain fail. res: %d\n", res);
+		ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+		return notifySync();
+	}
+#endif
+
 	mBufSize = get_output_card_buffer_size();
 	if (mBufSize < 0) {
 		meddbg("MediaPlayer prepare fail : get_output_frames_byte_size fail\n");
@@ -203,6 +225,7 @@ void MediaPlayerImpl::preparePlayer(player_result_t &ret)
 	}
 
 	mCurState = PLAYER_STATE_READY;
+	prerollNextSource();
 	return notifySync();
 }
 
@@ -244,7 +267,7 @@ void MediaPlayerImpl::prepareAsyncPlayer()
 
 	mCurState = PLAYER_STATE_PREPARING;
 
-	if (!mInputHandler.doStandBy()) {
+	if (!mInputHandler->doStandBy()) {
 		meddbg("MediaPlayer prepare fail : doStandBy fail\n");
 		notifyObserver(PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 		return;
@@ -287,7 +310,10 @@ void MediaPlayerImpl::unpreparePlayer(player_result_t &ret)
 		return notifySync();
 	}
 
-	mInputHandler.close();
+	// A paused player is still held by the worker.
+	PlayerWorker::getWorker().removePlayer(shared_from_this());
+	clearNextSources();
+	mInputHandler->close();
 
 	if (mBuffer) {
 		delete[] mBuffer;
@@ -318,6 +344,7 @@ player_result_t MediaPlayerImpl::start()
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
+	media_stats_mark_start();
 	mpw.enQueue(&MediaPlayerImpl::startPlayer, shared_from_this());
 
 	return PLAYER_OK;
@@ -336,7 +363,7 @@ void MediaPlayerImpl::startPlayer()
 	}
 
 	if (mCurState == PLAYER_STATE_PAUSED) {
-		auto source = mInputHandler.getDataSource();
+		auto source = mInputHandler->getDataSource();
 		if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
 								 source->getPcmFormat(), mStreamInfo->id) != AUDIO_MANAGER_SUCCESS) {
 			meddbg("MediaPlayer startPlayer fail : set_audio_stream_out fail\n");
@@ -357,7 +384,7 @@ void MediaPlayerImpl::startPlayer()
 	}
 	medvdbg("MediaPlayer set output stream volume success\n");
 
-	mpw.setPlayer(shared_from_this());
+	mpw.addPlayer(shared_from_this());
 	mCurState = PLAYER_STATE_PLAYING;
 	mPlaybackFinished = false;
 	notifyObserver(PLAYER_OBSERVER_COMMAND_STARTED);
@@ -419,9 +446,13 @@ player_result_t MediaPlayerImpl::stopPlayback(bool drain)
 	}
 
 	mCurState = PLAYER_STATE_READY;
-	mpw.setPlayer(nullptr);
+	mpw.removePlayer(shared_from_this());
 
+#ifdef CONFIG_AUDIO_MIXER
+	audio_manager_result_t result = stop_mixed_stream_out(mStreamInfo->id, drain);
+#else
 	audio_manager_result_t result = stop_audio_stream_out(drain);
+#endif
 	if (result != AUDIO_MANAGER_SUCCESS) {
 		meddbg("stop_audio_stream_out failed ret : %d\n", result);
 		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
@@ -463,7 +494,6 @@ void MediaPlayerImpl::pausePlayer()
 		return;
 	}
 
-	PlayerWorker &mpw = PlayerWorker::getWorker();
 	if (mCurState != PLAYER_STATE_PLAYING) {
 		meddbg("%s Fail : invalid state mPlayer : %x\n", __func__, &mPlayer);
 		LOG_STATE_DEBUG(mCurState);
@@ -471,16 +501,17 @@ void MediaPlayerImpl::pausePlayer()
 		return;
 	}
 
+#ifdef CONFIG_AUDIO_MIXER
+	audio_manager_result_t result = pause_mixed_stream_out(mStreamInfo->id);
+#else
 	audio_manager_result_t result = pause_audio_stream_out();
+#endif
 	if (result != AUDIO_MANAGER_SUCCESS) {
 		meddbg("pause_audio_stream_in failed ret : %d\n", result);
 		notifyObserver(PLAYER_OBSERVER_COMMAND_PAUSE_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 		return;
 	}
 
-	auto prevPlayer = mpw.getPlayer();
-	auto curPlayer = shared_from_this();
-
 	mCurState = PLAYER_STATE_PAUSED;
 	notifyObserver(PLAYER_OBSERVER_COMMAND_PAUSED);
 }
@@ -642,6 +673,51 @@ void MediaPlayerImpl::setPlayerVolume(uint8_t vol, player_result_t &ret)
 	return notifySync();
 }
 
+player_result_t MediaPlayerImpl::setGain(uint8_t gain)
+{
+	player_result_t ret = PLAYER_OK;
+
+	if (gain > 100) {
+		meddbg("MediaPlayer setGain fail : invalid argument. gain %u\n", gain);
+		return PLAYER_ERROR_INVALID_PARAMETER;
+	}
+
+	std::unique_lock<std::mutex> lock(mCmdMtx);
+	medvdbg("MediaPlayer setGain\n");
+
+	PlayerWorker &mpw = PlayerWorker::getWorker();
+	if (!mpw.isAlive()) {
+		meddbg("PlayerWorker is not alive\n");
+		return PLAYER_ERROR_NOT_ALIVE;
+	}
+
+	mpw.enQueue(&MediaPlayerImpl::setPlayerGain, shared_from_this(), gain, std::ref(ret));
+	mSyncCv.wait(lock);
+
+	return ret;
+}
+
+void MediaPlayerImpl::setPlayerGain(uint8_t gain, player_result_t &ret)
+{
+	medvdbg("MediaPlayer Worker : setGain %u\n", gain);
+
+	mGain = (uint16_t)((gain * REMIX_GAIN_UNITY) / 100);
+#ifdef CONFIG_AUDIO_MIXER
+	// The mixer scales the stream while it sums the players, a prepared stream takes the gain at once.
+	if (mCurState >= PLAYER_STATE_READY) {
+		audio_manager_result_t result = set_mixed_stream_out_gain(mStreamInfo->id, mGain);
+		if (result != AUDIO_MANAGER_SUCCESS) {
+			meddbg("set_mixed_stream_out_gain failed gain : %u ret : %d\n", gain, result);
+			ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+			return notifySync();
+		}
+	}
+#endif
+
+	ret = PLAYER_OK;
+	return notifySync();
+}
+
 player_result_t MediaPlayerImpl::setDataSource(std::unique_ptr<stream::InputDataSource> source)
 {
 	player_result_t ret = PLAYER_OK;
@@ -677,8 +753,8 @@ void MediaPlayerImpl::setPlayerDataSource(std::shared_ptr<stream::InputDataSourc
 		return notifySync();
 	}
 
-	mInputHandler.setPlayer(shared_from_this());
-	mInputHandler.setInputDataSource(source);
+	mInputHandler->setPlayer(shared_from_this());
+	mInputHandler->setInputDataSource(source);
 	mCurState = PLAYER_STATE_CONFIGURED;
 
 	return notifySync();
@@ -753,6 +829,14 @@ void MediaPlayerImpl::setPlayerStreamInfo(std::shared_ptr<stream_info_t> stream_
 
 stream_focus_state_t MediaPlayerImpl::getStreamFocusState(void)
 {
+#ifdef CONFIG_AUDIO_MIXER
+	/* A player ducked by a transient focus owner keeps playing through the mixer,
+	 * it can still be paused or stopped.
+	 */
+	if (mCurState == PLAYER_STATE_PLAYING || mCurState == PLAYER_STATE_PAUSED) {
+		return STREAM_FOCUS_STATE_ACQUIRED;
+	}
+#endif
 	FocusManager &fm = FocusManager::getFocusManager();
 	stream_info_t stream_info = fm.getCurrentStreamInfo();
 	if (mStreamInfo->id == stream_info.id) {
@@ -811,10 +895,211 @@ void MediaPlayerImpl::setPlayerLooping(bool loop, player_result_t &ret)
 		LOG_STATE_DEBUG(mCurState);
 		ret = PLAYER_ERROR_INVALID_STATE;
 	}
-	mInputHandler.setLoop(loop);
+	mInputHandler->setLoop(loop);
+	notifySync();
+}
+
+player_result_t MediaPlayerImpl::seekTo(unsigned int msec)
+{
+	player_result_t ret = PLAYER_OK;
+
+	std::unique_lock<std::mutex> lock(mCmdMtx);
+	medvdbg("MediaPlayer seekTo mPlayer : %x msec : %u\n", &mPlayer, msec);
+
+	PlayerWorker &mpw = PlayerWorker::getWorker();
+
+	if (!mpw.isAlive()) {
+		meddbg("PlayerWorker is not alive\n");
+		return PLAYER_ERROR_NOT_ALIVE;
+	}
+
+	mpw.enQueue(&MediaPlayerImpl::seekPlayer, shared_from_this(), msec, std::ref(ret));
+	mSyncCv.wait(lock);
+
+	return ret;
+}
+
+void MediaPlayerImpl::seekPlayer(unsigned int msec, player_result_t &ret)
+{
+	medvdbg("seekPlayer\n");
+	if (mCurState != PLAYER_STATE_READY && mCurState != PLAYER_STATE_PLAYING && mCurState != PLAYER_STATE_PAUSED) {
+		meddbg("seekTo failed, Player not prepared!\n");
+		LOG_STATE_DEBUG(mCurState);
+		ret = PLAYER_ERROR_INVALID_STATE;
+		notifySync();
+		return;
+	}
+
+	// Playback runs in the same worker, so input is not read while seeking.
+	if (!mInputHandler->seekTo(msec)) {
+		meddbg("seekTo failed, msec : %u\n", msec);
+		ret = PLAYER_ERROR_INVALID_OPERATION;
+	}
 	notifySync();
 }
 
+player_result_t MediaPlayerImpl::setNextDataSource(std::unique_ptr<stream::InputDataSource> source)
+{
+	player_result_t ret = PLAYER_OK;
+
+	std::unique_lock<std::mutex> lock(mCmdMtx);
+	medvdbg("MediaPlayer setNextDataSource mPlayer : %x\n", &mPlayer);
+
+	PlayerWorker &mpw = PlayerWorker::getWorker();
+	if (!mpw.isAlive()) {
+		meddbg("PlayerWorker is not alive\n");
+		return PLAYER_ERROR_NOT_ALIVE;
+	}
+
+	std::shared_ptr<stream::InputDataSource> sharedDataSource = std::move(source);
+	mpw.enQueue(&MediaPlayerImpl::setPlayerNextDataSource, shared_from_this(), sharedDataSource, std::ref(ret));
+	mSyncCv.wait(lock);
+
+	return ret;
+}
+
+void MediaPlayerImpl::setPlayerNextDataSource(std::shared_ptr<stream::InputDataSource> source, player_result_t &ret)
+{
+	LOG_STATE_INFO(mCurState);
+
+	if (mCurState == PLAYER_STATE_NONE || mCurState == PLAYER_STATE_IDLE) {
+		meddbg("%s Fail : invalid state mPlayer : %x\n", __func__, &mPlayer);
+		LOG_STATE_DEBUG(mCurState);
+		ret = PLAYER_ERROR_INVALID_STATE;
+		return notifySync();
+	}
+
+	if (!source) {
+		meddbg("MediaPlayer setNextDataSource fail : invalid argument. DataSource should not be nullptr\n");
+		ret = PLAYER_ERROR_INVALID_PARAMETER;
+		return notifySync();
+	}
+
+	mNextSources.push_back(source);
+	prerollNextSource();
+	return notifySync();
+}
+
+void MediaPlayerImpl::prerollNextSource()
+{
+	if (mNextInputHandler || mNextSources.empty()) {
+		return;
+	}
+
+	if (mCurState != PLAYER_STATE_READY && mCurState != PLAYER_STATE_PLAYING && mCurState != PLAYER_STATE_PAUSED) {
+		return;
+	}
+
+	auto handler = std::make_shared<stream::InputHandler>();
+	handler->setInputDataSource(mNextSources.front());
+	mNextSources.pop_front();
+	mNextInputHandler = handler;
+
+	// Opening blocks until data is buffered, so do it aside from the playback.
+	mPrerollResult = false;
+
+	struct sched_param sparam;
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_MEDIA_PLAYER_PREROLL_STACKSIZE);
+	sparam.sched_priority = CONFIG_MEDIA_PLAYER_PREROLL_THREAD_PRIORITY;
+	pthread_attr_setschedparam(&attr, &sparam);
+	int ret = pthread_create(&mPrerollThread, &attr, static_cast<pthread_startroutine_t>(MediaPlayerImpl::prerollMain), this);
+	if (ret != OK) {
+		// The source is skipped when switching, as if it failed to open.
+		meddbg("Fail to create MediaPlayer preroll thread, return value : %d\n", ret);
+		mPrerollThread = (pthread_t)0;
+		return;
+	}
+	pthread_setname_np(mPrerollThread, "MediaPlayerPreroll");
+}
+
+void *MediaPlayerImpl::prerollMain(void *arg)
+{
+	auto player = static_cast<MediaPlayerImpl *>(arg);
+
+	// mNextInputHandler is not changed until the thread is joined.
+	medvdbg("MediaPlayer preroll thread enter\n");
+	player->mPrerollResult = player->mNextInputHandler->open();
+	medvdbg("MediaPlayer preroll thread exit, result : %d\n", (int)player->mPrerollResult);
+	return NULL;
+}
+
+void MediaPlayerImpl::joinPreroll()
+{
+	if (mPrerollThread != (pthread_t)0) {
+		pthread_join(mPrerollThread, NULL);
+		mPrerollThread = (pthread_t)0;
+	}
+}
+
+bool MediaPlayerImpl::switchToNextSource()
+{
+	while (mNextInputHandler) {
+		joinPreroll();
+		auto handler = mNextInputHandler;
+		mNextInputHandler = nullptr;
+
+		if (mPrerollResult) {
+			auto prev = mInputHandler->getDataSource();
+			auto next = handler->getDataSource();
+			bool reconfig = (prev->getChannels() != next->getChannels())
+							|| (prev->getSampleRate() != next->getSampleRate())
+							|| (prev->getPcmFormat() != next->getPcmFormat());
+
+			mInputHandler->close();
+			mInputHandler = handler;
+			mInputHandler->setPlayer(shared_from_this());
+
+			if (reconfig) {
+				// PCM format changed, output has to be set up again after the current data played out.
+				medvdbg("MediaPlayer reconfigure output for the next source\n");
+#ifdef CONFIG_AUDIO_MIXER
+				stop_mixed_stream_out(mStreamInfo->id, true);
+#else
+				stop_audio_stream_out(true);
+#endif
+				if (reset_audio_stream_out(mStreamInfo->id) != AUDIO_MANAGER_SUCCESS
+					|| set_audio_stream_out(next->getChannels(), next->getSampleRate(),
+											next->getPcmFormat(), mStreamInfo->id) != AUDIO_MANAGER_SUCCESS
+					|| set_stream_out_policy(mStreamInfo->policy) != AUDIO_MANAGER_SUCCESS
+#ifdef CONFIG_AUDIO_MIXER
+					|| set_mixed_stream_out_policy(mStreamInfo->id, mStreamInfo->policy) != AUDIO_MANAGER_SUCCESS
+					|| set_mixed_stream_out_gain(mStreamInfo->id, mGain) != AUDIO_MANAGER_SUCCESS
+#endif
+					|| set_output_stream_volume(mStreamInfo.get()) != AUDIO_MANAGER_SUCCESS) {
+					meddbg("MediaPlayer switch source fail : output reconfiguration fail\n");
+					notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
+					PlayerWorker &mpw = PlayerWorker::getWorker();
+					mpw.enQueue(&MediaPlayerImpl::stopPlayer, shared_from_this(), PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
+					return true;
+				}
+			}
+
+			prerollNextSource();
+			notifyObserver(PLAYER_OBSERVER_COMMAND_SOURCE_CHANGED);
+			return true;
+		}
+
+		// Skip the source failed to open, and try the following one.
+		meddbg("MediaPlayer preroll fail : open next source fail\n");
+		handler->close();
+		prerollNextSource();
+	}
+
+	return false;
+}
+
+void MediaPlayerImpl::clearNextSources()
+{
+	if (mNextInputHandler) {
+		joinPreroll();
+		mNextInputHandler->close();
+		mNextInputHandler = nullptr;
+	}
+	mNextSources.clear();
+}
+
 player_state_t MediaPlayerImpl::getState()
 {
 	medvdbg("MediaPlayer getState\n");
@@ -879,6 +1164,9 @@ void MediaPlayerImpl::notifyObserver(player_observer_command_t cmd, ...)
 			// Because data buffer would be released after this function returned.
 			mPlayerObserver->onPlaybackBufferDataReached(mPlayer, data, size);
 		} break;
+		case PLAYER_OBSERVER_COMMAND_SOURCE_CHANGED:
+			pow.enQueue(&MediaPlayerObserverInterface::onPlaybackSourceChanged, mPlayerObserver, mPlayer);
+			break;
 		case PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED:
 			player_error_t error = (player_error_t)va_arg(ap, int);
 			if (error != PLAYER_ERROR_NONE) {
@@ -906,7 +1194,7 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 	case PLAYER_EVENT_SOURCE_PREPARED: {
 		// Input handler has been opened successfully by InputHandler::doStandBy().
 		// Now setup audio manager and notify player observer the result.
-		auto source = mInputHandler.getDataSource();
+		auto source = mInputHandler->getDataSource();
 		if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
 								 source->getPcmFormat(), mStreamInfo->id) != AUDIO_MANAGER_SUCCESS) {
 			meddbg("MediaPlayer prepare fail : set_audio_stream_out fail\n");
@@ -931,6 +1219,8 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 		}
 
 		mCurState = PLAYER_STATE_READY;
+		// Called in the stand-by thread, pre-roll is started in PlayerWorker.
+		PlayerWorker::getWorker().enQueue(&MediaPlayerImpl::prerollNextSource, shared_from_this());
 		return notifyObserver(PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED, PLAYER_ERROR_NONE);
 	}
 
@@ -941,10 +1231,22 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 
 void MediaPlayerImpl::playback()
 {
-	ssize_t num_read = mInputHandler.read(mBuffer, (int)mBufSize);
+	ssize_t num_read = mInputHandler->read(mBuffer, (int)mBufSize);
 	medvdbg("num_read : %d player : %x\n", num_read, &mPlayer);
 	if (num_read > 0) {
-		int ret = start_audio_stream_out(mBuffer, get_user_output_bytes_to_frame((unsigned int)num_read));
+#ifdef CONFIG_AUDIO_MIXER
+		// Other players may have set the output since, so count frames of this source.
+		unsigned int frames = (unsigned int)num_read / (mInputHandler->getDataSource()->getChannels() * sizeof(int16_t));
+		int ret = start_mixed_stream_out(mStreamInfo->id, mBuffer, frames);
+#else
+		unsigned int frames = get_user_output_bytes_to_frame((unsigned int)num_read);
+		if (mGain != REMIX_GAIN_UNITY) {
+			// Scale the samples in place, the layout is kept.
+			uint32_t layout = ch2layout(mInputHandler->getDataSource()->getChannels());
+			remix(layout, layout, (const int16_t *)mBuffer, frames, (int16_t *)mBuffer, frames, mGain);
+		}
+		int ret = start_audio_stream_out(mBuffer, frames);
+#endif
 		if (ret < 0) {
 			notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 			PlayerWorker &mpw = PlayerWorker::getWorker();
@@ -960,6 +1262,10 @@ void MediaPlayerImpl::playback()
 			}
 		}
 	} else if (num_read == 0) {
+		if (switchToNextSource()) {
+			// Playback goes on with the next source, audio output is kept open.
+			return;
+		}
 		player_result_t errcode = stopPlayback(true);
 		mPlaybackFinished = true;
 		if (errcode != PLAYER_OK) {
@@ -992,5 +1298,8 @@ MediaPlayerImpl::~MediaPlayerImpl()
 			meddbg("~MediaPlayer fail : destroy fail\n");
 		}
 	}
+
+	// Pre-roll thread has to be joined even if unprepare failed.
+	clearNextSources();
 }
 } // namespace media
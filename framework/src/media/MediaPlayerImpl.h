@@ -20,8 +20,10 @@
 #define __MEDIA_MEDIAPLAYERIMPL_H
 
 #include <thread>
+#include <pthread.h>
 #include <mutex>
 #include <condition_variable>
+#include <deque>
 
 #include <media/MediaPlayer.h>
 #include <media/InputDataSource.h>
@@ -78,6 +80,7 @@ typedef enum player_observer_command_e {
 	PLAYER_OBSERVER_COMMAND_BUFFER_UPDATED,
 	PLAYER_OBSERVER_COMMAND_BUFFER_STATECHANGED,
 	PLAYER_OBSERVER_COMMAND_BUFFER_DATAREACHED,
+	PLAYER_OBSERVER_COMMAND_SOURCE_CHANGED,
 } player_observer_command_t;
 
 typedef enum player_event_e {
@@ -104,8 +107,10 @@ public:
 	player_result_t getStreamVolume(uint8_t *vol);
 	player_result_t getMaxVolume(uint8_t *vol);
 	player_result_t setVolume(uint8_t vol);
+	player_result_t setGain(uint8_t gain);
 
 	player_result_t setDataSource(std::unique_ptr<stream::InputDataSource>);
+	player_result_t setNextDataSource(std::unique_ptr<stream::InputDataSource>);
 	player_result_t setObserver(std::shared_ptr<MediaPlayerObserverInterface>);
 	player_result_t setStreamInfo(std::shared_ptr<stream_info_t> stream_info);
 
@@ -117,6 +122,7 @@ public:
 	void notifyAsync(player_event_t event);
 	void playback();
 	player_result_t setLooping(bool loop);
+	player_result_t seekTo(unsigned int msec);
 
 private:
 	void createPlayer(player_result_t &ret);
@@ -132,11 +138,19 @@ private:
 	void getPlayerStreamVolume(uint8_t *vol, player_result_t &ret);
 	void getPlayerMaxVolume(uint8_t *vol, player_result_t &ret);
 	void setPlayerVolume(uint8_t vol, player_result_t &ret);
+	void setPlayerGain(uint8_t gain, player_result_t &ret);
 	void setPlayerObserver(std::shared_ptr<MediaPlayerObserverInterface> observer);
 	void setPlayerDataSource(std::shared_ptr<stream::InputDataSource> dataSource, player_result_t &ret);
 	void setPlayerStreamInfo(std::shared_ptr<stream_info_t> stream_info, player_result_t &ret);
 	stream_focus_state_t getStreamFocusState(void);
 	void setPlayerLooping(bool loop, player_result_t &ret);
+	void seekPlayer(unsigned int msec, player_result_t &ret);
+	void setPlayerNextDataSource(std::shared_ptr<stream::InputDataSource> dataSource, player_result_t &ret);
+	void prerollNextSource();
+	static void *prerollMain(void *arg);
+	void joinPreroll();
+	bool switchToNextSource();
+	void clearNextSources();
 
 private:
 	MediaPlayer &mPlayer;
@@ -147,8 +161,16 @@ private:
 	std::mutex mCmdMtx;
 	std::condition_variable mSyncCv;
 	std::shared_ptr<stream_info_t> mStreamInfo;
+	uint16_t mGain;
 	std::shared_ptr<MediaPlayerObserverInterface> mPlayerObserver;
-	stream::InputHandler mInputHandler;
+	std::shared_ptr<stream::InputHandler> mInputHandler;
+	/* Sources queued to play after the current one. The first of them is
+	 * opened and decoded in advance by mNextInputHandler (pre-roll).
+	 */
+	std::deque<std::shared_ptr<stream::InputDataSource>> mNextSources;
+	std::shared_ptr<stream::InputHandler> mNextInputHandler;
+	pthread_t mPrerollThread;
+	std::atomic<bool> mPrerollResult;
 };
 } // namespace media
 #endif
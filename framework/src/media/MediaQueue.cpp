@@ -16,38 +16,153 @@
  *
  ******************************************************************/
 
+#include <debug.h>
 #include "MediaQueue.h"
 
 namespace media {
-MediaQueue::MediaQueue()
+MediaQueue::Task::Task() :
+	mInvoke(nullptr),
+	mManage(nullptr)
+{
+}
+
+MediaQueue::Task::Task(Task &&other) :
+	mInvoke(nullptr),
+	mManage(nullptr)
+{
+	*this = std::move(other);
+}
+
+MediaQueue::Task &MediaQueue::Task::operator=(Task &&other)
+{
+	if (this != &other) {
+		reset();
+		if (other.mInvoke) {
+			other.mManage(&mStorage, &other.mStorage);
+			mInvoke = other.mInvoke;
+			mManage = other.mManage;
+			other.mInvoke = nullptr;
+			other.mManage = nullptr;
+		}
+	}
+	return *this;
+}
+
+MediaQueue::Task::~Task()
+{
+	reset();
+}
+
+void MediaQueue::Task::reset()
+{
+	if (mInvoke) {
+		mManage(nullptr, &mStorage);
+		mInvoke = nullptr;
+		mManage = nullptr;
+	}
+}
+
+MediaQueue::MediaQueue() :
+	mHead(0),
+	mCount(0),
+	mMaxDepth(0),
+	mMaxLatency(0),
+	mOverflowCount(0),
+	mDropCount(0)
 {
 }
 MediaQueue::~MediaQueue()
 {
+	clearQueue();
+}
+
+MediaQueue::Slot *MediaQueue::acquireSlot(void)
+{
+	Slot *slot;
+
+	// Producers never wait for the consumer: a worker may queue to itself, or to
+	// a worker which is waiting for it. Once the ring is full, tasks take the
+	// preallocated overflow slots which follow it, in order.
+	if (mCount == MEDIA_QUEUE_CAPACITY) {
+		mDropCount++;
+		meddbg("queue and its overflow slots are full, drop the task! count : %u\n", mDropCount);
+		return nullptr;
+	}
+	if (mCount >= CONFIG_MEDIA_QUEUE_SIZE) {
+		mOverflowCount++;
+	}
+	slot = &mSlots[(mHead + mCount) % MEDIA_QUEUE_CAPACITY];
+	mCount++;
+
+	if (mCount > mMaxDepth) {
+		mMaxDepth = mCount;
+	}
+	return slot;
 }
 
-std::function<void()> MediaQueue::deQueue()
+void MediaQueue::deQueue(Task &task)
 {
 	std::unique_lock<std::mutex> lock(mQueueMtx);
-	if (mQueueData.empty()) {
+	while (mCount == 0) {
 		mQueueCv.wait(lock);
 	}
 
-	auto data = std::move(mQueueData.front());
-	mQueueData.pop();
-	return data;
+	Slot &slot = mSlots[mHead];
+	task = std::move(slot.task);
+	mHead = (mHead + 1) % MEDIA_QUEUE_CAPACITY;
+	mCount--;
+
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	long long latency = (long long)(now.tv_sec - slot.enqueued.tv_sec) * 1000000LL + (now.tv_nsec - slot.enqueued.tv_nsec) / 1000;
+	if (latency > (long long)mMaxLatency) {
+		mMaxLatency = (unsigned int)latency;
+	}
 }
 
 bool MediaQueue::isEmpty()
 {
 	std::unique_lock<std::mutex> lock(mQueueMtx);
-	return mQueueData.empty();
+	return mCount == 0;
 }
 
 void MediaQueue::clearQueue(void)
 {
 	std::unique_lock<std::mutex> lock(mQueueMtx);
-   	std::queue<std::function<void()>> empty;
-   	std::swap(mQueueData, empty);
+	while (mCount > 0) {
+		mSlots[mHead].task.reset();
+		mHead = (mHead + 1) % MEDIA_QUEUE_CAPACITY;
+		mCount--;
+	}
+}
+
+size_t MediaQueue::getDepth()
+{
+	std::unique_lock<std::mutex> lock(mQueueMtx);
+	return mCount;
+}
+
+size_t MediaQueue::getMaxDepth()
+{
+	std::unique_lock<std::mutex> lock(mQueueMtx);
+	return mMaxDepth;
+}
+
+unsigned int MediaQueue::getMaxLatency()
+{
+	std::unique_lock<std::mutex> lock(mQueueMtx);
+	return mMaxLatency;
+}
+
+unsigned int MediaQueue::getOverflowCount()
+{
+	std::unique_lock<std::mutex> lock(mQueueMtx);
+	return mOverflowCount;
+}
+
+unsigned int MediaQueue::getDropCount()
+{
+	std::unique_lock<std::mutex> lock(mQueueMtx);
+	return mDropCount;
 }
 } // namespace media
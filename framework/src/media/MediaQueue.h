@@ -19,32 +19,137 @@
 #ifndef __MEDIA_QUEUE_H
 #define __MEDIA_QUEUE_H
 
+#include <tinyara/config.h>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
 #include <atomic>
 #include <iostream>
 #include <functional>
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <pthread.h>
+#include <time.h>
+
+#ifndef CONFIG_MEDIA_QUEUE_SIZE
+#define CONFIG_MEDIA_QUEUE_SIZE 16
+#endif
+
+#ifndef CONFIG_MEDIA_QUEUE_OVERFLOW_SIZE
+#define CONFIG_MEDIA_QUEUE_OVERFLOW_SIZE 8
+#endif
+
+/* Overflow slots are preallocated after the ring, so queuing never allocates */
+#define MEDIA_QUEUE_CAPACITY (CONFIG_MEDIA_QUEUE_SIZE + CONFIG_MEDIA_QUEUE_OVERFLOW_SIZE)
+
+#ifndef CONFIG_MEDIA_QUEUE_TASK_SIZE
+#define CONFIG_MEDIA_QUEUE_TASK_SIZE 48
+#endif
 
 namespace media {
 class MediaQueue
 {
 public:
+	/**
+	 * Callable stored inline in a fixed-size buffer, so queuing a command never allocates.
+	 */
+	class Task
+	{
+	public:
+		Task();
+		Task(Task &&other);
+		Task &operator=(Task &&other);
+		Task(const Task &) = delete;
+		Task &operator=(const Task &) = delete;
+		~Task();
+
+		template <typename _Fn>
+		void set(_Fn &&fn) {
+			typedef typename std::decay<_Fn>::type Fn;
+			static_assert(sizeof(Fn) <= sizeof(Storage), "Task is too large, increase CONFIG_MEDIA_QUEUE_TASK_SIZE");
+			static_assert(alignof(Fn) <= alignof(Storage), "Task alignment is not supported");
+			reset();
+			new (&mStorage) Fn(std::forward<_Fn>(fn));
+			mInvoke = [](void *p) { (*static_cast<Fn *>(p))(); };
+			mManage = [](void *dst, void *src) {
+				if (dst) {
+					new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+				}
+				static_cast<Fn *>(src)->~Fn();
+			};
+		}
+		void reset();
+		void operator()() { mInvoke(&mStorage); }
+		explicit operator bool() const { return mInvoke != nullptr; }
+
+	private:
+		typedef typename std::aligned_storage<CONFIG_MEDIA_QUEUE_TASK_SIZE>::type Storage;
+		/* Invoke the callable stored in the buffer */
+		typedef void (*invoke_t)(void *);
+		/* Move the callable to 'dst' (if not null) and destroy the one in 'src' */
+		typedef void (*manage_t)(void *dst, void *src);
+
+		Storage mStorage;
+		invoke_t mInvoke;
+		manage_t mManage;
+	};
+
 	MediaQueue();
 	~MediaQueue();
+	/**
+	 * Queue a task, it never waits for the consumer.
+	 * Returns false if the task could not be stored, when the ring and its overflow slots are full.
+	 */
 	template <typename _Callable, typename... _Args>
-	void enQueue(_Callable &&__f, _Args &&... __args) {
+	bool enQueue(_Callable &&__f, _Args &&... __args) {
 		std::unique_lock<std::mutex> lock(mQueueMtx);
-		std::function<void()> func = std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...);
-		mQueueData.push(func);
-		mQueueCv.notify_one();
+		Slot *slot = acquireSlot();
+		if (!slot) {
+			return false;
+		}
+		slot->task.set(std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...));
+		clock_gettime(CLOCK_MONOTONIC, &slot->enqueued);
+		mQueueCv.notify_all();
+		return true;
 	}
-	std::function<void()> deQueue();
+	/**
+	 * Wait and pop the oldest task into 'task'.
+	 */
+	void deQueue(Task &task);
 	bool isEmpty();
 	void clearQueue(void);
+	/**
+	 * Number of tasks in queue now, and the maximum ever reached.
+	 */
+	size_t getDepth();
+	size_t getMaxDepth();
+	/**
+	 * Maximum time in microseconds a task waited between enQueue and dispatch.
+	 */
+	unsigned int getMaxLatency();
+	/**
+	 * Number of tasks stored in overflow slots, because the ring was full.
+	 */
+	unsigned int getOverflowCount();
+	/**
+	 * Number of tasks dropped, because the ring and its overflow slots were full.
+	 */
+	unsigned int getDropCount();
 
 private:
-	std::queue<std::function<void()>> mQueueData;
+	struct Slot {
+		Task task;
+		struct timespec enqueued;
+	};
+	Slot *acquireSlot(void);
+
+	Slot mSlots[MEDIA_QUEUE_CAPACITY];
+	size_t mHead;
+	size_t mCount;
+	size_t mMaxDepth;
+	unsigned int mMaxLatency;
+	unsigned int mOverflowCount;
+	unsigned int mDropCount;
 	std::condition_variable mQueueCv;
 	std::mutex mQueueMtx;
 };
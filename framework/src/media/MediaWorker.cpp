@@ -61,6 +61,7 @@ void MediaWorker::startWorker()
 			return;
 		}
 		pthread_setname_np(mWorkerThread, mThreadName);
+		media_stats_register_queue(mThreadName, MediaWorker::getQueueStats, this);
 	}
 }
 
@@ -77,13 +78,24 @@ void MediaWorker::stopWorker()
 			refBool = false;
 		});
 		pthread_join(mWorkerThread, NULL);
+		media_stats_unregister_queue(this);
 		medvdbg("%s::stopWorker() - mWorkerthread exited\n", mThreadName);
 	}
 }
 
-std::function<void()> MediaWorker::deQueue()
+void MediaWorker::getQueueStats(void *arg, struct media_stats_queue_s *stats)
 {
-	return mWorkerQueue.deQueue();
+	auto worker = static_cast<MediaWorker *>(arg);
+	stats->depth = worker->mWorkerQueue.getDepth();
+	stats->max_depth = worker->mWorkerQueue.getMaxDepth();
+	stats->max_latency_us = worker->mWorkerQueue.getMaxLatency();
+	stats->overflows = worker->mWorkerQueue.getOverflowCount();
+	stats->drops = worker->mWorkerQueue.getDropCount();
+}
+
+void MediaWorker::deQueue(MediaQueue::Task &task)
+{
+	mWorkerQueue.deQueue(task);
 }
 
 bool MediaWorker::processLoop()
@@ -104,9 +116,10 @@ void *MediaWorker::mediaLooper(void *arg)
 			pthread_yield();
 		}
 
-		std::function<void()> run = worker->deQueue();
+		MediaQueue::Task run;
+		worker->deQueue(run);
 		medvdbg("MediaWorker : deQueue\n");
-		if (run != nullptr) {
+		if (run) {
 			run();
 		}
 	}
@@ -23,6 +23,8 @@
 #include <atomic>
 #include <mutex>
 
+#include <media/media_stats.h>
+
 #include "MediaQueue.h"
 
 namespace media {
@@ -36,12 +38,13 @@ public:
 	void stopWorker();
 
 	template <typename _Callable, typename... _Args>
-	void enQueue(_Callable &&__f, _Args &&... __args) {
-		mWorkerQueue.enQueue(__f, __args...);
+	bool enQueue(_Callable &&__f, _Args &&... __args) {
+		return mWorkerQueue.enQueue(__f, __args...);
 	}
-	std::function<void()> deQueue();
+	void deQueue(MediaQueue::Task &task);
 	bool isAlive();
 	void clearQueue(void);
+	MediaQueue &getQueue() { return mWorkerQueue; }
 
 protected:
 	long mStacksize;
@@ -51,6 +54,7 @@ protected:
 
 private:
 	static void *mediaLooper(void *);
+	static void getQueueStats(void *arg, struct media_stats_queue_s *stats);
 
 	MediaQueue mWorkerQueue;
 	std::atomic<bool> mIsRunning;
@@ -54,6 +54,25 @@ OutputDataSource::~OutputDataSource()
 {
 }
 
+ssize_t OutputDataSource::writev(const struct iovec *iov, int iovcnt)
+{
+	ssize_t total = 0;
+	for (int i = 0; i < iovcnt; i++) {
+		if (iov[i].iov_len == 0) {
+			continue;
+		}
+		ssize_t written = write((unsigned char *)iov[i].iov_base, iov[i].iov_len);
+		if (written <= 0) {
+			return (total > 0) ? total : written;
+		}
+		total += written;
+		if ((size_t)written < iov[i].iov_len) {
+			break;
+		}
+	}
+	return total;
+}
+
 } // namespace stream
 } // namespace media
 
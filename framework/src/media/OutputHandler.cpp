@@ -20,17 +20,34 @@
 
 #include <pthread.h>
 #include <debug.h>
+#include <media/media_stats.h>
 
 #include "OutputHandler.h"
 #include "MediaRecorderImpl.h"
 
+#ifndef CONFIG_OUTPUT_DATASOURCE_THREAD_PRIORITY
+#define CONFIG_OUTPUT_DATASOURCE_THREAD_PRIORITY 100
+#endif
+
 namespace media {
 namespace stream {
 
 OutputHandler::OutputHandler() :
+#ifdef CONFIG_MEDIA_RECORDER_ENCODE_WORKER
+	mEncodeFrame(nullptr),
+	mEncodeFrameSize(0),
+	mEncodeWorker(0),
+	mIsEncodeWorkerAlive(false),
+	mIsEncoding(false),
+	mIsDroppingPCM(false),
+#endif
+#if CONFIG_OUTPUT_DATASOURCE_FLUSH_MSEC > 0
+	mIsDeadlineSet(false),
+#endif
 	mIsFlushing(false)
 {
 	mWorkerStackSize = CONFIG_OUTPUT_DATASOURCE_STACKSIZE;
+	mWorkerPriority = CONFIG_OUTPUT_DATASOURCE_THREAD_PRIORITY;
 }
 
 void OutputHandler::setOutputDataSource(std::shared_ptr<OutputDataSource> source)
@@ -52,6 +69,32 @@ ssize_t OutputHandler::write(unsigned char *buf, size_t size)
 		return (ssize_t)EOF;
 	}
 
+#ifdef CONFIG_MEDIA_RECORDER_ENCODE_WORKER
+	if (mIsEncodeWorkerAlive) {
+		if (mBufferReader->isEndOfStream()) {
+			// Output worker stopped on an error of output data source
+			return 0;
+		}
+		// Capture never waits for the encoder, PCM which doesn't fit the encoder queue is dropped.
+		size_t written = mPCMWriter->write(buf, size, false);
+		media_stats_set_level(MEDIA_STATS_CAPTURE, mPCMReader->sizeOfData());
+		if (written < size) {
+			media_stats_xrun(MEDIA_STATS_CAPTURE);
+			if (!mIsDroppingPCM) {
+				meddbg("Encoder queue is full, drop captured PCM %u/%u\n", size - written, size);
+				mIsDroppingPCM = true;
+				auto mr = getRecorder();
+				if (mr) {
+					mr->notifyObserver(RECORDER_OBSERVER_COMMAND_BUFFER_OVERRUN);
+				}
+			}
+		} else {
+			mIsDroppingPCM = false;
+		}
+		return (ssize_t)size;
+	}
+#endif
+
 	std::shared_ptr<Encoder> encoder = mEncoder;
 
 	size_t wlen = 0;
@@ -66,24 +109,9 @@ ssize_t OutputHandler::write(unsigned char *buf, size_t size)
 			}
 			wlen += pushed;
 
-			while (1) {
-				// Encoded data size is usually smaller than origin PCM data size,
-				// So we can reuse 'wlen' bytes free space in 'buf'.
-				// Process encoding and get encoded data.
-				size_t ret = wlen;
-				if (!encoder->getFrame(buf, &ret)) {
-					// Normal case, break and continue to push more PCM data
-					break;
-				}
-
-				// Write encoded data to output stream.
-				ssize_t written = writeToStreamBuffer(buf, ret);
-				medvdbg("written size: %d\n", written);
-				if (written != (ssize_t)ret) {
-					meddbg("Can not write all!\n");
-					break;
-				}
-			}
+			// Encoded data size is usually smaller than origin PCM data size,
+			// So we can reuse 'wlen' bytes free space in 'buf'.
+			drainEncoder(encoder, buf, wlen);
 		} else {
 			// No... Write original PCM data to output stream.
 			wlen += writeToStreamBuffer(buf + wlen, size - wlen);
@@ -96,9 +124,63 @@ ssize_t OutputHandler::write(unsigned char *buf, size_t size)
 	return (ssize_t)wlen;
 }
 
+// Get all encoded frames and write them to output stream, 'buf' of 'size' bytes takes a frame
+// when there's no contiguous space for it in the stream buffer.
+void OutputHandler::drainEncoder(std::shared_ptr<Encoder> encoder, unsigned char *buf, size_t size)
+{
+	while (1) {
+		// If there's enough contiguous space, encode into stream buffer in place.
+		rb_span_t span[2];
+		size_t maxFrameSize = encoder->getMaxFrameSize();
+		if (maxFrameSize > 0 && mBufferWriter && mBufferWriter->acquire(span, maxFrameSize, false) == maxFrameSize && span[0].len == maxFrameSize) {
+			size_t ret = maxFrameSize;
+			if (!encoder->getFrame((unsigned char *)span[0].buf, &ret)) {
+				// Normal case, break and continue to push more PCM data
+				break;
+			}
+			mBufferWriter->commit(ret);
+			medvdbg("written size: %u\n", ret);
+			continue;
+		}
+
+		// Process encoding and get encoded data.
+		size_t ret = size;
+		if (!encoder->getFrame(buf, &ret)) {
+			// Normal case, break and continue to push more PCM data
+			break;
+		}
+
+		// Write encoded data to output stream.
+		ssize_t written = writeToStreamBuffer(buf, ret);
+		medvdbg("written size: %d\n", written);
+		if (written != (ssize_t)ret) {
+			meddbg("Can not write all!\n");
+			break;
+		}
+	}
+}
+
+bool OutputHandler::start()
+{
+	medvdbg("OutputHandler::start()\n");
+	if (!StreamHandler::start()) {
+		return false;
+	}
+#ifdef CONFIG_MEDIA_RECORDER_ENCODE_WORKER
+	if (mEncoder && !createEncodeWorker()) {
+		StreamHandler::stop();
+		return false;
+	}
+#endif
+	return true;
+}
+
 bool OutputHandler::stop()
 {
 	medvdbg("OutputHandler::stop()\n");
+#ifdef CONFIG_MEDIA_RECORDER_ENCODE_WORKER
+	destroyEncodeWorker();
+#endif
 	return StreamHandler::stop();
 }
 
@@ -106,6 +188,11 @@ void OutputHandler::flush()
 {
 	medvdbg("OutputHandler::flush() enter\n");
 
+#ifdef CONFIG_MEDIA_RECORDER_ENCODE_WORKER
+	// Captured PCM should be encoded before flushing the stream buffer
+	flushEncodeWorker();
+#endif
+
 	if (mIsWorkerAlive) {
 		std::unique_lock<std::mutex> lock(mFlushMutex);
 		mIsFlushing = true;
@@ -120,26 +207,47 @@ void OutputHandler::resetWorker()
 {
 	std::unique_lock<std::mutex> lock(mFlushMutex);
 	mIsFlushing = false;
+#if CONFIG_OUTPUT_DATASOURCE_FLUSH_MSEC > 0
+	mIsDeadlineSet = false;
+#endif
 }
 
 void OutputHandler::writeToSource(size_t size)
 {
-	auto buf = new unsigned char[size];
-	auto readed = mBufferReader->read(buf, size);
-	if (readed != size) {
-		meddbg("StreamBufferReader::read failed! size : %u, readed : %u\n", size, readed);
-		delete[] buf;
+	// Write data to output data source in place, without copying into a temporary buffer.
+	// Both spans of the ring go in one batch, e.g. one sendmsg of a socket.
+	rb_span_t span[2];
+	auto acquired = mBufferReader->acquire(span, size, false);
+	if (acquired != size) {
+		meddbg("StreamBufferReader::acquire failed! size : %u, acquired : %u\n", size, acquired);
 		return;
 	}
 
-	auto written = mOutputDataSource->write(buf, size);
+	struct iovec iov[2];
+	int iovcnt = 0;
+	for (int i = 0; i < 2 && span[i].len > 0; i++) {
+		iov[iovcnt].iov_base = span[i].buf;
+		iov[iovcnt].iov_len = span[i].len;
+		iovcnt++;
+	}
+
+	uint32_t start = media_stats_now();
+	auto written = mOutputDataSource->writev(iov, iovcnt);
 	if (written <= 0) {
 		// Error occurred, stop outputting
-		meddbg("OutputDataSource::write returned <= 0! size : %u, written : %d\n", size, written);
+		meddbg("OutputDataSource::writev returned <= 0! size : %u, written : %d\n", acquired, written);
 		mBufferWriter->setEndOfStream();
+	} else {
+		media_stats_record(MEDIA_STATS_SINK, start, (size_t)written, 0);
+		if ((size_t)written < acquired) {
+			meddbg("OutputDataSource::writev wrote partially, size : %u, written : %d\n", acquired, written);
+		}
 	}
 
-	delete[] buf;
+	mBufferReader->release(acquired);
+#if CONFIG_OUTPUT_DATASOURCE_FLUSH_MSEC > 0
+	mIsDeadlineSet = false;
+#endif
 }
 
 bool OutputHandler::processWorker()
@@ -155,6 +263,12 @@ bool OutputHandler::processWorker()
 	} else if (size >= this->mStreamBuffer->getThreshold()) {
 		this->writeToSource(size);
 	}
+#if CONFIG_OUTPUT_DATASOURCE_FLUSH_MSEC > 0
+	else if (size > 0 && this->mIsDeadlineSet && std::chrono::steady_clock::now() >= this->mFlushDeadline) {
+		// Don't hold data of a slow stream, e.g. a pause of speech, longer than the deadline
+		this->writeToSource(size);
+	}
+#endif
 
 	return true;
 }
@@ -163,12 +277,26 @@ void OutputHandler::sleepWorker()
 {
 	size_t spaces = mBufferWriter->sizeOfSpace();
 	if (spaces > 0 && !mIsFlushing) {
+#if CONFIG_OUTPUT_DATASOURCE_FLUSH_MSEC > 0
+		// Deadline starts with the oldest data which is not written yet
+		if (!mIsDeadlineSet && mBufferReader->sizeOfData() > 0) {
+			mFlushDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CONFIG_OUTPUT_DATASOURCE_FLUSH_MSEC);
+			mIsDeadlineSet = true;
+		}
+		if (mIsDeadlineSet) {
+			if (std::chrono::steady_clock::now() < mFlushDeadline) {
+				StreamHandler::sleepWorkerUntil(mFlushDeadline);
+			}
+			return;
+		}
+#endif
 		StreamHandler::sleepWorker();
 	}
 }
 
 void OutputHandler::onBufferOverrun()
 {
+	media_stats_xrun(MEDIA_STATS_SINK);
 	auto mr = getRecorder();
 	if (mr) {
 		mr->notifyObserver(RECORDER_OBSERVER_COMMAND_BUFFER_OVERRUN);
@@ -186,10 +314,20 @@ void OutputHandler::onBufferUnderrun()
 void OutputHandler::onBufferUpdated(ssize_t change, size_t current)
 {
 	medvdbg("OutputHandler::onBufferUpdated(%d, %u)\n", change, current);
-	if (change > 0) {
-		// Writing wake worker up
+	media_stats_set_level(MEDIA_STATS_SINK, current);
+	if (change <= 0) {
+		return;
+	}
+	// Writing wakes worker up once there's a batch to write out,
+	// or to start the flush deadline of the first data after the buffer got empty.
+	if (current >= mStreamBuffer->getThreshold()) {
+		wakenWorker();
+	}
+#if CONFIG_OUTPUT_DATASOURCE_FLUSH_MSEC > 0
+	else if (current == (size_t)change) {
 		wakenWorker();
 	}
+#endif
 }
 
 ssize_t OutputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
@@ -231,6 +369,16 @@ bool OutputHandler::registerCodec(audio_type_t audioType, unsigned int channels,
 void OutputHandler::unregisterCodec()
 {
 	mEncoder = nullptr;
+#ifdef CONFIG_MEDIA_RECORDER_ENCODE_WORKER
+	mPCMBuffer = nullptr;
+	mPCMReader = nullptr;
+	mPCMWriter = nullptr;
+	if (mEncodeFrame) {
+		delete[] mEncodeFrame;
+		mEncodeFrame = nullptr;
+	}
+	mEncodeFrameSize = 0;
+#endif
 }
 
 bool OutputHandler::probeDataSource()
@@ -239,5 +387,134 @@ bool OutputHandler::probeDataSource()
 	return true;
 }
 
+#ifdef CONFIG_MEDIA_RECORDER_ENCODE_WORKER
+bool OutputHandler::createEncodeWorker()
+{
+	if (mIsEncodeWorkerAlive) {
+		return true;
+	}
+
+	if (!mPCMBuffer) {
+		auto streamBuffer = StreamBuffer::Builder()
+								.setBufferSize(CONFIG_MEDIA_RECORDER_ENCODE_BUFFER_SIZE)
+								.setThreshold(CONFIG_MEDIA_RECORDER_ENCODE_BUFFER_SIZE / 2)
+#ifdef CONFIG_HANDLER_STREAM_BUFFER_LOCKFREE
+								.setLockFree(true)
+#endif
+								.build();
+		if (!streamBuffer) {
+			meddbg("PCM streamBuffer is nullptr!\n");
+			return false;
+		}
+		mPCMBuffer = streamBuffer;
+		mPCMReader = std::make_shared<StreamBufferReader>(mPCMBuffer);
+		mPCMWriter = std::make_shared<StreamBufferWriter>(mPCMBuffer);
+	}
+
+	if (!mEncodeFrame) {
+		mEncodeFrameSize = mEncoder->getMaxFrameSize();
+		mEncodeFrame = new unsigned char[mEncodeFrameSize];
+		if (!mEncodeFrame) {
+			meddbg("Fail to allocate encoded frame buffer, size : %u\n", mEncodeFrameSize);
+			mEncodeFrameSize = 0;
+			return false;
+		}
+	}
+
+	mPCMBuffer->reset();
+	mIsEncoding = false;
+	mIsDroppingPCM = false;
+	mIsEncodeWorkerAlive = true;
+
+	struct sched_param sparam;
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_MEDIA_RECORDER_ENCODE_STACKSIZE);
+	sparam.sched_priority = CONFIG_MEDIA_RECORDER_ENCODE_THREAD_PRIORITY;
+	pthread_attr_setschedparam(&attr, &sparam);
+	int ret = pthread_create(&mEncodeWorker, &attr, static_cast<pthread_startroutine_t>(OutputHandler::encodeWorkerMain), this);
+	if (ret != OK) {
+		meddbg("Fail to create Encoder Worker thread, return value : %d\n", ret);
+		mIsEncodeWorkerAlive = false;
+		return false;
+	}
+	pthread_setname_np(mEncodeWorker, "RecorderEncoder");
+	return true;
+}
+
+void OutputHandler::destroyEncodeWorker()
+{
+	if (mIsEncodeWorkerAlive) {
+		mIsEncodeWorkerAlive = false;
+		// Worker may be blocked in reading PCM, or in writing to the stream buffer,
+		// which is unblocked by the end of stream set when the output worker stops.
+		mPCMWriter->setEndOfStream();
+		StreamHandler::stop();
+		pthread_join(mEncodeWorker, NULL);
+	}
+}
+
+void OutputHandler::flushEncodeWorker()
+{
+	std::unique_lock<std::mutex> lock(mEncodeMutex);
+	while (mIsEncodeWorkerAlive && (mIsEncoding || mPCMReader->sizeOfData() > 0)) {
+		mEncodeCondv.wait(lock);
+	}
+}
+
+void OutputHandler::encode(unsigned char *buf, size_t size)
+{
+	std::shared_ptr<Encoder> encoder = mEncoder;
+	size_t wlen = 0;
+
+	while (wlen < size) {
+		uint32_t start = media_stats_now();
+		size_t pushed = encoder->pushData(buf + wlen, size - wlen);
+		if (pushed == 0) {
+			meddbg("Can not push any data! Error occurred during encoding!\n");
+			media_stats_xrun(MEDIA_STATS_ENCODE);
+			break;
+		}
+		wlen += pushed;
+		drainEncoder(encoder, mEncodeFrame, mEncodeFrameSize);
+		media_stats_record(MEDIA_STATS_ENCODE, start, pushed, 0);
+	}
+}
+
+void *OutputHandler::encodeWorkerMain(void *arg)
+{
+	medvdbg("OutputHandler::encodeWorkerMain()\n");
+
+	auto handler = static_cast<OutputHandler *>(arg);
+	rb_span_t span[2];
+
+	while (handler->mIsEncodeWorkerAlive) {
+		// Wait for captured PCM, or end of stream set by stop
+		size_t size = handler->mPCMReader->acquire(span, CONFIG_MEDIA_RECORDER_ENCODE_BUFFER_SIZE, true);
+		if (size == 0) {
+			continue;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(handler->mEncodeMutex);
+			handler->mIsEncoding = true;
+		}
+		for (int i = 0; i < 2 && span[i].len > 0; i++) {
+			handler->encode((unsigned char *)span[i].buf, span[i].len);
+		}
+		handler->mPCMReader->release(size);
+
+		std::lock_guard<std::mutex> lock(handler->mEncodeMutex);
+		handler->mIsEncoding = false;
+		handler->mEncodeCondv.notify_all();
+	}
+
+	std::lock_guard<std::mutex> lock(handler->mEncodeMutex);
+	handler->mEncodeCondv.notify_all();
+	medvdbg("OutputHandler encoder exit\n");
+	return NULL;
+}
+#endif
+
 } // namespace stream
 } // namespace media
@@ -18,6 +18,7 @@
 #ifndef __MEDIA_OUTPUTHANDLER_H
 #define __MEDIA_OUTPUTHANDLER_H
 
+#include <tinyara/config.h>
 #include <sys/types.h>
 #include <memory>
 #include <media/OutputDataSource.h>
@@ -25,6 +26,10 @@
 #include "StreamHandler.h"
 #include "Encoder.h"
 
+#ifndef CONFIG_OUTPUT_DATASOURCE_FLUSH_MSEC
+#define CONFIG_OUTPUT_DATASOURCE_FLUSH_MSEC 0
+#endif
+
 namespace media {
 class MediaRecorderImpl;
 namespace stream {
@@ -34,6 +39,7 @@ public:
 	OutputHandler();
 	void setOutputDataSource(std::shared_ptr<OutputDataSource> source);
 	ssize_t write(unsigned char *buf, size_t size);
+	bool start() override;
 	bool stop() override;
 	void flush();
 
@@ -55,9 +61,37 @@ private:
 	virtual bool processWorker() override;
 	const char *getWorkerName(void) const override { return "OutputHandler"; };
 	void writeToSource(size_t size);
+	void drainEncoder(std::shared_ptr<Encoder> encoder, unsigned char *buf, size_t size);
 	std::shared_ptr<OutputDataSource> mOutputDataSource;
 	std::shared_ptr<Encoder> mEncoder;
 
+#ifdef CONFIG_MEDIA_RECORDER_ENCODE_WORKER
+	// Encoder worker takes captured PCM from mPCMBuffer and writes encoded frames to the stream buffer
+	bool createEncodeWorker();
+	void destroyEncodeWorker();
+	void flushEncodeWorker();
+	void encode(unsigned char *buf, size_t size);
+	static void *encodeWorkerMain(void *arg);
+	std::shared_ptr<StreamBuffer> mPCMBuffer;
+	std::shared_ptr<StreamBufferReader> mPCMReader;
+	std::shared_ptr<StreamBufferWriter> mPCMWriter;
+	// Encoded frame, when there's no contiguous space for it in the stream buffer
+	unsigned char *mEncodeFrame;
+	size_t mEncodeFrameSize;
+	pthread_t mEncodeWorker;
+	bool mIsEncodeWorkerAlive;
+	bool mIsEncoding;
+	bool mIsDroppingPCM;
+	std::mutex mEncodeMutex;
+	std::condition_variable mEncodeCondv;
+#endif
+
+#if CONFIG_OUTPUT_DATASOURCE_FLUSH_MSEC > 0
+	// Data below the threshold is written to the output data source when the deadline expires
+	std::chrono::steady_clock::time_point mFlushDeadline;
+	bool mIsDeadlineSet;
+#endif
+
 	bool mIsFlushing;
 	std::mutex mFlushMutex;
 	std::condition_variable mFlushCondv;
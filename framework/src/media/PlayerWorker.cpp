@@ -33,7 +33,7 @@
 using namespace std;
 
 namespace media {
-PlayerWorker::PlayerWorker() : mCurPlayer(nullptr)
+PlayerWorker::PlayerWorker()
 {
 	mThreadName = "PlayerWorker";
 	mStacksize = CONFIG_MEDIA_PLAYER_STACKSIZE;
@@ -52,22 +52,38 @@ PlayerWorker& PlayerWorker::getWorker()
 
 bool PlayerWorker::processLoop()
 {
-	if (mCurPlayer && (mCurPlayer->getState() == PLAYER_STATE_PLAYING)) {
-		mCurPlayer->playback();
-		return true;
+	bool played = false;
+
+	// playback() may remove players, so iterate over a snapshot of them.
+	auto players = mPlayers;
+	for (auto &player : players) {
+		if (player->getState() == PLAYER_STATE_PLAYING) {
+			player->playback();
+			played = true;
+		}
 	}
 
-	return false;
+	return played;
 }
 
-void PlayerWorker::setPlayer(std::shared_ptr<MediaPlayerImpl> player)
+void PlayerWorker::addPlayer(std::shared_ptr<MediaPlayerImpl> player)
 {
-	mCurPlayer = player;
+#ifdef CONFIG_AUDIO_MIXER
+	removePlayer(player);
+#else
+	mPlayers.clear();
+#endif
+	mPlayers.push_back(player);
 }
 
-std::shared_ptr<MediaPlayerImpl> PlayerWorker::getPlayer()
+void PlayerWorker::removePlayer(std::shared_ptr<MediaPlayerImpl> player)
 {
-	return mCurPlayer;
+	for (auto iter = mPlayers.begin(); iter != mPlayers.end(); ++iter) {
+		if (*iter == player) {
+			mPlayers.erase(iter);
+			return;
+		}
+	}
 }
 
 } // namespace media
@@ -20,6 +20,7 @@
 #define __MEDIA_PLAYERWORKER_HPP
 
 #include <memory>
+#include <vector>
 #include <media/MediaPlayer.h>
 #include "MediaWorker.h"
 
@@ -29,8 +30,8 @@ class PlayerWorker : public MediaWorker
 public:
 	static PlayerWorker &getWorker();
 
-	void setPlayer(std::shared_ptr<MediaPlayerImpl>);
-	std::shared_ptr<MediaPlayerImpl> getPlayer();
+	void addPlayer(std::shared_ptr<MediaPlayerImpl>);
+	void removePlayer(std::shared_ptr<MediaPlayerImpl>);
 
 private:
 	PlayerWorker();
@@ -38,7 +39,10 @@ private:
 	bool processLoop() override;
 
 private:
-	std::shared_ptr<MediaPlayerImpl> mCurPlayer;
+	/* Players fed by the worker. With the software mixer they play at the
+	 * same time, otherwise only the last started one is kept.
+	 */
+	std::vector<std::shared_ptr<MediaPlayerImpl>> mPlayers;
 };
 } // namespace media
 #endif
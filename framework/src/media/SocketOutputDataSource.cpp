@@ -17,6 +17,7 @@
  ******************************************************************/
 
 #include <debug.h>
+#include <errno.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
 
@@ -75,9 +76,17 @@ bool SocketOutputDataSource::open()
 	if (connect(mSockFd, (struct sockaddr *)&serveraddr, addrlen) < 0) {
 		meddbg("Errro: Fail to connect socket (errno=%d)\n", errno);
 		::close(mSockFd);
+		mSockFd = INVALID_SOCKET;
 		return false;
 	}
 
+	// OutputHandler already gathers data up to the threshold of its stream buffer before writing,
+	// so don't let Nagle hold the tail of a batch until the previous segment is acknowledged.
+	int flag = 1;
+	if (setsockopt(mSockFd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) < 0) {
+		meddbg("Warning: Fail to set TCP_NODELAY (errno=%d)\n", errno);
+	}
+
 	medvdbg("Connected to the server, fd = %d\n", mSockFd);
 
 	return true;
@@ -108,7 +117,77 @@ ssize_t SocketOutputDataSource::write(unsigned char* buf, size_t size)
 		return EOF;
 	}
 
-	return send(mSockFd, buf, size, 0);
+	return sendAll(buf, size);
+}
+
+ssize_t SocketOutputDataSource::writev(const struct iovec *iov, int iovcnt)
+{
+	struct msghdr msg;
+	ssize_t total = 0;
+	int index = 0;
+
+	memset(&msg, 0, sizeof(struct msghdr));
+	while (index < iovcnt) {
+		msg.msg_iov = (struct iovec *)&iov[index];
+		msg.msg_iovlen = iovcnt - index;
+		ssize_t ret = sendmsg(mSockFd, &msg, 0);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			meddbg("Error: Fail to send message (errno=%d)\n", errno);
+			return (total > 0) ? total : EOF;
+		}
+		total += ret;
+
+		// Skip buffers sent completely
+		size_t sent = (size_t)ret;
+		while (index < iovcnt && sent >= iov[index].iov_len) {
+			sent -= iov[index].iov_len;
+			index++;
+		}
+		if (index == iovcnt) {
+			break;
+		}
+		if (ret == 0) {
+			meddbg("Error: Connection doesn't take any data\n");
+			return (total > 0) ? total : EOF;
+		}
+		if (sent > 0) {
+			// Rest of a buffer sent partially
+			size_t remain = iov[index].iov_len - sent;
+			ssize_t rest = sendAll((const unsigned char *)iov[index].iov_base + sent, remain);
+			if (rest > 0) {
+				total += rest;
+			}
+			if (rest != (ssize_t)remain) {
+				return total;
+			}
+			index++;
+		}
+	}
+
+	return total;
+}
+
+ssize_t SocketOutputDataSource::sendAll(const unsigned char *buf, size_t size)
+{
+	size_t total = 0;
+	while (total < size) {
+		ssize_t ret = send(mSockFd, buf + total, size - total, 0);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			meddbg("Error: Fail to send (errno=%d)\n", errno);
+			return (total > 0) ? (ssize_t)total : EOF;
+		}
+		if (ret == 0) {
+			break;
+		}
+		total += ret;
+	}
+	return (ssize_t)total;
 }
 
 SocketOutputDataSource::~SocketOutputDataSource()
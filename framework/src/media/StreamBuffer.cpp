@@ -45,8 +45,8 @@
 namespace media {
 namespace stream {
 
-StreamBuffer::StreamBuffer(size_t bufferSize, size_t threshold)
-	: mObserver(nullptr), mEOS(false), mBufferSize(bufferSize), mThreshold(threshold)
+StreamBuffer::StreamBuffer(size_t bufferSize, size_t threshold, bool lockFree)
+	: mObserver(nullptr), mEOS(false), mLockFree(lockFree), mReaderWaiting(false), mWriterWaiting(false), mBufferSize(bufferSize), mThreshold(threshold)
 {
 	mRingBuf.buf = nullptr;
 	mRingBuf.depth = 0;
@@ -92,6 +92,26 @@ size_t StreamBuffer::write(unsigned char *buf, size_t size)
 	return rb_write(&mRingBuf, buf, size);
 }
 
+size_t StreamBuffer::acquireRead(rb_span_t span[2], size_t size)
+{
+	return rb_acquire_read(&mRingBuf, span, size);
+}
+
+size_t StreamBuffer::commitRead(size_t size)
+{
+	return rb_commit_read(&mRingBuf, size);
+}
+
+size_t StreamBuffer::acquireWrite(rb_span_t span[2], size_t size)
+{
+	return rb_acquire_write(&mRingBuf, span, size);
+}
+
+size_t StreamBuffer::commitWrite(size_t size)
+{
+	return rb_commit_write(&mRingBuf, size);
+}
+
 size_t StreamBuffer::sizeOfSpace()
 {
 	return rb_avail(&mRingBuf);
@@ -112,6 +132,48 @@ bool StreamBuffer::isEndOfStream()
 	return mEOS;
 }
 
+void StreamBuffer::waitForData()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mReaderWaiting = true;
+	// Check again after flag was set, writer checks the flag after publishing data.
+	while (sizeOfData() == 0 && !isEndOfStream()) {
+		mCondv.wait(lock);
+	}
+	mReaderWaiting = false;
+}
+
+void StreamBuffer::waitForSpace()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mWriterWaiting = true;
+	// Check again after flag was set, reader checks the flag after releasing space.
+	while (sizeOfSpace() == 0 && !isEndOfStream()) {
+		mCondv.wait(lock);
+	}
+	mWriterWaiting = false;
+}
+
+void StreamBuffer::wakeReader()
+{
+	// Order publishing data before checking the flag.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (mReaderWaiting) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCondv.notify_all();
+	}
+}
+
+void StreamBuffer::wakeWriter()
+{
+	// Order releasing space before checking the flag.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (mWriterWaiting) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCondv.notify_all();
+	}
+}
+
 void StreamBuffer::setObserver(BufferObserverInterface *observer)
 {
 	mObserver = observer;
@@ -140,7 +202,7 @@ void StreamBuffer::notifyObserver(State st, ...)
 }
 
 StreamBuffer::Builder::Builder()
-	: mBufferSize(CONFIG_STREAM_BUFFER_SIZE_DEFAULT), mThreshold(CONFIG_STREAM_BUFFER_THRESHOLD_DEFAULT)
+	: mBufferSize(CONFIG_STREAM_BUFFER_SIZE_DEFAULT), mThreshold(CONFIG_STREAM_BUFFER_THRESHOLD_DEFAULT), mLockFree(false)
 {
 }
 
@@ -166,13 +228,19 @@ StreamBuffer::Builder &StreamBuffer::Builder::setThreshold(size_t threshold)
 	return *this;
 }
 
+StreamBuffer::Builder &StreamBuffer::Builder::setLockFree(bool lockFree)
+{
+	mLockFree = lockFree;
+	return *this;
+}
+
 std::shared_ptr<StreamBuffer> StreamBuffer::Builder::build()
 {
 	if (mThreshold > mBufferSize) {
 		mThreshold = mBufferSize;
 	}
 
-	auto instance = std::make_shared<StreamBuffer>(mBufferSize, mThreshold);
+	auto instance = std::make_shared<StreamBuffer>(mBufferSize, mThreshold, mLockFree);
 	if (instance->init(mBufferSize)) {
 		return instance;
 	}
@@ -20,6 +20,7 @@
 #define __MEDIA_STREAMBUFFER_H
 
 #include <memory>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include "utils/rb.h"
@@ -38,14 +39,23 @@ public:
 		Builder();
 		Builder &setBufferSize(size_t bufferSize);
 		Builder &setThreshold(size_t threshold);
+		/**
+		 * Use lock-free single-producer/single-consumer mode.
+		 * Data is moved without taking the stream buffer mutex, and reader/writer
+		 * wake each other only when the other side is waiting on empty/full buffer.
+		 * Only one reader thread and one writer thread are allowed, and observer
+		 * callbacks may be invoked from both of them at the same time.
+		 */
+		Builder &setLockFree(bool lockFree);
 		std::shared_ptr<StreamBuffer> build();
 
 	private:
 		size_t mBufferSize;
 		size_t mThreshold;
+		bool mLockFree;
 	};
 
-	StreamBuffer(size_t bufferSize, size_t threshold);
+	StreamBuffer(size_t bufferSize, size_t threshold, bool lockFree = false);
 	virtual ~StreamBuffer();
 	/**
 	 * Initialize stream buffer with specific buffer size.
@@ -87,6 +97,24 @@ public:
 	 * Write(push) data into stream buffer.
 	 */
 	size_t write(unsigned char *buf, size_t size);
+	/**
+	 * Get regions holding data in stream buffer, without copying.
+	 * Data stays in stream buffer until commitRead() is called.
+	 */
+	size_t acquireRead(rb_span_t span[2], size_t size);
+	/**
+	 * Pop data consumed from regions got by acquireRead().
+	 */
+	size_t commitRead(size_t size);
+	/**
+	 * Get regions of free space in stream buffer, to be filled in place.
+	 * Data is not visible to reader until commitWrite() is called.
+	 */
+	size_t acquireWrite(rb_span_t span[2], size_t size);
+	/**
+	 * Push data filled in regions got by acquireWrite().
+	 */
+	size_t commitWrite(size_t size);
 	/**
 	 * Get bytes of data available in stream buffer.
 	 */
@@ -105,13 +133,33 @@ public:
 	bool isEndOfStream();
 	size_t getBufferSize() { return mBufferSize; }
 	size_t getThreshold() { return mThreshold; }
+	bool isLockFree() { return mLockFree; }
+	/**
+	 * Wait until data is available or end-of-stream flag was set (lock-free mode).
+	 */
+	void waitForData();
+	/**
+	 * Wait until space is available or end-of-stream flag was set (lock-free mode).
+	 */
+	void waitForSpace();
+	/**
+	 * Wake reader up if it is waiting for data (lock-free mode).
+	 */
+	void wakeReader();
+	/**
+	 * Wake writer up if it is waiting for space (lock-free mode).
+	 */
+	void wakeWriter();
 
 private:
 	std::mutex mMutex;
 	std::condition_variable mCondv;
 	BufferObserverInterface *mObserver;
 	rb_t mRingBuf;
-	bool mEOS;
+	std::atomic<bool> mEOS;
+	bool mLockFree;
+	std::atomic<bool> mReaderWaiting;
+	std::atomic<bool> mWriterWaiting;
 	size_t mBufferSize;
 	size_t mThreshold;
 };
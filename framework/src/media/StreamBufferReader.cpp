@@ -36,6 +36,10 @@ StreamBufferReader::StreamBufferReader(std::shared_ptr<StreamBuffer> stream)
 size_t StreamBufferReader::copy(unsigned char *buf, size_t size, size_t offset)
 {
 	medvdbg("offset %lu, size %lu\n", offset, size);
+	if (mStream->isLockFree()) {
+		return mStream->copy(buf, size, offset);
+	}
+
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
 	size_t len = mStream->copy(buf, size, offset);
 	medvdbg("copied %lu\n", len);
@@ -45,6 +49,10 @@ size_t StreamBufferReader::copy(unsigned char *buf, size_t size, size_t offset)
 size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 {
 	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	if (mStream->isLockFree()) {
+		return readLockFree(buf, size, sync);
+	}
+
 	std::unique_lock<std::mutex> lock(mStream->getMutex());
 
 	size_t rlen = 0;
@@ -86,17 +94,123 @@ size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 	return rlen;
 }
 
+size_t StreamBufferReader::acquire(rb_span_t span[2], size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	if (mStream->isLockFree()) {
+		return acquireLockFree(span, size, sync);
+	}
+
+	std::unique_lock<std::mutex> lock(mStream->getMutex());
+
+	size_t len = mStream->acquireRead(span, size);
+	while (sync && len == 0 && size > 0) {
+		if (mStream->isEndOfStream()) {
+			medvdbg("EOS break\n");
+			break;
+		}
+
+		// There's no data, notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
+		// Wait notification from writer.
+		mStream->getCondv().notify_one();
+		mStream->getCondv().wait(lock);
+		len = mStream->acquireRead(span, size);
+	}
+
+	medvdbg("acquired %lu\n", len);
+	return len;
+}
+
+size_t StreamBufferReader::release(size_t size)
+{
+	if (mStream->isLockFree()) {
+		size_t len = mStream->commitRead(size);
+		mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) len));
+		mStream->wakeWriter();
+		return len;
+	}
+
+	std::lock_guard<std::mutex> lock(mStream->getMutex());
+
+	size_t len = mStream->commitRead(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) len));
+	// Writer may be waiting for more spaces, so it's necessary to notify after reading.
+	mStream->getCondv().notify_one();
+
+	medvdbg("released %lu\n", len);
+	return len;
+}
+
 size_t StreamBufferReader::sizeOfData()
 {
+	if (mStream->isLockFree()) {
+		return mStream->sizeOfData();
+	}
+
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
 	return mStream->sizeOfData();
 }
 
 bool StreamBufferReader::isEndOfStream()
 {
+	if (mStream->isLockFree()) {
+		return mStream->isEndOfStream();
+	}
+
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
 	return mStream->isEndOfStream();
 }
 
+size_t StreamBufferReader::readLockFree(unsigned char *buf, size_t size, bool sync)
+{
+	size_t rlen = 0;
+
+	while (true) {
+		// Check EOS before reading, so data written before EOS won't be missed.
+		bool eos = mStream->isEndOfStream();
+		size_t temp = mStream->read(buf + rlen, size - rlen);
+		if (temp > 0) {
+			rlen += temp;
+			mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) temp));
+			// Writer is notified only if it is waiting for more spaces.
+			mStream->wakeWriter();
+		}
+
+		if (!sync || rlen == size || eos) {
+			break;
+		}
+
+		medvdbg("read %lu/%lu\n", rlen, size);
+		// There's not enough data, notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
+		// Then wait until writer pushes more data.
+		mStream->waitForData();
+	}
+
+	medvdbg("read %lu\n", rlen);
+	return rlen;
+}
+
+size_t StreamBufferReader::acquireLockFree(rb_span_t span[2], size_t size, bool sync)
+{
+	size_t len = 0;
+
+	while (true) {
+		bool eos = mStream->isEndOfStream();
+		len = mStream->acquireRead(span, size);
+		if (!sync || len > 0 || size == 0 || eos) {
+			break;
+		}
+
+		// There's no data, notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
+		mStream->waitForData();
+	}
+
+	medvdbg("acquired %lu\n", len);
+	return len;
+}
+
 } // namespace stream
 } // namespace media
@@ -20,6 +20,7 @@
 #define __MEDIA_STREAMBUFFERREADER_H
 
 #include <memory>
+#include "utils/rb.h"
 
 namespace media {
 namespace stream {
@@ -34,11 +35,21 @@ public:
 	virtual size_t copy(unsigned char *buf, size_t size, size_t offset = 0);
 	virtual size_t read(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfData();
+	/**
+	 * Get regions holding data in stream buffer for zero-copy reading.
+	 * In sync mode, it waits until some data is available or EOS was set.
+	 * Data must be released by release() after being consumed.
+	 */
+	virtual size_t acquire(rb_span_t span[2], size_t size, bool sync = true);
+	virtual size_t release(size_t size);
 
 public:
 	bool isEndOfStream();
 
 private:
+	size_t readLockFree(unsigned char *buf, size_t size, bool sync);
+	size_t acquireLockFree(rb_span_t span[2], size_t size, bool sync);
+
 	std::shared_ptr<StreamBuffer> mStream;
 };
 
@@ -36,6 +36,10 @@ StreamBufferWriter::StreamBufferWriter(std::shared_ptr<StreamBuffer> stream)
 size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 {
 	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	if (mStream->isLockFree()) {
+		return writeLockFree(buf, size, sync);
+	}
+
 	std::unique_lock<std::mutex> lock(mStream->getMutex());
 
 	size_t wlen = 0;
@@ -78,10 +82,61 @@ size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 
 size_t StreamBufferWriter::sizeOfSpace()
 {
+	if (mStream->isLockFree()) {
+		return mStream->sizeOfSpace();
+	}
+
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
 	return mStream->sizeOfSpace();
 }
 
+size_t StreamBufferWriter::acquire(rb_span_t span[2], size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	if (mStream->isLockFree()) {
+		return acquireLockFree(span, size, sync);
+	}
+
+	std::unique_lock<std::mutex> lock(mStream->getMutex());
+
+	size_t len = 0;
+	while (!mStream->isEndOfStream()) {
+		len = mStream->acquireWrite(span, size);
+		if (!sync || len > 0 || size == 0) {
+			break;
+		}
+
+		// There's no space, notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::OVERRUN);
+		// Wait notification from reader.
+		mStream->getCondv().notify_one();
+		mStream->getCondv().wait(lock);
+	}
+
+	medvdbg("acquired %lu\n", len);
+	return len;
+}
+
+size_t StreamBufferWriter::commit(size_t size)
+{
+	if (mStream->isLockFree()) {
+		size_t len = mStream->commitWrite(size);
+		mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) len);
+		mStream->wakeReader();
+		return len;
+	}
+
+	std::lock_guard<std::mutex> lock(mStream->getMutex());
+
+	size_t len = mStream->commitWrite(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) len);
+	// Reader may be waiting for more data, so it's necessary to notify after writing.
+	mStream->getCondv().notify_one();
+
+	medvdbg("committed %lu\n", len);
+	return len;
+}
+
 void StreamBufferWriter::setEndOfStream()
 {
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
@@ -93,5 +148,58 @@ void StreamBufferWriter::setEndOfStream()
 	mStream->getCondv().notify_one();
 }
 
+size_t StreamBufferWriter::writeLockFree(unsigned char *buf, size_t size, bool sync)
+{
+	size_t wlen = 0;
+
+	while (true) {
+		// Streaming may be stopped (EOS was set)
+		if (sync && mStream->isEndOfStream()) {
+			medvdbg("EOS break\n");
+			break;
+		}
+
+		size_t temp = mStream->write(buf + wlen, size - wlen);
+		if (temp > 0) {
+			wlen += temp;
+			mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) temp);
+			// Reader is notified only if it is waiting for more data.
+			mStream->wakeReader();
+		}
+
+		if (!sync || wlen == size) {
+			break;
+		}
+
+		medvdbg("written %lu/%lu\n", wlen, size);
+		// There's not enough space, notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::OVERRUN);
+		// Then wait until reader pops some data.
+		mStream->waitForSpace();
+	}
+
+	medvdbg("written %lu\n", wlen);
+	return wlen;
+}
+
+size_t StreamBufferWriter::acquireLockFree(rb_span_t span[2], size_t size, bool sync)
+{
+	size_t len = 0;
+
+	while (!mStream->isEndOfStream()) {
+		len = mStream->acquireWrite(span, size);
+		if (!sync || len > 0 || size == 0) {
+			break;
+		}
+
+		// There's no space, notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::OVERRUN);
+		mStream->waitForSpace();
+	}
+
+	medvdbg("acquired %lu\n", len);
+	return len;
+}
+
 } // namespace stream
 } // namespace media
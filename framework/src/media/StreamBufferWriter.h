@@ -20,6 +20,7 @@
 #define __MEDIA_STREAMBUFFERWRITER_H
 
 #include <memory>
+#include "utils/rb.h"
 
 namespace media {
 namespace stream {
@@ -33,11 +34,21 @@ public:
 public:
 	virtual size_t write(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfSpace();
+	/**
+	 * Get regions of free space in stream buffer for zero-copy writing.
+	 * In sync mode, it waits until some space is available or EOS was set.
+	 * Data filled in the regions must be published by commit().
+	 */
+	virtual size_t acquire(rb_span_t span[2], size_t size, bool sync = true);
+	virtual size_t commit(size_t size);
 
 public:
 	void setEndOfStream();
 
 private:
+	size_t writeLockFree(unsigned char *buf, size_t size, bool sync);
+	size_t acquireLockFree(rb_span_t span[2], size_t size, bool sync);
+
 	std::shared_ptr<StreamBuffer> mStream;
 };
 
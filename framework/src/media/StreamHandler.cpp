@@ -30,6 +30,7 @@ namespace stream {
 StreamHandler::StreamHandler() :
 	mWorker(0),
 	mWorkerStackSize(4096),
+	mWorkerPriority(CONFIG_HANDLER_STREAM_THREAD_PRIORITY),
 	mIsWorkerAlive(false)
 {
 }
@@ -45,6 +46,9 @@ bool StreamHandler::open()
 		auto streamBuffer = StreamBuffer::Builder()
 								.setBufferSize(CONFIG_HANDLER_STREAM_BUFFER_SIZE)
 								.setThreshold(CONFIG_HANDLER_STREAM_BUFFER_THRESHOLD)
+#ifdef CONFIG_HANDLER_STREAM_BUFFER_LOCKFREE
+								.setLockFree(true)
+#endif
 								.build();
 
 		if (!streamBuffer) {
@@ -114,7 +118,7 @@ void StreamHandler::createWorker()
 		pthread_attr_t attr;
 		pthread_attr_init(&attr);
 		pthread_attr_setstacksize(&attr, mWorkerStackSize);
-		sparam.sched_priority = CONFIG_HANDLER_STREAM_THREAD_PRIORITY;
+		sparam.sched_priority = mWorkerPriority;
 		pthread_attr_setschedparam(&attr, &sparam);
 		int ret = pthread_create(&mWorker, &attr, static_cast<pthread_startroutine_t>(StreamHandler::workerMain), this);
 		if (ret != OK) {
@@ -153,6 +157,14 @@ void StreamHandler::sleepWorker()
 	}
 }
 
+void StreamHandler::sleepWorkerUntil(std::chrono::steady_clock::time_point deadline)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	if (mIsWorkerAlive) {
+		mCondv.wait_until(lock, deadline);
+	}
+}
+
 void StreamHandler::wakenWorker()
 {
 	std::lock_guard<std::mutex> lock(mMutex);
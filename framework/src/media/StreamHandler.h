@@ -18,6 +18,7 @@
 #ifndef __MEDIA_STREAMHANDLER_H
 #define __MEDIA_STREAMHANDLER_H
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <pthread.h>
@@ -59,6 +60,7 @@ protected:
 	virtual bool processWorker() = 0;
 	void wakenWorker();
 	virtual void sleepWorker();
+	void sleepWorkerUntil(std::chrono::steady_clock::time_point deadline);
 
 	virtual bool probeDataSource() = 0;
 	virtual bool registerCodec(audio_type_t audioType, unsigned int channels, unsigned int sampleRate) = 0;
@@ -71,6 +73,7 @@ protected:
 
 	pthread_t mWorker;
 	size_t mWorkerStackSize;
+	int mWorkerPriority;
 	bool mIsWorkerAlive;
 private:
 	void createWorker();
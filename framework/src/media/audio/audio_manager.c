@@ -30,9 +30,13 @@
 #include <tinyara/audio/audio.h>
 #include <tinyalsa/tinyalsa.h>
 #include <json/cJSON.h>
+#include <media/media_stats.h>
 
 #include "audio_manager.h"
 #include "resample/samplerate.h"
+#ifdef CONFIG_AUDIO_MIXER
+#include "audio_mixer.h"
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -94,6 +98,10 @@
 #define CONFIG_AUDIO_RESAMPLER_BUFSIZE 4096
 #endif
 
+#ifndef CONFIG_AUDIO_MIXER_SAMPLE_RATE
+#define CONFIG_AUDIO_MIXER_SAMPLE_RATE AUDIO_STREAM_MEDIA_SAMPLE_RATE
+#endif
+
 #ifndef CONFIG_PROCESS_MSG_TIMEOUT_MSEC
 #define CONFIG_PROCESS_MSG_TIMEOUT_MSEC 150
 #endif
@@ -154,6 +162,9 @@ struct audio_card_info_s {
 	struct audio_resample_s resample;
 	pthread_mutex_t card_mutex;
 	uint8_t volume[MAX_STREAM_POLICY_NUM];
+#ifdef CONFIG_AUDIO_MIXER
+	audio_mixer_t mixer;        // mixes streams sharing an output card, used while it's running
+#endif
 };
 
 struct audio_samprate_map_entry_s {
@@ -206,6 +217,11 @@ static audio_manager_result_t get_supported_process_type(int card_id, int device
 static uint32_t get_closest_samprate(unsigned origin_samprate, audio_io_direction_t direct);
 static unsigned int resample_stream_in(audio_card_info_t *card, void *data, unsigned int frames);
 static unsigned int resample_stream_out(audio_card_info_t *card, void *data, unsigned int frames);
+static int write_stream_out(audio_card_info_t *card, const void *data, unsigned int frames);
+#ifdef CONFIG_AUDIO_MIXER
+static int write_mixed_stream_out(void *priv, const void *data, unsigned int frames);
+static audio_manager_result_t set_mixed_stream_out(audio_card_info_t *card, unsigned int card_channels, unsigned int channels, unsigned int sample_rate, int format, stream_info_id_t stream_id);
+#endif
 static audio_manager_result_t get_audio_volume(audio_io_direction_t direct);
 static audio_manager_result_t set_audio_volume(audio_io_direction_t direct, uint8_t volume);
 static audio_manager_result_t set_audio_equalizer(audio_io_direction_t direct, uint32_t preset);
@@ -1005,6 +1021,10 @@ audio_manager_result_t set_audio_stream_out(unsigned int channels, unsigned int
 	}
 
 	card = &g_audio_out_cards[g_actual_audio_out_card_id];
+#ifdef CONFIG_AUDIO_MIXER
+	// Streams share the card through the mixer instead of replacing each other.
+	return set_mixed_stream_out(card, channel_num, channels, sample_rate, format, stream_id);
+#endif
 	card_config = &card->config[card->device_id];
 	medvdbg("[%s] state : %d\n", __func__, card_config->status);
 	medvdbg("card->stream_id : %d stream_id : %d\n", card->stream_id, stream_id);
@@ -1137,11 +1157,13 @@ int start_audio_stream_in(void *data, unsigned int frames)
 		}
 	}
 
+	uint32_t start = media_stats_now();
 	do {
 		ret = pcm_readi(card->pcm, buffer_ptr, frames_to_read);
 		medvdbg("Read %d frames\n", ret);
 
 		if (ret == -EPIPE) {
+			media_stats_xrun(MEDIA_STATS_CAPTURE);
 			ret = pcm_prepare(card->pcm);
 			medvdbg("PCM is reprepared\n");
 			if (ret != OK) {
@@ -1160,6 +1182,10 @@ int start_audio_stream_in(void *data, unsigned int frames)
 		}
 	} while ((ret == OK) && (prepare_retry--));
 
+	if (ret > 0) {
+		media_stats_record(MEDIA_STATS_CAPTURE, start, pcm_frames_to_bytes(card->pcm, ret), ret);
+	}
+
 	if (card->resample.necessary && ret > 0) {
 		// Tell the number of frames saved in resampling buffer
 		card->resample.frames = ret;
@@ -1180,7 +1206,6 @@ error_with_lock:
 int start_audio_stream_out(void *data, unsigned int frames)
 {
 	int ret = 0;
-	int prepare_retry = AUDIO_STREAM_RETRY_COUNT;
 	audio_card_info_t *card;
 	medvdbg("start_audio_stream_out(%u)\n", frames);
 
@@ -1190,6 +1215,9 @@ int start_audio_stream_out(void *data, unsigned int frames)
 	}
 
 	card = &g_audio_out_cards[g_actual_audio_out_card_id];
+#ifdef CONFIG_AUDIO_MIXER
+	return start_mixed_stream_out(card->stream_id, data, frames);
+#endif
 
 	pthread_mutex_lock(&(card->card_mutex));
 	if (card->resample.necessary) {
@@ -1207,51 +1235,225 @@ int start_audio_stream_out(void *data, unsigned int frames)
 		frames = card->resample.frames;
 	}
 
+	ret = write_stream_out(card, data, frames);
+
+error_with_lock:
+	pthread_mutex_unlock(&(card->card_mutex));
+
+	return ret;
+}
+
+/* Write frames in the card format, called with card_mutex locked */
+static int write_stream_out(audio_card_info_t *card, const void *data, unsigned int frames)
+{
+	int ret = 0;
+	int prepare_retry = AUDIO_STREAM_RETRY_COUNT;
+
 	if (card->config[card->device_id].status == AUDIO_CARD_PAUSE) {
 		ret = ioctl(pcm_get_file_descriptor(card->pcm), AUDIOIOC_RESUME, 0UL);
 		if (ret < 0) {
 			meddbg("Fail to ioctl AUDIOIOC_RESUME, ret = %d\n", ret);
-			ret = AUDIO_MANAGER_DEVICE_FAIL;
-			goto error_with_lock;
+			return AUDIO_MANAGER_DEVICE_FAIL;
 		}
 	}
 
 	card->config[card->device_id].status = AUDIO_CARD_RUNNING;
 
+	uint32_t start = media_stats_now();
 	do {
 		ret = pcm_writei(card->pcm, data, frames);
 		if (ret < 0) {
 			if (ret == -EPIPE) {
+				media_stats_xrun(MEDIA_STATS_OUTPUT);
 				if (prepare_retry > 0) {
 					ret = pcm_prepare(card->pcm);
 					if (ret != OK) {
 						meddbg("Fail to pcm_prepare()\n");
-						ret = AUDIO_MANAGER_XRUN_STATE;
-						goto error_with_lock;
+						return AUDIO_MANAGER_XRUN_STATE;
 					}
 					prepare_retry--;
 				} else {
 					meddbg("prepare_retry = 0\n");
-					ret = AUDIO_MANAGER_XRUN_STATE;
-					goto error_with_lock;
+					return AUDIO_MANAGER_XRUN_STATE;
 				}
 			} else if (ret == -EINVAL) {
 				meddbg("pcm_writei = -EINVAL\n");
-				ret = AUDIO_MANAGER_INVALID_PARAM;
-				goto error_with_lock;
+				return AUDIO_MANAGER_INVALID_PARAM;
 			} else {
-				ret = AUDIO_MANAGER_OPERATION_FAIL;
-				goto error_with_lock;
+				return AUDIO_MANAGER_OPERATION_FAIL;
 			}
 		}
 	} while (ret == OK);
 
-error_with_lock:
+	if (ret > 0) {
+		media_stats_record(MEDIA_STATS_OUTPUT, start, pcm_frames_to_bytes(card->pcm, ret), ret);
+		media_stats_mark_output();
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_AUDIO_MIXER
+static int write_mixed_stream_out(void *priv, const void *data, unsigned int frames)
+{
+	audio_card_info_t *card = (audio_card_info_t *)priv;
+	int ret;
+
+	pthread_mutex_lock(&(card->card_mutex));
+	ret = write_stream_out(card, data, frames);
+	pthread_mutex_unlock(&(card->card_mutex));
+
+	return ret;
+}
+
+static audio_manager_result_t set_mixed_stream_out(audio_card_info_t *card, unsigned int card_channels, unsigned int channels, unsigned int sample_rate, int format, stream_info_id_t stream_id)
+{
+	audio_config_t *card_config = &card->config[card->device_id];
+	struct pcm_config config;
+	audio_manager_result_t ret;
+
+	pthread_mutex_lock(&(card->card_mutex));
+	medvdbg("[%s] state : %d stream_id : %d\n", __func__, card_config->status, stream_id);
+
+	if (!pcm_is_ready(card->pcm)) {
+		/* The card runs at a fixed rate while it's shared, streams of other
+		 * rates are resampled by their mixer inputs.
+		 */
+		memset(&config, 0, sizeof(struct pcm_config));
+		config.rate = get_closest_samprate(CONFIG_AUDIO_MIXER_SAMPLE_RATE, OUTPUT);
+		config.format = format;
+		config.period_size = AUDIO_STREAM_VOICE_RECOGNITION_PERIOD_SIZE;
+		config.period_count = AUDIO_STREAM_VOICE_RECOGNITION_PERIOD_COUNT;
+		config.channels = card_channels;
+		card->pcm = pcm_open(g_actual_audio_out_card_id, card->device_id, PCM_OUT, &config);
+		if (!pcm_is_ready(card->pcm)) {
+			meddbg("fail to pcm_is_ready() error : %s", pcm_get_error(card->pcm));
+			ret = AUDIO_MANAGER_CARD_NOT_READY;
+			goto error_with_pcm;
+		}
+		medvdbg("[OUT] Mixer samplerate: %u, channel: %u\n", config.rate, config.channels);
+
+		ret = audio_mixer_init(&card->mixer, config.channels, config.rate, config.period_size, write_mixed_stream_out, card);
+		if (ret != AUDIO_MANAGER_SUCCESS) {
+			meddbg("audio_mixer_init failed, ret : %d\n", ret);
+			goto error_with_pcm;
+		}
+		card_config->status = AUDIO_CARD_READY;
+	}
+
+	ret = audio_mixer_add_input(&card->mixer, stream_id, channels, sample_rate);
+	if (ret != AUDIO_MANAGER_SUCCESS) {
+		meddbg("audio_mixer_add_input failed, ret : %d\n", ret);
+		pthread_mutex_unlock(&(card->card_mutex));
+		return ret;
+	}
+
+	// Legacy frame conversions follow the stream configured last.
+	card->resample.necessary = false;
+	card->resample.user_channel = channels;
+	card->resample.user_sample_rate = sample_rate;
+	card->resample.user_format = pcm_format_to_bits((enum pcm_format)format) >> 3;
+	card->stream_id = stream_id;
+
 	pthread_mutex_unlock(&(card->card_mutex));
+	return AUDIO_MANAGER_SUCCESS;
 
+error_with_pcm:
+	pcm_close(card->pcm);
+	card->pcm = NULL;
+	pthread_mutex_unlock(&(card->card_mutex));
 	return ret;
 }
 
+int start_mixed_stream_out(stream_info_id_t stream_id, void *data, unsigned int frames)
+{
+	medvdbg("start_mixed_stream_out(%d, %u)\n", stream_id, frames);
+
+	if (g_actual_audio_out_card_id < 0) {
+		meddbg("Found no active output audio card\n");
+		return AUDIO_MANAGER_NO_AVAIL_CARD;
+	}
+
+	return audio_mixer_write(&g_audio_out_cards[g_actual_audio_out_card_id].mixer, stream_id, data, frames);
+}
+
+audio_manager_result_t pause_mixed_stream_out(stream_info_id_t stream_id)
+{
+	if (g_actual_audio_out_card_id < 0) {
+		meddbg("Found no active output audio card\n");
+		return AUDIO_MANAGER_NO_AVAIL_CARD;
+	}
+
+	return audio_mixer_pause_input(&g_audio_out_cards[g_actual_audio_out_card_id].mixer, stream_id);
+}
+
+audio_manager_result_t stop_mixed_stream_out(stream_info_id_t stream_id, bool drain)
+{
+	audio_manager_result_t ret;
+	audio_card_info_t *card;
+
+	if (g_actual_audio_out_card_id < 0) {
+		meddbg("Found no active output audio card\n");
+		return AUDIO_MANAGER_NO_AVAIL_CARD;
+	}
+
+	card = &g_audio_out_cards[g_actual_audio_out_card_id];
+
+	// Wait without card_mutex, the mixer thread takes it to write.
+	ret = audio_mixer_stop_input(&card->mixer, stream_id, drain);
+	if (ret != AUDIO_MANAGER_SUCCESS) {
+		return ret;
+	}
+
+	if (!audio_mixer_is_idle(&card->mixer)) {
+		// Other streams are still playing, keep the card running.
+		return AUDIO_MANAGER_SUCCESS;
+	}
+
+	pthread_mutex_lock(&(card->card_mutex));
+	if (drain) {
+		if ((ret = pcm_drain(card->pcm)) < 0) {
+			if (ret == -EPIPE) {
+				ret = AUDIO_MANAGER_SUCCESS;
+			} else {
+				meddbg("pcm_drain faled, ret = %d\n", ret);
+			}
+		}
+	} else {
+		if ((ret = pcm_drop(card->pcm)) < 0) {
+			meddbg("pcm_drop faled, ret = %d\n", ret);
+		}
+	}
+	card->config[card->device_id].status = AUDIO_CARD_READY;
+	pthread_mutex_unlock(&(card->card_mutex));
+
+	if (ret < 0) {
+		return AUDIO_MANAGER_DEVICE_FAIL;
+	}
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+audio_manager_result_t set_mixed_stream_out_gain(stream_info_id_t stream_id, uint16_t gain)
+{
+	if (g_actual_audio_out_card_id < 0) {
+		meddbg("Found no active output audio card\n");
+		return AUDIO_MANAGER_NO_AVAIL_CARD;
+	}
+
+	return audio_mixer_set_input_gain(&g_audio_out_cards[g_actual_audio_out_card_id].mixer, stream_id, gain);
+}
+
+audio_manager_result_t set_mixed_stream_out_policy(stream_info_id_t stream_id, stream_policy_t policy)
+{
+	if (g_actual_audio_out_card_id < 0) {
+		meddbg("Found no active output audio card\n");
+		return AUDIO_MANAGER_NO_AVAIL_CARD;
+	}
+
+	return audio_mixer_set_input_policy(&g_audio_out_cards[g_actual_audio_out_card_id].mixer, stream_id, policy);
+}
+#endif
+
 static audio_manager_result_t pause_audio_stream(audio_io_direction_t direct)
 {
 	audio_manager_result_t ret;
@@ -1302,6 +1504,11 @@ audio_manager_result_t pause_audio_stream_in(void)
 
 audio_manager_result_t pause_audio_stream_out(void)
 {
+#ifdef CONFIG_AUDIO_MIXER
+	if (g_actual_audio_out_card_id >= 0) {
+		return pause_mixed_stream_out(g_audio_out_cards[g_actual_audio_out_card_id].stream_id);
+	}
+#endif
 	return pause_audio_stream(OUTPUT);
 }
 
@@ -1345,6 +1552,9 @@ audio_manager_result_t stop_audio_stream_out(bool drain)
 	}
 
 	card = &g_audio_out_cards[g_actual_audio_out_card_id];
+#ifdef CONFIG_AUDIO_MIXER
+	return stop_mixed_stream_out(card->stream_id, drain);
+#endif
 
 	pthread_mutex_lock(&(card->card_mutex));
 	medvdbg("[%s] state : %d\n", __func__, card->config[card->device_id].status);
@@ -1417,10 +1627,20 @@ audio_manager_result_t reset_audio_stream_out(stream_info_id_t stream_id)
 	}
 
 	card = &g_audio_out_cards[g_actual_audio_out_card_id];
+#ifdef CONFIG_AUDIO_MIXER
+	audio_mixer_remove_input(&card->mixer, stream_id);
+	if (audio_mixer_get_input_count(&card->mixer) > 0) {
+		medvdbg("stream_id = %d removed from mixer, card is kept for other streams\n", stream_id);
+		return AUDIO_MANAGER_SUCCESS;
+	}
+	// Stop the mixer thread before taking card_mutex, the thread takes it to write.
+	audio_mixer_deinit(&card->mixer);
+#else
 	if (stream_id != card->stream_id) {
 		medvdbg("audio manager already got reset for stream_id = %d, currently being used by stream_id = %d\n", stream_id, card->stream_id);
 		return AUDIO_MANAGER_SUCCESS;
 	}
+#endif
 	pthread_mutex_lock(&(g_audio_out_cards[g_actual_audio_out_card_id].card_mutex));
 	medvdbg("[%s] state : %d\n", __func__, card->config[card->device_id].status);
 
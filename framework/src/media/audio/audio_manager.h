@@ -273,6 +273,88 @@ audio_manager_result_t reset_audio_stream_in(void);
  ****************************************************************************/
 audio_manager_result_t reset_audio_stream_out(stream_info_id_t stream_id);
 
+#ifdef CONFIG_AUDIO_MIXER
+/****************************************************************************
+ * Name: start_mixed_stream_out
+ *
+ * Description:
+ *   Queue frames of the stream to the software mixer of the active output
+ *   card. Each stream set by set_audio_stream_out() has its own mixer input,
+ *   which converts the frames to the card format. Blocks while the input is full.
+ *
+ * Input parameters:
+ *   stream_id: stream info id given to set_audio_stream_out()
+ *   data: buffer to transfer the frame data, 16 bits per sample
+ *   frames: number of frames to be written
+ *
+ * Return Value:
+ *   On success, the number of frames written. Otherwise, a negative value.
+ ****************************************************************************/
+int start_mixed_stream_out(stream_info_id_t stream_id, void *data, unsigned int frames);
+
+/****************************************************************************
+ * Name: pause_mixed_stream_out
+ *
+ * Description:
+ *   Pause the stream in the mixer, other streams keep playing.
+ *   The stream is resumed by start_mixed_stream_out().
+ *
+ * Input parameters:
+ *   stream_id: stream info id given to set_audio_stream_out()
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t pause_mixed_stream_out(stream_info_id_t stream_id);
+
+/****************************************************************************
+ * Name: stop_mixed_stream_out
+ *
+ * Description:
+ *   Stop the stream in the mixer. The output card is drained or dropped only
+ *   if no other stream is playing.
+ *
+ * Input parameters:
+ *   stream_id: stream info id given to set_audio_stream_out()
+ *   drain: true to play out queued frames, false to drop them
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t stop_mixed_stream_out(stream_info_id_t stream_id, bool drain);
+
+/****************************************************************************
+ * Name: set_mixed_stream_out_gain
+ *
+ * Description:
+ *   Set the gain of the stream in the mixer, independent of the card volume.
+ *
+ * Input parameters:
+ *   stream_id: stream info id given to set_audio_stream_out()
+ *   gain: gain in Q14 format, 16384 keeps the level
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t set_mixed_stream_out_gain(stream_info_id_t stream_id, uint16_t gain);
+
+/****************************************************************************
+ * Name: set_mixed_stream_out_policy
+ *
+ * Description:
+ *   Set the policy of the stream in the mixer. While a stream of a higher
+ *   policy is playing, streams of lower policies are ducked.
+ *
+ * Input parameters:
+ *   stream_id: stream info id given to set_audio_stream_out()
+ *   policy: policy of the stream
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t set_mixed_stream_out_policy(stream_info_id_t stream_id, stream_policy_t policy);
+#endif
+
 /****************************************************************************
  * Name: get_input_frame_count
  *
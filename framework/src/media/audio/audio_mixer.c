@@ -0,0 +1,593 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <debug.h>
+#include <sched.h>
+
+#include "audio_mixer.h"
+#include "../utils/internal_defs.h"
+#include "../utils/remix.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#ifndef CONFIG_AUDIO_RESAMPLER_BUFSIZE
+#define CONFIG_AUDIO_RESAMPLER_BUFSIZE 4096
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_INPUT_PERIOD_COUNT
+#define CONFIG_AUDIO_MIXER_INPUT_PERIOD_COUNT 4
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_DUCK_LEVEL
+#define CONFIG_AUDIO_MIXER_DUCK_LEVEL 30
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_STACKSIZE
+#define CONFIG_AUDIO_MIXER_STACKSIZE 2048
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_THREAD_PRIORITY
+#define CONFIG_AUDIO_MIXER_THREAD_PRIORITY 200
+#endif
+
+#define Q14_SHIFT      (14)
+
+#define DUCK_GAIN      ((CONFIG_AUDIO_MIXER_DUCK_LEVEL * AUDIO_MIXER_GAIN_UNITY) / 100)
+
+#define MIXER_FRAME_SIZE(channels) ((channels) * sizeof(int16_t))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static struct audio_mixer_input_s *find_input(audio_mixer_t *mixer, stream_info_id_t stream_id)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_AUDIO_MIXER_MAX_STREAMS; i++) {
+		if (mixer->inputs[i].active && mixer->inputs[i].stream_id == stream_id) {
+			return &mixer->inputs[i];
+		}
+	}
+
+	return NULL;
+}
+
+static inline bool is_sounding(struct audio_mixer_input_s *input)
+{
+	return input->active && !input->paused && (rb_used(&input->rb) > 0);
+}
+
+static void release_converter(struct audio_mixer_input_s *input)
+{
+	if (input->handle) {
+		src_destroy(input->handle);
+		input->handle = NULL;
+	}
+	if (input->buffer) {
+		free(input->buffer);
+		input->buffer = NULL;
+	}
+	input->buffer_size = 0;
+}
+
+static audio_manager_result_t setup_converter(audio_mixer_t *mixer, struct audio_mixer_input_s *input)
+{
+	if ((input->channels == mixer->channels) && (input->sample_rate == mixer->sample_rate)) {
+		return AUDIO_MANAGER_SUCCESS;
+	}
+
+	input->handle = src_init(CONFIG_AUDIO_RESAMPLER_BUFSIZE);
+	if (!input->handle) {
+		meddbg("src_init failed\n");
+		return AUDIO_MANAGER_RESAMPLE_FAIL;
+	}
+
+	input->buffer_size = mixer->period_frames * MIXER_FRAME_SIZE(mixer->channels);
+	input->buffer = malloc(input->buffer_size);
+	if (!input->buffer) {
+		meddbg("malloc for a mixer input buffer is failed, size %u\n", input->buffer_size);
+		release_converter(input);
+		return AUDIO_MANAGER_RESAMPLE_FAIL;
+	}
+
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+/* Queue converted frames to the input, waiting for the mixer while it is full */
+static void queue_input(audio_mixer_t *mixer, struct audio_mixer_input_s *input, const uint8_t *data, size_t len)
+{
+	pthread_mutex_lock(&mixer->mutex);
+	while (len > 0) {
+		size_t written = rb_write(&input->rb, data, len);
+		if (written > 0) {
+			data += written;
+			len -= written;
+			pthread_cond_broadcast(&mixer->cond);
+			continue;
+		}
+		if (!mixer->running || !input->active || input->paused) {
+			medvdbg("input of stream %d is not mixed, drop %u bytes\n", input->stream_id, len);
+			break;
+		}
+		pthread_cond_wait(&mixer->cond, &mixer->mutex);
+	}
+	pthread_mutex_unlock(&mixer->mutex);
+}
+
+/* Mix one block from all inputs having data, called with the mixer locked.
+ * Inputs shorter than the others are padded with silence.
+ */
+static unsigned int mix_block(audio_mixer_t *mixer)
+{
+	unsigned int frame_size = MIXER_FRAME_SIZE(mixer->channels);
+	unsigned int frames = 0;
+	stream_policy_t top_policy = STREAM_TYPE_MEDIA;
+	bool sounding = false;
+	int i;
+
+	for (i = 0; i < CONFIG_AUDIO_MIXER_MAX_STREAMS; i++) {
+		struct audio_mixer_input_s *input = &mixer->inputs[i];
+		if (is_sounding(input)) {
+			if (!sounding || input->policy > top_policy) {
+				top_policy = input->policy;
+			}
+			sounding = true;
+		}
+	}
+
+	if (!sounding) {
+		return 0;
+	}
+
+	memset(mixer->buffer, 0, mixer->period_frames * frame_size);
+
+	for (i = 0; i < CONFIG_AUDIO_MIXER_MAX_STREAMS; i++) {
+		struct audio_mixer_input_s *input = &mixer->inputs[i];
+		rb_span_t span[2];
+		unsigned int got;
+		unsigned int pos = 0;
+		int s;
+
+		if (!is_sounding(input)) {
+			continue;
+		}
+
+		uint16_t target = input->gain;
+		if (input->policy < top_policy) {
+			target = (uint16_t)(((uint32_t)target * DUCK_GAIN) >> Q14_SHIFT);
+		}
+
+		got = rb_acquire_read(&input->rb, span, mixer->period_frames * frame_size) / frame_size;
+		for (s = 0; s < 2 && span[s].len > 0; s++) {
+			unsigned int span_frames = span[s].len / frame_size;
+			int16_t *acc = mixer->buffer + pos * mixer->channels;
+			if (input->cur_gain == target) {
+				remix_accumulate(acc, (const int16_t *)span[s].buf, span_frames * mixer->channels, target);
+			} else {
+				remix_accumulate_ramp(acc, (const int16_t *)span[s].buf, span_frames, mixer->channels, input->cur_gain, target, pos, got);
+			}
+			pos += span_frames;
+		}
+		rb_commit_read(&input->rb, got * frame_size);
+		input->cur_gain = target;
+
+		if (got > frames) {
+			frames = got;
+		}
+	}
+
+	return frames;
+}
+
+static void *mixer_thread(void *arg)
+{
+	audio_mixer_t *mixer = (audio_mixer_t *)arg;
+
+	pthread_mutex_lock(&mixer->mutex);
+	while (mixer->running) {
+		unsigned int frames = mix_block(mixer);
+		if (frames == 0) {
+			pthread_cond_wait(&mixer->cond, &mixer->mutex);
+			continue;
+		}
+
+		// Space is freed in the inputs, wake up writers and drainers.
+		pthread_cond_broadcast(&mixer->cond);
+		pthread_mutex_unlock(&mixer->mutex);
+
+		int ret = mixer->write(mixer->priv, mixer->buffer, frames);
+
+		pthread_mutex_lock(&mixer->mutex);
+		if (ret < 0) {
+			meddbg("Fail to write mixed frames, ret %d\n", ret);
+			mixer->error = ret;
+		}
+	}
+	pthread_mutex_unlock(&mixer->mutex);
+
+	medvdbg("mixer thread exit\n");
+	return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_init(audio_mixer_t *mixer, unsigned int channels, unsigned int sample_rate, unsigned int period_frames, audio_mixer_write_t write, void *priv)
+{
+	struct sched_param sparam;
+	pthread_attr_t attr;
+	int ret;
+
+	if (!mixer || !write || (channels == 0) || (sample_rate == 0) || (period_frames == 0)) {
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	memset(mixer, 0, sizeof(audio_mixer_t));
+	mixer->channels = channels;
+	mixer->sample_rate = sample_rate;
+	mixer->period_frames = period_frames;
+	mixer->write = write;
+	mixer->priv = priv;
+
+	mixer->buffer = (int16_t *)malloc(period_frames * MIXER_FRAME_SIZE(channels));
+	if (!mixer->buffer) {
+		meddbg("malloc for a mixer buffer is failed, frames %u\n", period_frames);
+		return AUDIO_MANAGER_OPERATION_FAIL;
+	}
+
+	pthread_mutex_init(&mixer->mutex, NULL);
+	pthread_cond_init(&mixer->cond, NULL);
+	mixer->running = true;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_AUDIO_MIXER_STACKSIZE);
+	sparam.sched_priority = CONFIG_AUDIO_MIXER_THREAD_PRIORITY;
+	pthread_attr_setschedparam(&attr, &sparam);
+	ret = pthread_create(&mixer->thread, &attr, mixer_thread, mixer);
+	if (ret != OK) {
+		meddbg("Fail to create mixer thread, return value : %d\n", ret);
+		mixer->running = false;
+		pthread_cond_destroy(&mixer->cond);
+		pthread_mutex_destroy(&mixer->mutex);
+		free(mixer->buffer);
+		mixer->buffer = NULL;
+		return AUDIO_MANAGER_OPERATION_FAIL;
+	}
+	pthread_setname_np(mixer->thread, "AudioMixer");
+
+	medvdbg("mixer started, channels %u rate %u period %u\n", channels, sample_rate, period_frames);
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+void audio_mixer_deinit(audio_mixer_t *mixer)
+{
+	int i;
+
+	if (!mixer || !mixer->running) {
+		return;
+	}
+
+	pthread_mutex_lock(&mixer->mutex);
+	mixer->running = false;
+	pthread_cond_broadcast(&mixer->cond);
+	pthread_mutex_unlock(&mixer->mutex);
+	pthread_join(mixer->thread, NULL);
+
+	for (i = 0; i < CONFIG_AUDIO_MIXER_MAX_STREAMS; i++) {
+		struct audio_mixer_input_s *input = &mixer->inputs[i];
+		if (input->active) {
+			input->active = false;
+			release_converter(input);
+			rb_free(&input->rb);
+		}
+	}
+
+	pthread_cond_destroy(&mixer->cond);
+	pthread_mutex_destroy(&mixer->mutex);
+	free(mixer->buffer);
+	mixer->buffer = NULL;
+}
+
+audio_manager_result_t audio_mixer_add_input(audio_mixer_t *mixer, stream_info_id_t stream_id, unsigned int channels, unsigned int sample_rate)
+{
+	struct audio_mixer_input_s *input;
+	audio_manager_result_t ret;
+	int i;
+
+	if (!mixer || !mixer->running || (channels == 0) || (sample_rate == 0)) {
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	pthread_mutex_lock(&mixer->mutex);
+	input = find_input(mixer, stream_id);
+	if (input) {
+		if ((input->channels == channels) && (input->sample_rate == sample_rate)) {
+			pthread_mutex_unlock(&mixer->mutex);
+			return AUDIO_MANAGER_SUCCESS;
+		}
+		// Format of the stream changed, queued data is already in the card format.
+		release_converter(input);
+		input->channels = channels;
+		input->sample_rate = sample_rate;
+		ret = setup_converter(mixer, input);
+		if (ret != AUDIO_MANAGER_SUCCESS) {
+			input->active = false;
+			rb_free(&input->rb);
+		}
+		pthread_mutex_unlock(&mixer->mutex);
+		return ret;
+	}
+
+	for (i = 0; i < CONFIG_AUDIO_MIXER_MAX_STREAMS; i++) {
+		if (!mixer->inputs[i].active) {
+			break;
+		}
+	}
+	if (i == CONFIG_AUDIO_MIXER_MAX_STREAMS) {
+		pthread_mutex_unlock(&mixer->mutex);
+		meddbg("No free mixer input for stream %d\n", stream_id);
+		return AUDIO_MANAGER_DEVICE_ALREADY_IN_USE;
+	}
+
+	input = &mixer->inputs[i];
+	memset(input, 0, sizeof(struct audio_mixer_input_s));
+	input->stream_id = stream_id;
+	input->policy = STREAM_TYPE_MEDIA;
+	input->channels = channels;
+	input->sample_rate = sample_rate;
+	input->gain = AUDIO_MIXER_GAIN_UNITY;
+	input->cur_gain = AUDIO_MIXER_GAIN_UNITY;
+
+	if (!rb_init(&input->rb, mixer->period_frames * CONFIG_AUDIO_MIXER_INPUT_PERIOD_COUNT * MIXER_FRAME_SIZE(mixer->channels))) {
+		pthread_mutex_unlock(&mixer->mutex);
+		meddbg("rb_init for a mixer input is failed\n");
+		return AUDIO_MANAGER_OPERATION_FAIL;
+	}
+
+	ret = setup_converter(mixer, input);
+	if (ret != AUDIO_MANAGER_SUCCESS) {
+		rb_free(&input->rb);
+		pthread_mutex_unlock(&mixer->mutex);
+		return ret;
+	}
+
+	input->active = true;
+	pthread_mutex_unlock(&mixer->mutex);
+
+	medvdbg("mixer input %d added for stream %d, channels %u rate %u\n", i, stream_id, channels, sample_rate);
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+void audio_mixer_remove_input(audio_mixer_t *mixer, stream_info_id_t stream_id)
+{
+	struct audio_mixer_input_s *input;
+
+	if (!mixer || !mixer->running) {
+		return;
+	}
+
+	pthread_mutex_lock(&mixer->mutex);
+	input = find_input(mixer, stream_id);
+	if (!input) {
+		pthread_mutex_unlock(&mixer->mutex);
+		return;
+	}
+	input->active = false;
+	pthread_cond_broadcast(&mixer->cond);
+	pthread_mutex_unlock(&mixer->mutex);
+
+	// The mixer thread never touches an inactive input, release it without the lock.
+	release_converter(input);
+	rb_free(&input->rb);
+}
+
+int audio_mixer_write(audio_mixer_t *mixer, stream_info_id_t stream_id, const void *data, unsigned int frames)
+{
+	struct audio_mixer_input_s *input;
+	unsigned int frame_size;
+	unsigned int used_frames = 0;
+	src_data_t srcData = { 0, };
+
+	if (!mixer || !data) {
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	pthread_mutex_lock(&mixer->mutex);
+	input = find_input(mixer, stream_id);
+	if (!input || !mixer->running) {
+		pthread_mutex_unlock(&mixer->mutex);
+		meddbg("No mixer input for stream %d\n", stream_id);
+		return AUDIO_MANAGER_CARD_NOT_READY;
+	}
+	if (mixer->error < 0) {
+		int ret = mixer->error;
+		mixer->error = 0;
+		pthread_mutex_unlock(&mixer->mutex);
+		return ret;
+	}
+	input->paused = false;
+	pthread_mutex_unlock(&mixer->mutex);
+
+	/* Inputs are added, written and removed by the thread of the stream,
+	 * so its converter is used without the lock.
+	 */
+	if (!input->handle) {
+		queue_input(mixer, input, (const uint8_t *)data, frames * MIXER_FRAME_SIZE(mixer->channels));
+		return frames;
+	}
+
+	frame_size = MIXER_FRAME_SIZE(input->channels);
+	srcData.origin_channel_num = input->channels;
+	srcData.origin_sample_rate = input->sample_rate;
+	srcData.origin_sample_width = SAMPLE_WIDTH_16BITS;
+	srcData.desired_channel_num = mixer->channels;
+	srcData.desired_sample_rate = mixer->sample_rate;
+	srcData.desired_sample_width = SAMPLE_WIDTH_16BITS;
+
+	/* Resampler keeps input frames internally, go on converting after all input
+	 * is taken until it holds no more output than the overlap.
+	 */
+	do {
+		srcData.data_in = (const void *)((const uint8_t *)data + used_frames * frame_size);
+		srcData.input_frames = frames - used_frames;
+		srcData.data_out = input->buffer;
+		srcData.out_buf_length = input->buffer_size;
+
+		int src_ret = src_simple(input->handle, &srcData);
+		if (src_ret < 0) {
+			meddbg("Fail to resample in:%u/%u, error %d\n", used_frames, frames, src_ret);
+			return AUDIO_MANAGER_RESAMPLE_FAIL;
+		}
+		if ((frames > used_frames) && (srcData.input_frames_used == 0) && (srcData.output_frames_gen == 0)) {
+			meddbg("Error: resampler made no progress, used input frames %u/%u\n", used_frames, frames);
+			return AUDIO_MANAGER_RESAMPLE_FAIL;
+		}
+
+		used_frames += srcData.input_frames_used;
+		if (srcData.output_frames_gen > 0) {
+			queue_input(mixer, input, (const uint8_t *)input->buffer, srcData.output_frames_gen * MIXER_FRAME_SIZE(mixer->channels));
+		}
+	} while ((frames > used_frames) || ((input->sample_rate != mixer->sample_rate) && (srcData.output_frames_gen > 0)));
+
+	return frames;
+}
+
+audio_manager_result_t audio_mixer_pause_input(audio_mixer_t *mixer, stream_info_id_t stream_id)
+{
+	struct audio_mixer_input_s *input;
+
+	RETURN_VAL_IF_FAIL(mixer != NULL, AUDIO_MANAGER_INVALID_PARAM);
+
+	pthread_mutex_lock(&mixer->mutex);
+	input = find_input(mixer, stream_id);
+	if (!input) {
+		pthread_mutex_unlock(&mixer->mutex);
+		return AUDIO_MANAGER_CARD_NOT_READY;
+	}
+	input->paused = true;
+	pthread_mutex_unlock(&mixer->mutex);
+
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+audio_manager_result_t audio_mixer_stop_input(audio_mixer_t *mixer, stream_info_id_t stream_id, bool drain)
+{
+	struct audio_mixer_input_s *input;
+
+	RETURN_VAL_IF_FAIL(mixer != NULL, AUDIO_MANAGER_INVALID_PARAM);
+
+	pthread_mutex_lock(&mixer->mutex);
+	input = find_input(mixer, stream_id);
+	if (!input) {
+		pthread_mutex_unlock(&mixer->mutex);
+		return AUDIO_MANAGER_CARD_NOT_READY;
+	}
+
+	if (drain) {
+		input->paused = false;
+		while (mixer->running && input->active && (rb_used(&input->rb) > 0)) {
+			pthread_cond_wait(&mixer->cond, &mixer->mutex);
+		}
+	} else {
+		// The mixer thread reads the input with the lock held, so it's safe to reset here.
+		rb_reset(&input->rb);
+	}
+	input->paused = true;
+	pthread_mutex_unlock(&mixer->mutex);
+
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+audio_manager_result_t audio_mixer_set_input_gain(audio_mixer_t *mixer, stream_info_id_t stream_id, uint16_t gain)
+{
+	struct audio_mixer_input_s *input;
+
+	RETURN_VAL_IF_FAIL(mixer != NULL, AUDIO_MANAGER_INVALID_PARAM);
+	RETURN_VAL_IF_FAIL(gain <= AUDIO_MIXER_GAIN_UNITY, AUDIO_MANAGER_INVALID_PARAM);
+
+	pthread_mutex_lock(&mixer->mutex);
+	input = find_input(mixer, stream_id);
+	if (!input) {
+		pthread_mutex_unlock(&mixer->mutex);
+		return AUDIO_MANAGER_CARD_NOT_READY;
+	}
+	input->gain = gain;
+	pthread_mutex_unlock(&mixer->mutex);
+
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+audio_manager_result_t audio_mixer_set_input_policy(audio_mixer_t *mixer, stream_info_id_t stream_id, stream_policy_t policy)
+{
+	struct audio_mixer_input_s *input;
+
+	RETURN_VAL_IF_FAIL(mixer != NULL, AUDIO_MANAGER_INVALID_PARAM);
+
+	pthread_mutex_lock(&mixer->mutex);
+	input = find_input(mixer, stream_id);
+	if (!input) {
+		pthread_mutex_unlock(&mixer->mutex);
+		return AUDIO_MANAGER_CARD_NOT_READY;
+	}
+	input->policy = policy;
+	pthread_mutex_unlock(&mixer->mutex);
+
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+unsigned int audio_mixer_get_input_count(audio_mixer_t *mixer)
+{
+	unsigned int count = 0;
+	int i;
+
+	RETURN_VAL_IF_FAIL(mixer != NULL, 0);
+	RETURN_VAL_IF_FAIL(mixer->running, 0);
+
+	pthread_mutex_lock(&mixer->mutex);
+	for (i = 0; i < CONFIG_AUDIO_MIXER_MAX_STREAMS; i++) {
+		if (mixer->inputs[i].active) {
+			count++;
+		}
+	}
+	pthread_mutex_unlock(&mixer->mutex);
+
+	return count;
+}
+
+bool audio_mixer_is_idle(audio_mixer_t *mixer)
+{
+	bool idle = true;
+	int i;
+
+	RETURN_VAL_IF_FAIL(mixer != NULL, true);
+	RETURN_VAL_IF_FAIL(mixer->running, true);
+
+	pthread_mutex_lock(&mixer->mutex);
+	for (i = 0; i < CONFIG_AUDIO_MIXER_MAX_STREAMS; i++) {
+		if (is_sounding(&mixer->inputs[i])) {
+			idle = false;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&mixer->mutex);
+
+	return idle;
+}
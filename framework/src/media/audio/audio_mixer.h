@@ -0,0 +1,274 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/**
+ * @file audio_mixer.h
+ * @brief Software mixer which sums several output streams into one audio card.
+ */
+
+#ifndef __AUDIO_MIXER_H
+#define __AUDIO_MIXER_H
+
+#include <tinyara/config.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <media/stream_info.h>
+
+#include "audio_manager.h"
+#include "resample/samplerate.h"
+#include "../utils/rb.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#ifndef CONFIG_AUDIO_MIXER_MAX_STREAMS
+#define CONFIG_AUDIO_MIXER_MAX_STREAMS 4
+#endif
+
+/* Gain of a mixer input in Q14 format, unity keeps the level */
+#define AUDIO_MIXER_GAIN_UNITY (1 << 14)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+/**
+ * @brief Callback writing mixed frames in the card format to the audio card.
+ *        Returns the number of frames written, or a negative value on failure.
+ */
+typedef int (*audio_mixer_write_t)(void *priv, const void *data, unsigned int frames);
+
+struct audio_mixer_input_s {
+	bool active;                // if the slot is used by a stream
+	bool paused;                // paused inputs are kept but not mixed
+	stream_info_id_t stream_id; // stream which writes to this input
+	stream_policy_t policy;     // inputs of lower policy are ducked while a higher one sounds
+	unsigned int channels;      // channels of the user data
+	unsigned int sample_rate;   // sample rate of the user data
+	src_handle_t handle;        // converter to the card format, NULL if not necessary
+	void *buffer;               // buffer of converted frames
+	uint32_t buffer_size;       // size in bytes of the buffer
+	uint16_t gain;              // gain in Q14 format set by the user
+	uint16_t cur_gain;          // gain applied to the last mixed block, ramps to the target
+	rb_t rb;                    // frames in the card format waiting to be mixed
+};
+
+struct audio_mixer_s {
+	unsigned int channels;      // channels of the card
+	unsigned int sample_rate;   // sample rate of the card
+	unsigned int period_frames; // frames mixed in one block
+	int16_t *buffer;            // mixed block
+	struct audio_mixer_input_s inputs[CONFIG_AUDIO_MIXER_MAX_STREAMS];
+	audio_mixer_write_t write;
+	void *priv;
+	int error;                  // last error of the write callback, reported to writers
+	bool running;
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;        // signaled when data is queued or mixed, or state changes
+};
+
+typedef struct audio_mixer_s audio_mixer_t;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: audio_mixer_init
+ *
+ * Description:
+ *   Initialize the mixer for a card and start the mixing thread.
+ *   The thread mixes one block of period_frames at a time from all inputs
+ *   having data, and passes it to the write callback.
+ *
+ * Input parameters:
+ *   mixer: mixer to be initialized
+ *   channels: number of channels of the card
+ *   sample_rate: sample rate of the card
+ *   period_frames: number of frames mixed in one block
+ *   write: callback writing mixed blocks to the card
+ *   priv: argument of the callback
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_init(audio_mixer_t *mixer, unsigned int channels, unsigned int sample_rate, unsigned int period_frames, audio_mixer_write_t write, void *priv);
+
+/****************************************************************************
+ * Name: audio_mixer_deinit
+ *
+ * Description:
+ *   Stop the mixing thread and release all inputs.
+ *   Must not be called with a lock which the write callback takes.
+ *
+ * Input parameters:
+ *   mixer: mixer to be released
+ ****************************************************************************/
+void audio_mixer_deinit(audio_mixer_t *mixer);
+
+/****************************************************************************
+ * Name: audio_mixer_add_input
+ *
+ * Description:
+ *   Add an input for the stream, or reconfigure it if it is already added.
+ *   Data of the stream is converted to the card format when written.
+ *
+ * Input parameters:
+ *   mixer: mixer of the card
+ *   stream_id: stream info id of the input
+ *   channels: number of channels of the stream
+ *   sample_rate: sample rate of the stream
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_add_input(audio_mixer_t *mixer, stream_info_id_t stream_id, unsigned int channels, unsigned int sample_rate);
+
+/****************************************************************************
+ * Name: audio_mixer_remove_input
+ *
+ * Description:
+ *   Remove the input of the stream, data not mixed yet is dropped.
+ *
+ * Input parameters:
+ *   mixer: mixer of the card
+ *   stream_id: stream info id of the input
+ ****************************************************************************/
+void audio_mixer_remove_input(audio_mixer_t *mixer, stream_info_id_t stream_id);
+
+/****************************************************************************
+ * Name: audio_mixer_write
+ *
+ * Description:
+ *   Convert frames of the stream to the card format and queue them to be
+ *   mixed. Blocks while the input is full. A paused input is resumed.
+ *
+ * Input parameters:
+ *   mixer: mixer of the card
+ *   stream_id: stream info id of the input
+ *   data: 16 bits frames in the format given to audio_mixer_add_input()
+ *   frames: number of frames
+ *
+ * Return Value:
+ *   On success, the number of frames queued. Otherwise, a negative value.
+ ****************************************************************************/
+int audio_mixer_write(audio_mixer_t *mixer, stream_info_id_t stream_id, const void *data, unsigned int frames);
+
+/****************************************************************************
+ * Name: audio_mixer_pause_input
+ *
+ * Description:
+ *   Pause the input of the stream, its queued data is kept.
+ *
+ * Input parameters:
+ *   mixer: mixer of the card
+ *   stream_id: stream info id of the input
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_pause_input(audio_mixer_t *mixer, stream_info_id_t stream_id);
+
+/****************************************************************************
+ * Name: audio_mixer_stop_input
+ *
+ * Description:
+ *   Wait until queued data of the stream is mixed, or drop it.
+ *
+ * Input parameters:
+ *   mixer: mixer of the card
+ *   stream_id: stream info id of the input
+ *   drain: true to wait for queued data, false to drop it
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_stop_input(audio_mixer_t *mixer, stream_info_id_t stream_id, bool drain);
+
+/****************************************************************************
+ * Name: audio_mixer_set_input_gain
+ *
+ * Description:
+ *   Set the gain of the input, the change is ramped over one block.
+ *
+ * Input parameters:
+ *   mixer: mixer of the card
+ *   stream_id: stream info id of the input
+ *   gain: gain in Q14 format, up to AUDIO_MIXER_GAIN_UNITY
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_set_input_gain(audio_mixer_t *mixer, stream_info_id_t stream_id, uint16_t gain);
+
+/****************************************************************************
+ * Name: audio_mixer_set_input_policy
+ *
+ * Description:
+ *   Set the stream policy of the input. While an input of a higher policy
+ *   has data, inputs of lower policies are attenuated to
+ *   CONFIG_AUDIO_MIXER_DUCK_LEVEL percent.
+ *
+ * Input parameters:
+ *   mixer: mixer of the card
+ *   stream_id: stream info id of the input
+ *   policy: stream policy
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t audio_mixer_set_input_policy(audio_mixer_t *mixer, stream_info_id_t stream_id, stream_policy_t policy);
+
+/****************************************************************************
+ * Name: audio_mixer_get_input_count
+ *
+ * Description:
+ *   Get the number of inputs added to the mixer.
+ *
+ * Input parameters:
+ *   mixer: mixer of the card
+ *
+ * Return Value:
+ *   Number of inputs.
+ ****************************************************************************/
+unsigned int audio_mixer_get_input_count(audio_mixer_t *mixer);
+
+/****************************************************************************
+ * Name: audio_mixer_is_idle
+ *
+ * Description:
+ *   Check if no input has data to be mixed, paused inputs are not counted.
+ *
+ * Input parameters:
+ *   mixer: mixer of the card
+ *
+ * Return Value:
+ *   true if the mixer is idle, otherwise false.
+ ****************************************************************************/
+bool audio_mixer_is_idle(audio_mixer_t *mixer);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif							/* __AUDIO_MIXER_H */
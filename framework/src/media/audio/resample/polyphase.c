@@ -0,0 +1,307 @@
+/******************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <tinyara/compiler.h>
+#include "polyphase.h"
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#define POLYPHASE_USE_MVE
+#elif defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+#include <arm_acle.h>
+#define POLYPHASE_USE_DSP
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#if (CONFIG_AUDIO_RESAMPLER_POLYPHASE_TAPS % 8) != 0
+#error "CONFIG_AUDIO_RESAMPLER_POLYPHASE_TAPS should be multiple of 8!"
+#endif
+
+#define TAPS            CONFIG_AUDIO_RESAMPLER_POLYPHASE_TAPS
+#define MAX_PHASES      CONFIG_AUDIO_RESAMPLER_POLYPHASE_MAX_PHASES
+
+#define Q15_ONE         (1 << 15)
+#define Q15_ROUND       (1 << 14)
+
+// Pass band edge relative to the nyquist frequency of the lower sample rate
+#define PASSBAND_RATIO  (0.9f)
+
+#define PI_F            (3.14159265358979f)
+
+// Pack low halves (PKHBT) or high halves (PKHTB) of two words into one word
+#define PACK_LO(a, b)   ((int32_t)(((uint32_t)(a) & 0xffff) | ((uint32_t)(b) << 16)))
+#define PACK_HI(a, b)   ((int32_t)(((uint32_t)(a) >> 16) | ((uint32_t)(b) & 0xffff0000)))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static int gcd(int a, int b)
+{
+	while (b != 0) {
+		int t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+static inline int16_t clip(int32_t x)
+{
+	// Both bounds are selected without branches
+	x = x > INT16_MAX ? INT16_MAX : x;
+	return (int16_t)(x < INT16_MIN ? INT16_MIN : x);
+}
+
+/**
+ * @brief   Windowed sinc low pass kernel.
+ * @param   t: distance to the kernel center, in input frames.
+ * @param   fc: cutoff frequency relative to the input sample rate.
+ * @param   half: half length of the kernel, in input frames.
+ */
+static float kernel(float t, float fc, float half)
+{
+	if (t <= -half || t >= half) {
+		return 0.0f;
+	}
+
+	float x = 2.0f * fc * t;
+	float sinc = (fabsf(x) < 1e-6f) ? 1.0f : sinf(PI_F * x) / (PI_F * x);
+	// Blackman window
+	float w = (t + half) / (2.0f * half);
+	float window = 0.42f - 0.5f * cosf(2.0f * PI_F * w) + 0.08f * cosf(4.0f * PI_F * w);
+	return 2.0f * fc * sinc * window;
+}
+
+/**
+ * @brief   Multiply-accumulate TAPS frames of interleaved samples with one phase.
+ * @remarks Packed 16bit multiply-accumulate is used if the core supports it,
+ *          2 (DSP extension) or 8 (Helium) taps are processed at one time.
+ *          acc[0] and acc[1] accumulate the first and second channel.
+ *          It is inlined with constant channels, so that the loop is fully unrolled.
+ */
+static inline_function inline void dot_product(const int16_t *in, const int16_t *coeff, int channels, int32_t acc[2])
+{
+	const int taps = TAPS;
+	int i;
+#if defined(POLYPHASE_USE_MVE)
+	if (channels == 1) {
+		for (i = 0; i < taps; i += 8) {
+			acc[0] = vmladavaq_s16(acc[0], vld1q_s16(in + i), vld1q_s16(coeff + i));
+		}
+	} else {
+		for (i = 0; i < taps; i += 8) {
+			int16x8x2_t frames = vld2q_s16(in + i * 2);
+			int16x8_t h = vld1q_s16(coeff + i);
+			acc[0] = vmladavaq_s16(acc[0], frames.val[0], h);
+			acc[1] = vmladavaq_s16(acc[1], frames.val[1], h);
+		}
+	}
+#elif defined(POLYPHASE_USE_DSP)
+	const int16_t *h = coeff;
+	if (channels == 1) {
+		for (i = 0; i < taps; i += 2) {
+			int16x2_t x, c;
+			memcpy(&x, in + i, sizeof(x));
+			memcpy(&c, h + i, sizeof(c));
+			acc[0] = __smlad(x, c, acc[0]);
+		}
+	} else {
+		for (i = 0; i < taps; i += 2) {
+			// Two stereo frames (L0 R0) (L1 R1), pack them to (L0 L1) and (R0 R1).
+			int16x2_t f0, f1, c;
+			memcpy(&f0, in + i * 2, sizeof(f0));
+			memcpy(&f1, in + i * 2 + 2, sizeof(f1));
+			memcpy(&c, h + i, sizeof(c));
+			acc[0] = __smlad(PACK_LO(f0, f1), c, acc[0]);
+			acc[1] = __smlad(PACK_HI(f0, f1), c, acc[1]);
+		}
+	}
+#else
+	int32_t a0 = 0;
+	int32_t a1 = 0;
+	if (channels == 1) {
+		for (i = 0; i < taps; i++) {
+			a0 += in[i] * coeff[i];
+		}
+	} else {
+		for (i = 0; i < taps; i++) {
+			a0 += in[i * 2] * coeff[i];
+			a1 += in[i * 2 + 1] * coeff[i];
+		}
+	}
+	acc[0] += a0;
+	acc[1] += a1;
+#endif
+}
+
+/**
+ * @brief   Row of the filter bank for the phase of the next output frame.
+ * @remarks Ratios with more phases than the bank round the phase to the nearest row,
+ *          the last row is one input frame after the first one.
+ */
+static inline int bank_row(const polyphase_t *pp, int phase)
+{
+	if (pp->rows == pp->phases) {
+		return phase;
+	}
+	return (phase * (pp->rows - 1) + pp->phases / 2) / pp->phases;
+}
+
+/**
+ * @brief   Convert frames of constant channels, see polyphase_process().
+ */
+static inline_function inline int process_frames(polyphase_t *pp, const int16_t *in, int in_frames, int16_t *out, int out_frames, int channels, int *next_pos)
+{
+	const int16_t *bank = pp->bank;
+	int pos = pp->offset;
+	int phase = pp->phase;
+	int num_out = 0;
+
+	while (pos < in_frames && num_out < out_frames) {
+		int32_t acc[2] = { Q15_ROUND, Q15_ROUND };
+		dot_product(in + pos * channels, bank + bank_row(pp, phase) * TAPS, channels, acc);
+
+		*out++ = clip(acc[0] >> 15);
+		if (channels == 2) {
+			*out++ = clip(acc[1] >> 15);
+		}
+		num_out++;
+
+		pos += pp->step_int;
+		phase += pp->step_frac;
+		if (phase >= pp->phases) {
+			phase -= pp->phases;
+			pos++;
+		}
+	}
+
+	pp->phase = phase;
+	*next_pos = pos;
+	return num_out;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+int polyphase_init(polyphase_t *pp, int old_rate, int new_rate)
+{
+	if (pp == NULL || old_rate <= 0 || new_rate <= 0) {
+		return -1;
+	}
+
+	int div = gcd(old_rate, new_rate);
+	int phases = new_rate / div;
+	int decimation = old_rate / div;
+
+	// Ratios of too many phases take MAX_PHASES rows spaced evenly, and one more for rounding up.
+	int rows = (phases <= MAX_PHASES) ? phases : MAX_PHASES + 1;
+	int spacing = (phases <= MAX_PHASES) ? phases : MAX_PHASES;
+
+	int taps = TAPS;
+	pp->bank = (int16_t *)malloc(rows * taps * sizeof(int16_t));
+	if (pp->bank == NULL) {
+		return -1;
+	}
+
+	pp->taps = taps;
+	pp->rows = rows;
+	pp->phases = phases;
+	pp->decimation = decimation;
+	pp->step_int = decimation / phases;
+	pp->step_frac = decimation % phases;
+	pp->phase = 0;
+	pp->offset = 0;
+
+	// Cut off at the nyquist frequency of the lower sample rate, to avoid aliasing and imaging.
+	float fc = 0.5f * PASSBAND_RATIO * ((phases < decimation) ? (float)phases / (float)decimation : 1.0f);
+	float half = (float)taps / 2.0f;
+
+	int p, k;
+	for (p = 0; p < rows; p++) {
+		int16_t *h = pp->bank + p * taps;
+		float coeff[TAPS];
+		float sum = 0.0f;
+
+		// Output frame of row p is located at p/spacing after the center of input frames [0, taps).
+		for (k = 0; k < taps; k++) {
+			coeff[k] = kernel((half - 1.0f) + (float)p / (float)spacing - (float)k, fc, half);
+			sum += coeff[k];
+		}
+
+		// Normalize to unity DC gain, and put the rounding error to the largest tap.
+		int32_t total = 0;
+		int center = 0;
+		for (k = 0; k < taps; k++) {
+			int32_t q = (int32_t)lrintf(coeff[k] / sum * (float)Q15_ONE);
+			h[k] = clip(q);
+			total += h[k];
+			if (abs(h[k]) > abs(h[center])) {
+				center = k;
+			}
+		}
+		h[center] = clip(h[center] + (Q15_ONE - total));
+	}
+
+	return 0;
+}
+
+void polyphase_deinit(polyphase_t *pp)
+{
+	if (pp != NULL) {
+		free(pp->bank);
+		pp->bank = NULL;
+	}
+}
+
+int polyphase_overlap(polyphase_t *pp)
+{
+	return pp->taps;
+}
+
+int polyphase_process(polyphase_t *pp, const int16_t *in, int *in_frames, int16_t *out, int out_frames, int channels)
+{
+	int pos;
+	int num_out;
+
+	if (channels == 1) {
+		num_out = process_frames(pp, in, *in_frames, out, out_frames, 1, &pos);
+	} else {
+		num_out = process_frames(pp, in, *in_frames, out, out_frames, 2, &pos);
+	}
+
+	if (num_out == 0) {
+		// Nothing converted, keep state and wait for more input frames.
+		*in_frames = 0;
+		return 0;
+	}
+
+	// pos may step over the available frames in downsampling, skip the rest next time.
+	if (pos > *in_frames) {
+		pp->offset = pos - *in_frames;
+	} else {
+		pp->offset = 0;
+		*in_frames = pos;
+	}
+	return num_out;
+}
@@ -0,0 +1,107 @@
+/******************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef POLYPHASE_H
+#define POLYPHASE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+// Number of filter taps of each phase, must be multiple of 8
+#ifndef CONFIG_AUDIO_RESAMPLER_POLYPHASE_TAPS
+#define CONFIG_AUDIO_RESAMPLER_POLYPHASE_TAPS 16
+#endif
+
+// Maximum number of phases of a filter bank, ratios whose interpolation factor L is larger round
+// the phase of each output frame to the nearest of these
+#ifndef CONFIG_AUDIO_RESAMPLER_POLYPHASE_MAX_PHASES
+#define CONFIG_AUDIO_RESAMPLER_POLYPHASE_MAX_PHASES 160
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+/**
+ * @structure polyphase_t
+ * @brief     Polyphase FIR resampler for the rational ratio L/M.
+ *            Filter bank is precomputed per ratio in Q15 format, phase p holds
+ *            taps for output samples located at p/L between two input frames.
+ */
+struct polyphase_s {
+	int16_t *bank;          // filter bank, 'rows' rows of 'taps' coefficients
+	int taps;               // number of taps of each phase
+	int rows;               // number of phases in the bank, 'phases' or MAX_PHASES + 1
+	int phases;             // interpolation factor L
+	int decimation;         // decimation factor M
+	int step_int;           // M / L, input frames to step for each output frame
+	int step_frac;          // M % L, phase to step for each output frame
+	int phase;              // phase of the next output frame
+	int offset;             // input frames to skip before the next output frame
+};
+
+typedef struct polyphase_s polyphase_t;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+/**
+ * @brief   Build filter bank for converting 'old_rate' to 'new_rate'.
+ * @param   pp: pointer to the resampler object.
+ * @param   old_rate: sample rate of input frames.
+ * @param   new_rate: sample rate of output frames.
+ * @return  0 on success, negative value if the rates are invalid or out of memory.
+ */
+int polyphase_init(polyphase_t *pp, int old_rate, int new_rate);
+
+/**
+ * @brief   Release filter bank allocated in polyphase_init().
+ * @param   pp: pointer to the resampler object.
+ */
+void polyphase_deinit(polyphase_t *pp);
+
+/**
+ * @brief   Number of input frames must be kept after the last used frame,
+ *          since each output frame is convolved with 'taps' input frames.
+ * @param   pp: pointer to the resampler object.
+ */
+int polyphase_overlap(polyphase_t *pp);
+
+/**
+ * @brief   Convert interleaved 16bit frames in blocks.
+ * @param   pp: pointer to the resampler object.
+ * @param   in: input frames, (in_frames + overlap) frames must be readable.
+ * @param   in_frames: input/output parameter, number of frames available for converting,
+ *          and retrieve number of frames used actually.
+ * @param   out: output frames buffer.
+ * @param   out_frames: capability of output frames buffer.
+ * @param   channels: number of interleaved channels, 1 or 2.
+ * @return  number of frames generated.
+ */
+int polyphase_process(polyphase_t *pp, const int16_t *in, int *in_frames, int16_t *out, int out_frames, int channels);
+
+#ifdef __cplusplus
+}		/* extern "C" */
+#endif	/* __cplusplus */
+
+#endif	/* POLYPHASE_H */
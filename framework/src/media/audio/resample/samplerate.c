@@ -30,6 +30,7 @@
 #include <string.h>
 #include <math.h>
 #include "samplerate.h"
+#include "polyphase.h"
 #include "../../utils/remix.h"
 
 
@@ -90,6 +91,13 @@
 #define OLD_FRAMES_TO_BYTES(src, frames) ((frames) * (src)->old_channel_num * BYTES_PER_SAMPLE((src)->old_sample_width))
 #define NEW_FRAMES_TO_BYTES(src, frames) ((frames) * (src)->new_channel_num * BYTES_PER_SAMPLE((src)->new_sample_width))
 
+// Default resampling engine
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+#define SRC_ENGINE_DEFAULT SRC_ENGINE_POLYPHASE
+#else
+#define SRC_ENGINE_DEFAULT SRC_ENGINE_LINEAR
+#endif
+
 // Check src context initialized or not
 #define CHECK_SRC_CONTEXT_INIT(src) ((src)->in_buffer != NULL)
 
@@ -104,6 +112,7 @@
 struct src_context_s {
 	int16_t *in_buffer;     // pointer to the internal input buffer allocated
 	int16_t *out_buffer;    // pointer to the external output buffer assigned
+	int out_buffer_frames;  // capability of the external output buffer in frames
 	int in_buffer_bytes;    // internal input buffer capability in bytes
 	int in_buffer_frames;   // internal input buffer capability in frames
 	int left_frames;        // number of frames remained in internal input buffer
@@ -119,6 +128,8 @@ struct src_context_s {
 	float ratio;            // (float)new_sample_rate / (float)old_sample_rate
 	float inverse_ratio;    // (float)old_sample_rate / (float)new_sample_rate
 	uint32_t fp_frac;       // fraction part value of last fixed point index
+	int engine;             // resampling engine, SRC_ENGINE_*
+	polyphase_t poly;       // polyphase filter bank, used by SRC_ENGINE_POLYPHASE
 	/**
 	 * @brief   Function pointer to resampling process function
 	 * @param   src_context_t *: pointer to resampler object.
@@ -244,6 +255,18 @@ static int32_t downresample_int(src_context_t *src, int32_t *num_frames_in)
 	return num_frames_out;
 }
 
+/**
+ * It handles all ratio cases with a polyphase filter bank precomputed for the ratio,
+ * output frames are low pass filtered and interpolated in a single pass.
+ */
+static int32_t resample_polyphase(src_context_t *src, int32_t *num_frames_in)
+{
+	int frames = *num_frames_in;
+	int num_frames_out = polyphase_process(&src->poly, src->in_buffer, &frames, src->out_buffer, src->out_buffer_frames, src->new_channel_num);
+	*num_frames_in = frames;
+	return num_frames_out;
+}
+
 /**
  * @brief   Do filtering once new frames added to internal buffer.
  * @param   src: pointer to resampler object.
@@ -335,7 +358,12 @@ static int init_src_context(src_context_t *src, src_data_t *src_data)
 	src->inverse_ratio = (float)src->old_sample_rate / (float)src->new_sample_rate;
 
 	// Set overlap frame number and converting function as per converting ratio
-	if (src->old_sample_rate > src->new_sample_rate) {
+	if ((src->engine == SRC_ENGINE_POLYPHASE) && (polyphase_init(&src->poly, src->old_sample_rate, src->new_sample_rate) == 0)) {
+		// polyphase filter bank is available for the ratio
+		src->filter_coeff = NULL;
+		src->overlap_frames = polyphase_overlap(&src->poly);
+		src->src_func = resample_polyphase;
+	} else if (src->old_sample_rate > src->new_sample_rate) {
 		// down resampling
 		if (src->old_sample_rate % src->new_sample_rate == 0) {
 			// inverse ratio 2.0/3.0 cases. e.g. 48K->16K, 48K->24K, 44.1K->22.05K, ...
@@ -378,6 +406,8 @@ src_handle_t src_init(int size)
 	src->in_buffer_bytes = (((size + max_frame_size - 1) / max_frame_size) * max_frame_size);
 	src->in_buffer_frames = 0;
 	src->in_buffer = NULL;
+	src->engine = SRC_ENGINE_DEFAULT;
+	src->poly.bank = NULL;
 	// Other members will be initilized before first use,
 	// as soon as in_buffer allocated in init_src_context().
 
@@ -391,11 +421,24 @@ int src_destroy(src_handle_t handle)
 
 	free(src->in_buffer);
 	src->in_buffer = NULL;
+	polyphase_deinit(&src->poly);
 
 	free(src);
 	return SRC_ERR_NO_ERROR;
 }
 
+int src_set_engine(src_handle_t handle, int engine)
+{
+	src_context_t *src = (src_context_t *)handle;
+	RETURN_VAL_IF_FAIL((src != NULL), SRC_ERR_BAD_PARAMS);
+	RETURN_VAL_IF_FAIL(((engine == SRC_ENGINE_LINEAR) || (engine == SRC_ENGINE_POLYPHASE)), SRC_ERR_BAD_PARAMS);
+	// Engine can not be changed after converting started
+	RETURN_VAL_IF_FAIL(!CHECK_SRC_CONTEXT_INIT(src), SRC_ERR_NOT_SUPPORT);
+
+	src->engine = engine;
+	return SRC_ERR_NO_ERROR;
+}
+
 bool src_is_valid_ratio(float ratio)
 {
 	if ((ratio <= SRC_MAX_RATIO) && (ratio >= SRC_MIN_RATIO)) {
@@ -442,6 +485,7 @@ int src_simple(src_handle_t handle, src_data_t *src_data)
 
 	// Update output buffer to src context (used in converting proccess functions)
 	src->out_buffer = (int16_t *)src_data->data_out;
+	src->out_buffer_frames = out_buffer_frames;
 
 	// Move remaining frames in internal buffer
 	if ((src->used_frames > 0) && (src->left_frames > 0)) {
@@ -67,6 +67,17 @@ enum {
 	SAMPLE_WIDTH_MAX = SAMPLE_WIDTH_32BITS,
 };
 
+/**
+ * @enum  Define resampling engines.
+ * @brief SRC_ENGINE_LINEAR interpolates linearly, with a fixed FIR pre-filter for downsampling.
+ *        SRC_ENGINE_POLYPHASE filters and interpolates in one pass with a polyphase filter bank
+ *        precomputed per ratio, it falls back to SRC_ENGINE_LINEAR if the ratio needs too many phases.
+ */
+enum {
+	SRC_ENGINE_LINEAR = 0,
+	SRC_ENGINE_POLYPHASE = 1,
+};
+
 /**
  * @typedef src_handle_t, SRC(Sample Rate Convertor) hanlde type declaration.
  * @brief   NULL means invalid handle.
@@ -135,6 +146,17 @@ src_handle_t src_init(int size);
  */
 int src_destroy(src_handle_t handle);
 
+/**
+ * @brief   Select resampling engine.
+ * @remarks Engine must be selected before the first src_simple() call,
+ *          default engine is SRC_ENGINE_POLYPHASE if CONFIG_AUDIO_RESAMPLER_POLYPHASE enabled.
+ * @param   handle: pointer to a SRC instance, returned by src_init().
+ * @param   engine: SRC_ENGINE_LINEAR or SRC_ENGINE_POLYPHASE.
+ * @return  0 on success, otherwise, it means failure.
+ * @see     src_init()
+ */
+int src_set_engine(src_handle_t handle, int engine);
+
 /**
  * @brief   Check if the conversion ratio is valid or not.
  * @remarks To provide high quality SRC, conversion ratio is limited in a range.
@@ -143,9 +143,12 @@ typedef struct pcm_data_s *pcm_data_p;
  */
 struct priv_data_s {
 	ssize_t mCurrentPos;        /* read position when decoding */
+	ssize_t mFramePos;          /* position of the frame got last */
 	uint32_t mFixedHeader;      /* mp3 frame header */
 	pcm_data_t pcm;             /* a recorder of pcm data info */
 	src_handle_t mResampler;    /* resampler handle */
+	audio_decoder_frame_callback_t mFrameCallback; /* frame position callback */
+	void *mFrameCallbackUser;   /* user data of frame position callback */
 };
 
 typedef struct priv_data_s priv_data_t;
@@ -807,29 +810,40 @@ bool _get_frame(audio_decoder_p decoder)
 	priv_data_p priv = (priv_data_p) decoder->priv_data;
 	assert(priv != NULL);
 
+	bool ret;
+	uint32_t *frame_size;
+
 	switch (decoder->audio_type) {
 #ifdef CONFIG_CODEC_MP3
 	case AUDIO_TYPE_MP3: {
 		tPVMP3DecoderExternal *mp3_ext = (tPVMP3DecoderExternal *) decoder->dec_ext;
-		return mp3_get_frame(decoder->rbsp, &priv->mCurrentPos, &priv->mFixedHeader, (void *)mp3_ext->pInputBuffer, (uint32_t *)&mp3_ext->inputBufferCurrentLength);
+		frame_size = (uint32_t *)&mp3_ext->inputBufferCurrentLength;
+		ret = mp3_get_frame(decoder->rbsp, &priv->mCurrentPos, &priv->mFixedHeader, (void *)mp3_ext->pInputBuffer, frame_size);
+		break;
 	}
 #endif
 #ifdef CONFIG_CODEC_AAC
 	case AUDIO_TYPE_AAC: {
 		tPVMP4AudioDecoderExternal *aac_ext = (tPVMP4AudioDecoderExternal *) decoder->dec_ext;
-		return aac_get_frame(decoder->rbsp, &priv->mCurrentPos, (void *)aac_ext->pInputBuffer, (uint32_t *)&aac_ext->inputBufferCurrentLength);
+		frame_size = (uint32_t *)&aac_ext->inputBufferCurrentLength;
+		ret = aac_get_frame(decoder->rbsp, &priv->mCurrentPos, (void *)aac_ext->pInputBuffer, frame_size);
+		break;
 	}
 #endif
 	case AUDIO_TYPE_WAVE: {
 		wav_dec_external_t *wav_ext = (wav_dec_external_t *) decoder->dec_ext;
 		wav_ext->inputBufferCurrentLength = wav_ext->inputBufferMaxLength;
-		return wav_get_frame(decoder->rbsp, &priv->mCurrentPos, decoder->dec_mem, (void *)wav_ext->pInputBuffer, (uint32_t *)&wav_ext->inputBufferCurrentLength);
+		frame_size = (uint32_t *)&wav_ext->inputBufferCurrentLength;
+		ret = wav_get_frame(decoder->rbsp, &priv->mCurrentPos, decoder->dec_mem, (void *)wav_ext->pInputBuffer, frame_size);
+		break;
 	}
 
 #ifdef CONFIG_CODEC_LIBOPUS
 	case AUDIO_TYPE_OPUS: {
 		opus_dec_external_t *opus_ext = (opus_dec_external_t *) decoder->dec_ext;
-		return opus_get_frame(decoder->rbsp, &priv->mCurrentPos, (void *)opus_ext->pInputBuffer, (uint32_t *)&opus_ext->inputBufferCurrentLength);
+		frame_size = (uint32_t *)&opus_ext->inputBufferCurrentLength;
+		ret = opus_get_frame(decoder->rbsp, &priv->mCurrentPos, (void *)opus_ext->pInputBuffer, frame_size);
+		break;
 	}
 #endif
 
@@ -837,6 +851,13 @@ bool _get_frame(audio_decoder_p decoder)
 		medwdbg("[%s] unsupported audio type: %d\n", __FUNCTION__, decoder->audio_type);
 		return false;
 	}
+
+	if (ret) {
+		// mCurrentPos has been moved to the end of the frame
+		priv->mFramePos = priv->mCurrentPos - (ssize_t)*frame_size;
+	}
+
+	return ret;
 }
 
 int _init_decoder(audio_decoder_p decoder, void *dec_ext)
@@ -1081,6 +1102,10 @@ size_t audio_decoder_get_frames(audio_decoder_p decoder, unsigned char *buf, siz
 			meddbg("frame decoding failed!\n");
 			break;
 		}
+
+		if (priv->mFrameCallback != NULL && pcm->channels > 0) {
+			priv->mFrameCallback(priv->mFrameCallbackUser, (size_t)priv->mFramePos, pcm->length / pcm->channels, pcm->samplerate);
+		}
 	}
 
 	// Output sample rate if desired
@@ -1096,6 +1121,16 @@ size_t audio_decoder_get_frames(audio_decoder_p decoder, unsigned char *buf, siz
 	return size;
 }
 
+void audio_decoder_set_frame_callback(audio_decoder_p decoder, audio_decoder_frame_callback_t callback, void *user)
+{
+	assert(decoder != NULL);
+
+	priv_data_p priv = (priv_data_p) decoder->priv_data;
+	RETURN_IF_FAIL(priv != NULL);
+
+	priv->mFrameCallback = callback;
+	priv->mFrameCallbackUser = user;
+}
 
 int audio_decoder_init(audio_decoder_p decoder, size_t rbuf_size)
 {
@@ -1106,9 +1141,12 @@ int audio_decoder_init(audio_decoder_p decoder, size_t rbuf_size)
 
 	// init private data
 	priv->mCurrentPos = 0;
+	priv->mFramePos = 0;
 	priv->mFixedHeader = 0;
 	memset(&(priv->pcm), 0, sizeof(pcm_data_t));
 	priv->mResampler = NULL;
+	priv->mFrameCallback = NULL;
+	priv->mFrameCallbackUser = NULL;
 
 	// init decoder data
 	decoder->dec_ext = NULL;
@@ -40,6 +40,15 @@ struct audio_decoder_s;
 typedef struct audio_decoder_s audio_decoder_t;
 typedef struct audio_decoder_s *audio_decoder_p;
 
+/**
+ * @brief  Callback invoked for each frame decoded successfully.
+ * @param  user : user data given to audio_decoder_set_frame_callback()
+ * @param  offset : byte offset of the frame, counted from the first byte pushed to decoder
+ * @param  samples : number of samples per channel decoded from the frame
+ * @param  sample_rate : sample rate (Hz) of the decoded samples
+ */
+typedef void (*audio_decoder_frame_callback_t)(void *user, size_t offset, unsigned int samples, unsigned int sample_rate);
+
 /**
  * @struct  audio_decoder_s
  * @brief   Decoder structure, support decoding various types of audio stream, see enum audio_type_e.
@@ -141,6 +150,15 @@ int audio_decoder_configure(audio_decoder_p decoder, int audio_type, void *dec_e
  */
 size_t audio_decoder_get_frames(audio_decoder_p decoder, unsigned char *buf, size_t max, unsigned int *sr, unsigned short *ch);
 
+/**
+ * @brief  Set callback to be notified of the position of each decoded frame.
+ *
+ * @param  decoder : Pointer to decoder object
+ * @param  callback : Callback invoked in audio_decoder_get_frames(), NULL to disable
+ * @param  user : user data passed to callback
+ */
+void audio_decoder_set_frame_callback(audio_decoder_p decoder, audio_decoder_frame_callback_t callback, void *user);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
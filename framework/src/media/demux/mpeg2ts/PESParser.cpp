@@ -19,7 +19,6 @@
 #include <debug.h>
 #include "Mpeg2TsTypes.h"
 #include "PESParser.h"
-#include "PESPacket.h"
 
 #define PES_PACKET_HEAD_BYTES               (6) // packet_start_code_prefix + stream_id + packet length fields
 #define PES_STREAM_HEAD_BYTES               (3) // stream info + 7 flags + PES head data length fields
@@ -28,7 +27,8 @@
 #define PACKET_LENGTH(buffer)               ((buffer[4] << 8) | buffer[5])
 
 PESParser::PESParser()
-	: mPacketStartCodePrefix(0)
+	: mPESData(nullptr)
+	, mPacketStartCodePrefix(0)
 	, mStreamId(0)
 	, mPacketLength(0)
 	, mPESHeaderDataLength(0)
@@ -39,17 +39,15 @@ PESParser::~PESParser()
 {
 }
 
-bool PESParser::parse(std::shared_ptr<PESPacket> pPESPacket)
+bool PESParser::parse(uint8_t *pData, uint32_t size)
 {
-	if (!pPESPacket) {
-		meddbg("pPESPacket is null!\n");
+	if (!pData || size < PES_PACKET_HEAD_BYTES) {
+		meddbg("PES packet data is null or too short (%u)!\n", size);
 		reset();
 		return false;
 	}
 
-	mPESPacket = pPESPacket;
-
-	uint8_t *pData = mPESPacket->getDataPtr();
+	mPESData = pData;
 	mPacketStartCodePrefix = PACKET_START_CODE_PREFIX(pData);
 	mStreamId = STREAM_ID(pData);
 	mPacketLength = PACKET_LENGTH(pData);
@@ -60,7 +58,7 @@ bool PESParser::parse(std::shared_ptr<PESPacket> pPESPacket)
 		return false;
 	}
 
-	if ((size_t)PES_PACKET_HEAD_BYTES + mPacketLength > mPESPacket->getDataLen()) {
+	if ((size_t)PES_PACKET_HEAD_BYTES + mPacketLength > size) {
 		meddbg("Packet length overflow!\n");
 		reset();
 		return false;
@@ -73,6 +71,11 @@ bool PESParser::parseStream(uint8_t *pData, uint32_t size)
 {
 	if (mStreamId >= 0xc0 && mStreamId <= 0xdf) {
 		// stream id = 110xxxxx means audio streams
+		if (size < PES_STREAM_HEAD_BYTES || size < (uint32_t)PES_STREAM_HEAD_BYTES + pData[2]) {
+			meddbg("PES header data length overflow!\n");
+			reset();
+			return false;
+		}
 		mPESScramblingControl   = (pData[0] >> 4) & 0x3;
 		mPESPriority            = (pData[0] >> 3) & 0x1;
 		mDataAlignmentIndicator = (pData[0] >> 2) & 0x1;
@@ -97,17 +100,17 @@ bool PESParser::parseStream(uint8_t *pData, uint32_t size)
 
 uint8_t *PESParser::getESData(void)
 {
-	if (!mPESPacket) {
+	if (!mPESData) {
 		// no PES packet, it's normal case.
 		return nullptr;
 	}
 
-	return mPESPacket->getDataPtr() + PES_PACKET_HEAD_BYTES + PES_STREAM_HEAD_BYTES + mPESHeaderDataLength;
+	return mPESData + PES_PACKET_HEAD_BYTES + PES_STREAM_HEAD_BYTES + mPESHeaderDataLength;
 }
 
 uint16_t PESParser::getESDataLen(void)
 {
-	if (!mPESPacket) {
+	if (!mPESData) {
 		meddbg("There's no valid PES packet!\n");
 		return 0;
 	}
@@ -118,7 +121,7 @@ uint16_t PESParser::getESDataLen(void)
 void PESParser::reset(void)
 {
 	medvdbg("reset PES packet!\n");
-	mPESPacket = nullptr;
+	mPESData = nullptr;
 	mPacketStartCodePrefix = 0;
 	mStreamId = 0;
 	mPacketLength = 0;
@@ -19,10 +19,8 @@
 #ifndef __PES_PARSER_H
 #define __PES_PARSER_H
 
-#include <memory>
 #include "Mpeg2TsTypes.h"
 
-class PESPacket;
 class PESParser
 {
 public:
@@ -32,13 +30,13 @@ public:
 
 	PESParser();
 	virtual ~PESParser();
-	// parse PES packet, and the parser will add reference to the packet.
-	bool parse(std::shared_ptr<PESPacket> pPESPacket);
+	// parse a completed PES packet in place, the data must be kept until reset.
+	bool parse(uint8_t *pData, uint32_t size);
 	// get ES data in PES
 	uint8_t *getESData(void);
 	// get ES data length
 	uint16_t getESDataLen(void);
-	// reset PES parser, to remove reference of the PES packet
+	// reset PES parser, to remove reference of the PES packet data
 	void reset(void);
 
 protected:
@@ -46,8 +44,8 @@ protected:
 	bool parseStream(uint8_t *pData, uint32_t size);
 
 private:
-	// PES packet reference
-	std::shared_ptr<PESPacket> mPESPacket;
+	// PES packet data reference
+	uint8_t *mPESData;
 	// packet start code prefix
 	uint32_t mPacketStartCodePrefix;
 	// stream id
@@ -27,7 +27,6 @@
 #include "PATParser.h"
 #include "ParseManager.h"
 #include "PMTElementary.h"
-#include "PESPacket.h"
 #include "PESParser.h"
 #include "TSDemuxer.h"
 
@@ -39,6 +38,12 @@
 #define TS_SYNC_COUNT               (3)
 // threshold is not used, we don't have any buffer observer now.
 #define TS_DEMUX_BUFFER_THRESHOLD   (CONFIG_DEMUX_BUFFER_SIZE / 2)
+// PES packet header: packet_start_code_prefix + stream_id + PES_packet_length
+#define PES_PACKET_HEAD_BYTES       (6)
+#define PES_PACKET_LENGTH(buffer)   ((buffer[4] << 8) | buffer[5])
+#define CONTINUITY_COUNTER_MOD      (16)
+#define PID_FILTER_SET(filter, pid)  ((filter)[(pid) >> 3] |= (uint8_t)(1 << ((pid) & 7)))
+#define PID_FILTER_TEST(filter, pid) ((filter)[(pid) >> 3] & (1 << ((pid) & 7)))
 
 namespace media {
 
@@ -46,11 +51,21 @@ TSDemuxer::TSDemuxer()
 	: Demuxer(AUDIO_TYPE_MP2T)
 	, mPESPid(INVALID_PID)
 	, mPESDataUsed(0)
+	, mPESBuffer(nullptr)
+	, mPESBufferSize(0)
+	, mPESLength(0)
+	, mPESPresentLen(0)
+	, mPESContinuityCounter(0)
 {
+	memset(mPESPidFilter, 0, sizeof(mPESPidFilter));
 }
 
 TSDemuxer::~TSDemuxer()
 {
+	if (mPESBuffer) {
+		delete[] mPESBuffer;
+		mPESBuffer = nullptr;
+	}
 }
 
 std::shared_ptr<TSDemuxer> TSDemuxer::create(void)
@@ -137,6 +152,7 @@ ssize_t TSDemuxer::pullData(uint8_t *buf, size_t size, void *param)
 			meddbg("get audio PES PID failed\n");
 			return DEMUXER_ERROR_NOT_READY;
 		}
+		PID_FILTER_SET(mPESPidFilter, mPESPid);
 		medvdbg("setup audio PES PID: 0x%x\n", mPESPid);
 	}
 
@@ -168,8 +184,9 @@ ssize_t TSDemuxer::pullData(uint8_t *buf, size_t size, void *param)
 		}
 
 		// get new PES packet
-		std::shared_ptr<PESPacket> pPESPacket = nullptr;
-		ret = getPESPacket(pPESPacket);
+		uint8_t *pPESData = nullptr;
+		uint32_t PESDataLen = 0;
+		ret = getPESPacket(&pPESData, &PESDataLen);
 		if (ret == DEMUXER_ERROR_WANT_DATA) {
 			medvdbg("Push more data to get PES packet\n");
 			break;
@@ -181,7 +198,7 @@ ssize_t TSDemuxer::pullData(uint8_t *buf, size_t size, void *param)
 		}
 
 		// parse PES packet
-		if (mPESParser->parse(pPESPacket)) {
+		if (mPESParser->parse(pPESData, PESDataLen)) {
 			mPESDataUsed = 0;
 		} else {
 			meddbg("PES parse failed!\n");
@@ -333,47 +350,72 @@ std::shared_ptr<Section> TSDemuxer::PSIUnpack(std::shared_ptr<TSPacket> pTSPacke
 	return pSection;
 }
 
-std::shared_ptr<PESPacket> TSDemuxer::PESUnpack(std::shared_ptr<TSPacket> pTSPacket)
+bool TSDemuxer::PESUnpack(const uint8_t *pPacketData)
 {
-	std::shared_ptr<PESPacket> pPESPacket = nullptr;
-	uint8_t  lenPayload = 0;
-	uint8_t *ptrPayload = pTSPacket->getPayloadData(&lenPayload);
+	uint8_t lenPayload = 0;
+	bool unitStart = false;
+	uint8_t continuityCounter = 0;
+	const uint8_t *ptrPayload = TSPacket::parsePayload(pPacketData, &lenPayload, &unitStart, &continuityCounter);
 
 	if (!ptrPayload) {
 		// no payload
-		return pPESPacket;
+		return false;
 	}
 
-	if (pTSPacket->payloadUnitStartIndicator()) {
-		// new PES packet start
-		medvdbg("new PES packet (PID:%u) start...\n", pTSPacket->getPid());
-		auto newPacket = PESPacket::create(pTSPacket->getPid(), pTSPacket->continuityCounter(), ptrPayload, lenPayload);
-		if (newPacket->isCompleted()) {
-			medvdbg("PES packet (PID:%u) complete\n", pTSPacket->getPid());
-			pPESPacket = newPacket;
-		} else {
-			auto it = mPidPESPacketMap.find(pTSPacket->getPid());
-			if (it != mPidPESPacketMap.end()) {
-				// incomplete PES packet with same PID exist, remove it!
-				mPidPESPacketMap.erase(it);
+	if (unitStart) {
+		// new PES packet start, incomplete PES packet in buffer is dropped if any
+		if (mPESLength != 0) {
+			meddbg("Drop incomplete PES packet %u/%u!\n", mPESPresentLen, mPESLength);
+		}
+		mPESLength = 0;
+		if (lenPayload < PES_PACKET_HEAD_BYTES || PES_PACKET_LENGTH(ptrPayload) == 0) {
+			// PES packet of unbounded length is used by video streams only
+			meddbg("Invalid PES packet header in payload of %u bytes!\n", lenPayload);
+			return false;
+		}
+		uint32_t length = PES_PACKET_HEAD_BYTES + PES_PACKET_LENGTH(ptrPayload);
+		if (length > mPESBufferSize) {
+			if (mPESBuffer) {
+				delete[] mPESBuffer;
 			}
-			mPidPESPacketMap.insert(std::pair<uint16_t, std::shared_ptr<PESPacket>>(pTSPacket->getPid(), newPacket));
+			mPESBuffer = new uint8_t[length];
+			if (!mPESBuffer) {
+				meddbg("Run out of memory! Allocating %u bytes failed!\n", length);
+				mPESBufferSize = 0;
+				return false;
+			}
+			mPESBufferSize = length;
 		}
+		medvdbg("new PES packet start, length %u\n", length);
+		mPESLength = length;
+		mPESPresentLen = 0;
 	} else {
 		// PES packet appending
-		auto it = mPidPESPacketMap.find(pTSPacket->getPid());
-		if (it != mPidPESPacketMap.end()) {
-			auto prePacket = it->second;
-			prePacket->appendData(pTSPacket->getPid(), pTSPacket->continuityCounter(), ptrPayload, lenPayload);
-			if (prePacket->isCompleted()) {
-				medvdbg("PES packet (PID:%u) complete\n", pTSPacket->getPid());
-				pPESPacket = prePacket;
-				mPidPESPacketMap.erase(it);
-			}
+		if (mPESLength == 0) {
+			return false;
 		}
+		if (continuityCounter != ((mPESContinuityCounter + 1) % CONTINUITY_COUNTER_MOD)) {
+			meddbg("continuity counter(0x%x) do not match, current 0x%x, drop PES packet\n", continuityCounter, mPESContinuityCounter);
+			mPESLength = 0;
+			return false;
+		}
+	}
+	mPESContinuityCounter = continuityCounter;
+
+	// stuffing bytes beyond PES packet length are ignored
+	uint32_t size = mPESLength - mPESPresentLen;
+	if (size > lenPayload) {
+		size = lenPayload;
+	}
+	memcpy(mPESBuffer + mPESPresentLen, ptrPayload, size);
+	mPESPresentLen += size;
+	if (mPESPresentLen < mPESLength) {
+		return false;
 	}
 
-	return pPESPacket;
+	medvdbg("PES packet complete, length %u\n", mPESLength);
+	mPESLength = 0;
+	return true;
 }
 
 bool TSDemuxer::isPsiPid(uint16_t pid)
@@ -388,7 +430,7 @@ bool TSDemuxer::isPsiPid(uint16_t pid)
 
 bool TSDemuxer::isPESPid(uint16_t pid)
 {
-	return (pid == mPESPid);
+	return PID_FILTER_TEST(mPESPidFilter, pid);
 }
 
 int TSDemuxer::loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync, size_t *offset)
@@ -432,21 +474,66 @@ int TSDemuxer::loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync, size
 }
 
 // return demuxer_error_e
-int TSDemuxer::getPESPacket(std::shared_ptr<PESPacket> &pPESPacket)
+int TSDemuxer::getPESPacket(uint8_t **pPESData, uint32_t *pPESDataLen)
 {
+	rb_span_t span[2];
+	uint8_t buffLen; // TSPacket::PACKET_SIZE
+	uint8_t *pBuffer = mTSPacket->getPacketBuffer(&buffLen);
 	int ret;
 
-	while ((ret = loadTSPacket(mTSPacket)) == DEMUXER_ERROR_NONE) {
-		if (isPESPid(mTSPacket->getPid())) {
-			pPESPacket = PESUnpack(mTSPacket);
-			if (pPESPacket) {
-				medvdbg("got new PES packet\n");
-				return DEMUXER_ERROR_NONE;
+	while (true) {
+		// scan all packets available in stream buffer with a single acquire and release
+		size_t len = mBufferReader->acquire(span, CONFIG_DEMUX_BUFFER_SIZE, false);
+		size_t used = 0;
+		bool completed = false;
+
+		while (!completed && len - used >= buffLen) {
+			const uint8_t *pPacketData;
+			if (used + buffLen <= span[0].len) {
+				pPacketData = (const uint8_t *)span[0].buf + used;
+			} else if (used >= span[0].len) {
+				pPacketData = (const uint8_t *)span[1].buf + (used - span[0].len);
+			} else {
+				// packet wraps around the end of stream buffer
+				size_t head = span[0].len - used;
+				memcpy(pBuffer, (const uint8_t *)span[0].buf + used, head);
+				memcpy(pBuffer + head, span[1].buf, buffLen - head);
+				pPacketData = pBuffer;
+			}
+
+			if (pPacketData[0] != TSPacket::SYNC_BYTE) {
+				// lost sync, packet is loaded again with resync below
+				break;
+			}
+			used += buffLen;
+			if (PID_FILTER_TEST(mPESPidFilter, TSPacket::parsePid(pPacketData))) {
+				completed = PESUnpack(pPacketData);
 			}
 		}
-	}
+		mBufferReader->release(used);
 
-	return ret;
+		if (completed) {
+			medvdbg("got new PES packet\n");
+			*pPESData = mPESBuffer;
+			*pPESDataLen = mPESPresentLen;
+			return DEMUXER_ERROR_NONE;
+		}
+
+		if (len - used < buffLen) {
+			return DEMUXER_ERROR_WANT_DATA;
+		}
+
+		ret = loadTSPacket(mTSPacket);
+		if (ret != DEMUXER_ERROR_NONE) {
+			return ret;
+		}
+		if (isPESPid(mTSPacket->getPid()) && PESUnpack(pBuffer)) {
+			medvdbg("got new PES packet\n");
+			*pPESData = mPESBuffer;
+			*pPESDataLen = mPESPresentLen;
+			return DEMUXER_ERROR_NONE;
+		}
+	}
 }
 
 bool TSDemuxer::isReady(void)
@@ -28,12 +28,12 @@
 #include <memory>
 #include <media/MediaTypes.h>
 #include "../../Demuxer.h"
+#include "Mpeg2TsTypes.h"
 
 class ParserManager;
 class Section;
 class TSPacket;
 class PESParser;
-class PESPacket;
 
 namespace media {
 namespace stream {
@@ -78,9 +78,11 @@ private:
 	// check if the given PID is PES packet's PID we need
 	bool isPESPid(uint16_t pid);
 	// extract a PES packet from the input transport stream
+	// TS packets are parsed in batches in place in the stream buffer, and the PES packet is
+	// reassembled in mPESBuffer, it's valid until next call.
 	// on success, return 0
 	// on failure, return negative value (see demuxer_error_e)
-	int getPESPacket(std::shared_ptr<PESPacket> &pPESPacket);
+	int getPESPacket(uint8_t **pPESData, uint32_t *pPESDataLen);
 	// load a valid TS packet from the input data stream
 	// sync, request to do force resync
 	// offset, if not null, just copy data from stream buffer
@@ -90,16 +92,14 @@ private:
 	int loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync = false, size_t *offset = nullptr);
 	// Unpack a TS packet and return a section if get a completed one
 	std::shared_ptr<Section> PSIUnpack(std::shared_ptr<TSPacket> pTSPacket);
-	// Unpack a TS packet and return a PES packet if get a completed one
-	std::shared_ptr<PESPacket> PESUnpack(std::shared_ptr<TSPacket> pTSPacket);
+	// Unpack data of a TS packet and return true if get a completed PES packet in mPESBuffer
+	bool PESUnpack(const uint8_t *pPacketData);
 	// resync TS packet by TSPacket::SYNC_BYTE
 	int resync(uint8_t *pPacketData, size_t offset);
 
 private:
 	// <pid, section_ptr> pairs in map to take incomplete sections
 	std::map<uint16_t, std::shared_ptr<Section>> mPidSectionMap;
-	// <pid, pespacket_ptr> pairs in map to take incomplete PES packets
-	std::map<uint16_t, std::shared_ptr<PESPacket>> mPidPESPacketMap;
 	// PSI table pasers manager
 	std::shared_ptr<ParserManager> mParserManager;
 	// stream buffer to held inputing TS stream data
@@ -114,6 +114,16 @@ private:
 	std::shared_ptr<TSPacket> mTSPacket;
 	uint16_t mPESPid;
 	size_t mPESDataUsed;
+	// flat lookup table of PIDs, one bit per PID, set for PES packets we need
+	uint8_t mPESPidFilter[(INVALID_PID + 1) / 8];
+	// buffer to reassemble PES packet, reused for all packets and grown only for a longer one
+	uint8_t *mPESBuffer;
+	uint32_t mPESBufferSize;
+	// total and present length of PES packet in mPESBuffer, total length is 0 if there's none
+	uint32_t mPESLength;
+	uint32_t mPESPresentLen;
+	// continuity counter of last ts packet appended to PES packet
+	uint8_t mPESContinuityCounter;
 };
 
 } // namespace media
@@ -187,3 +187,33 @@ uint8_t *TSPacket::getPayloadData(uint8_t *payloadDataLen)
 
 	return ptrPayload;
 }
+
+const uint8_t *TSPacket::parsePayload(const uint8_t *pPacket, uint8_t *payloadDataLen, bool *unitStart, uint8_t *continuityCounter)
+{
+	uint8_t lenPayload = PACKET_SIZE - HEAD_BYTES;
+
+	if (pPacket[0] != SYNC_BYTE || ((pPacket[1] >> 7) & BITS_MASK(1))) {
+		// invalid packet or transport error
+		return nullptr;
+	}
+
+	switch ((pPacket[3] >> 4) & BITS_MASK(2)) {
+	case CONTROL_PAYLOAD_ONLY:
+		break;
+	case CONTROL_ADAPTATION_PLAYLOAD:
+		if (pPacket[HEAD_BYTES] >= PACKET_SIZE - HEAD_BYTES - LENGTH_BYTES) {
+			// adaptation field takes whole packet
+			return nullptr;
+		}
+		lenPayload = PACKET_SIZE - HEAD_BYTES - (LENGTH_BYTES + pPacket[HEAD_BYTES]);
+		break;
+	default:
+		// reserved, or adaptation field only
+		return nullptr;
+	}
+
+	*payloadDataLen = lenPayload;
+	*unitStart = static_cast<bool>((pPacket[1] >> 6) & BITS_MASK(1));
+	*continuityCounter = pPacket[3] & BITS_MASK(4);
+	return pPacket + (PACKET_SIZE - lenPayload);
+}
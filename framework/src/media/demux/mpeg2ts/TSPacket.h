@@ -84,6 +84,12 @@ public:
 	uint8_t *getPayloadData(uint8_t *payloadDataLen);
 	// add more getters if necessary...
 
+	// parse header of the packet data in place, without loading it into a TSPacket object
+	// return pointer to the payload data start address in pPacket, or nullptr if there's no payload
+	static const uint8_t *parsePayload(const uint8_t *pPacket, uint8_t *payloadDataLen, bool *unitStart, uint8_t *continuityCounter);
+	// get PID of the packet data in place
+	static ts_pid_t parsePid(const uint8_t *pPacket) { return ((pPacket[1] << 8) + pPacket[2]) & 0x1FFF; }
+
 private:
 	// packet data array
 	uint8_t mData[PACKET_SIZE];
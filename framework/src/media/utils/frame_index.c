@@ -0,0 +1,219 @@
+/******************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <debug.h>
+#include "frame_index.h"
+#include "internal_defs.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define FRAME_INDEX_MAGIC   0x58444946  // "FIDX"
+#define FRAME_INDEX_VERSION 1
+
+/****************************************************************************
+ * Private Declarations
+ ****************************************************************************/
+struct frame_index_file_header_s {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t complete;
+	uint32_t interval_ms;
+	uint32_t count;
+	uint32_t source_size;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+// Drop every other entry, keeping the first one, and double the interval.
+static void _decimate(frame_index_p index)
+{
+	uint32_t i;
+
+	for (i = 0; i < (index->count + 1) / 2; i++) {
+		index->entries[i] = index->entries[i * 2];
+	}
+	index->count = i;
+	index->interval_ms *= 2;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+bool frame_index_init(frame_index_p index, uint32_t interval_ms, uint32_t capacity)
+{
+	RETURN_VAL_IF_FAIL(index != NULL, false);
+	RETURN_VAL_IF_FAIL(interval_ms > 0, false);
+	RETURN_VAL_IF_FAIL(capacity > 1, false);
+
+	index->entries = (frame_index_entry_t *)malloc(capacity * sizeof(frame_index_entry_t));
+	RETURN_VAL_IF_FAIL(index->entries != NULL, false);
+
+	index->capacity = capacity;
+	index->count = 0;
+	index->interval_ms = interval_ms;
+	index->complete = false;
+	index->dirty = false;
+	return true;
+}
+
+void frame_index_free(frame_index_p index)
+{
+	RETURN_IF_FAIL(index != NULL);
+
+	free(index->entries);
+	index->entries = NULL;
+	index->capacity = 0;
+	index->count = 0;
+}
+
+void frame_index_add(frame_index_p index, uint32_t msec, uint32_t offset)
+{
+	RETURN_IF_FAIL(index != NULL);
+	RETURN_IF_FAIL(!index->complete);
+
+	if (index->count > 0) {
+		frame_index_entry_t *last = &index->entries[index->count - 1];
+		if (msec < last->msec + index->interval_ms || offset <= last->offset) {
+			return;
+		}
+	}
+
+	if (index->count == index->capacity) {
+		_decimate(index);
+		if (msec < index->entries[index->count - 1].msec + index->interval_ms) {
+			return;
+		}
+	}
+
+	index->entries[index->count].msec = msec;
+	index->entries[index->count].offset = offset;
+	index->count++;
+	index->dirty = true;
+}
+
+void frame_index_set_complete(frame_index_p index)
+{
+	RETURN_IF_FAIL(index != NULL);
+
+	if (!index->complete) {
+		index->complete = true;
+		index->dirty = true;
+	}
+}
+
+bool frame_index_lookup(frame_index_p index, uint32_t msec, frame_index_entry_t *entry)
+{
+	RETURN_VAL_IF_FAIL(index != NULL, false);
+	RETURN_VAL_IF_FAIL(entry != NULL, false);
+	RETURN_VAL_IF_FAIL(index->count > 0, false);
+	RETURN_VAL_IF_FAIL(index->entries[0].msec <= msec, false);
+
+	// Last entry whose time is not after msec
+	uint32_t lo = 0;
+	uint32_t hi = index->count;
+	while (hi - lo > 1) {
+		uint32_t mid = lo + (hi - lo) / 2;
+		if (index->entries[mid].msec <= msec) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	*entry = index->entries[lo];
+	return true;
+}
+
+size_t frame_index_skip_bytes(uint32_t from_msec, uint32_t to_msec, uint32_t sample_rate, size_t frame_bytes)
+{
+	RETURN_VAL_IF_FAIL(to_msec >= from_msec, 0);
+
+	uint64_t skip_frames = (uint64_t)(to_msec - from_msec) * sample_rate / 1000;
+	return (size_t)(skip_frames * frame_bytes);
+}
+
+bool frame_index_load(frame_index_p index, const char *path, uint32_t source_size)
+{
+	RETURN_VAL_IF_FAIL(index != NULL, false);
+	RETURN_VAL_IF_FAIL(path != NULL, false);
+
+	FILE *fp = fopen(path, "rb");
+	RETURN_VAL_IF_FAIL(fp != NULL, false);
+
+	bool ret = false;
+	struct frame_index_file_header_s header;
+	GOTO_IF_FAIL(fread(&header, sizeof(header), 1, fp) == 1, done);
+	GOTO_IF_FAIL(header.magic == FRAME_INDEX_MAGIC && header.version == FRAME_INDEX_VERSION, done);
+	GOTO_IF_FAIL(header.source_size == source_size, done);
+	GOTO_IF_FAIL(header.count <= index->capacity && header.interval_ms > 0, done);
+	GOTO_IF_FAIL(fread(index->entries, sizeof(frame_index_entry_t), header.count, fp) == header.count, done);
+
+	index->count = header.count;
+	index->interval_ms = header.interval_ms;
+	index->complete = (header.complete != 0);
+	index->dirty = false;
+	ret = true;
+
+done:
+	if (!ret) {
+		medvdbg("frame index %s is not valid for the source\n", path);
+		index->count = 0;
+	}
+	fclose(fp);
+	return ret;
+}
+
+bool frame_index_save(frame_index_p index, const char *path, uint32_t source_size)
+{
+	RETURN_VAL_IF_FAIL(index != NULL, false);
+	RETURN_VAL_IF_FAIL(path != NULL, false);
+
+	FILE *fp = fopen(path, "wb");
+	if (fp == NULL) {
+		meddbg("open frame index %s failed\n", path);
+		return false;
+	}
+
+	struct frame_index_file_header_s header;
+	header.magic = FRAME_INDEX_MAGIC;
+	header.version = FRAME_INDEX_VERSION;
+	header.complete = index->complete ? 1 : 0;
+	header.interval_ms = index->interval_ms;
+	header.count = index->count;
+	header.source_size = source_size;
+
+	bool ret = (fwrite(&header, sizeof(header), 1, fp) == 1)
+			   && (fwrite(index->entries, sizeof(frame_index_entry_t), index->count, fp) == index->count);
+	if (fclose(fp) != 0) {
+		ret = false;
+	}
+
+	if (!ret) {
+		meddbg("write frame index %s failed\n", path);
+		remove(path);
+		return false;
+	}
+
+	index->dirty = false;
+	return true;
+}
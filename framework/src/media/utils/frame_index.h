@@ -0,0 +1,128 @@
+/******************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef _FRAME_INDEX_H_
+#define _FRAME_INDEX_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* sparse frame index
+ * Maps playback time to the byte offset of a compressed audio frame in the source,
+ * so that seek can start decoding near the target instead of scanning from the start.
+ * Entries are appended in order while decoding, at least 'interval_ms' apart. When the
+ * table is full, every other entry is dropped and the interval is doubled, so memory
+ * stays bounded for any stream length.
+ */
+struct frame_index_entry_s {
+	uint32_t msec;              /* playback time of the frame         */
+	uint32_t offset;            /* byte offset of the frame in source */
+};
+
+typedef struct frame_index_entry_s frame_index_entry_t;
+
+struct frame_index_s {
+	frame_index_entry_t *entries;
+	uint32_t capacity;          /* maximum number of entries          */
+	uint32_t count;             /* number of entries                  */
+	uint32_t interval_ms;       /* minimum time between entries       */
+	bool complete;              /* whole stream was indexed           */
+	bool dirty;                 /* changed since loaded or saved      */
+};
+
+typedef struct frame_index_s  frame_index_t;
+typedef struct frame_index_s *frame_index_p;
+
+/**
+ * @brief  Initialize the frame index. Allocate memory for the entries.
+ * @param  index: Pointer to the frame index object
+ * @param  interval_ms: Minimum time between entries
+ * @param  capacity: Maximum number of entries
+ * @return true on success, false on failure.
+ */
+bool frame_index_init(frame_index_p index, uint32_t interval_ms, uint32_t capacity);
+
+/**
+ * @brief  Release the frame index object. Deallocate the entries.
+ * @param  index: Pointer to the frame index object
+ */
+void frame_index_free(frame_index_p index);
+
+/**
+ * @brief  Record a frame found while decoding.
+ *         Frames before the last entry, or closer than the interval, are ignored.
+ * @param  index: Pointer to the frame index object
+ * @param  msec: Playback time of the frame
+ * @param  offset: Byte offset of the frame in source
+ */
+void frame_index_add(frame_index_p index, uint32_t msec, uint32_t offset);
+
+/**
+ * @brief  Mark the index as covering the whole stream, no more entries are added.
+ * @param  index: Pointer to the frame index object
+ */
+void frame_index_set_complete(frame_index_p index);
+
+/**
+ * @brief  Find the last entry at or before the given time, by binary search.
+ * @param  index: Pointer to the frame index object
+ * @param  msec: Target playback time
+ * @param  entry: Output of the entry found
+ * @return true if an entry was found, false if the index has no entry before msec.
+ */
+bool frame_index_lookup(frame_index_p index, uint32_t msec, frame_index_entry_t *entry);
+
+/**
+ * @brief  Count the PCM bytes to drop when decoding starts before the seek target.
+ *         Seek target is usually in the middle of a frame, decoding starts at a frame
+ *         found by frame_index_lookup() or at the start of source.
+ * @param  from_msec: Playback time where decoding starts
+ * @param  to_msec: Seek target, not before from_msec
+ * @param  sample_rate: Sample rate of the stream
+ * @param  frame_bytes: Bytes of one PCM frame in the decoder output, channels * sample width
+ * @return Number of bytes, a whole number of PCM frames.
+ */
+size_t frame_index_skip_bytes(uint32_t from_msec, uint32_t to_msec, uint32_t sample_rate, size_t frame_bytes);
+
+/**
+ * @brief  Load entries from a sidecar file.
+ * @param  index: Pointer to the frame index object, initialized already
+ * @param  path: Path of the sidecar file
+ * @param  source_size: Size of the source file, index of a different size is rejected
+ * @return true on success, false on failure (index is left empty).
+ */
+bool frame_index_load(frame_index_p index, const char *path, uint32_t source_size);
+
+/**
+ * @brief  Save entries to a sidecar file.
+ * @param  index: Pointer to the frame index object
+ * @param  path: Path of the sidecar file
+ * @param  source_size: Size of the source file
+ * @return true on success, false on failure.
+ */
+bool frame_index_save(frame_index_p index, const char *path, uint32_t source_size);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
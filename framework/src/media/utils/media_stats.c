@@ -0,0 +1,280 @@
+/******************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <tinyara/config.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <debug.h>
+#include <media/media_stats.h>
+#include "internal_defs.h"
+
+/****************************************************************************
+ * Private Declarations
+ ****************************************************************************/
+static const char *const g_stage_names[MEDIA_STATS_STAGE_MAX] = {
+	"source",
+	"decode",
+	"buffer",
+	"output",
+	"sink",
+	"capture",
+	"encode",
+};
+
+#define MEDIA_STATS_QUEUE_MAX 8
+
+struct media_stats_queue_entry_s {
+	const char *name;
+	media_stats_queue_cb_t cb;
+	void *arg;
+};
+
+static struct media_stats_stage_s g_stages[MEDIA_STATS_STAGE_MAX];
+static struct media_stats_queue_entry_s g_queues[MEDIA_STATS_QUEUE_MAX];
+static struct media_stats_latency_s g_latency;
+static uint32_t g_start_time;
+static bool g_start_pending;
+static pthread_mutex_t g_stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+// Append formatted text at len, the length keeps counting once buf is full.
+static int _append(char *buf, size_t size, int len, const char *format, ...)
+{
+	va_list ap;
+	size_t offset = (size_t)len < size ? (size_t)len : size;
+	int ret;
+
+	va_start(ap, format);
+	ret = vsnprintf(buf + offset, size - offset, format, ap);
+	va_end(ap);
+
+	return ret > 0 ? len + ret : len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+uint32_t media_stats_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)ts.tv_sec * 1000000 + (uint32_t)ts.tv_nsec / 1000;
+}
+
+void media_stats_record(media_stats_stage_t stage, uint32_t start, size_t bytes, unsigned int frames)
+{
+	RETURN_IF_FAIL(stage < MEDIA_STATS_STAGE_MAX);
+
+	// Wrapping of the timestamp is handled by the unsigned subtraction
+	uint32_t elapsed = media_stats_now() - start;
+	struct media_stats_stage_s *s = &g_stages[stage];
+
+	pthread_mutex_lock(&g_stats_mutex);
+	s->calls++;
+	s->frames += frames;
+	s->bytes += bytes;
+	s->total_us += elapsed;
+	if (elapsed > s->max_us) {
+		s->max_us = elapsed;
+	}
+	pthread_mutex_unlock(&g_stats_mutex);
+}
+
+void media_stats_set_level(media_stats_stage_t stage, size_t level)
+{
+	RETURN_IF_FAIL(stage < MEDIA_STATS_STAGE_MAX);
+
+	struct media_stats_stage_s *s = &g_stages[stage];
+
+	pthread_mutex_lock(&g_stats_mutex);
+	s->level = (uint32_t)level;
+	if (s->level > s->high_water) {
+		s->high_water = s->level;
+	}
+	pthread_mutex_unlock(&g_stats_mutex);
+}
+
+void media_stats_xrun(media_stats_stage_t stage)
+{
+	RETURN_IF_FAIL(stage < MEDIA_STATS_STAGE_MAX);
+
+	pthread_mutex_lock(&g_stats_mutex);
+	g_stages[stage].xruns++;
+	pthread_mutex_unlock(&g_stats_mutex);
+}
+
+void media_stats_mark_start(void)
+{
+	uint32_t now = media_stats_now();
+
+	pthread_mutex_lock(&g_stats_mutex);
+	g_start_time = now;
+	g_start_pending = true;
+	pthread_mutex_unlock(&g_stats_mutex);
+}
+
+void media_stats_mark_output(void)
+{
+	uint32_t now;
+
+	// Unlocked peek, frames are written far more often than playback starts
+	if (!g_start_pending) {
+		return;
+	}
+
+	now = media_stats_now();
+	pthread_mutex_lock(&g_stats_mutex);
+	if (g_start_pending) {
+		g_start_pending = false;
+		g_latency.count++;
+		g_latency.last_us = now - g_start_time;
+		if (g_latency.last_us > g_latency.max_us) {
+			g_latency.max_us = g_latency.last_us;
+		}
+	}
+	pthread_mutex_unlock(&g_stats_mutex);
+}
+
+int media_stats_get(media_stats_stage_t stage, struct media_stats_stage_s *stats)
+{
+	RETURN_VAL_IF_FAIL(stage < MEDIA_STATS_STAGE_MAX, -EINVAL);
+	RETURN_VAL_IF_FAIL(stats != NULL, -EINVAL);
+
+	pthread_mutex_lock(&g_stats_mutex);
+	*stats = g_stages[stage];
+	pthread_mutex_unlock(&g_stats_mutex);
+	return OK;
+}
+
+int media_stats_get_latency(struct media_stats_latency_s *latency)
+{
+	RETURN_VAL_IF_FAIL(latency != NULL, -EINVAL);
+
+	pthread_mutex_lock(&g_stats_mutex);
+	*latency = g_latency;
+	pthread_mutex_unlock(&g_stats_mutex);
+	return OK;
+}
+
+int media_stats_register_queue(const char *name, media_stats_queue_cb_t cb, void *arg)
+{
+	int i;
+
+	RETURN_VAL_IF_FAIL(name != NULL && cb != NULL && arg != NULL, -EINVAL);
+
+	pthread_mutex_lock(&g_stats_mutex);
+	for (i = 0; i < MEDIA_STATS_QUEUE_MAX; i++) {
+		if (g_queues[i].arg == NULL) {
+			g_queues[i].name = name;
+			g_queues[i].cb = cb;
+			g_queues[i].arg = arg;
+			pthread_mutex_unlock(&g_stats_mutex);
+			return OK;
+		}
+	}
+	pthread_mutex_unlock(&g_stats_mutex);
+	meddbg("no room to register queue of %s\n", name);
+	return -ENOMEM;
+}
+
+void media_stats_unregister_queue(void *arg)
+{
+	int i;
+
+	pthread_mutex_lock(&g_stats_mutex);
+	for (i = 0; i < MEDIA_STATS_QUEUE_MAX; i++) {
+		if (g_queues[i].arg == arg) {
+			memset(&g_queues[i], 0, sizeof(g_queues[i]));
+		}
+	}
+	pthread_mutex_unlock(&g_stats_mutex);
+}
+
+int media_stats_get_queues(struct media_stats_queue_s *queues, int count)
+{
+	int filled = 0;
+	int i;
+
+	RETURN_VAL_IF_FAIL(queues != NULL || count == 0, -EINVAL);
+
+	// Callbacks only take the lock of their queue, which never waits for this one
+	pthread_mutex_lock(&g_stats_mutex);
+	for (i = 0; i < MEDIA_STATS_QUEUE_MAX && filled < count; i++) {
+		if (g_queues[i].arg != NULL) {
+			memset(&queues[filled], 0, sizeof(queues[filled]));
+			g_queues[i].cb(g_queues[i].arg, &queues[filled]);
+			queues[filled].name = g_queues[i].name;
+			filled++;
+		}
+	}
+	pthread_mutex_unlock(&g_stats_mutex);
+	return filled;
+}
+
+void media_stats_reset(void)
+{
+	pthread_mutex_lock(&g_stats_mutex);
+	memset(g_stages, 0, sizeof(g_stages));
+	memset(&g_latency, 0, sizeof(g_latency));
+	g_start_pending = false;
+	pthread_mutex_unlock(&g_stats_mutex);
+}
+
+int media_stats_print(char *buf, size_t size)
+{
+	struct media_stats_stage_s stages[MEDIA_STATS_STAGE_MAX];
+	struct media_stats_latency_s latency;
+	struct media_stats_queue_s queues[MEDIA_STATS_QUEUE_MAX];
+	int nqueues;
+	int len;
+	int i;
+
+	RETURN_VAL_IF_FAIL(buf != NULL || size == 0, -EINVAL);
+
+	// Format a snapshot, so that the lock is not held while printing
+	pthread_mutex_lock(&g_stats_mutex);
+	memcpy(stages, g_stages, sizeof(stages));
+	latency = g_latency;
+	pthread_mutex_unlock(&g_stats_mutex);
+	nqueues = media_stats_get_queues(queues, MEDIA_STATS_QUEUE_MAX);
+
+	len = _append(buf, size, 0, "%-8s %10s %10s %10s %8s %8s %8s %8s %6s\n", "stage", "calls", "frames", "kbytes", "avg_us", "max_us", "level", "high", "xruns");
+	for (i = 0; i < MEDIA_STATS_STAGE_MAX; i++) {
+		struct media_stats_stage_s *s = &stages[i];
+		uint32_t avg = s->calls ? (uint32_t)(s->total_us / s->calls) : 0;
+		len = _append(buf, size, len, "%-8s %10lu %10lu %10lu %8lu %8lu %8lu %8lu %6lu\n", g_stage_names[i], (unsigned long)s->calls, (unsigned long)s->frames, (unsigned long)(s->bytes >> 10), (unsigned long)avg, (unsigned long)s->max_us, (unsigned long)s->level, (unsigned long)s->high_water, (unsigned long)s->xruns);
+	}
+	len = _append(buf, size, len, "start latency: count %lu last %lu us max %lu us\n", (unsigned long)latency.count, (unsigned long)latency.last_us, (unsigned long)latency.max_us);
+	if (nqueues > 0) {
+		len = _append(buf, size, len, "%-22s %6s %6s %8s %8s %6s\n", "queue", "depth", "max", "max_us", "overflow", "drops");
+		for (i = 0; i < nqueues; i++) {
+			struct media_stats_queue_s *q = &queues[i];
+			len = _append(buf, size, len, "%-22.22s %6lu %6lu %8lu %8lu %6lu\n", q->name, (unsigned long)q->depth, (unsigned long)q->max_depth, (unsigned long)q->max_latency_us, (unsigned long)q->overflows, (unsigned long)q->drops);
+		}
+	}
+
+	return len;
+}
@@ -24,8 +24,20 @@
 #include "rb.h"
 #include "internal_defs.h"
 
-#define IS_EMPTY(rbp) (rbp->rd_idx == rbp->wr_idx)
-#define IS_FULL(rbp) ((rbp->rd_idx & IDX_MASK) == (rbp->wr_idx & IDX_MASK) && (rbp->rd_idx & MSB_MASK) != (rbp->wr_idx & MSB_MASK))
+/* Indices are published with release semantics and observed with acquire semantics,
+ * so one reader and one writer can operate the ring-buffer at the same time without locking.
+ */
+#define LOAD_IDX(p_idx) __atomic_load_n((p_idx), __ATOMIC_ACQUIRE)
+#define STORE_IDX(p_idx, idx) __atomic_store_n((p_idx), (idx), __ATOMIC_RELEASE)
+
+/**
+ * @brief  Get data bytes between the given read and write index snapshot.
+ *
+ * @param  rbp: Pointer to the ring-buffer
+ * @param  rd_idx: snapshot of the read index
+ * @param  wr_idx: snapshot of the write index
+ */
+static size_t _used(rb_p rbp, size_t rd_idx, size_t wr_idx);
 
 /**
  * @brief  Increase the buffer index while writing or reading the ring-buffer.
@@ -38,6 +50,17 @@
  */
 static void _incr(rb_p rbp, volatile size_t *p_idx, size_t len);
 
+/**
+ * @brief  Split a region started from the given index into at most two
+ *         contiguous parts, due to wrapping at the end of the buffer.
+ *
+ * @param  rbp: Pointer to the ring-buffer
+ * @param  idx: Start index of the region (without 'mirror' flag)
+ * @param  len: length of the region
+ * @param  span: Array of two regions to be filled
+ */
+static void _split(rb_p rbp, size_t idx, size_t len, rb_span_t span[2]);
+
 bool rb_init(rb_p rbp, size_t size)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, false);
@@ -64,18 +87,11 @@ size_t rb_used(rb_p rbp)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
 
-	if (IS_EMPTY(rbp)) {
-		return SIZE_ZERO;
-	}
-
-	size_t wr_idx = (rbp->wr_idx & IDX_MASK);
-	size_t rd_idx = (rbp->rd_idx & IDX_MASK);
-
-	if (wr_idx > rd_idx) {
-		return (wr_idx - rd_idx);
-	}
+	// Take a consistent snapshot, the other side may update its index at the same time.
+	size_t rd_idx = LOAD_IDX(&rbp->rd_idx);
+	size_t wr_idx = LOAD_IDX(&rbp->wr_idx);
 
-	return (rbp->depth - (rd_idx - wr_idx));
+	return _used(rbp, rd_idx, wr_idx);
 }
 
 size_t rb_avail(rb_p rbp)
@@ -155,6 +171,44 @@ size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset)
 	return len;
 }
 
+size_t rb_acquire_read(rb_p rbp, rb_span_t span[2], size_t len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+	RETURN_VAL_IF_FAIL(span != NULL, SIZE_ZERO);
+
+	len = MINIMUM(len, rb_used(rbp));
+	_split(rbp, (rbp->rd_idx & IDX_MASK), len, span);
+	return len;
+}
+
+size_t rb_commit_read(rb_p rbp, size_t len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+
+	len = MINIMUM(len, rb_used(rbp));
+	_incr(rbp, &rbp->rd_idx, len);
+	return len;
+}
+
+size_t rb_acquire_write(rb_p rbp, rb_span_t span[2], size_t len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+	RETURN_VAL_IF_FAIL(span != NULL, SIZE_ZERO);
+
+	len = MINIMUM(len, rb_avail(rbp));
+	_split(rbp, (rbp->wr_idx & IDX_MASK), len, span);
+	return len;
+}
+
+size_t rb_commit_write(rb_p rbp, size_t len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+
+	len = MINIMUM(len, rb_avail(rbp));
+	_incr(rbp, &rbp->wr_idx, len);
+	return len;
+}
+
 bool rb_reset(rb_p rbp)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, false);
@@ -165,6 +219,22 @@ bool rb_reset(rb_p rbp)
 	return true;
 }
 
+static size_t _used(rb_p rbp, size_t rd_idx, size_t wr_idx)
+{
+	if (rd_idx == wr_idx) {
+		return SIZE_ZERO;
+	}
+
+	size_t wr = (wr_idx & IDX_MASK);
+	size_t rd = (rd_idx & IDX_MASK);
+
+	if (wr > rd) {
+		return (wr - rd);
+	}
+
+	return (rbp->depth - (rd - wr));
+}
+
 static void _incr(rb_p rbp, volatile size_t *p_idx, size_t len)
 {
 	size_t idx = *p_idx & IDX_MASK;
@@ -176,5 +246,23 @@ static void _incr(rb_p rbp, volatile size_t *p_idx, size_t len)
 		idx -= rbp->depth;
 	}
 
-	*p_idx = msb | idx;
+	// Publish the new index after data has been copied.
+	STORE_IDX(p_idx, (msb | idx));
+}
+
+static void _split(rb_p rbp, size_t idx, size_t len, rb_span_t span[2])
+{
+	size_t len_part = rbp->depth - idx;
+
+	span[0].buf = (void *)((uint8_t *)rbp->buf + idx);
+	if (len > len_part) {
+		// Region wraps, the remained part starts at the start of ring buffer.
+		span[0].len = len_part;
+		span[1].buf = rbp->buf;
+		span[1].len = len - len_part;
+	} else {
+		span[0].len = len;
+		span[1].buf = NULL;
+		span[1].len = SIZE_ZERO;
+	}
 }
@@ -30,7 +30,11 @@ extern "C" {
 #define IDX_MASK (SIZE_MAX>>1)
 #define MSB_MASK (~IDX_MASK)    /* also the maximum value of the buffer depth */
 
-/* ring buffer structure */
+/* ring buffer structure
+ * It's safe for one reader thread and one writer thread to operate at the same
+ * time without locking, read index is updated only by reader and write index
+ * is updated only by writer. rb_reset() must not race with reading or writing.
+ */
 struct rb_s {
 	void *buf;                  /* pointer to the buffer allocated   */
 	size_t depth;               /* maximum size of the ring buffer   */
@@ -41,6 +45,14 @@ struct rb_s {
 typedef struct rb_s  rb_t;
 typedef struct rb_s *rb_p;
 
+/* contiguous region of the ring-buffer memory */
+struct rb_span_s {
+	void *buf;                  /* start address of the region       */
+	size_t len;                 /* length of the region in bytes     */
+};
+
+typedef struct rb_span_s rb_span_t;
+
 /**
  * @brief  Initialize the ring-buffer. Allocate necessary memory for the buffer.
  * @param  rbp : Pointer to the ring-buffer object
@@ -102,6 +114,44 @@ size_t rb_read(rb_p rbp, void *ptr, size_t len);
  */
 size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset);
 
+/**
+ * @brief  Get the regions holding data at the ring-buffer header, without copying.
+ *         Data wraps at the end of the buffer, so it may be split into two regions.
+ *         rd_idx will not be increased until rb_commit_read() is called.
+ * @param  rbp : Pointer to the ring-buffer object
+ * @param  span: Array of two regions to be filled, span[1].len is 0 if not wrapped.
+ * @param  len : length of the data wanted
+ * @return size of data in the regions, range[0, len]
+ */
+size_t rb_acquire_read(rb_p rbp, rb_span_t span[2], size_t len);
+
+/**
+ * @brief  Release data consumed from regions got by rb_acquire_read().
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  len: length of the data consumed
+ * @return size rd_idx increased, range[0, len]
+ */
+size_t rb_commit_read(rb_p rbp, size_t len);
+
+/**
+ * @brief  Get the regions of free space at the ring-buffer tail, to be written in place.
+ *         Free space wraps at the end of the buffer, so it may be split into two regions.
+ *         wr_idx will not be increased until rb_commit_write() is called.
+ * @param  rbp : Pointer to the ring-buffer object
+ * @param  span: Array of two regions to be filled, span[1].len is 0 if not wrapped.
+ * @param  len : length of the space wanted
+ * @return size of space in the regions, range[0, len]
+ */
+size_t rb_acquire_write(rb_p rbp, rb_span_t span[2], size_t len);
+
+/**
+ * @brief  Publish data filled in regions got by rb_acquire_write().
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  len: length of the data filled
+ * @return size wr_idx increased, range[0, len]
+ */
+size_t rb_commit_write(rb_p rbp, size_t len);
+
 /**
  * @brief  Reset ring-buffer, data in ring-buffer will be dropped.
  * @param  rbp: Pointer to the ring-buffer object
@@ -16,13 +16,20 @@
  *
  ****************************************************************************/
 
+#include <tinyara/compiler.h>
 #include <string.h>
 #include <debug.h>
-#include <media/MediaTypes.h>
 #include "internal_defs.h"
 #include "remix.h"
 
-using namespace media;
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#define REMIX_USE_MVE
+#endif
+#if defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+#include <arm_acle.h>
+#define REMIX_USE_DSP
+#endif
 
 // audio channel masks
 #define CH_MASK_FL                0x00000001 // Front Left
@@ -82,17 +89,36 @@ using namespace media;
                                 output[1] = input[1] + coeff * (input[2] + input[4])
  6 (5.1)        2 (Stereo)      output[0] = input[0] + coeff * (input[2] + input[4])
                                 output[1] = input[1] + coeff * (input[2] + input[5])
+ N (Multi)      1 (Mono)        output[0] = 0.5 * (stereo[0] + stereo[1])
+
+ Other conversions keep the channels existing in both layouts. When upmixing,
+ mono goes to the center channel, or to front left/right if there is no center.
+ When downmixing between multi-channel layouts, each dropped channel is added to
+ front left/right with the coefficient of the stereo rules above.
+
+ All rules are turned into one Q14 matrix, scaled by the gain, so that remix,
+ gain and clipping are done in a single pass over the buffer.
 */
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
-#define MIX_COEFF   7071 / 1000 // 0.7071, DONOT (7071 / 1000)
+#define MAX_CHANNELS    6
+
+#define Q14_ONE         (REMIX_GAIN_UNITY)
+#define Q14_HALF        (Q14_ONE / 2)
+#define Q14_ROUND       (Q14_ONE / 2)
+#define Q14_SHIFT       (14)
+
+#define MIX_COEFF       (11585) // 0.7071 in Q14
+
+// Input channels mixed into a stereo channel at most, see the table above
+#define STEREO_TAPS     3
 
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
-
+typedef int16_t remix_matrix_t[MAX_CHANNELS][MAX_CHANNELS];
 
 /****************************************************************************
  * Private Functions
@@ -143,179 +169,435 @@ uint32_t ch2layout(uint32_t nb_chs)
 }
 
 // Clip an integer value (32 bits) to a signed short type value(16 bits)
-static int16_t clip(int32_t x)
+static inline int16_t clip(int32_t x)
 {
-	if (x < INT16_MIN) {
-		return INT16_MIN;
-	} else if (x > INT16_MAX) {
-		return INT16_MAX;
-	}
+#ifdef REMIX_USE_DSP
+	return (int16_t)__ssat(x, 16);
+#else
+	// Both bounds are selected without branches, which audio data would mispredict
+	x = x > INT16_MAX ? INT16_MAX : x;
+	return (int16_t)(x < INT16_MIN ? INT16_MIN : x);
+#endif
+}
 
-	return x;
+// Scale a sample by a Q14 gain with rounding
+static inline int32_t scale(int32_t x, int32_t gain)
+{
+	return (x * gain + Q14_ROUND) >> Q14_SHIFT;
 }
 
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
-int32_t rechannel(uint32_t in_layout, uint32_t out_layout, const int16_t *input, uint32_t in_frames, int16_t *output, uint32_t max_frames)
+#ifdef REMIX_USE_DSP
+// Scale both samples of a pair by a Q14 gain with rounding, the products must fit 16 bits
+static inline int32_t scale_pair(int32_t x, int16_t gain)
 {
-	RETURN_VAL_IF_FAIL((input != NULL), -1);
-	RETURN_VAL_IF_FAIL((output != NULL), -1);
-	RETURN_VAL_IF_FAIL((out_layout == CH_LAYOUT_MONO || out_layout == CH_LAYOUT_STEREO), -1);
+	int32_t lo = (__smulbb(x, gain) + Q14_ROUND) >> Q14_SHIFT;
+	int32_t hi = (__smultb(x, gain) + Q14_ROUND) >> Q14_SHIFT;
+	return (int32_t)(((uint32_t)lo & 0xffff) | ((uint32_t)hi << 16));
+}
+#endif
 
-	uint32_t out_frames = MINIMUM(in_frames, max_frames);
+// Position of the channel in a frame, channels are ordered by their mask bit
+static inline uint32_t ch_index(uint32_t layout, uint32_t mask)
+{
+	return __builtin_popcount(layout & (mask - 1));
+}
 
-	if (in_layout == out_layout) {
-		// Same layout
-		if (output != input) {
-			memcpy((void *)output, (const void *)input, out_frames * layout2ch(out_layout) * sizeof(int16_t));
-		}
-		return (int32_t)out_frames;
+// Stereo coefficient of the given input channel, following the table above
+static void stereo_coeff(uint32_t in_layout, uint32_t mask, int32_t *left, int32_t *right)
+{
+	int32_t front = Q14_ONE;
+	int32_t other = Q14_HALF;
+
+	if (in_layout == CH_LAYOUT_QUAD) {
+		front = Q14_HALF;
+	} else if (in_layout & (CH_MASK_BL | CH_MASK_BR)) {
+		other = MIX_COEFF;
+	} else if (in_layout == CH_LAYOUT_MONO) {
+		other = Q14_ONE;
 	}
 
-	// Multi -> mono in two steps
-	if ((in_layout != CH_LAYOUT_MONO && in_layout != CH_LAYOUT_STEREO) && (out_layout == CH_LAYOUT_MONO)) {
-		// Firstly, multi -> stereo
-		int32_t ret = rechannel(in_layout, CH_LAYOUT_STEREO, input, in_frames, output, max_frames);
-		if (ret < 0) {
-			return ret;
-		}
-		// And then, stereo -> mono
-		return rechannel(CH_LAYOUT_STEREO, CH_LAYOUT_MONO, output, (uint32_t)ret, output, max_frames);
+	*left = 0;
+	*right = 0;
+	switch (mask) {
+	case CH_MASK_FL:
+		*left = front;
+		break;
+	case CH_MASK_FR:
+		*right = front;
+		break;
+	case CH_MASK_FC:
+		*left = other;
+		*right = other;
+		break;
+	case CH_MASK_BL:
+		*left = other;
+		break;
+	case CH_MASK_BR:
+		*right = other;
+		break;
+	default:
+		// CH_MASK_LF is not rendered
+		break;
 	}
+}
 
-	// Now consider scenarios:
-	// stereo -> mono, mono -> stereo, multi -> stereo.
-
-	const int16_t *in_fl, *in_fr, *in_fc, /* *in_lfe, */ *in_bl, *in_br;
+/**
+ * Build the Q14 matrix of output channel x input channel, scaled by gain.
+ */
+static void build_matrix(uint32_t in_layout, uint32_t out_layout, int32_t gain, remix_matrix_t m)
+{
+	int32_t coeff[MAX_CHANNELS][MAX_CHANNELS];
 	uint32_t in_ch = layout2ch(in_layout);
 	uint32_t out_ch = layout2ch(out_layout);
-	uint32_t out_samples = out_frames * out_ch;
-	int16_t *out_end = &output[out_samples];
-	int16_t *out_fl = &output[0];
-	int16_t *out_fr = &output[1];
-	int16_t *out_fc;
-
-	switch (in_layout) {
-	case CH_LAYOUT_MONO: { // out_layout: CH_LAYOUT_STEREO
-		// Maybe input == output, upmix backward.
-		in_fc = &input[out_frames * in_ch - 1];
-		out_fl = &output[out_samples - 2];
-		out_fr = &output[out_samples - 1];
+	uint32_t mask;
+	uint32_t i;
+	uint32_t o;
 
-		while (output <= out_fl) {
-			*out_fr = *in_fc;
-			*out_fl = *in_fc;
+	memset(coeff, 0, sizeof(coeff));
 
-			out_fr -= out_ch;
-			out_fl -= out_ch;
-			in_fc -= in_ch;
+	for (mask = 1; mask <= in_layout; mask <<= 1) {
+		if (!(in_layout & mask)) {
+			continue;
+		}
+		i = ch_index(in_layout, mask);
+
+		int32_t left;
+		int32_t right;
+		stereo_coeff(in_layout, mask, &left, &right);
+
+		if (out_layout == CH_LAYOUT_STEREO) {
+			coeff[0][i] = left;
+			coeff[1][i] = right;
+		} else if (out_layout == CH_LAYOUT_MONO) {
+			// Downmix to stereo, then average the two channels
+			coeff[0][i] = (left + right) / 2;
+		} else if (out_layout & mask) {
+			coeff[ch_index(out_layout, mask)][i] = Q14_ONE;
+		} else {
+			// Dropped channel is folded into front left/right, mono goes there if there is no center
+			coeff[ch_index(out_layout, CH_MASK_FL)][i] += left;
+			coeff[ch_index(out_layout, CH_MASK_FR)][i] += right;
 		}
-	} break;
+	}
 
-	case CH_LAYOUT_STEREO: { // out_layout: CH_LAYOUT_MONO
-		in_fl = &input[0];
-		in_fr = &input[1];
-		out_fc = &output[0];
+	for (o = 0; o < out_ch; o++) {
+		for (i = 0; i < in_ch; i++) {
+			m[o][i] = clip(scale(coeff[o][i], gain));
+		}
+	}
+}
 
-		while (out_fc < out_end) {
-			*out_fc = ((int32_t)*in_fl + *in_fr) / 2;
+// Apply gain to samples of the same layout in place, a single pointer lets the loop vectorize
+static void apply_gain(int16_t *output, uint32_t samples, int16_t gain)
+{
+	const int16_t *input = output;
+	uint32_t n = 0;
+
+#if defined(REMIX_USE_MVE)
+	for (; n + 8 <= samples; n += 8) {
+		int16x8_t x = vld1q_s16(input + n);
+		int32x4_t even = vmullbq_int_s16(x, vdupq_n_s16(gain));
+		int32x4_t odd = vmulltq_int_s16(x, vdupq_n_s16(gain));
+		x = vqrshrnbq_n_s32(x, even, Q14_SHIFT);
+		x = vqrshrntq_n_s32(x, odd, Q14_SHIFT);
+		vst1q_s16(output + n, x);
+	}
+#elif defined(REMIX_USE_DSP)
+	for (; n + 2 <= samples; n += 2) {
+		int32_t x;
+		memcpy(&x, input + n, sizeof(x));
+		int32_t lo = __ssat((__smulbb(x, gain) + Q14_ROUND) >> Q14_SHIFT, 16);
+		int32_t hi = __ssat((__smultb(x, gain) + Q14_ROUND) >> Q14_SHIFT, 16);
+		x = (int32_t)(((uint32_t)lo & 0xffff) | ((uint32_t)hi << 16));
+		memcpy(output + n, &x, sizeof(x));
+	}
+#endif
 
-			out_fc += out_ch;
-			in_fl += in_ch;
-			in_fr += in_ch;
+	for (; n < samples; n++) {
+		output[n] = clip(scale(input[n], gain));
+	}
+}
+
+// Mix one frame, all input samples are read before any output sample is written.
+// It is inlined into loops of constant numbers of channels to be unrolled there.
+static inline_function inline void mix_frame(const int16_t *in, uint32_t in_ch, int16_t *out, uint32_t out_ch, const remix_matrix_t m)
+{
+	int32_t acc[MAX_CHANNELS];
+	uint32_t o;
+	uint32_t i;
+
+#ifdef REMIX_USE_DSP
+	int32_t pairs[MAX_CHANNELS / 2];
+	for (i = 0; i + 2 <= in_ch; i += 2) {
+		memcpy(&pairs[i / 2], in + i, sizeof(int32_t));
+	}
+	for (o = 0; o < out_ch; o++) {
+		acc[o] = Q14_ROUND;
+		for (i = 0; i + 2 <= in_ch; i += 2) {
+			int32_t coeff;
+			memcpy(&coeff, &m[o][i], sizeof(coeff));
+			acc[o] = __smlad(pairs[i / 2], coeff, acc[o]);
+		}
+		if (i < in_ch) {
+			acc[o] += (int32_t)in[i] * m[o][i];
+		}
+	}
+#else
+	for (o = 0; o < out_ch; o++) {
+		acc[o] = Q14_ROUND;
+		for (i = 0; i < in_ch; i++) {
+			acc[o] += (int32_t)in[i] * m[o][i];
 		}
-	} break;
+	}
+#endif
 
-	// Below cases process: multi -> stereo
+	for (o = 0; o < out_ch; o++) {
+		out[o] = clip(acc[o] >> Q14_SHIFT);
+	}
+}
 
-	case CH_LAYOUT_2POINT1: {
-		in_fl = &input[0];
-		in_fr = &input[1];
-		// in_lfe at &input[2]
+// Mix frames, in place when input == output
+static void mix_frames(const int16_t *input, uint32_t in_ch, int16_t *output, uint32_t out_ch, uint32_t frames, const remix_matrix_t m)
+{
+	uint32_t f;
 
-		while (out_fl < out_end) {
-			*out_fl = *in_fl;
-			*out_fr = *in_fr;
+	if (out_ch <= in_ch) {
+		// Output never overtakes input, so it works in place.
+		for (f = 0; f < frames; f++) {
+			mix_frame(&input[f * in_ch], in_ch, &output[f * out_ch], out_ch, m);
+		}
+	} else {
+		// Maybe input == output, upmix backward.
+		for (f = frames; f > 0; f--) {
+			mix_frame(&input[(f - 1) * in_ch], in_ch, &output[(f - 1) * out_ch], out_ch, m);
+		}
+	}
+}
+
+// Mix frames of constant numbers of channels, so that the frame is unrolled. The matrix is
+// copied as output samples could alias it, which would make it reloaded for every frame.
+template <uint32_t IN, uint32_t OUT>
+static void mix_frames(const int16_t *input, int16_t *output, uint32_t frames, const remix_matrix_t m)
+{
+	remix_matrix_t coeff;
+	uint32_t f;
 
-			out_fl += out_ch;
-			out_fr += out_ch;
-			in_fl += in_ch;
-			in_fr += in_ch;
+	memcpy(coeff, m, sizeof(coeff));
+	if (OUT <= IN) {
+		for (f = 0; f < frames; f++) {
+			mix_frame(&input[f * IN], IN, &output[f * OUT], OUT, coeff);
 		}
-	} break;
-
-	case CH_LAYOUT_3POINT1:  // fall through
-	case CH_LAYOUT_SURROUND: {
-		in_fl = &input[0];
-		in_fr = &input[1];
-		in_fc = &input[2];
-		// in_lfe at &input[3]
-
-		while (out_fl < out_end) {
-			*out_fl = clip((int32_t)*in_fl + *in_fc / 2);
-			*out_fr = clip((int32_t)*in_fr + *in_fc / 2);
-
-			out_fl += out_ch;
-			out_fr += out_ch;
-			in_fl += in_ch;
-			in_fr += in_ch;
-			in_fc += in_ch;
+	} else {
+		for (f = frames; f > 0; f--) {
+			mix_frame(&input[(f - 1) * IN], IN, &output[(f - 1) * OUT], OUT, coeff);
 		}
-	} break;
-
-	case CH_LAYOUT_QUAD: {
-		in_fl = &input[0];
-		in_fr = &input[1];
-		in_bl = &input[2];
-		in_br = &input[3];
-
-		while (out_fl < out_end) {
-			*out_fl = ((int32_t)*in_fl + *in_bl) / 2;
-			*out_fr = ((int32_t)*in_fr + *in_br) / 2;
-
-			out_fl += out_ch;
-			out_fr += out_ch;
-			in_fl += in_ch;
-			in_fr += in_ch;
-			in_bl += in_ch;
-			in_br += in_ch;
+	}
+}
+
+// Downmix frames to stereo with the non-zero coefficients of the matrix only, up to
+// STEREO_TAPS for each channel, the others are zero. Output never overtakes input.
+template <uint32_t IN>
+static void mix_frames_stereo(const int16_t *input, int16_t *output, uint32_t frames, const uint8_t tap[2][STEREO_TAPS], const int16_t coeff[2][STEREO_TAPS])
+{
+	uint8_t l0 = tap[0][0], l1 = tap[0][1], l2 = tap[0][2];
+	uint8_t r0 = tap[1][0], r1 = tap[1][1], r2 = tap[1][2];
+	int32_t cl0 = coeff[0][0], cl1 = coeff[0][1], cl2 = coeff[0][2];
+	int32_t cr0 = coeff[1][0], cr1 = coeff[1][1], cr2 = coeff[1][2];
+	uint32_t f;
+
+	for (f = 0; f < frames; f++, input += IN, output += 2) {
+		int32_t left = Q14_ROUND + input[l0] * cl0 + input[l1] * cl1 + input[l2] * cl2;
+		int32_t right = Q14_ROUND + input[r0] * cr0 + input[r1] * cr1 + input[r2] * cr2;
+		output[0] = clip(left >> Q14_SHIFT);
+		output[1] = clip(right >> Q14_SHIFT);
+	}
+}
+
+// Find the non-zero coefficients of the stereo matrix, false if there are too many
+static bool stereo_taps(uint32_t in_ch, const remix_matrix_t m, uint8_t tap[2][STEREO_TAPS], int16_t coeff[2][STEREO_TAPS])
+{
+	uint32_t o;
+	uint32_t i;
+
+	memset(tap, 0, 2 * STEREO_TAPS * sizeof(uint8_t));
+	memset(coeff, 0, 2 * STEREO_TAPS * sizeof(int16_t));
+	for (o = 0; o < 2; o++) {
+		uint32_t n = 0;
+		for (i = 0; i < in_ch; i++) {
+			if (m[o][i] == 0) {
+				continue;
+			}
+			if (n == STEREO_TAPS) {
+				return false;
+			}
+			tap[o][n] = i;
+			coeff[o][n] = m[o][i];
+			n++;
 		}
-	} break;
-
-	case CH_LAYOUT_5POINT1_BACK: // fall through
-	case CH_LAYOUT_5POINT0_BACK: {
-		in_fl = &input[0];
-		in_fr = &input[1];
-		in_fc = &input[2];
-		if (in_layout == CH_LAYOUT_5POINT1_BACK) {
-			// in_lfe at &input[3]
-			in_bl = &input[4];
-			in_br = &input[5];
-		} else {
-			in_bl = &input[3];
-			in_br = &input[4];
+	}
+
+	return true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+int32_t remix(uint32_t in_layout, uint32_t out_layout, const int16_t *input, uint32_t in_frames, int16_t *output, uint32_t max_frames, uint16_t gain)
+{
+	RETURN_VAL_IF_FAIL((input != NULL), -1);
+	RETURN_VAL_IF_FAIL((output != NULL), -1);
+
+	uint32_t in_ch = layout2ch(in_layout);
+	uint32_t out_ch = layout2ch(out_layout);
+	if (in_ch == 0 || out_ch == 0) {
+		meddbg("unsupported layout 0x%x -> 0x%x\n", in_layout, out_layout);
+		return -1;
+	}
+
+	uint32_t out_frames = MINIMUM(in_frames, max_frames);
+	int16_t q14_gain = (int16_t)MINIMUM(gain, INT16_MAX);
+
+	if (in_layout == out_layout) {
+		// Same layout
+		if (output != input) {
+			memcpy((void *)output, (const void *)input, out_frames * out_ch * sizeof(int16_t));
 		}
+		if (q14_gain != Q14_ONE) {
+			apply_gain(output, out_frames * out_ch, q14_gain);
+		}
+		return (int32_t)out_frames;
+	}
 
-		while (out_fl < out_end) {
-			*out_fl = clip(*in_fl + ((int32_t)*in_fc + *in_bl) * MIX_COEFF);
-			*out_fr = clip(*in_fr + ((int32_t)*in_fc + *in_br) * MIX_COEFF);
-
-			out_fl += out_ch;
-			out_fr += out_ch;
-			in_fl += in_ch;
-			in_fr += in_ch;
-			in_fc += in_ch;
-			in_bl += in_ch;
-			in_br += in_ch;
+	remix_matrix_t m;
+	memset(m, 0, sizeof(m));
+	build_matrix(in_layout, out_layout, q14_gain, m);
+
+	// Downmix to stereo takes a few channels of the frame only
+	uint8_t tap[2][STEREO_TAPS];
+	int16_t coeff[2][STEREO_TAPS];
+	if (out_ch == 2 && in_ch > 2 && stereo_taps(in_ch, m, tap, coeff)) {
+		switch (in_ch) {
+		case 3:
+			mix_frames_stereo<3>(input, output, out_frames, tap, coeff);
+			break;
+		case 4:
+			mix_frames_stereo<4>(input, output, out_frames, tap, coeff);
+			break;
+		case 5:
+			mix_frames_stereo<5>(input, output, out_frames, tap, coeff);
+			break;
+		default:
+			mix_frames_stereo<6>(input, output, out_frames, tap, coeff);
+			break;
 		}
-	} break;
+		return (int32_t)out_frames;
+	}
 
+	// Conversions to mono and stereo are unrolled for their number of channels
+	switch (out_ch * 8 + in_ch) {
+	case 1 * 8 + 2:
+		mix_frames<2, 1>(input, output, out_frames, m);
+		break;
+	case 1 * 8 + 3:
+		mix_frames<3, 1>(input, output, out_frames, m);
+		break;
+	case 1 * 8 + 4:
+		mix_frames<4, 1>(input, output, out_frames, m);
+		break;
+	case 1 * 8 + 5:
+		mix_frames<5, 1>(input, output, out_frames, m);
+		break;
+	case 1 * 8 + 6:
+		mix_frames<6, 1>(input, output, out_frames, m);
+		break;
+	case 2 * 8 + 1:
+		mix_frames<1, 2>(input, output, out_frames, m);
+		break;
+	case 2 * 8 + 3:
+		mix_frames<3, 2>(input, output, out_frames, m);
+		break;
+	case 2 * 8 + 4:
+		mix_frames<4, 2>(input, output, out_frames, m);
+		break;
+	case 2 * 8 + 5:
+		mix_frames<5, 2>(input, output, out_frames, m);
+		break;
+	case 2 * 8 + 6:
+		mix_frames<6, 2>(input, output, out_frames, m);
+		break;
 	default:
-		// unsupported in_layout
-		meddbg("unsupported in_layout 0x%x\n", in_layout);
-		return -1;
+		mix_frames(input, in_ch, output, out_ch, out_frames, m);
+		break;
 	}
 
 	return (int32_t)out_frames;
 }
+
+void remix_accumulate(int16_t *acc, const int16_t *input, uint32_t samples, uint16_t gain)
+{
+	uint32_t n = 0;
+
+	if (gain >= Q14_ONE) {
+#if defined(REMIX_USE_MVE)
+		for (; n + 8 <= samples; n += 8) {
+			vst1q_s16(acc + n, vqaddq_s16(vld1q_s16(acc + n), vld1q_s16(input + n)));
+		}
+#elif defined(REMIX_USE_DSP)
+		for (; n + 2 <= samples; n += 2) {
+			int32_t a;
+			int32_t x;
+			memcpy(&a, acc + n, sizeof(a));
+			memcpy(&x, input + n, sizeof(x));
+			a = __qadd16(a, x);
+			memcpy(acc + n, &a, sizeof(a));
+		}
+#endif
+		for (; n < samples; n++) {
+			acc[n] = clip((int32_t)acc[n] + input[n]);
+		}
+		return;
+	}
+
+#if defined(REMIX_USE_MVE)
+	// (x * 2g * 2 + 2^15) >> 16 is the rounded Q14 product, 2g fits 16 bits below unity
+	for (; n + 8 <= samples; n += 8) {
+		int16x8_t x = vqrdmulhq_n_s16(vld1q_s16(input + n), (int16_t)(gain << 1));
+		vst1q_s16(acc + n, vqaddq_s16(vld1q_s16(acc + n), x));
+	}
+#elif defined(REMIX_USE_DSP)
+	for (; n + 2 <= samples; n += 2) {
+		int32_t a;
+		int32_t x;
+		memcpy(&a, acc + n, sizeof(a));
+		memcpy(&x, input + n, sizeof(x));
+		a = __qadd16(a, scale_pair(x, gain));
+		memcpy(acc + n, &a, sizeof(a));
+	}
+#endif
+
+	for (; n < samples; n++) {
+		acc[n] = clip((int32_t)acc[n] + scale(input[n], gain));
+	}
+}
+
+void remix_accumulate_ramp(int16_t *acc, const int16_t *input, uint32_t frames, uint32_t channels, int32_t from, int32_t to, uint32_t pos, uint32_t total)
+{
+	uint32_t f;
+	uint32_t c;
+
+	for (f = 0; f < frames; f++) {
+		int32_t gain = from + ((to - from) * (int32_t)(pos + f)) / (int32_t)total;
+		for (c = 0; c < channels; c++) {
+			*acc = clip((int32_t)*acc + scale(*input, gain));
+			acc++;
+			input++;
+		}
+	}
+}
+
+int32_t rechannel(uint32_t in_layout, uint32_t out_layout, const int16_t *input, uint32_t in_frames, int16_t *output, uint32_t max_frames)
+{
+	RETURN_VAL_IF_FAIL((out_layout == CH_LAYOUT_MONO || out_layout == CH_LAYOUT_STEREO), -1);
+
+	return remix(in_layout, out_layout, input, in_frames, output, max_frames, REMIX_GAIN_UNITY);
+}
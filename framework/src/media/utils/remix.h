@@ -21,6 +21,9 @@
 
 #include <stdint.h>
 
+/* Gain of remix() in Q14 format, unity keeps the level */
+#define REMIX_GAIN_UNITY (1 << 14)
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -52,6 +55,43 @@ uint32_t ch2layout(uint32_t nb_chs);
  */
 int32_t rechannel(uint32_t in_layout, uint32_t out_layout, const int16_t *input, uint32_t in_frames, int16_t *output, uint32_t max_frames);
 
+/**
+ * @brief   Remix audio channel, apply gain and clip in one pass
+ * @remarks Support conversion between any layouts of ch2layout(), rules of rechannel() apply
+ *          for mono/stereo output. Channels of other layouts are kept or folded into front left/right.
+ * @param   in_layout: channel layout of the input audio
+ * @param   out_layout: channel layout desired for the output
+ * @param   input: pointer to the input buffer
+ * @param   in_frames: number of frames in input buffer
+ * @param   output: pointer to the output buffer, it can be same with input buffer
+ * @param   max_frames: maximum of frames in specified layout can be stored in output buffer
+ * @param   gain: gain in Q14 format, REMIX_GAIN_UNITY for unity gain, up to INT16_MAX (about +6dB)
+ * @return  number of frames remixed and stored in output buffer, return negative value on failure.
+ */
+int32_t remix(uint32_t in_layout, uint32_t out_layout, const int16_t *input, uint32_t in_frames, int16_t *output, uint32_t max_frames, uint16_t gain);
+
+/**
+ * @brief   Add samples scaled by a gain to the accumulator with saturation
+ * @param   acc: samples to add to
+ * @param   input: samples to be added
+ * @param   samples: number of samples
+ * @param   gain: gain in Q14 format, up to REMIX_GAIN_UNITY
+ */
+void remix_accumulate(int16_t *acc, const int16_t *input, uint32_t samples, uint16_t gain);
+
+/**
+ * @brief   Add frames with a gain ramping linearly to the accumulator with saturation
+ * @param   acc: frames to add to
+ * @param   input: frames to be added
+ * @param   frames: number of frames
+ * @param   channels: number of channels of a frame
+ * @param   from: gain in Q14 format at the start of the ramp, up to REMIX_GAIN_UNITY
+ * @param   to: gain in Q14 format at the end of the ramp, up to REMIX_GAIN_UNITY
+ * @param   pos: position of the first frame in the ramp
+ * @param   total: number of frames of the ramp
+ */
+void remix_accumulate_ramp(int16_t *acc, const int16_t *input, uint32_t frames, uint32_t channels, int32_t from, int32_t to, uint32_t pos, uint32_t total);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif /* __cplusplus */
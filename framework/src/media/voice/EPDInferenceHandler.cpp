@@ -25,8 +25,8 @@
 
 static uint16_t gModelCount = 1;
 
-EPDInferenceHandler::EPDInferenceHandler(InferenceResultListener listener) :
-	AIInferenceHandler(gModelCount, listener)
+EPDInferenceHandler::EPDInferenceHandler(InferenceResultListener listener, uint32_t sampleRate) :
+	AIInferenceHandler(gModelCount, listener), mSampleRate(sampleRate)
 {
 	medvdbg("EPDInferenceHandler constructor");
 }
@@ -38,17 +38,23 @@ EPDInferenceHandler::~EPDInferenceHandler()
 
 AIFW_RESULT EPDInferenceHandler::prepare(void)
 {
-	mEPDProcessHandler = std::make_shared<EPDProcessHandler>();
-	if (!mEPDProcessHandler) {
+	std::shared_ptr<EPDProcessHandler> processHandler = std::make_shared<EPDProcessHandler>();
+	if (!processHandler) {
 		meddbg("EPD process handler memory allocation failed.");
 		return AIFW_NO_MEM;
 	}
+	AIFW_RESULT result = processHandler->init(mSampleRate);
+	if (result != AIFW_OK) {
+		meddbg("EPD process handler init failed. error: %d", result);
+		return result;
+	}
+	mEPDProcessHandler = processHandler;
 	mEPDModel = std::make_shared<aifw::AIModel>(mEPDProcessHandler);
 	if (!mEPDModel) {
 		meddbg("EPD model memory allocation failed.");
 		return AIFW_NO_MEM;
 	}
-	AIFW_RESULT result = mEPDModel->loadModel("/mnt/EPD.json");
+	result = mEPDModel->loadModel("/mnt/EPD.json");
 	if (result != AIFW_OK) {
 		meddbg("EPD Model load failed. error: %d", result);
 		return result;
@@ -91,6 +97,8 @@ AIFW_RESULT EPDInferenceHandler::clearData(void)
 		meddbg("clear raw data of EPD model failed. ret: %d", res);
 		return res;
 	}
+	/* PCM of the next utterance should not be framed together with the previous one */
+	std::static_pointer_cast<EPDProcessHandler>(mEPDProcessHandler)->resetFeatures();
 
 	medvdbg("EPD model clear data done");
 	return AIFW_OK;
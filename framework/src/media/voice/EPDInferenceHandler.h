@@ -27,8 +27,9 @@ public:
     /**
 	 * @brief EPDInferenceHandler constructor.
 	 * @param [IN] listener: Callback for inference result.
+	 * @param [IN] sampleRate: Sample rate of PCM pushed to EPD model.
 	*/
-	EPDInferenceHandler(InferenceResultListener listener);
+	EPDInferenceHandler(InferenceResultListener listener, uint32_t sampleRate);
 
     /**
 	 * @brief EPDInferenceHandler destructor.
@@ -58,4 +59,5 @@ private:
 	*/
 	std::shared_ptr<aifw::AIModel> mEPDModel;
 	std::shared_ptr<aifw::AIProcessHandler> mEPDProcessHandler;
+	uint32_t mSampleRate;
 };
@@ -23,6 +23,21 @@
 #include "EPDProcessHandler.h"
 #include <debug.h>
 
+#ifndef CONFIG_MEDIA_SOFTWARE_EPD_MEL_BANDS
+#define CONFIG_MEDIA_SOFTWARE_EPD_MEL_BANDS 10
+#endif
+
+/* EPD model takes log-mel energies of the latest frames, a short context in input 0 and a long one in input 1 */
+#define EPD_INPUT_SET_COUNT 2
+static const uint16_t gInputSetSize[EPD_INPUT_SET_COUNT] = {50, 100};
+#define EPD_CONTEXT_FRAMES (100 / CONFIG_MEDIA_SOFTWARE_EPD_MEL_BANDS)
+
+/* Frames of 25 msec every 10 msec */
+#define EPD_FRAME_MSEC 25
+#define EPD_SHIFT_MSEC 10
+#define EPD_LOW_FREQUENCY 20.0f
+#define EPD_PRE_EMPHASIS 0.97f
+
 EPDProcessHandler::EPDProcessHandler()
 {
 	medvdbg("EPDProcessHandler cosntructor");
@@ -33,6 +48,36 @@ EPDProcessHandler::~EPDProcessHandler()
 	medvdbg("EPDProcessHandler destructor");
 }
 
+AIFW_RESULT EPDProcessHandler::init(uint32_t sampleRate)
+{
+	aifw::AIFeatureConfig config;
+	config.sampleRate = sampleRate;
+	config.frameLength = sampleRate * EPD_FRAME_MSEC / 1000;
+	config.frameShift = sampleRate * EPD_SHIFT_MSEC / 1000;
+	config.fftLength = 32;
+	while (config.fftLength < config.frameLength) {
+		config.fftLength <<= 1;
+	}
+	config.melBands = CONFIG_MEDIA_SOFTWARE_EPD_MEL_BANDS;
+	config.mfccCount = 0;
+	config.lowFrequency = EPD_LOW_FREQUENCY;
+	config.highFrequency = 0;
+	config.preEmphasis = EPD_PRE_EMPHASIS;
+	config.contextFrames = EPD_CONTEXT_FRAMES;
+	AIFW_RESULT res = mFeatureExtractor.init(config);
+	if (res != AIFW_OK) {
+		meddbg("EPD feature extractor init failed for %u Hz, error: %d", sampleRate, res);
+		return res;
+	}
+	medvdbg("EPD features: %d bands, frame %d shift %d fft %d", config.melBands, config.frameLength, config.frameShift, config.fftLength);
+	return AIFW_OK;
+}
+
+void EPDProcessHandler::resetFeatures(void)
+{
+	mFeatureExtractor.reset();
+}
+
 AIFW_RESULT EPDProcessHandler::parseData(void *data, uint16_t count, float *parsedData, AIModelAttribute *modelAttribute)
 {
 	/** 
@@ -74,33 +119,38 @@ AIFW_RESULT EPDProcessHandler::preProcessData(std::shared_ptr<aifw::AIDataBuffer
 		return AIFW_INVALID_ARG;
 	}
 
-	/* Preprocessing of raw data can be done at this point. Preprocess result save in invokeInput */
-	/* Sample PreProcessing Logic : Filled Invokeinput with zeros and attached sample code for getting data from AIDataBuffer. */
-	/* Sample Preprocessing Logic Start here. */
-	/* Step 1 : Create memory to store one row of input data. */
-	float *rawData = new float[modelAttribute->rawDataCount];
-	if (!rawData) {
-		meddbg("Memory Allocation failed - data read buffer");
-		return AIFW_NO_MEM;
+	if (countInputSets != EPD_INPUT_SET_COUNT) {
+		meddbg("EPD model has %d inputs, %d expected", countInputSets, EPD_INPUT_SET_COUNT);
+		return AIFW_INVALID_ARG;
 	}
 
-	/* Step 2 : Read the parsed raw data from the latest row of buffer. At this time the latest row does not include invoke result. */
-	AIFW_RESULT res = buffer->readData(rawData, 0, modelAttribute->rawDataCount, 0);
+	/* Latest row holds PCM bytes copied by parseData, it is read in place */
+	aifw::AIDataBufferWindow window;
+	AIFW_RESULT res = buffer->getWindow(&window, 1);
 	if (res != AIFW_OK) {
-		AIFW_LOGE("Reading Data from the buffer failed.");
-		delete[] rawData;
+		meddbg("Reading Data from the buffer failed. error: %d", res);
+		return res;
+	}
+	if (window.type != AIFW_DATA_FLOAT32) {
+		meddbg("PCM should be stored in a float32 data buffer");
+		return AIFW_INVALID_ATTRIBUTE;
+	}
+	res = mFeatureExtractor.pushSamples((const int16_t *)window.span[0].data, modelAttribute->rawDataCount * sizeof(float) / sizeof(int16_t), NULL);
+	if (res != AIFW_OK) {
+		meddbg("Feature extraction failed. error: %d", res);
 		return res;
 	}
 
-	/* Step 3 : Prepare InvokeInput for the model inference. */
-	short *srawData = (short *)rawData;
-	uint16_t inputSetSize[2] = {50, 100};
-	memset(invokeInput[0], '\0', inputSetSize[0] * sizeof(float));
-	memset(invokeInput[1], '\0', inputSetSize[1] * sizeof(float));
-
-	/* Step 4 : Cleanup all local variables. */
-	delete[] rawData;
-	/* Sample Preprocessing Logic Ends here. */
+	/* Features of the latest frames are written straight into invoke inputs, invoke is skipped until enough frames are computed */
+	uint16_t featureCount = mFeatureExtractor.getFeatureCount();
+	for (uint16_t i = 0; i < EPD_INPUT_SET_COUNT; i++) {
+		uint16_t frames = gInputSetSize[i] / featureCount;
+		res = mFeatureExtractor.readFeatures(invokeInput[i], frames);
+		if (res != AIFW_OK) {
+			return res;
+		}
+		memset(invokeInput[i] + frames * featureCount, 0, (gInputSetSize[i] - frames * featureCount) * sizeof(float));
+	}
 
 	medvdbg("EPD model pre-process data complete OK");
 	return AIFW_OK;
@@ -118,32 +168,13 @@ AIFW_RESULT EPDProcessHandler::postProcessData(std::shared_ptr<aifw::AIDataBuffe
 	}
 
 	/* Post processing of result can be done at this point. Post Process result save in resultData */
-	/* Sample PostProcessing Logic : Copy the invoke output. */
-	/* Sample PostProcessing Logic Start here. */
-	/* Step 1 : Create memory to store one row of data. */
-	float *rawdata_invokeoutput = new float[modelAttribute->rawDataCount + modelAttribute->invokeOutputCount];
-	if (!rawdata_invokeoutput) {
-		meddbg("Memory Allocation failed - data read buffer");
-		return AIFW_NO_MEM;
-	}
-
-	/* Step 2 : Read the latest raw from buffer. At this time latest row includes parsed raw data as well as invoke result. */
-	AIFW_RESULT res = buffer->readData(rawdata_invokeoutput, 0);
+	/* Invoke output follows parsed raw data in the latest row, it is copied as it is. */
+	AIFW_RESULT res = buffer->readData(resultData, modelAttribute->rawDataCount, modelAttribute->rawDataCount + modelAttribute->postProcessResultCount, 0);
 	if (res != AIFW_OK) {
 		meddbg("Reading Data from the buffer failed. error: %d", res);
-		delete[] rawdata_invokeoutput;
 		return res;
 	}
 
-	/* Step 3 : Add logic to copy the invoke output. */
-	for (int i = 0; i < modelAttribute->postProcessResultCount; i++) {
-		resultData[i] = rawdata_invokeoutput[modelAttribute->rawDataCount + i];
-	}
-
-	/* Step 4 : Cleanup all local variables. */
-	delete[] rawdata_invokeoutput;
-	/* Sample Postprocessing Logic Ends here. */
-
 	medvdbg("EPD model post-process data complete OK");
 	return res;
 }
@@ -20,6 +20,7 @@
 #include <memory>
 #include "aifw/aifw.h"
 #include "aifw/AIProcessHandler.h"
+#include "aifw/AIFeatureExtractor.h"
 
 /**
  * @brief This class implements operations related to inference. It prepares data in parseData function.
@@ -41,6 +42,18 @@ public:
 	*/
 	~EPDProcessHandler();
 
+	/**
+	 * @brief Prepares log-mel feature extraction of PCM pushed to the model.
+	 * @param [in] sampleRate: Sample rate of mono PCM from the recorder.
+	 * @return: AIFW_RESULT enum object.
+	*/
+	AIFW_RESULT init(uint32_t sampleRate);
+
+	/**
+	 * @brief Drops PCM and features collected so far.
+	*/
+	void resetFeatures(void);
+
 	/**
 	 *! @copydoc AIProcessHandler::parseData()
 	*/
@@ -55,4 +68,7 @@ public:
 	 *! @copydoc AIProcessHandler::postProcessData()
 	*/	
 	AIFW_RESULT postProcessData(std::shared_ptr<aifw::AIDataBuffer> buffer, float *resultData, AIModelAttribute *modelAttribute);
+
+private:
+	aifw::AIFeatureExtractor mFeatureExtractor;
 };
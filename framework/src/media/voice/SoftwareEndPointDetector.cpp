@@ -38,7 +38,7 @@ SoftwareEndPointDetector::~SoftwareEndPointDetector()
 
 bool SoftwareEndPointDetector::init(uint32_t samprate, uint8_t channels)
 {
-	mAIInferenceHandler = std::make_shared<EPDInferenceHandler>(epd_inferenceResultListener);
+	mAIInferenceHandler = std::make_shared<EPDInferenceHandler>(epd_inferenceResultListener, samprate);
 	if (!mAIInferenceHandler) {
 		meddbg("Memory allocation failed for mAIInferenceHandler");
 		return false;
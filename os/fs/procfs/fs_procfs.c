@@ -111,6 +111,9 @@ extern const struct procfs_operations power_procfsoperations;
 extern const struct procfs_operations cm_operations;
 extern const struct procfs_operations irqs_operations;
 extern const struct procfs_operations ereport_operations;
+extern const struct procfs_operations media_operations;
+extern const struct procfs_operations heapstats_operations;
+extern const struct procfs_operations wdog_operations;
 
 /* And even worse, this one is specific to the STM32.  The solution to
  * this nasty couple would be to replace this hard-coded, ROM-able
@@ -174,6 +177,18 @@ static const struct procfs_entry_s g_procfsentries[] = {
 	{"ereport/*", &ereport_operations},
 #endif
 
+#if defined(CONFIG_MEDIA_PIPELINE_STATS) && defined(CONFIG_BUILD_FLAT) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEDIA)
+	{"media", &media_operations},
+#endif
+
+#if defined(CONFIG_MM_HEAP_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_HEAPSTATS)
+	{"heapstats", &heapstats_operations},
+#endif
+
+#if defined(CONFIG_WDOG_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WDOG)
+	{"wdog", &wdog_operations},
+#endif
+
 	{NULL, NULL}
 };
 
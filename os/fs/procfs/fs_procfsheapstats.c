@@ -0,0 +1,302 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+#include <tinyara/mm/mm.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_MM_HEAP_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_HEAPSTATS)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to hold the statistics of all kernel heaps, and of their arenas.
+ */
+
+#define HEAPSTATS_HEAPLEN 1280
+#ifdef CONFIG_MM_ARENAS
+#define HEAPSTATS_LINELEN (HEAPSTATS_HEAPLEN * CONFIG_KMM_NHEAPS * (CONFIG_SMP_NCPUS + 1))
+#else
+#define HEAPSTATS_LINELEN (HEAPSTATS_HEAPLEN * CONFIG_KMM_NHEAPS)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct heapstats_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	unsigned int linesize;		/* Number of valid characters in line[] */
+	char line[HEAPSTATS_LINELEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int heapstats_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int heapstats_close(FAR struct file *filep);
+static ssize_t heapstats_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int heapstats_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int heapstats_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations heapstats_operations = {
+	heapstats_open,				/* open */
+	heapstats_close,			/* close */
+	heapstats_read,				/* read */
+	NULL,						/* write */
+
+	heapstats_dup,				/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	heapstats_stat					/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: heapstats_print
+ *
+ * Description:
+ *   Print the statistics of every kernel heap to buf of len bytes.
+ *
+ ****************************************************************************/
+
+static int heapstats_print(FAR char *buf, size_t len)
+{
+	size_t n = 0;
+	int i;
+
+	for (i = HEAP_START_IDX; i <= HEAP_END_IDX && n < len - 1; i++) {
+		n += snprintf(buf + n, len - n, "Heap %d\n", i);
+		if (n < len - 1) {
+			n += mm_heapstats_print(&g_kmmheap[i], buf + n, len - n);
+		}
+	}
+
+	return n < len ? n : len - 1;
+}
+
+/****************************************************************************
+ * Name: heapstats_open
+ ****************************************************************************/
+
+static int heapstats_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct heapstats_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "heapstats" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "heapstats") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct heapstats_file_s *)kmm_zalloc(sizeof(struct heapstats_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: heapstats_close
+ ****************************************************************************/
+
+static int heapstats_close(FAR struct file *filep)
+{
+	FAR struct heapstats_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct heapstats_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: heapstats_read
+ ****************************************************************************/
+
+static ssize_t heapstats_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct heapstats_file_s *attr;
+	off_t offset;
+	ssize_t ret;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct heapstats_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Take a snapshot of the statistics when reading from the start, so
+	 * that they stay consistent while they are read in several parts.
+	 */
+
+	if (filep->f_pos == 0) {
+		attr->linesize = heapstats_print(attr->line, HEAPSTATS_LINELEN);
+	}
+
+	/* Transfer the table to user receive buffer */
+
+	offset = filep->f_pos;
+	ret = procfs_memcpy(attr->line, attr->linesize, buffer, buflen, &offset);
+
+	/* Update the file offset */
+
+	if (ret > 0) {
+		filep->f_pos += ret;
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: heapstats_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int heapstats_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct heapstats_file_s *oldattr;
+	FAR struct heapstats_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct heapstats_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the attributes */
+
+	newattr = (FAR struct heapstats_file_s *)kmm_malloc(sizeof(struct heapstats_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct heapstats_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: heapstats_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int heapstats_stat(const char *relpath, struct stat *buf)
+{
+	/* "heapstats" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "heapstats") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "heapstats" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* CONFIG_MM_HEAP_STATS && !CONFIG_FS_PROCFS_EXCLUDE_HEAPSTATS */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
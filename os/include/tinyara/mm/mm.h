@@ -67,6 +67,9 @@
 #ifdef CONFIG_HEAPINFO_USER_GROUP
 #include <tinyara/mm/heapinfo_internal.h>
 #endif
+#if defined(CONFIG_MM_ARENAS) || defined(CONFIG_MM_SLAB)
+#include <tinyara/spinlock.h>
+#endif
 
 #include <tinyara/sched.h>
 /****************************************************************************
@@ -168,7 +171,29 @@
 
 #define MM_MIN_CHUNK     (1 << MM_MIN_SHIFT)
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
+#ifdef CONFIG_MM_TLSF
+/* Two-level segregated fit: Sizes below MM_TLSF_FLMIN have a list per
+ * granule in the first level 0. A first level fl > 0 holds sizes in
+ * [MM_TLSF_FLMIN << (fl - 1), MM_TLSF_FLMIN << fl), split evenly into
+ * MM_TLSF_SLCOUNT second level lists. Sizes from MM_MAX_CHUNK << 1 go to the
+ * last list.
+ */
+
+#define MM_TLSF_SLI      CONFIG_MM_TLSF_SLI
+#define MM_TLSF_SLCOUNT  (1 << MM_TLSF_SLI)
+#define MM_TLSF_FLSHIFT  (MM_MIN_SHIFT + MM_TLSF_SLI)
+#define MM_TLSF_FLMIN    (1 << MM_TLSF_FLSHIFT)
+#define MM_TLSF_FLCOUNT  (MM_MAX_SHIFT - MM_TLSF_FLSHIFT + 2)
+#define MM_NNODES        (MM_TLSF_FLCOUNT * MM_TLSF_SLCOUNT)
+
+/* Smallest size in the list of an index */
+
+#define MM_TLSF_NDX2SIZE(ndx) \
+	((ndx) < MM_TLSF_SLCOUNT ? (size_t)(ndx) << MM_MIN_SHIFT : \
+	 ((size_t)MM_TLSF_SLCOUNT + ((ndx) & (MM_TLSF_SLCOUNT - 1))) << (((ndx) >> MM_TLSF_SLI) + MM_MIN_SHIFT - 1))
+#else
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
+#endif
 
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
@@ -340,6 +365,100 @@ struct mm_delaynode_s
 	FAR struct mm_delaynode_s *flink;
 };
 
+#ifdef CONFIG_MM_ARENAS
+/* Chunks up to this size are allocated from the arena of the CPU */
+
+#define MM_ARENA_MAXCHUNK (CONFIG_MM_ARENA_SIZE >> 3)
+#endif
+
+#ifdef CONFIG_MM_HEAP_STATS
+/* Sampled allocations by latency: bucket 0 counts those under 1 usec,
+ * bucket b > 0 those from 1 << (b - 1) usec, and the last one all longer.
+ */
+
+#define MM_STATS_NLATENCY 16
+
+/* Free chunks by size class: class c holds sizes from MM_MIN_CHUNK << c,
+ * and the last one all larger.
+ */
+
+#define MM_STATS_NSIZES   (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
+
+/* Counters of a heap, updated without holding its semaphore, so that
+ * concurrent allocations may rarely miss an increment.
+ */
+
+struct mm_heapstats_s {
+	uint32_t nallocs;			/* Calls of mm_malloc */
+	uint32_t nfails;			/* Calls of mm_malloc returning NULL */
+	uint32_t countdown;			/* Allocations until the next sampled one */
+	uint32_t nsampled;			/* Sampled allocations */
+	uint32_t maxlatency;			/* Longest sampled allocation in usec */
+	uint32_t latency[MM_STATS_NLATENCY];
+};
+#endif
+
+#ifdef CONFIG_MM_SLAB
+/* Small allocations are served from slabs, with a size class for every chunk
+ * size from MM_MIN_CHUNK to MM_SLAB_MAXCHUNK.  An object of a slab begins
+ * with an allocnode whose 'size' has MM_SLAB_BIT set, which never happens
+ * for a chunk of the heap as its size is a multiple of MM_MIN_CHUNK.  The
+ * 'preceding' of the object is its offset from the slab, with MM_ALLOC_BIT.
+ * A free object links to the next one through its data, so the smallest
+ * object has room for one pointer.
+ */
+
+#define MM_SLAB_MAXCHUNK  MM_ALIGN_UP(CONFIG_MM_SLAB_MAXSIZE + SIZEOF_MM_ALLOCNODE)
+#define MM_SLAB_MINCHUNK  MM_ALIGN_UP(SIZEOF_MM_ALLOCNODE + MM_PTR_SIZE)
+#define MM_SLAB_NCLASSES  (MM_SLAB_MAXCHUNK >> MM_MIN_SHIFT)
+#define MM_SLAB_CLASS(chunk) (((chunk) >> MM_MIN_SHIFT) - 1)
+#define MM_SLAB_BIT       1
+#define MM_IS_SLAB_OBJECT(node) (((node)->size & MM_SLAB_BIT) != 0)
+
+/* Offset of the first object from the slab, which keeps objects aligned as
+ * chunks of the heap.
+ */
+
+#define MM_SLAB_FIRST     (MM_ALIGN_UP(SIZEOF_MM_ALLOCNODE + sizeof(struct mm_slab_s)) - SIZEOF_MM_ALLOCNODE)
+
+/* Marks the allocnode of a slab in 'reserved' for heapinfo.  A slab is
+ * charged to no task, its objects are charged to the tasks allocating them.
+ */
+
+#define MM_SLAB_MAGIC     0x51ab
+
+/* This describes a slab, at the start of the heap chunk carved into objects */
+
+struct mm_slab_s {
+	FAR struct mm_slab_s *flink;		/* Slabs of a class having free objects */
+	FAR struct mm_slab_s *blink;
+	FAR struct mm_delaynode_s *freelist;	/* Free objects of this slab */
+	uint16_t chunk;				/* Size of an object including its allocnode */
+	uint16_t nobjects;			/* Number of objects in the slab */
+	uint16_t nfree;				/* Number of objects in freelist */
+};
+
+/* Slabs of a size class, protected by the heap semaphore */
+
+struct mm_slabclass_s {
+	FAR struct mm_slab_s *partial;		/* Slabs having free objects */
+	uint16_t nslabs;			/* Number of slabs */
+	uint16_t nobjects;			/* Objects taken out of slabs, in use or in magazines */
+};
+
+/* Free objects of a size class cached by a CPU, protected by the magazine
+ * lock of that CPU, which also masks its interrupts.  Only that CPU takes
+ * the lock, except when all magazines are drained.
+ */
+
+struct mm_magazine_s {
+	FAR struct mm_delaynode_s *head;
+	uint16_t count;
+	uint32_t hits;				/* Allocations served by the magazine */
+	uint32_t misses;			/* Allocations which had to refill it */
+};
+#endif
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 struct heapinfo_tcb_info_s {
 	int pid;
@@ -417,6 +536,15 @@ struct mm_heap_s {
 	 */
 
 	struct mm_freenode_s mm_nodelist[MM_NNODES + 1];
+
+#ifdef CONFIG_MM_TLSF
+	/* Bit fl of mm_tlsf_flmap is set if any list of the first level fl is
+	 * not empty, bit sl of mm_tlsf_slmap[fl] if its list sl is not empty.
+	 */
+
+	uint32_t mm_tlsf_flmap;
+	uint32_t mm_tlsf_slmap[MM_TLSF_FLCOUNT];
+#endif
 	
 	/* Free delay list, for some situations where we can't do free
 	* immdiately.
@@ -424,6 +552,39 @@ struct mm_heap_s {
 
 	FAR struct mm_delaynode_s *mm_delaylist[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_SMP
+	/* Number of times the semaphore was held by another task when taken */
+
+	uint32_t mm_contended;
+#endif
+
+#ifdef CONFIG_MM_ARENAS
+	/* Arena of each CPU carved out of this heap, set once and never
+	 * released.  An arena is a heap itself, with mm_isarena set, and keeps
+	 * its memory freed by other CPUs in mm_remotefree until its owner
+	 * allocates, frees or reallocates.
+	 */
+
+	FAR struct mm_heap_s *mm_arena[CONFIG_SMP_NCPUS];
+	bool mm_isarena;
+	spinlock_t mm_remotelock;
+	FAR struct mm_delaynode_s *mm_remotefree;
+	uint32_t mm_nremotefree;
+#endif
+
+#ifdef CONFIG_MM_HEAP_STATS
+	/* Allocation counters and latency histogram */
+
+	struct mm_heapstats_s mm_stats;
+#endif
+
+#ifdef CONFIG_MM_SLAB
+	/* Slabs and per CPU magazines of small objects */
+
+	struct mm_slabclass_s mm_slabclass[MM_SLAB_NCLASSES];
+	struct mm_magazine_s mm_magazine[CONFIG_SMP_NCPUS][MM_SLAB_NCLASSES];
+	spinlock_t mm_maglock[CONFIG_SMP_NCPUS];
+#endif
 };
 
 /****************************************************************************
@@ -521,6 +682,7 @@ void mm_seminitialize(FAR struct mm_heap_s *heap);
 bool mm_takesemaphore(FAR struct mm_heap_s *heap);
 int mm_trysemaphore(FAR struct mm_heap_s *heap);
 void mm_givesemaphore(FAR struct mm_heap_s *heap);
+bool mm_holdssemaphore(FAR struct mm_heap_s *heap);
 
 /* Functions contained in umm_sem.c ****************************************/
 
@@ -717,6 +879,56 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 int mm_size2ndx(size_t size);
 
+#ifdef CONFIG_MM_TLSF
+/* Functions contained in mm_tlsf.c, which also has mm_addfreechunk and
+ * mm_size2ndx of this mode.
+ */
+
+void mm_removefreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node);
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap, size_t size);
+#endif
+
+/* Functions contained in mm_slab.c *****************************************/
+
+#ifdef CONFIG_MM_SLAB
+void mm_slab_initialize(FAR struct mm_heap_s *heap);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *mm_slab_alloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr);
+#else
+FAR void *mm_slab_alloc(FAR struct mm_heap_s *heap, size_t size);
+#endif
+bool mm_slab_free(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node);
+int mm_slab_drain(FAR struct mm_heap_s *heap);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+void heapinfo_parse_slab(FAR struct mm_allocnode_s *node, int mode, pid_t pid);
+void heapinfo_slab_summary(FAR struct mm_heap_s *heap);
+#endif
+#endif
+
+/* Functions contained in mm_arena.c ****************************************/
+
+#ifdef CONFIG_MM_ARENAS
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *mm_arena_malloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr);
+#else
+FAR void *mm_arena_malloc(FAR struct mm_heap_s *heap, size_t size);
+#endif
+int mm_arena_drain(FAR struct mm_heap_s *heap);
+FAR struct mm_heap_s *mm_arena_of(FAR struct mm_heap_s *heap, FAR void *mem);
+bool mm_arena_free(FAR struct mm_heap_s *heap, FAR void *mem);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+void heapinfo_arena_summary(FAR struct mm_heap_s *heap);
+#endif
+#endif
+
+/* Functions contained in mm_heapstats.c ************************************/
+
+#ifdef CONFIG_MM_HEAP_STATS
+bool mm_heapstats_begin(FAR struct mm_heap_s *heap, FAR uint32_t *start);
+void mm_heapstats_end(FAR struct mm_heap_s *heap, bool sampled, uint32_t start, FAR void *mem);
+int mm_heapstats_print(FAR struct mm_heap_s *heap, FAR char *buf, size_t len);
+#endif
+
 void mm_dump_heap_region(uint32_t start, uint32_t end);
 int heap_dbg(const char *fmt, ...);
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
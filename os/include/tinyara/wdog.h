@@ -112,7 +112,9 @@
 #define wd_static(w) \
 	do { (w)->next = NULL; (w)->flags = WDOGF_STATIC; } while (0)
 
-#ifdef CONFIG_PIC
+#if defined(CONFIG_PIC) && defined(CONFIG_WDOG_WHEEL)
+#define WDOG_INITIAILIZER { NULL, NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
+#elif defined(CONFIG_PIC) || defined(CONFIG_WDOG_WHEEL)
 #define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
 #else
 #define WDOG_INITIAILIZER { NULL, NULL, 0, WDOGF_STATIC, 0 }
@@ -149,13 +151,20 @@ typedef CODE void (*wdentry_t)(int argc, uint32_t arg1, ...);
 
 struct wdog_s {
 	FAR struct wdog_s *next;	/* Support for singly linked lists. */
+#ifdef CONFIG_WDOG_WHEEL
+	FAR struct wdog_s *prev;	/* Slots of the timer wheel are doubly linked */
+#endif
 	wdentry_t func;				/* Function to execute when delay expires */
 #ifdef CONFIG_PIC
 	FAR void *picbase;			/* PIC base address */
 #endif
-	int lag;					/* Timer associated with the delay */
+	int lag;					/* Timer associated with the delay, or the
+								 * tick it expires at with CONFIG_WDOG_WHEEL */
 	uint8_t flags;				/* See WDOGF_* definitions above */
 	uint8_t argc;				/* The number of parameters to pass */
+#ifdef CONFIG_WDOG_WHEEL
+	uint8_t slot;				/* Slot of the timer wheel holding it */
+#endif
 	uint32_t parm[CONFIG_MAX_WDOGPARMS];
 };
 
@@ -187,6 +196,9 @@ int wd_gettime(WDOG_ID wdog);
 int wd_setwakeupsource(WDOG_ID wdog);
 clock_t wd_getwakeupdelay(void);
 #endif
+#ifdef CONFIG_WDOG_STATS
+int wd_stats_print(FAR char *buf, size_t len);
+#endif
 
 #undef EXTERN
 #ifdef __cplusplus
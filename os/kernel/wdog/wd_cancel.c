@@ -108,9 +108,18 @@
 
 int wd_cancel(WDOG_ID wdog)
 {
+#ifdef CONFIG_WDOG_WHEEL
+#ifdef CONFIG_SCHED_TICKLESS
+	unsigned int next;
+#endif
+#else
 	FAR struct wdog_s *curr;
 	FAR struct wdog_s *prev;
+#endif
 	irqstate_t state;
+#ifdef CONFIG_WDOG_STATS
+	uint32_t start;
+#endif
 	int ret = ERROR;
 
 	/* Prohibit timer interactions with the timer queue until the
@@ -118,12 +127,31 @@ int wd_cancel(WDOG_ID wdog)
 	 */
 
 	state = enter_critical_section();
+#ifdef CONFIG_WDOG_STATS
+	start = wd_stats_now();
+#endif
 
 	/* Make sure that the watchdog is initialized (non-NULL) and is still
 	 * active.
 	 */
 
 	if (wdog && WDOG_ISACTIVE(wdog)) {
+#ifdef CONFIG_WDOG_WHEEL
+		/* Remove the watchdog from its slot of the wheel */
+
+#ifdef CONFIG_SCHED_TICKLESS
+		next = wd_wheel_next();
+#endif
+		wd_wheel_remove(wdog);
+
+#ifdef CONFIG_SCHED_TICKLESS
+		/* Reassess the interval timer if it was set for this watchdog */
+
+		if (wd_wheel_next() != next) {
+			sched_timer_reassess();
+		}
+#endif
+#else
 		/* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
 		 * to do this because there are additional operations that need to be
 		 * done.
@@ -169,16 +197,24 @@ int wd_cancel(WDOG_ID wdog)
 			sched_timer_reassess();
 		}
 
+		wdog->next = NULL;
+#endif
+
 		/* Mark the watchdog inactive */
 
-		wdog->next = NULL;
 		WDOG_CLRACTIVE(wdog);
+#ifdef CONFIG_WDOG_STATS
+		g_wdstats.nactive--;
+#endif
 
 		/* Return success */
 
 		ret = OK;
 	}
 
+#ifdef CONFIG_WDOG_STATS
+	wd_stats_update(&g_wdstats.maxcancel, start);
+#endif
 	leave_critical_section(state);
 	return ret;
 }
@@ -110,6 +110,16 @@ int wd_gettime(WDOG_ID wdog)
 
 	flags = enter_critical_section();
 	if (wdog && WDOG_ISACTIVE(wdog)) {
+#ifdef CONFIG_WDOG_WHEEL
+		/* The lag is the tick the watchdog expires at, which may have passed
+		 * in suppressed ticks not processed yet.
+		 */
+
+		int delay = (int)((uint32_t)wdog->lag - WDOG_WHEEL_NOW());
+
+		leave_critical_section(flags);
+		return delay > 0 ? delay : 0;
+#else
 		/* Traverse the watchdog list accumulating lag times until we find the wdog
 		 * that we are looking for
 		 */
@@ -124,6 +134,7 @@ int wd_gettime(WDOG_ID wdog)
 				return delay;
 			}
 		}
+#endif
 	}
 
 	leave_critical_section(flags);
@@ -150,6 +161,20 @@ int wd_gettime(WDOG_ID wdog)
 
 int wd_getdelay(void)
 {
+#ifdef CONFIG_WDOG_WHEEL
+	/* The next watchdog may only move down the wheel by then.  If it is
+	 * due within the ticks suppressed so far, it is due at the next tick.
+	 */
+
+	unsigned int next = wd_wheel_next();
+
+	if (next == 0) {
+		return 0;
+	}
+
+	return next > g_wdpending ? next - g_wdpending : 1;
+#else
 	return (g_wdactivelist.head) ? ((FAR struct wdog_s *)g_wdactivelist.head)->lag : 0;
+#endif
 }
 #endif
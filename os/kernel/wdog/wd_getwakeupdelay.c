@@ -70,7 +70,28 @@ clock_t wd_getwakeupdelay(void)
 	clock_t delay = 0;
 	struct wdog_s *curr;
 	irqstate_t flags;
+#ifdef CONFIG_WDOG_WHEEL
+	clock_t remaining;
+	int level;
+	int ndx;
 
+	/* Slots are not ordered by expiration, visit all of them */
+
+	flags = enter_critical_section();
+	for (level = 0; level < CONFIG_WDOG_WHEEL_LEVELS; level++) {
+		for (ndx = 0; ndx < WDOG_WHEEL_SLOTS; ndx++) {
+			for (curr = (FAR struct wdog_s *)g_wdwheel[level][ndx].head; curr; curr = curr->next) {
+				remaining = (clock_t)((uint32_t)curr->lag - WDOG_WHEEL_NOW());
+				if (WDOG_ISWAKEUP(curr) && (delay == 0 || remaining < delay)) {
+					delay = remaining;
+				}
+			}
+		}
+	}
+
+	leave_critical_section(flags);
+	return delay;
+#else
 	flags = enter_critical_section();
 	for (curr = (FAR struct wdog_s *)g_wdactivelist.head; curr; curr = curr->next) {
 		delay += curr->lag;
@@ -82,4 +103,5 @@ clock_t wd_getwakeupdelay(void)
 
 	leave_critical_section(flags);
 	return 0;
+#endif
 }
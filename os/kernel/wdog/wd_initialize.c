@@ -78,12 +78,14 @@
 
 sq_queue_t g_wdfreelist;
 
+#ifndef CONFIG_WDOG_WHEEL
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 sq_queue_t g_wdactivelist;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -133,11 +135,25 @@ void wd_initialize(void)
 {
 	FAR struct wdog_s *wdog = g_wdpool;
 	int i;
+#ifdef CONFIG_WDOG_WHEEL
+	int j;
+#endif
 
 	/* Initialize watchdog lists */
 
 	sq_init(&g_wdfreelist);
+#ifdef CONFIG_WDOG_WHEEL
+	g_wdtick = 0;
+	g_wdpending = 0;
+	for (i = 0; i < CONFIG_WDOG_WHEEL_LEVELS; i++) {
+		for (j = 0; j < WDOG_WHEEL_SLOTS; j++) {
+			dq_init(&g_wdwheel[i][j]);
+		}
+		g_wdwheelmap[i] = 0;
+	}
+#else
 	sq_init(&g_wdactivelist);
+#endif
 
 	/* The g_wdfreelist must be loaded at initialization time to hold the
 	 * configured number of watchdogs.
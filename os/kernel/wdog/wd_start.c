@@ -111,6 +111,50 @@ typedef void (*wdentry4_t)(int argc, uint32_t arg1, uint32_t arg2, uint32_t arg3
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+/****************************************************************************
+ * Name: wd_execute
+ *
+ * Description:
+ *   Execute the function of an expired watchdog.
+ *
+ ****************************************************************************/
+
+static inline void wd_execute(FAR struct wdog_s *wdog)
+{
+	up_setpicbase(wdog->picbase);
+	switch (wdog->argc) {
+	default:
+		DEBUGPANIC();
+		break;
+
+	case 0:
+		(*((wdentry0_t)(wdog->func)))(0);
+		break;
+
+#if CONFIG_MAX_WDOGPARMS > 0
+	case 1:
+		(*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 1
+	case 2:
+		(*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 2
+	case 3:
+		(*((wdentry3_t)(wdog->func)))(3, wdog->parm[0], wdog->parm[1], wdog->parm[2]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 3
+	case 4:
+		(*((wdentry4_t)(wdog->func)))(4, wdog->parm[0], wdog->parm[1], wdog->parm[2], wdog->parm[3]);
+		break;
+#endif
+	}
+}
+
+#ifndef CONFIG_WDOG_WHEEL
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -155,43 +199,87 @@ static inline void wd_expiration(void)
 			/* Indicate that the watchdog is no longer active. */
 
 			WDOG_CLRACTIVE(wdog);
+#ifdef CONFIG_WDOG_STATS
+			g_wdstats.nactive--;
+#endif
 
 			/* Execute the watchdog function */
 
-			up_setpicbase(wdog->picbase);
-			switch (wdog->argc) {
-			default:
-				DEBUGPANIC();
-				break;
+			wd_execute(wdog);
+		}
+	}
+}
+#else
+/****************************************************************************
+ * Name: wd_wheel_process
+ *
+ * Description:
+ *   Advance the timer wheel by ticks and by the ticks suppressed before,
+ *   moving watchdogs down its levels and executing the expired ones at each
+ *   tick where there are any.  The ticks in between are skipped at once.
+ *
+ * Parameters:
+ *   ticks - The number of ticks elapsed since the last call
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.  A watchdog function may start a
+ *   watchdog, whose delay counts from the current tick, not from the tick
+ *   being processed, as g_wdpending holds the ticks left.
+ *
+ ****************************************************************************/
 
-			case 0:
-				(*((wdentry0_t)(wdog->func)))(0);
-				break;
+static void wd_wheel_process(unsigned int ticks)
+{
+	FAR struct wdog_s *wdog;
+	uint32_t tick;
+	unsigned int next;
+	int nmoved;
+
+	g_wdpending += ticks;
+	while (g_wdpending > 0) {
+		next = wd_wheel_next();
+		if (next == 0 || next > g_wdpending) {
+			break;
+		}
 
-#if CONFIG_MAX_WDOGPARMS > 0
-			case 1:
-				(*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 1
-			case 2:
-				(*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 2
-			case 3:
-				(*((wdentry3_t)(wdog->func)))(3, wdog->parm[0], wdog->parm[1], wdog->parm[2]);
-				break;
+		g_wdtick += next;
+		g_wdpending -= next;
+		tick = g_wdtick;
+
+		/* Watchdogs of higher levels whose slot begins now move down first,
+		 * as some may be due now.
+		 */
+
+		nmoved = wd_wheel_cascade();
+#ifdef CONFIG_WDOG_STATS
+		if (nmoved > g_wdstats.maxcascade) {
+			g_wdstats.maxcascade = nmoved;
+		}
+#else
+		UNUSED(nmoved);
 #endif
-#if CONFIG_MAX_WDOGPARMS > 3
-			case 4:
-				(*((wdentry4_t)(wdog->func)))(4, wdog->parm[0], wdog->parm[1], wdog->parm[2], wdog->parm[3]);
-				break;
+
+		while ((wdog = wd_wheel_expired(tick)) != NULL) {
+			/* Indicate that the watchdog is no longer active. */
+
+			WDOG_CLRACTIVE(wdog);
+#ifdef CONFIG_WDOG_STATS
+			g_wdstats.nactive--;
 #endif
-			}
+
+			/* Execute the watchdog function */
+
+			wd_execute(wdog);
 		}
 	}
+
+	g_wdtick += g_wdpending;
+	g_wdpending = 0;
 }
+#endif							/* CONFIG_WDOG_WHEEL */
 
 /****************************************************************************
  * Public Functions
@@ -233,11 +321,16 @@ static inline void wd_expiration(void)
 int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 {
 	va_list ap;
+#ifndef CONFIG_WDOG_WHEEL
 	FAR struct wdog_s *curr;
 	FAR struct wdog_s *prev;
 	FAR struct wdog_s *next;
 	int32_t now;
+#endif
 	irqstate_t state;
+#ifdef CONFIG_WDOG_STATS
+	uint32_t start;
+#endif
 	int i;
 
 	/* Verify the wdog */
@@ -254,6 +347,9 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 	 */
 
 	state = enter_critical_section();
+#ifdef CONFIG_WDOG_STATS
+	start = wd_stats_now();
+#endif
 	if (WDOG_ISACTIVE(wdog)) {
 		wd_cancel(wdog);
 	}
@@ -292,6 +388,14 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 	(void)sched_timer_cancel();
 #endif
 
+#ifdef CONFIG_WDOG_WHEEL
+	/* The lag is the tick to expire at, counted from the current tick even
+	 * if the wheel is not processed up to it yet.
+	 */
+
+	wdog->lag = (int)(WDOG_WHEEL_NOW() + delay);
+	wd_wheel_add(wdog);
+#else
 	/* Do the easy case first -- when the watchdog timer queue is empty. */
 
 	if (g_wdactivelist.head == NULL) {
@@ -366,7 +470,13 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 	/* Put the lag into the watchdog structure and mark it as active. */
 
 	wdog->lag = delay;
+#endif
 	WDOG_SETACTIVE(wdog);
+#ifdef CONFIG_WDOG_STATS
+	if (++g_wdstats.nactive > g_wdstats.maxactive) {
+		g_wdstats.maxactive = g_wdstats.nactive;
+	}
+#endif
 
 #ifdef CONFIG_SCHED_TICKLESS
 	/* Resume the interval timer that will generate the next interval event.
@@ -377,6 +487,9 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 	sched_timer_resume();
 #endif
 
+#ifdef CONFIG_WDOG_STATS
+	wd_stats_update(&g_wdstats.maxstart, start);
+#endif
 	leave_critical_section(state);
 	return OK;
 }
@@ -409,8 +522,31 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 #ifdef CONFIG_SCHED_TICKLESS
 unsigned int wd_timer(int ticks)
 {
+#ifdef CONFIG_WDOG_WHEEL
+	unsigned int next;
+#ifdef CONFIG_WDOG_STATS
+	uint32_t start = wd_stats_now();
+#endif
+
+	/* Process the expired ticks, and return the delay for the next
+	 * watchdog to expire or move down the wheel.
+	 */
+
+	if (ticks > 0) {
+		wd_wheel_process(ticks);
+	}
+
+	next = wd_wheel_next();
+#ifdef CONFIG_WDOG_STATS
+	wd_stats_update(&g_wdstats.maxtimer, start);
+#endif
+	return next;
+#else
 	FAR struct wdog_s *wdog;
 	int decr;
+#ifdef CONFIG_WDOG_STATS
+	uint32_t start = wd_stats_now();
+#endif
 
 	/* Check if there are any active watchdogs to process */
 
@@ -441,14 +577,28 @@ unsigned int wd_timer(int ticks)
 		wd_expiration();
 	}
 
+#ifdef CONFIG_WDOG_STATS
+	wd_stats_update(&g_wdstats.maxtimer, start);
+#endif
+
 	/* Return the delay for the next watchdog to expire */
 
 	return g_wdactivelist.head ? ((FAR struct wdog_s *)g_wdactivelist.head)->lag : 0;
+#endif							/* CONFIG_WDOG_WHEEL */
 }
 
 #else
 void wd_timer(void)
 {
+#ifdef CONFIG_WDOG_STATS
+	uint32_t start = wd_stats_now();
+#endif
+
+#ifdef CONFIG_WDOG_WHEEL
+	/* Process this tick, and the ticks suppressed before it */
+
+	wd_wheel_process(1);
+#else
 	/* Check if there are any active watchdogs to process */
 
 	if (g_wdactivelist.head) {
@@ -460,17 +610,26 @@ void wd_timer(void)
 
 		wd_expiration();
 	}
+#endif							/* CONFIG_WDOG_WHEEL */
 
+#ifdef CONFIG_WDOG_STATS
+	wd_stats_update(&g_wdstats.maxtimer, start);
+#endif
 }
 #endif							/* CONFIG_SCHED_TICKLESS */
 
 #ifdef CONFIG_SCHED_TICKSUPPRESS
 void wd_timer_nohz(clock_t ticks)
 {
+#ifdef CONFIG_WDOG_WHEEL
+	/* Watchdogs expired meanwhile are executed by the next wd_timer */
+
+	g_wdpending += ticks;
+#else
 	FAR struct wdog_s *wdog;
 	int decr;
 
-	for (wdog = g_wdactivelist.head; ticks > 0 && wdog; wdog = wdog->next) {
+	for (wdog = (FAR struct wdog_s *)g_wdactivelist.head; ticks > 0 && wdog; wdog = wdog->next) {
 
 		/* Decrement the lag for this watchdog. */
 
@@ -483,5 +642,6 @@ void wd_timer_nohz(clock_t ticks)
 
 		/* Expires when the next wd_timer is called.*/
 	}
+#endif
 }
 #endif
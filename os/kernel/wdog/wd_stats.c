@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <tinyara/clock.h>
+#include <tinyara/irq.h>
+#include <tinyara/wdog.h>
+
+#include "wdog/wdog.h"
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+struct wd_stats_s g_wdstats;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_stats_now
+ *
+ * Description:
+ *   Return the time since power up in usec, wrapping around.
+ *
+ ****************************************************************************/
+
+uint32_t wd_stats_now(void)
+{
+	struct timespec ts;
+
+	if (clock_systimespec(&ts) < 0) {
+		return 0;
+	}
+
+	return (uint32_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/****************************************************************************
+ * Name: wd_stats_update
+ *
+ * Description:
+ *   Raise *max to the time elapsed since start if it is longer.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void wd_stats_update(FAR uint32_t *max, uint32_t start)
+{
+	uint32_t elapsed = wd_stats_now() - start;
+
+	if (elapsed > *max) {
+		*max = elapsed;
+	}
+}
+
+/****************************************************************************
+ * Name: wd_stats_print
+ *
+ * Description:
+ *   Print the watchdog statistics to buf of len bytes.  Return the number of
+ *   characters printed, at most len - 1.
+ *
+ ****************************************************************************/
+
+int wd_stats_print(FAR char *buf, size_t len)
+{
+	struct wd_stats_s stats;
+	irqstate_t flags;
+	int n;
+
+	flags = enter_critical_section();
+	memcpy(&stats, &g_wdstats, sizeof(struct wd_stats_s));
+	leave_critical_section(flags);
+
+	n = snprintf(buf, len, "Active %u Peak %u\n"
+#ifdef CONFIG_WDOG_WHEEL
+				 "Wheel levels %d tick %u moved at most %u at a tick\n"
+#endif
+				 "Longest with interrupts disabled in usec:\n"
+				 "  wd_start  %u\n"
+				 "  wd_cancel %u\n"
+				 "  wd_timer  %u, watchdog functions included\n",
+				 stats.nactive, stats.maxactive,
+#ifdef CONFIG_WDOG_WHEEL
+				 CONFIG_WDOG_WHEEL_LEVELS, g_wdtick, stats.maxcascade,
+#endif
+				 stats.maxstart, stats.maxcancel, stats.maxtimer);
+
+	return n < (int)len ? n : (int)len - 1;
+}
@@ -0,0 +1,271 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <tinyara/wdog.h>
+
+#include "wdog/wdog.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WDOG_WHEEL_MASK   (WDOG_WHEEL_SLOTS - 1)
+
+/* Shift of the ticks of a slot of level l */
+
+#define WDOG_WHEEL_SHIFT(l) ((l) * WDOG_WHEEL_BITS)
+
+/* Index of the most significant bit set, x must not be 0 */
+
+#define WDOG_WHEEL_FLS(x) (31 - __builtin_clz((uint32_t)(x)))
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* The tick up to which the wheel is processed */
+
+uint32_t g_wdtick;
+
+/* The ticks passed since g_wdtick, processed by the next wd_timer */
+
+uint32_t g_wdpending;
+
+/* Slots of each level, and bitmaps of the slots which are not empty */
+
+dq_queue_t g_wdwheel[CONFIG_WDOG_WHEEL_LEVELS][WDOG_WHEEL_SLOTS];
+uint32_t g_wdwheelmap[CONFIG_WDOG_WHEEL_LEVELS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Distance from the bit after bit start of map to the first bit set,
+ * wrapping around, from 1 to WDOG_WHEEL_SLOTS.  map must not be 0.
+ */
+
+static inline unsigned int wd_wheel_distance(uint32_t map, unsigned int start)
+{
+	start = (start + 1) & WDOG_WHEEL_MASK;
+	map = (map >> start) | (map << ((WDOG_WHEEL_SLOTS - start) & WDOG_WHEEL_MASK));
+	return __builtin_ctz(map) + 1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Add wdog, whose lag is the tick it expires at, to the slot of the wheel
+ *   that moves or expires it when that tick comes.  A level l slot holds the
+ *   watchdogs expiring from 32^l to 32^(l+1) ticks after g_wdtick, those
+ *   beyond the last level wait in its farthest slot.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void wd_wheel_add(FAR struct wdog_s *wdog)
+{
+	uint32_t expire = (uint32_t)wdog->lag;
+	int32_t delay = (int32_t)(expire - g_wdtick);
+	int level;
+	int ndx;
+
+	if (delay < WDOG_WHEEL_SLOTS) {
+		/* Due at most at g_wdtick, from a tick being processed */
+
+		if (delay < 0) {
+			expire = g_wdtick;
+		}
+
+		level = 0;
+	} else {
+		level = WDOG_WHEEL_FLS(delay) / WDOG_WHEEL_BITS;
+		if (level >= CONFIG_WDOG_WHEEL_LEVELS) {
+			level = CONFIG_WDOG_WHEEL_LEVELS - 1;
+			expire = g_wdtick + (1U << WDOG_WHEEL_SHIFT(CONFIG_WDOG_WHEEL_LEVELS)) - 1;
+		}
+	}
+
+	ndx = (expire >> WDOG_WHEEL_SHIFT(level)) & WDOG_WHEEL_MASK;
+	dq_addlast((FAR dq_entry_t *)wdog, &g_wdwheel[level][ndx]);
+	g_wdwheelmap[level] |= 1U << ndx;
+	wdog->slot = (level << WDOG_WHEEL_BITS) + ndx;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove wdog from its slot of the wheel.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+	int level = wdog->slot >> WDOG_WHEEL_BITS;
+	int ndx = wdog->slot & WDOG_WHEEL_MASK;
+	FAR dq_queue_t *queue = &g_wdwheel[level][ndx];
+
+	dq_rem((FAR dq_entry_t *)wdog, queue);
+	if (dq_empty(queue)) {
+		g_wdwheelmap[level] &= ~(1U << ndx);
+	}
+
+	wdog->next = NULL;
+	wdog->prev = NULL;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of ticks from g_wdtick to the next tick at which a
+ *   watchdog expires or moves down a level, or zero if no watchdog is
+ *   active.  A slot of level l > 0 moves down at the first tick of its
+ *   range, so this is the exact delay of the next expiration only if it is
+ *   in level 0.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+unsigned int wd_wheel_next(void)
+{
+	unsigned int next = 0;
+	unsigned int delay;
+	uint32_t base;
+	int level;
+
+	for (level = 0; level < CONFIG_WDOG_WHEEL_LEVELS; level++) {
+		if (!g_wdwheelmap[level]) {
+			continue;
+		}
+
+		/* The slot of g_wdtick has been processed in this round */
+
+		base = g_wdtick >> WDOG_WHEEL_SHIFT(level);
+		delay = wd_wheel_distance(g_wdwheelmap[level], base & WDOG_WHEEL_MASK);
+		delay = ((base + delay) << WDOG_WHEEL_SHIFT(level)) - g_wdtick;
+		if (next == 0 || delay < next) {
+			next = delay;
+		}
+	}
+
+	return next;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Move the watchdogs of the slots of higher levels starting at g_wdtick
+ *   down to lower levels, before the watchdogs of g_wdtick expire.  Return
+ *   the number of watchdogs moved.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+int wd_wheel_cascade(void)
+{
+	FAR struct wdog_s *wdog;
+	FAR struct wdog_s *next;
+	dq_queue_t queue;
+	int nmoved = 0;
+	int level;
+	int ndx;
+
+	for (level = 1; level < CONFIG_WDOG_WHEEL_LEVELS; level++) {
+		/* A slot of level l starts when the ticks of level l - 1 wrap */
+
+		if ((g_wdtick >> WDOG_WHEEL_SHIFT(level - 1)) & WDOG_WHEEL_MASK) {
+			break;
+		}
+
+		ndx = (g_wdtick >> WDOG_WHEEL_SHIFT(level)) & WDOG_WHEEL_MASK;
+		if (!(g_wdwheelmap[level] & (1U << ndx))) {
+			continue;
+		}
+
+		/* Detach the slot first, a watchdog waiting beyond the last level
+		 * may go back to the level it comes from.
+		 */
+
+		queue = g_wdwheel[level][ndx];
+		dq_init(&g_wdwheel[level][ndx]);
+		g_wdwheelmap[level] &= ~(1U << ndx);
+
+		for (wdog = (FAR struct wdog_s *)queue.head; wdog; wdog = next) {
+			next = wdog->next;
+			wd_wheel_add(wdog);
+			nmoved++;
+		}
+	}
+
+	return nmoved;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Remove and return a watchdog of the level 0 slot of tick which is due
+ *   at tick, or NULL if there is none left.  A watchdog started by a
+ *   watchdog function of tick may share the slot, due a round later.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(uint32_t tick)
+{
+	FAR struct wdog_s *wdog;
+
+	wdog = (FAR struct wdog_s *)g_wdwheel[0][tick & WDOG_WHEEL_MASK].head;
+	while (wdog && (int32_t)((uint32_t)wdog->lag - tick) > 0) {
+		wdog = wdog->next;
+	}
+
+	if (wdog) {
+		wd_wheel_remove(wdog);
+	}
+
+	return wdog;
+}
@@ -62,6 +62,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include <queue.h>
+
 #include <tinyara/compiler.h>
 #include <tinyara/wdog.h>
 
@@ -69,10 +71,37 @@
  * Pre-processor Definitions
  ************************************************************************/
 
+#ifdef CONFIG_WDOG_WHEEL
+/* Every level of the timer wheel has 32 slots, one bit of a bitmap each */
+
+#define WDOG_WHEEL_BITS   5
+#define WDOG_WHEEL_SLOTS  (1 << WDOG_WHEEL_BITS)
+
+/* The current tick.  g_wdtick lags behind it by the ticks suppressed since
+ * the last wd_timer, and by the ticks left to process while wd_timer runs
+ * watchdog functions.
+ */
+
+#define WDOG_WHEEL_NOW()  (g_wdtick + g_wdpending)
+#endif
+
 /************************************************************************
  * Public Type Declarations
  ************************************************************************/
 
+#ifdef CONFIG_WDOG_STATS
+/* Worst case times in usec spent with interrupts disabled */
+
+struct wd_stats_s {
+	uint32_t nactive;			/* Active watchdogs */
+	uint32_t maxactive;			/* Most watchdogs active at once */
+	uint32_t maxstart;			/* Longest wd_start */
+	uint32_t maxcancel;			/* Longest wd_cancel */
+	uint32_t maxtimer;			/* Longest wd_timer, watchdog functions included */
+	uint32_t maxcascade;		/* Most watchdogs moved down the wheel at a tick */
+};
+#endif
+
 /************************************************************************
  * Public Variables
  ************************************************************************/
@@ -90,12 +119,24 @@ extern "C" {
 
 extern sq_queue_t g_wdfreelist;
 
+#ifdef CONFIG_WDOG_WHEEL
+/* Active watchdogs are in the slots of the timer wheel, processed up to
+ * g_wdtick, g_wdpending ticks ago.  Bit n of g_wdwheelmap[l] is set if slot
+ * n of level l is not empty.
+ */
+
+extern uint32_t g_wdtick;
+extern uint32_t g_wdpending;
+extern dq_queue_t g_wdwheel[CONFIG_WDOG_WHEEL_LEVELS][WDOG_WHEEL_SLOTS];
+extern uint32_t g_wdwheelmap[CONFIG_WDOG_WHEEL_LEVELS];
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern sq_queue_t g_wdactivelist;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -104,6 +145,10 @@ extern sq_queue_t g_wdactivelist;
 
 extern uint16_t g_wdnfree;
 
+#ifdef CONFIG_WDOG_STATS
+extern struct wd_stats_s g_wdstats;
+#endif
+
 /************************************************************************
  * Public Function Prototypes
  ************************************************************************/
@@ -184,6 +229,23 @@ void wd_timer_nohz(clock_t ticks);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+#ifdef CONFIG_WDOG_WHEEL
+/* Functions contained in wd_wheel.c, called with interrupts disabled */
+
+void wd_wheel_add(FAR struct wdog_s *wdog);
+void wd_wheel_remove(FAR struct wdog_s *wdog);
+unsigned int wd_wheel_next(void);
+int wd_wheel_cascade(void);
+FAR struct wdog_s *wd_wheel_expired(uint32_t tick);
+#endif
+
+#ifdef CONFIG_WDOG_STATS
+/* Functions contained in wd_stats.c */
+
+uint32_t wd_stats_now(void);
+void wd_stats_update(FAR uint32_t *max, uint32_t start);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
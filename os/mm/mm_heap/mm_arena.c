@@ -0,0 +1,302 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <string.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/spinlock.h>
+#include <tinyara/mm/mm.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* An arena is a chunk of CONFIG_MM_ARENA_SIZE bytes, its heap structure
+ * at the start of it.
+ */
+
+#define ARENA_SIZE     (MM_ALIGN_DOWN(CONFIG_MM_ARENA_SIZE) - SIZEOF_MM_ALLOCNODE)
+#define ARENA_HEAPSIZE MM_ALIGN_UP(sizeof(struct mm_heap_s))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Carve the arena of cpu out of heap, or return the one another task of the
+ * same CPU carved meanwhile.
+ */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+static FAR struct mm_heap_s *mm_arena_create(FAR struct mm_heap_s *heap, int cpu, mmaddress_t caller_retaddr)
+#else
+static FAR struct mm_heap_s *mm_arena_create(FAR struct mm_heap_s *heap, int cpu)
+#endif
+{
+	FAR struct mm_heap_s *arena;
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	FAR struct mm_allocnode_s *node;
+	int i;
+#endif
+
+	mm_takesemaphore(heap);
+
+	arena = heap->mm_arena[cpu];
+	if (arena) {
+		mm_givesemaphore(heap);
+		return arena;
+	}
+
+	/* The arena is larger than MM_ARENA_MAXCHUNK, so it comes from the
+	 * heap itself.
+	 */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	arena = (FAR struct mm_heap_s *)mm_malloc(heap, ARENA_SIZE, caller_retaddr);
+#else
+	arena = (FAR struct mm_heap_s *)mm_malloc(heap, ARENA_SIZE);
+#endif
+	if (!arena) {
+		mm_givesemaphore(heap);
+		return NULL;
+	}
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* The heap doesn't charge what it allocates for itself, but the arena
+	 * is charged to the task that created it, as it's freed like others.
+	 */
+
+	node = (FAR struct mm_allocnode_s *)((FAR char *)arena - SIZEOF_MM_ALLOCNODE);
+	heapinfo_add_size(heap, node->pid, node->size);
+	heapinfo_update_total_size(heap, node->size, node->pid);
+#endif
+
+	/* mm_initialize would reset global heapinfo of groups, so the arena is
+	 * set up here.
+	 */
+
+	memset(arena, 0, sizeof(struct mm_heap_s));
+	mm_seminitialize(arena);
+	arena->mm_isarena = true;
+	spin_initialize(&arena->mm_remotelock, SP_UNLOCKED);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	for (i = 0; i < CONFIG_MAX_TASKS; i++) {
+		arena->alloc_list[i].pid = HEAPINFO_INIT_INFO;
+	}
+#endif
+	if (mm_addregion(arena, (FAR char *)arena + ARENA_HEAPSIZE, ARENA_SIZE - ARENA_HEAPSIZE) != OK) {
+		mm_free(heap, arena);
+		mm_givesemaphore(heap);
+		return NULL;
+	}
+
+	heap->mm_arena[cpu] = arena;
+	mm_givesemaphore(heap);
+
+	mvdbg("CPU%d arena at %p\n", cpu, arena);
+	return arena;
+}
+
+/* Free the memory other CPUs freed to the arena, return how many chunks */
+
+static int mm_arena_freeremote(FAR struct mm_heap_s *arena)
+{
+	FAR struct mm_delaynode_s *node;
+	FAR struct mm_delaynode_s *next;
+	irqstate_t flags;
+	int nfreed = 0;
+
+	if (!arena->mm_remotefree) {
+		return 0;
+	}
+
+	flags = spin_lock_irqsave(&arena->mm_remotelock);
+	node = arena->mm_remotefree;
+	arena->mm_remotefree = NULL;
+	spin_unlock_irqrestore(&arena->mm_remotelock, flags);
+
+	for (; node; node = next) {
+		next = node->flink;
+		mm_free(arena, node);
+		nfreed++;
+	}
+
+	return nfreed;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_arena_malloc
+ *
+ * Description:
+ *   Allocate size bytes, including the allocation node, from the arena of
+ *   this CPU, carving it out of heap on the first allocation.  Memory freed
+ *   by other CPUs to the arena is freed first, and again before failing.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *mm_arena_malloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr)
+#else
+FAR void *mm_arena_malloc(FAR struct mm_heap_s *heap, size_t size)
+#endif
+{
+	FAR struct mm_heap_s *arena;
+	FAR void *ret;
+	int cpu = up_cpu_index();
+
+	arena = heap->mm_arena[cpu];
+	if (!arena) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		arena = mm_arena_create(heap, cpu, caller_retaddr);
+#else
+		arena = mm_arena_create(heap, cpu);
+#endif
+		if (!arena) {
+			return NULL;
+		}
+	}
+
+	mm_arena_freeremote(arena);
+
+	/* The task may move to another CPU meanwhile, the semaphore of the
+	 * arena still protects it.  Other CPUs may free to the arena meanwhile
+	 * too, which is taken before the heap serves the request.
+	 */
+
+	do {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		ret = mm_malloc(arena, size - SIZEOF_MM_ALLOCNODE, caller_retaddr);
+#else
+		ret = mm_malloc(arena, size - SIZEOF_MM_ALLOCNODE);
+#endif
+	} while (!ret && mm_arena_freeremote(arena) > 0);
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: mm_arena_drain
+ *
+ * Description:
+ *   Free the memory other CPUs freed to the arena of this CPU, if heap has
+ *   one.  Return the number of chunks freed.
+ *
+ ****************************************************************************/
+
+int mm_arena_drain(FAR struct mm_heap_s *heap)
+{
+	FAR struct mm_heap_s *arena = heap->mm_arena[up_cpu_index()];
+
+	return arena ? mm_arena_freeremote(arena) : 0;
+}
+
+/****************************************************************************
+ * Name: mm_arena_of
+ *
+ * Description:
+ *   Return the arena of heap which mem belongs to, or NULL.
+ *
+ ****************************************************************************/
+
+FAR struct mm_heap_s *mm_arena_of(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+	FAR struct mm_heap_s *arena;
+	int cpu;
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		arena = heap->mm_arena[cpu];
+		if (arena && mem > (FAR void *)arena->mm_heapstart[0] && mem < (FAR void *)arena->mm_heapend[0]) {
+			return arena;
+		}
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: mm_arena_free
+ *
+ * Description:
+ *   Free mem if it belongs to an arena of heap.  Memory of the arena of
+ *   this CPU is freed at once, memory of the arena of another CPU is queued
+ *   to it without taking its semaphore.  Return false if mem is not in an
+ *   arena.
+ *
+ ****************************************************************************/
+
+bool mm_arena_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+	FAR struct mm_heap_s *arena;
+	FAR struct mm_delaynode_s *node;
+	irqstate_t flags;
+
+	arena = mm_arena_of(heap, mem);
+	if (!arena) {
+		return false;
+	}
+
+	if (arena == heap->mm_arena[up_cpu_index()]) {
+		mm_free(arena, mem);
+		return true;
+	}
+
+	node = (FAR struct mm_delaynode_s *)mem;
+	flags = spin_lock_irqsave(&arena->mm_remotelock);
+	node->flink = arena->mm_remotefree;
+	arena->mm_remotefree = node;
+	arena->mm_nremotefree++;
+	spin_unlock_irqrestore(&arena->mm_remotelock, flags);
+
+	return true;
+}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+/****************************************************************************
+ * Name: heapinfo_arena_summary
+ *
+ * Description:
+ *   Display usage and contention of the arenas of heap.
+ *
+ ****************************************************************************/
+
+void heapinfo_arena_summary(FAR struct mm_heap_s *heap)
+{
+	FAR struct mm_heap_s *arena;
+	int cpu;
+
+	heap_dbg("\n< Arena >\n");
+	heap_dbg(" CPU |     Size |    Alloc |     Peak | Contended | Remote free\n");
+	heap_dbg("-----|----------|----------|----------|-----------|------------\n");
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		arena = heap->mm_arena[cpu];
+		if (arena) {
+			heap_dbg(" %3d | %8u | %8u | %8u | %9u | %11u\n", cpu, arena->mm_heapsize, arena->total_alloc_size, arena->peak_alloc_size, arena->mm_contended, arena->mm_nremotefree);
+		}
+	}
+}
+#endif
@@ -125,6 +125,33 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MM_SLAB
+	/* Objects of slabs go back to the magazine of this CPU */
+
+	node = (FAR struct mm_freenode_s *)((char *)mem - SIZEOF_MM_ALLOCNODE);
+	if (MM_IS_SLAB_OBJECT(node)) {
+		if (mm_slab_free(heap, (FAR struct mm_allocnode_s *)node) == false) {
+			mm_add_delaylist(heap, mem);
+		}
+		return;
+	}
+#endif
+
+#ifdef CONFIG_MM_ARENAS
+	/* Memory other CPUs freed to the arena of this CPU is freed with it, as
+	 * this CPU may not allocate from the arena again soon.  Memory of an
+	 * arena goes back to it, or to its queue of remote frees.
+	 */
+
+	if (!heap->mm_isarena) {
+		mm_arena_drain(heap);
+	}
+
+	if (mm_arena_free(heap, mem)) {
+		return;
+	}
+#endif
+
 	/* We need to hold the MM semaphore while we muck with the
 	 * nodelist.
 	 */
@@ -158,8 +185,15 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		return;
 	}
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
-	heapinfo_subtract_size(heap, ((struct mm_allocnode_s *)node)->pid, ((struct mm_allocnode_s *)node)->size);
-	heapinfo_update_total_size(heap, ((-1) * ((struct mm_allocnode_s *)node)->size), ((struct mm_allocnode_s *)node)->pid);
+#ifdef CONFIG_MM_SLAB
+	/* A slab is charged to no task */
+
+	if (((struct mm_allocnode_s *)node)->reserved != MM_SLAB_MAGIC)
+#endif
+	{
+		heapinfo_subtract_size(heap, ((struct mm_allocnode_s *)node)->pid, ((struct mm_allocnode_s *)node)->size);
+		heapinfo_update_total_size(heap, ((-1) * ((struct mm_allocnode_s *)node)->size), ((struct mm_allocnode_s *)node)->pid);
+	}
 #endif
 	node->preceding &= ~MM_ALLOC_BIT;
 
@@ -180,7 +214,7 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		 * but there may not be a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(next);
+		REMOVE_NODE_FROM_LIST(heap, next);
 
 		/* Then merge the two chunks */
 
@@ -199,7 +233,7 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		 * not be a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(prev);
+		REMOVE_NODE_FROM_LIST(heap, prev);
 
 		/* Then merge the two chunks */
 
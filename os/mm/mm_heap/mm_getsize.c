@@ -38,6 +38,22 @@ static size_t mm_get_largest_freesize_from_specific_heap(struct mm_heap_s *heap)
 	struct mm_freenode_s *fnode;
 	int nodelist_idx = 0;
 
+#ifdef CONFIG_MM_TLSF
+	/* Lists are not sorted in this mode, so the highest non-empty list
+	 * given by the bitmaps is searched.
+	 */
+	if (heap->mm_tlsf_flmap) {
+		int fl = 31 - __builtin_clz(heap->mm_tlsf_flmap);
+
+		nodelist_idx = (fl << MM_TLSF_SLI) + 31 - __builtin_clz(heap->mm_tlsf_slmap[fl]);
+		for (fnode = heap->mm_nodelist[nodelist_idx].flink; fnode; fnode = fnode->flink) {
+			if (largest_size < fnode->size) {
+				largest_size = fnode->size;
+			}
+		}
+	}
+	return largest_size;
+#else
 	/* Free nodes are sorted in a descending order,
 	 * so the first node in each nodelist is the largest within its nodelist.
 	 */
@@ -50,6 +66,7 @@ static size_t mm_get_largest_freesize_from_specific_heap(struct mm_heap_s *heap)
 		}
 	}
 	return largest_size;
+#endif
 }
 
 /****************************************************************************
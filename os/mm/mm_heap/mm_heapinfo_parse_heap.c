@@ -190,6 +190,13 @@ void heapinfo_parse_heap(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 		for (node = heap->mm_heapstart[region]; node < heap->mm_heapend[region]; node = (struct mm_allocnode_s *)((char *)node + node->size)) {
 			ASSERT(node->size);
 
+#ifdef CONFIG_MM_SLAB
+			/* Objects of a slab are listed after its chunk */
+			if ((node->preceding & MM_ALLOC_BIT) != 0 && node->reserved == MM_SLAB_MAGIC) {
+				heapinfo_parse_slab(node, mode, pid);
+			}
+#endif
+
 			/* Check if the node corresponds to an allocated memory chunk */
 			if ((pid == HEAPINFO_PID_ALL || node->pid == pid) && (node->preceding & MM_ALLOC_BIT) != 0) {
 				if (mode == HEAPINFO_DETAIL_ALL || mode == HEAPINFO_DETAIL_PID || mode == HEAPINFO_DETAIL_SPECIFIC_HEAP) {
@@ -283,6 +290,20 @@ void heapinfo_parse_heap(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 	heap_dbg("(*)  Alive allocation by dead threads might be used by others or might be a leakage.\n");
 	heap_dbg("(**) Only Idle task has a separate stack region,\n");
 	heap_dbg("  rest are all allocated on the heap region.\n");
+#ifdef CONFIG_MM_SLAB
+	heap_dbg("(***) A slab is one allocation of the task which needed it first,\n");
+	heap_dbg("  its objects are listed with 's' status after it.\n");
+	heapinfo_slab_summary(heap);
+#endif
+#ifdef CONFIG_MM_ARENAS
+	heap_dbg("(****) An arena is one allocation of the task which needed it first,\n");
+	heap_dbg("  its own allocations are shown by the Arena table only.\n");
+	heapinfo_arena_summary(heap);
+#endif
+#ifdef CONFIG_SMP
+	heap_dbg("\n< Semaphore >\n");
+	heap_dbg("  - Waits for other tasks (Contended) : %u\n", heap->mm_contended);
+#endif
 
 #ifdef CONFIG_DEBUG_CHECK_FRAGMENTATION
 	heap_dbg("\nAvailable fragmented memory segments in heap memory\n");
@@ -299,7 +320,14 @@ void heapinfo_parse_heap(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 	mm_givesemaphore(heap);
 
 	for (ndx = 0; ndx < MM_NNODES; ++ndx) {
+#ifdef CONFIG_MM_TLSF
+		/* Most of the many lists are empty, only the others are printed */
+		if (nodelist_cnt[ndx] > 0) {
+			heap_dbg("Nodelist[%d] from %u : num %d, size %u [Bytes]\n", ndx, MM_TLSF_NDX2SIZE(ndx), nodelist_cnt[ndx], nodelist_size[ndx]);
+		}
+#else
 		heap_dbg("Nodelist[%d] ranging [%u, %u] : num %d, size %u [Bytes]\n", ndx, ((ndx > 0 ? (1 << (ndx + MM_MIN_SHIFT)) : 0) + 1), 1 << (ndx + MM_MIN_SHIFT + 1), nodelist_cnt[ndx], nodelist_size[ndx]);
+#endif
 	}
 #endif
 
@@ -0,0 +1,252 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <tinyara/mm/mm.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A change of the time of day may spoil one sample without a monotonic
+ * clock.
+ */
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+#define MM_STATS_CLOCK CLOCK_MONOTONIC
+#else
+#define MM_STATS_CLOCK CLOCK_REALTIME
+#endif
+
+/* Index of the most significant bit set, x must not be 0 */
+
+#define MM_STATS_FLS(x) (31 - __builtin_clz((uint32_t)(x)))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Free lists of a heap, taken under its semaphore */
+
+struct mm_fraginfo_s {
+	size_t freesize;
+	size_t largest;
+	uint32_t nchunks;
+	uint32_t count[MM_STATS_NSIZES];
+	size_t size[MM_STATS_NSIZES];
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t mm_heapstats_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(MM_STATS_CLOCK, &ts);
+	return (uint32_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Append to buf of len bytes, of which *n are used */
+
+static void mm_heapstats_printf(FAR char *buf, size_t len, FAR size_t *n, FAR const char *fmt, ...)
+{
+	va_list ap;
+
+	if (*n >= len) {
+		return;
+	}
+
+	va_start(ap, fmt);
+	*n += vsnprintf(buf + *n, len - *n, fmt, ap);
+	va_end(ap);
+}
+
+static void mm_heapstats_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info)
+{
+	FAR struct mm_freenode_s *node;
+	int ndx;
+	int c;
+
+	memset(info, 0, sizeof(struct mm_fraginfo_s));
+
+	mm_takesemaphore(heap);
+
+	for (ndx = 0; ndx < MM_NNODES; ndx++) {
+		for (node = heap->mm_nodelist[ndx].flink; node && node->size; node = node->flink) {
+			c = MM_STATS_FLS(node->size) - MM_MIN_SHIFT;
+			if (c >= MM_STATS_NSIZES) {
+				c = MM_STATS_NSIZES - 1;
+			}
+			info->count[c]++;
+			info->size[c] += node->size;
+			info->nchunks++;
+			info->freesize += node->size;
+			if (node->size > info->largest) {
+				info->largest = node->size;
+			}
+		}
+	}
+
+	mm_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_heapstats_begin
+ *
+ * Description:
+ *   Count an allocation from heap.  If it is to be timed, save the current
+ *   time in usec to start and return true.
+ *
+ ****************************************************************************/
+
+bool mm_heapstats_begin(FAR struct mm_heap_s *heap, FAR uint32_t *start)
+{
+	heap->mm_stats.nallocs++;
+
+	if (CONFIG_MM_HEAP_STATS_SAMPLE == 0) {
+		return false;
+	}
+
+	if (heap->mm_stats.countdown > 0) {
+		heap->mm_stats.countdown--;
+		return false;
+	}
+
+	heap->mm_stats.countdown = CONFIG_MM_HEAP_STATS_SAMPLE - 1;
+	*start = mm_heapstats_now();
+	return true;
+}
+
+/****************************************************************************
+ * Name: mm_heapstats_end
+ *
+ * Description:
+ *   Account the result mem of an allocation counted by mm_heapstats_begin,
+ *   after every way of the heap to serve it was tried, and its latency if
+ *   it was sampled.
+ *
+ ****************************************************************************/
+
+void mm_heapstats_end(FAR struct mm_heap_s *heap, bool sampled, uint32_t start, FAR void *mem)
+{
+	uint32_t usec;
+	int bucket;
+
+	if (!mem) {
+		heap->mm_stats.nfails++;
+	}
+
+	if (!sampled) {
+		return;
+	}
+
+	usec = mm_heapstats_now() - start;
+	bucket = usec ? MM_STATS_FLS(usec) + 1 : 0;
+	if (bucket >= MM_STATS_NLATENCY) {
+		bucket = MM_STATS_NLATENCY - 1;
+	}
+
+	heap->mm_stats.latency[bucket]++;
+	heap->mm_stats.nsampled++;
+	if (usec > heap->mm_stats.maxlatency) {
+		heap->mm_stats.maxlatency = usec;
+	}
+}
+
+/****************************************************************************
+ * Name: mm_heapstats_print
+ *
+ * Description:
+ *   Print the statistics of heap, and of its arenas, to buf of len bytes.
+ *   Return the number of characters printed, at most len - 1.
+ *
+ ****************************************************************************/
+
+int mm_heapstats_print(FAR struct mm_heap_s *heap, FAR char *buf, size_t len)
+{
+	struct mm_fraginfo_s info;
+	struct mm_heapstats_s stats;
+	size_t n = 0;
+	int frag;
+	int i;
+
+	mm_heapstats_fraginfo(heap, &info);
+	memcpy(&stats, &heap->mm_stats, sizeof(struct mm_heapstats_s));
+
+	/* External fragmentation is the part of the free memory which a single
+	 * allocation can't get.
+	 */
+
+	frag = info.freesize ? (int)((uint64_t)(info.freesize - info.largest) * 100 / info.freesize) : 0;
+
+	mm_heapstats_printf(buf, len, &n, "Size %u Free %u Largest %u Chunks %u Fragmentation %d%%\n", heap->mm_heapsize, info.freesize, info.largest, info.nchunks, frag);
+
+	mm_heapstats_printf(buf, len, &n, "Free chunks by size:\n");
+	for (i = 0; i < MM_STATS_NSIZES; i++) {
+		if (info.count[i] > 0) {
+			mm_heapstats_printf(buf, len, &n, "  %8u%s %6u %10u\n", MM_MIN_CHUNK << i, i == MM_STATS_NSIZES - 1 ? "+" : " ", info.count[i], info.size[i]);
+		}
+	}
+
+#ifdef CONFIG_MM_ARENAS
+	/* Allocations from arenas are counted by the heap they belong to */
+
+	if (heap->mm_isarena) {
+		return n < len ? n : len - 1;
+	}
+#endif
+
+	mm_heapstats_printf(buf, len, &n, "Allocations %u Failed %u Sampled %u Max %u usec\n", stats.nallocs, stats.nfails, stats.nsampled, stats.maxlatency);
+
+	mm_heapstats_printf(buf, len, &n, "Latency by usec:\n");
+	for (i = 0; i < MM_STATS_NLATENCY; i++) {
+		if (stats.latency[i] > 0) {
+			mm_heapstats_printf(buf, len, &n, "  %2s %-6u %10u\n", i == MM_STATS_NLATENCY - 1 ? ">=" : "<", i == MM_STATS_NLATENCY - 1 ? 1U << (i - 1) : 1U << i, stats.latency[i]);
+		}
+	}
+
+#ifdef CONFIG_MM_ARENAS
+	for (i = 0; i < CONFIG_SMP_NCPUS; i++) {
+		if (heap->mm_arena[i]) {
+			mm_heapstats_printf(buf, len, &n, "Arena of CPU%d:\n", i);
+			if (n < len) {
+				n += mm_heapstats_print(heap->mm_arena[i], buf + n, len - n);
+			}
+		}
+	}
+#endif
+
+	return n < len ? n : len - 1;
+}
@@ -252,6 +252,13 @@ int mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart, size_t heapsi
 	/* Initialize the node array */
 
 	memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * (MM_NNODES + 1));
+#ifdef CONFIG_MM_TLSF
+	heap->mm_tlsf_flmap = 0;
+	memset(heap->mm_tlsf_slmap, 0, sizeof(heap->mm_tlsf_slmap));
+#endif
+#ifdef CONFIG_MM_HEAP_STATS
+	memset(&heap->mm_stats, 0, sizeof(heap->mm_stats));
+#endif
 
 	/* Initialize delay list to NULL for all cpus */
 
@@ -265,6 +272,10 @@ int mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart, size_t heapsi
 
 	mm_seminitialize(heap);
 
+#ifdef CONFIG_MM_SLAB
+	mm_slab_initialize(heap);
+#endif
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 	heap->total_alloc_size = heap->peak_alloc_size = 0;
 #endif
@@ -147,8 +147,22 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 {
 	FAR struct mm_freenode_s *node;
 	void *ret = NULL;
+#ifndef CONFIG_MM_TLSF
 	int ndx;
+#endif
+#ifdef CONFIG_MM_HEAP_STATS
+	uint32_t start = 0;
+	bool sampled = false;
+	bool counted;
+#endif
+#if defined(CONFIG_MM_ARENAS) || (defined(CONFIG_MM_SLAB) && defined(CONFIG_DEBUG_MM_HEAPINFO)) || defined(CONFIG_MM_HEAP_STATS)
+	/* The heap allocates memory for itself under its semaphore, e.g. a slab
+	 * or an arena.  It comes from the heap itself, is charged to no task
+	 * and is not counted as an allocation.
+	 */
 
+	bool owned = mm_holdssemaphore(heap);
+#endif
 
 	/* Free the delay list first */
 	mm_free_delaylist(heap);
@@ -168,10 +182,63 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
 	size = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
 
+#ifdef CONFIG_MM_HEAP_STATS
+	/* Only the outermost call is counted, an allocation from an arena is
+	 * counted by the heap it belongs to.
+	 */
+
+	counted = !owned;
+#ifdef CONFIG_MM_ARENAS
+	counted = counted && !heap->mm_isarena;
+#endif
+	if (counted) {
+		sampled = mm_heapstats_begin(heap, &start);
+	}
+#endif
+
+#ifdef CONFIG_MM_SLAB
+	/* Small chunks come from slabs, without searching the nodelist. */
+
+	if (size <= MM_SLAB_MAXCHUNK) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		ret = mm_slab_alloc(heap, size, caller_retaddr);
+#else
+		ret = mm_slab_alloc(heap, size);
+#endif
+		if (ret) {
+			goto done;
+		}
+	}
+
+retry:
+#endif
+
+#ifdef CONFIG_MM_ARENAS
+	/* Small chunks come from the arena of this CPU, without contending
+	 * with other CPUs for the semaphore of the heap.
+	 */
+
+	if (size <= MM_ARENA_MAXCHUNK && !heap->mm_isarena && !owned) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		ret = mm_arena_malloc(heap, size, caller_retaddr);
+#else
+		ret = mm_arena_malloc(heap, size);
+#endif
+		if (ret) {
+			goto done;
+		}
+	}
+#endif
+
 	/* We need to hold the MM semaphore while we muck with the nodelist. */
 
 	mm_takesemaphore(heap);
 
+#ifdef CONFIG_MM_TLSF
+	/* Find a list whose first chunk is large enough with the bitmaps */
+
+	node = mm_findfreechunk(heap, size);
+#else
 	/* Get the location in the node list to start the search
 	 * by converting the request size into a nodelist index.
 	 */
@@ -195,13 +262,14 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 	if (!(node && node->size == size)) {
 		node = prev;
 	}
+#endif
 
 	/* If we found a node with non-zero size, then this is one to use. Since
 	 * the list is ordered, we know that is must be best fitting chunk
 	 * available.
 	 */
 
-	if (node->size) {
+	if (node && node->size) {
 		FAR struct mm_freenode_s *remainder;
 		FAR struct mm_freenode_s *next;
 		size_t remaining;
@@ -210,7 +278,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 		 * a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(node);
+		REMOVE_NODE_FROM_LIST(heap, node);
 
 		/* Check if we have to split the free node into one of the allocated
 		 * size and another smaller freenode.  In some cases, the remaining
@@ -252,14 +320,38 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 		heapinfo_update_node((struct mm_allocnode_s *)node, caller_retaddr);
-		heapinfo_add_size(heap, ((struct mm_allocnode_s *)node)->pid, node->size);
-		heapinfo_update_total_size(heap, node->size, ((struct mm_allocnode_s *)node)->pid);
+#if defined(CONFIG_MM_ARENAS) || defined(CONFIG_MM_SLAB)
+		if (!owned)
+#endif
+		{
+			heapinfo_add_size(heap, ((struct mm_allocnode_s *)node)->pid, node->size);
+			heapinfo_update_total_size(heap, node->size, ((struct mm_allocnode_s *)node)->pid);
+		}
 #endif
 		ret = (void *)((char *)node + SIZEOF_MM_ALLOCNODE);
 	}
 
 	mm_givesemaphore(heap);
 
+#ifdef CONFIG_MM_SLAB
+	/* Free objects cached by the CPUs may be all that keeps some slabs
+	 * allocated.  Return them to the heap and search again.
+	 */
+
+	if (!ret && mm_slab_drain(heap) > 0) {
+		goto retry;
+	}
+#endif
+
+#if defined(CONFIG_MM_SLAB) || defined(CONFIG_MM_ARENAS)
+done:
+#endif
+#ifdef CONFIG_MM_HEAP_STATS
+	if (counted) {
+		mm_heapstats_end(heap, sampled, start, ret);
+	}
+#endif
+
 	/* If CONFIG_DEBUG_MM is defined, then output the result of the allocation
 	 * to the SYSLOG.
 	 */
@@ -161,6 +161,15 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 	 * to accommodate the requested size, it will fail due to no more space.
 	 */
 	for (; ndx < MM_NNODES; ndx++) {
+#ifdef CONFIG_MM_TLSF
+		/* Lists are not sorted in this mode, so every large enough node of
+		 * a list is checked.
+		 */
+		for (node = heap->mm_nodelist[ndx].flink; node; node = node->flink) {
+			if (node->size < newsize) {
+				continue;
+			}
+#else
 		node = heap->mm_nodelist[ndx].flink;
 		if (!(node && node->size >= newsize)) {
 			/* If the list at this index is empty or if the size of first node
@@ -181,6 +190,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 
 		/* Now, traverse the list in reverse direction, towards bigger size nodes */
 		for ( ; node; node = node->blink) {
+#endif
 			/* Search the suitable aligned address in the same node. */
 			for (alignchunk = (FAR struct mm_allocnode_s *)(((size_t)node + SIZEOF_MM_ALLOCNODE + mask) & ~mask);
 				(uintptr_t)(alignchunk + alignment) < (uintptr_t)(node + node->size);
@@ -217,7 +227,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 		 * a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(node);
+		REMOVE_NODE_FROM_LIST(heap, node);
 
 		/* Check if there is free space at the beginning of the aligned chunk */
 		if ((size_t)newnode - (size_t)node >= SIZEOF_MM_FREENODE) {
@@ -29,7 +29,10 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define REMOVE_NODE_FROM_LIST(node)				\
+#ifdef CONFIG_MM_TLSF
+#define REMOVE_NODE_FROM_LIST(heap, node) mm_removefreechunk(heap, node)
+#else
+#define REMOVE_NODE_FROM_LIST(heap, node)			\
 	do {							\
 		DEBUGASSERT((node)->blink);			\
 		(node)->blink->flink = (node)->flink;		\
@@ -37,6 +40,7 @@
 			(node)->flink->blink = (node)->blink;	\
 		}						\
 	} while (0)
+#endif
 
 /****************************************************************************
  * Public Functions
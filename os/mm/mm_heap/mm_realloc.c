@@ -118,6 +118,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 	size_t nextsize = 0;
 #endif
 	FAR void *newmem;
+#ifdef CONFIG_MM_ARENAS
+	FAR struct mm_heap_s *arena;
+#endif
 
 	/* If oldmem is NULL, then realloc is equivalent to malloc */
 
@@ -146,6 +149,60 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 
 	oldnode = (FAR struct mm_allocnode_s *)((FAR char *)oldmem - SIZEOF_MM_ALLOCNODE);
 
+#ifdef CONFIG_MM_SLAB
+	/* An object of a slab can't grow or shrink, keep it if it's large
+	 * enough, otherwise move it.
+	 */
+
+	if (MM_IS_SLAB_OBJECT(oldnode)) {
+		oldsize = oldnode->size & ~MM_SLAB_BIT;
+		if (newsize <= oldsize) {
+			return oldmem;
+		}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		newmem = (FAR void *)mm_malloc(heap, size, caller_retaddr);
+#else
+		newmem = (FAR void *)mm_malloc(heap, size);
+#endif
+		if (newmem) {
+			memcpy(newmem, oldmem, oldsize - SIZEOF_MM_ALLOCNODE);
+			mm_free(heap, oldmem);
+		}
+
+		return newmem;
+	}
+#endif
+
+#ifdef CONFIG_MM_ARENAS
+	/* Memory of an arena is resized in it, or moved out of it if it can't
+	 * grow there.  Memory other CPUs freed to the arena of this CPU is
+	 * freed first, it may be what the chunk grows into.
+	 */
+
+	mm_arena_drain(heap);
+	arena = mm_arena_of(heap, oldmem);
+	if (arena) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		newmem = (FAR void *)mm_realloc(arena, oldmem, size, caller_retaddr);
+		if (!newmem) {
+			newmem = (FAR void *)mm_malloc(heap, size, caller_retaddr);
+#else
+		newmem = (FAR void *)mm_realloc(arena, oldmem, size);
+		if (!newmem) {
+			newmem = (FAR void *)mm_malloc(heap, size);
+#endif
+			if (newmem) {
+				oldsize = oldnode->size;
+				memcpy(newmem, oldmem, (newsize < oldsize ? newsize : oldsize) - SIZEOF_MM_ALLOCNODE);
+				mm_free(heap, oldmem);
+			}
+		}
+
+		return newmem;
+	}
+#endif
+
 	/* We need to hold the MM semaphore while we muck with the nodelist. */
 
 	DEBUGASSERT(mm_takesemaphore(heap));
@@ -267,7 +324,7 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 			 * there may not be a successor node.
 			 */
 
-			REMOVE_NODE_FROM_LIST(prev);
+			REMOVE_NODE_FROM_LIST(heap, prev);
 
 			/* Extend the node into the previous free chunk */
 			/* Did we consume the entire preceding chunk? */
@@ -321,7 +378,7 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem, size_t size)
 			 * may not be a successor node.
 			 */
 
-			REMOVE_NODE_FROM_LIST(next);
+			REMOVE_NODE_FROM_LIST(heap, next);
 
 			/* Extend the node into the next chunk */
 			/* Did we consume the entire preceding chunk? */
@@ -93,6 +93,9 @@ void mm_seminitialize(FAR struct mm_heap_s *heap)
 
 	heap->mm_holder      = -1;
 	heap->mm_counts_held = 0;
+#ifdef CONFIG_SMP
+	heap->mm_contended   = 0;
+#endif
 }
 
 /****************************************************************************
@@ -164,16 +167,28 @@ bool mm_takesemaphore(FAR struct mm_heap_s *heap)
 		/* Take the semaphore (perhaps waiting) */
 
 		mvdbg("PID=%d taking\n", my_pid);
-		while (sem_wait(&heap->mm_semaphore) != 0) {
-			/* The only case that an error should occur here is if
-			 * the wait was awakened by a signal.
-			 */
-
-			ASSERT(errno == EINTR);
+#ifdef CONFIG_SMP
+		bool contended = (sem_trywait(&heap->mm_semaphore) != 0);
+		if (contended)
+#endif
+		{
+			while (sem_wait(&heap->mm_semaphore) != 0) {
+				/* The only case that an error should occur here is if
+				 * the wait was awakened by a signal.
+				 */
+
+				ASSERT(errno == EINTR);
+			}
 		}
 
 		/* We have it.  Claim the stake and return */
 
+#ifdef CONFIG_SMP
+		if (contended) {
+			heap->mm_contended++;
+		}
+#endif
+
 		heap->mm_holder      = my_pid;
 		heap->mm_counts_held = 1;
 	}
@@ -220,6 +235,20 @@ void mm_givesemaphore(FAR struct mm_heap_s *heap)
 	}
 }
 
+/****************************************************************************
+ * Name: mm_holdssemaphore
+ *
+ * Description:
+ *   Return true if the calling task holds the MM mutex, i.e. the heap
+ *   allocates memory for itself, e.g. a slab or an arena.
+ *
+ ****************************************************************************/
+
+bool mm_holdssemaphore(FAR struct mm_heap_s *heap)
+{
+	return heap->mm_holder == getpid();
+}
+
 /****************************************************************************
  * Name: mm_is_sem_available
  *
@@ -0,0 +1,592 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <string.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/irq.h>
+#include <tinyara/mm/mm.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Number of objects moved between a magazine and slabs at once */
+
+#define SLAB_BATCH ((CONFIG_MM_SLAB_MAGAZINE + 1) / 2)
+
+#define SLAB_SIZE MM_ALIGN_DOWN(CONFIG_MM_SLAB_SIZE)
+
+/* A free object is linked through its data, right after its allocnode */
+
+#define NODE2OBJ(node) ((FAR struct mm_delaynode_s *)((FAR char *)(node) + SIZEOF_MM_ALLOCNODE))
+#define OBJ2NODE(obj)  ((FAR struct mm_allocnode_s *)((FAR char *)(obj) - SIZEOF_MM_ALLOCNODE))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Magazines of a CPU are mostly used by the CPU itself, but are drained by
+ * other CPUs as well.  Lock the magazines of the current CPU, the task can't
+ * move to another CPU until they are unlocked.
+ */
+
+static inline int mm_magazine_lock(FAR struct mm_heap_s *heap, FAR irqstate_t *flags)
+{
+	int cpu;
+
+	*flags = irqsave();
+	cpu = up_cpu_index();
+#ifdef CONFIG_SMP
+	spin_lock(&heap->mm_maglock[cpu]);
+#endif
+	return cpu;
+}
+
+static inline void mm_magazine_unlock(FAR struct mm_heap_s *heap, int cpu, irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+	spin_unlock(&heap->mm_maglock[cpu]);
+#endif
+	irqrestore(flags);
+}
+
+static inline FAR struct mm_slab_s *mm_slab_of(FAR struct mm_allocnode_s *node)
+{
+	return (FAR struct mm_slab_s *)((FAR char *)node - (node->preceding & ~MM_ALLOC_BIT));
+}
+
+static void mm_slab_link(FAR struct mm_slabclass_s *class, FAR struct mm_slab_s *slab)
+{
+	slab->blink = NULL;
+	slab->flink = class->partial;
+	if (class->partial) {
+		class->partial->blink = slab;
+	}
+	class->partial = slab;
+}
+
+static void mm_slab_unlink(FAR struct mm_slabclass_s *class, FAR struct mm_slab_s *slab)
+{
+	if (slab->blink) {
+		slab->blink->flink = slab->flink;
+	} else {
+		class->partial = slab->flink;
+	}
+	if (slab->flink) {
+		slab->flink->blink = slab->blink;
+	}
+}
+
+/****************************************************************************
+ * Name: mm_slab_create
+ *
+ * Description:
+ *   Carve a chunk of the heap into free objects of 'chunk' bytes and add it
+ *   to the slabs of the class.  It is assumed that the caller holds the mm
+ *   semaphore.
+ *
+ ****************************************************************************/
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+static FAR struct mm_slab_s *mm_slab_create(FAR struct mm_heap_s *heap, size_t chunk, mmaddress_t caller_retaddr)
+#else
+static FAR struct mm_slab_s *mm_slab_create(FAR struct mm_heap_s *heap, size_t chunk)
+#endif
+{
+	FAR struct mm_slab_s *slab;
+	FAR struct mm_allocnode_s *node;
+	FAR char *object;
+	int i;
+
+	/* Slabs are larger than MM_SLAB_MAXCHUNK, so they come from the free lists */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	slab = (FAR struct mm_slab_s *)mm_malloc(heap, SLAB_SIZE - SIZEOF_MM_ALLOCNODE, caller_retaddr);
+#else
+	slab = (FAR struct mm_slab_s *)mm_malloc(heap, SLAB_SIZE - SIZEOF_MM_ALLOCNODE);
+#endif
+	if (!slab) {
+		return NULL;
+	}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	((FAR struct mm_allocnode_s *)((FAR char *)slab - SIZEOF_MM_ALLOCNODE))->reserved = MM_SLAB_MAGIC;
+#endif
+
+	slab->chunk    = chunk;
+	slab->nobjects = (SLAB_SIZE - SIZEOF_MM_ALLOCNODE - MM_SLAB_FIRST) / chunk;
+	slab->nfree    = slab->nobjects;
+	slab->freelist = NULL;
+
+	/* Link objects in the order of addresses, the first one is taken first */
+
+	object = (FAR char *)slab + MM_SLAB_FIRST + (slab->nobjects - 1) * chunk;
+	for (i = 0; i < slab->nobjects; i++, object -= chunk) {
+		node            = (FAR struct mm_allocnode_s *)object;
+		node->size      = chunk | MM_SLAB_BIT;
+		node->preceding = object - (FAR char *)slab;
+
+		NODE2OBJ(node)->flink = slab->freelist;
+		slab->freelist        = NODE2OBJ(node);
+	}
+
+	mm_slab_link(&heap->mm_slabclass[MM_SLAB_CLASS(chunk)], slab);
+	heap->mm_slabclass[MM_SLAB_CLASS(chunk)].nslabs++;
+
+	mvdbg("Slab %p of %d objects of %u bytes\n", slab, slab->nobjects, chunk);
+	return slab;
+}
+
+/****************************************************************************
+ * Name: mm_slab_take
+ *
+ * Description:
+ *   Take up to 'count' free objects of 'chunk' bytes out of slabs, creating
+ *   a slab only when there is no free object at all.  It is assumed that the
+ *   caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+static FAR struct mm_delaynode_s *mm_slab_take(FAR struct mm_heap_s *heap, size_t chunk, int count, mmaddress_t caller_retaddr)
+#else
+static FAR struct mm_delaynode_s *mm_slab_take(FAR struct mm_heap_s *heap, size_t chunk, int count)
+#endif
+{
+	FAR struct mm_slabclass_s *class = &heap->mm_slabclass[MM_SLAB_CLASS(chunk)];
+	FAR struct mm_delaynode_s *list = NULL;
+	FAR struct mm_delaynode_s *obj;
+	FAR struct mm_slab_s *slab;
+	int taken = 0;
+
+	while (taken < count) {
+		slab = class->partial;
+		if (!slab) {
+			if (taken > 0) {
+				break;
+			}
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+			if (!mm_slab_create(heap, chunk, caller_retaddr)) {
+#else
+			if (!mm_slab_create(heap, chunk)) {
+#endif
+				break;
+			}
+
+			/* Creating a slab may have freed delayed objects into slabs, so
+			 * take the list again.
+			 */
+
+			continue;
+		}
+
+		obj            = slab->freelist;
+		slab->freelist = obj->flink;
+		if (--slab->nfree == 0) {
+			mm_slab_unlink(class, slab);
+		}
+
+		obj->flink = list;
+		list       = obj;
+		taken++;
+	}
+
+	class->nobjects += taken;
+	return list;
+}
+
+/****************************************************************************
+ * Name: mm_slab_put
+ *
+ * Description:
+ *   Return a free object to its slab, and the slab to the heap when all of
+ *   its objects are free.  It is assumed that the caller holds the mm
+ *   semaphore.
+ *
+ ****************************************************************************/
+
+static void mm_slab_put(FAR struct mm_heap_s *heap, FAR struct mm_delaynode_s *obj)
+{
+	FAR struct mm_slab_s *slab = mm_slab_of(OBJ2NODE(obj));
+	FAR struct mm_slabclass_s *class = &heap->mm_slabclass[MM_SLAB_CLASS(slab->chunk)];
+
+	obj->flink     = slab->freelist;
+	slab->freelist = obj;
+	class->nobjects--;
+
+	if (++slab->nfree == 1) {
+		mm_slab_link(class, slab);
+	}
+
+	if (slab->nfree == slab->nobjects) {
+		mm_slab_unlink(class, slab);
+		class->nslabs--;
+		mvdbg("Slab %p of %u bytes objects is free\n", slab, slab->chunk);
+		mm_free(heap, slab);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_slab_initialize
+ *
+ * Description:
+ *   Initialize slabs and magazines of the heap, there is no slab until the
+ *   first small allocation.
+ *
+ ****************************************************************************/
+
+void mm_slab_initialize(FAR struct mm_heap_s *heap)
+{
+	int cpu;
+
+	memset(heap->mm_slabclass, 0, sizeof(heap->mm_slabclass));
+	memset(heap->mm_magazine, 0, sizeof(heap->mm_magazine));
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		spin_initialize(&heap->mm_maglock[cpu], SP_UNLOCKED);
+	}
+}
+
+/****************************************************************************
+ * Name: mm_slab_alloc
+ *
+ * Description:
+ *   Allocate an object of 'size' bytes including its allocnode, at most
+ *   MM_SLAB_MAXCHUNK.  It is taken from the magazine of the current CPU
+ *   with its interrupts masked.  Only when the magazine is empty, the mm
+ *   semaphore is taken to refill half of it from slabs.
+ *
+ * Return Value:
+ *   Allocated memory, or NULL when there's no memory for a new slab.
+ *
+ ****************************************************************************/
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *mm_slab_alloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr)
+#else
+FAR void *mm_slab_alloc(FAR struct mm_heap_s *heap, size_t size)
+#endif
+{
+	FAR struct mm_magazine_s *magazine;
+	FAR struct mm_delaynode_s *obj;
+	FAR struct mm_delaynode_s *next;
+	FAR struct mm_allocnode_s *node;
+	irqstate_t flags;
+	int class;
+	int cpu;
+
+	if (size < MM_SLAB_MINCHUNK) {
+		size = MM_SLAB_MINCHUNK;
+	}
+	class = MM_SLAB_CLASS(size);
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* The object is charged to the task under the mm semaphore */
+
+	if (mm_takesemaphore(heap) == false) {
+		return NULL;
+	}
+#endif
+
+	cpu      = mm_magazine_lock(heap, &flags);
+	magazine = &heap->mm_magazine[cpu][class];
+	obj      = magazine->head;
+	if (obj) {
+		magazine->head = obj->flink;
+		magazine->count--;
+		magazine->hits++;
+	} else {
+		magazine->misses++;
+	}
+	mm_magazine_unlock(heap, cpu, flags);
+
+	if (!obj) {
+		/* The magazine is empty, refill it from slabs */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		obj = mm_slab_take(heap, size, SLAB_BATCH, caller_retaddr);
+#else
+		if (mm_takesemaphore(heap) == false) {
+			return NULL;
+		}
+		obj = mm_slab_take(heap, size, SLAB_BATCH);
+		mm_givesemaphore(heap);
+#endif
+
+		if (!obj) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+			mm_givesemaphore(heap);
+#endif
+			return NULL;
+		}
+
+		/* Keep the first object, cache the rest.  The task may run on
+		 * another CPU now, so take the magazine again.
+		 */
+
+		if (obj->flink) {
+			cpu      = mm_magazine_lock(heap, &flags);
+			magazine = &heap->mm_magazine[cpu][class];
+			for (next = obj->flink; next; next = obj->flink) {
+				obj->flink     = next->flink;
+				next->flink    = magazine->head;
+				magazine->head = next;
+				magazine->count++;
+			}
+			mm_magazine_unlock(heap, cpu, flags);
+		}
+	}
+
+	node = OBJ2NODE(obj);
+	node->preceding |= MM_ALLOC_BIT;
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	heapinfo_update_node(node, caller_retaddr);
+	heapinfo_add_size(heap, node->pid, node->size & ~MM_SLAB_BIT);
+	heapinfo_update_total_size(heap, node->size & ~MM_SLAB_BIT, node->pid);
+	mm_givesemaphore(heap);
+#endif
+
+	mvdbg("Allocated %p from slab, size %u\n", obj, size);
+	return (FAR void *)obj;
+}
+
+/****************************************************************************
+ * Name: mm_slab_free
+ *
+ * Description:
+ *   Free an object of a slab into the magazine of the current CPU.  When the
+ *   magazine is full, the object and half of the magazine are returned to
+ *   their slabs under the mm semaphore.
+ *
+ * Return Value:
+ *   false if the mm semaphore can't be taken in this context, then the
+ *   caller should delay the free.
+ *
+ ****************************************************************************/
+
+bool mm_slab_free(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node)
+{
+	FAR struct mm_magazine_s *magazine;
+	FAR struct mm_delaynode_s *obj = NODE2OBJ(node);
+	FAR struct mm_delaynode_s *list = NULL;
+	FAR struct mm_delaynode_s *next;
+	irqstate_t flags;
+	int class = MM_SLAB_CLASS(node->size & ~MM_SLAB_BIT);
+	int cpu;
+	int i;
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* Uncharge the task of the object under the mm semaphore */
+
+	if (mm_takesemaphore(heap) == false) {
+		return false;
+	}
+	if ((node->preceding & MM_ALLOC_BIT) == MM_ALLOC_BIT) {
+		heapinfo_subtract_size(heap, node->pid, node->size & ~MM_SLAB_BIT);
+		heapinfo_update_total_size(heap, ((-1) * (node->size & ~MM_SLAB_BIT)), node->pid);
+	}
+	mm_givesemaphore(heap);
+#endif
+
+	cpu = mm_magazine_lock(heap, &flags);
+	if ((node->preceding & MM_ALLOC_BIT) != MM_ALLOC_BIT) {
+		mm_magazine_unlock(heap, cpu, flags);
+		mdbg("Attempt for double freeing a pointer or releasing an unallocated pointer\n");
+		return true;
+	}
+
+	magazine = &heap->mm_magazine[cpu][class];
+	if (magazine->count < CONFIG_MM_SLAB_MAGAZINE) {
+		node->preceding &= ~MM_ALLOC_BIT;
+		obj->flink       = magazine->head;
+		magazine->head   = obj;
+		magazine->count++;
+		mm_magazine_unlock(heap, cpu, flags);
+		return true;
+	}
+	mm_magazine_unlock(heap, cpu, flags);
+
+	/* The magazine is full, return the object and half of the magazine */
+
+	if (mm_takesemaphore(heap) == false) {
+		return false;
+	}
+
+	node->preceding &= ~MM_ALLOC_BIT;
+
+	cpu      = mm_magazine_lock(heap, &flags);
+	magazine = &heap->mm_magazine[cpu][class];
+	for (i = 0; i < SLAB_BATCH && magazine->head; i++) {
+		next           = magazine->head;
+		magazine->head = next->flink;
+		magazine->count--;
+		next->flink    = list;
+		list           = next;
+	}
+	mm_magazine_unlock(heap, cpu, flags);
+
+	mm_slab_put(heap, obj);
+	for (; list; list = next) {
+		next = list->flink;
+		mm_slab_put(heap, list);
+	}
+
+	mm_givesemaphore(heap);
+	return true;
+}
+
+/****************************************************************************
+ * Name: mm_slab_drain
+ *
+ * Description:
+ *   Return all objects cached by the magazines of every CPU to their slabs,
+ *   e.g. before an allocation of the heap fails.
+ *
+ * Return Value:
+ *   Number of slabs returned to the heap.
+ *
+ ****************************************************************************/
+
+int mm_slab_drain(FAR struct mm_heap_s *heap)
+{
+	FAR struct mm_magazine_s *magazine;
+	FAR struct mm_delaynode_s *list = NULL;
+	FAR struct mm_delaynode_s *next;
+	irqstate_t flags;
+	int nslabs = 0;
+	unsigned int class;
+	int cpu;
+
+	if (mm_takesemaphore(heap) == false) {
+		return 0;
+	}
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		flags = irqsave();
+#ifdef CONFIG_SMP
+		spin_lock(&heap->mm_maglock[cpu]);
+#endif
+		for (class = 0; class < MM_SLAB_NCLASSES; class++) {
+			magazine = &heap->mm_magazine[cpu][class];
+			while (magazine->head) {
+				next           = magazine->head;
+				magazine->head = next->flink;
+				next->flink    = list;
+				list           = next;
+			}
+			magazine->count = 0;
+		}
+#ifdef CONFIG_SMP
+		spin_unlock(&heap->mm_maglock[cpu]);
+#endif
+		irqrestore(flags);
+	}
+
+	for (class = 0; class < MM_SLAB_NCLASSES; class++) {
+		nslabs += heap->mm_slabclass[class].nslabs;
+	}
+
+	for (; list; list = next) {
+		next = list->flink;
+		mm_slab_put(heap, list);
+	}
+
+	for (class = 0; class < MM_SLAB_NCLASSES; class++) {
+		nslabs -= heap->mm_slabclass[class].nslabs;
+	}
+
+	mm_givesemaphore(heap);
+	return nslabs;
+}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+/****************************************************************************
+ * Name: heapinfo_parse_slab
+ *
+ * Description:
+ *   Display allocated objects of the slab in the chunk 'node'.  It is
+ *   assumed that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+void heapinfo_parse_slab(FAR struct mm_allocnode_s *node, int mode, pid_t pid)
+{
+	FAR struct mm_slab_s *slab = (FAR struct mm_slab_s *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
+	FAR struct mm_allocnode_s *object;
+	int i;
+
+	if (mode != HEAPINFO_DETAIL_ALL && mode != HEAPINFO_DETAIL_PID && mode != HEAPINFO_DETAIL_SPECIFIC_HEAP) {
+		return;
+	}
+
+	for (i = 0; i < slab->nobjects; i++) {
+		object = (FAR struct mm_allocnode_s *)((FAR char *)slab + MM_SLAB_FIRST + i * slab->chunk);
+		if ((object->preceding & MM_ALLOC_BIT) == 0 || (pid != HEAPINFO_PID_ALL && object->pid != pid)) {
+			continue;
+		}
+		heap_dbg("0x%x | %8u |   %c    | 0x%8x | %3d   |\n", object, slab->chunk, 's', object->alloc_call_addr, object->pid);
+	}
+}
+
+/****************************************************************************
+ * Name: heapinfo_slab_summary
+ *
+ * Description:
+ *   Display slabs and magazines of every size class in use.
+ *
+ ****************************************************************************/
+
+void heapinfo_slab_summary(FAR struct mm_heap_s *heap)
+{
+	FAR struct mm_slabclass_s *class;
+	uint32_t hits;
+	uint32_t misses;
+	int cached;
+	unsigned int ndx;
+	int cpu;
+
+	heap_dbg("\n< Slab >\n");
+	heap_dbg(" Size | Slabs | In use | Cached |     Hits |   Misses\n");
+	heap_dbg("------|-------|--------|--------|----------|---------\n");
+
+	for (ndx = 0; ndx < MM_SLAB_NCLASSES; ndx++) {
+		class = &heap->mm_slabclass[ndx];
+		cached = 0;
+		hits = 0;
+		misses = 0;
+		for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+			cached += heap->mm_magazine[cpu][ndx].count;
+			hits += heap->mm_magazine[cpu][ndx].hits;
+			misses += heap->mm_magazine[cpu][ndx].misses;
+		}
+		if (class->nslabs == 0 && hits == 0 && misses == 0) {
+			continue;
+		}
+		/* Objects taken out of slabs are in use or cached in magazines */
+		heap_dbg(" %4u | %5u | %6d | %6d | %8u | %8u\n", (ndx + 1) << MM_MIN_SHIFT, class->nslabs, class->nobjects - cached, cached, hits, misses);
+	}
+}
+#endif
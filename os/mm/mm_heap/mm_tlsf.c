@@ -0,0 +1,188 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+
+#include <tinyara/mm/mm.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Index of the most and the least significant bit set, x must not be 0.
+ * Both are single instructions (CLZ, RBIT + CLZ) on ARMv7.
+ */
+
+#define MM_TLSF_FLS(x)   (31 - __builtin_clz((uint32_t)(x)))
+#define MM_TLSF_FFS(x)   __builtin_ctz((uint32_t)(x))
+
+#define MM_TLSF_SLMASK   (MM_TLSF_SLCOUNT - 1)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline void mm_tlsf_setbit(FAR struct mm_heap_s *heap, int ndx)
+{
+	heap->mm_tlsf_slmap[ndx >> MM_TLSF_SLI] |= 1U << (ndx & MM_TLSF_SLMASK);
+	heap->mm_tlsf_flmap |= 1U << (ndx >> MM_TLSF_SLI);
+}
+
+static inline void mm_tlsf_clearbit(FAR struct mm_heap_s *heap, int ndx)
+{
+	int fl = ndx >> MM_TLSF_SLI;
+
+	heap->mm_tlsf_slmap[fl] &= ~(1U << (ndx & MM_TLSF_SLMASK));
+	if (heap->mm_tlsf_slmap[fl] == 0) {
+		heap->mm_tlsf_flmap &= ~(1U << fl);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_size2ndx
+ *
+ * Description:
+ *    Convert the size to the index of the list holding chunks of that size.
+ *
+ ****************************************************************************/
+
+int mm_size2ndx(size_t size)
+{
+	int fl;
+
+	if (size < MM_TLSF_FLMIN) {
+		return size >> MM_MIN_SHIFT;
+	}
+
+	if (size >= ((size_t)MM_MAX_CHUNK << 1)) {
+		return MM_NNODES - 1;
+	}
+
+	fl = MM_TLSF_FLS(size);
+	return ((fl - MM_TLSF_FLSHIFT + 1) << MM_TLSF_SLI) + ((size >> (fl - MM_TLSF_SLI)) & MM_TLSF_SLMASK);
+}
+
+/****************************************************************************
+ * Name: mm_addfreechunk
+ *
+ * Description:
+ *   Add a free chunk to the head of its list.  It is assumed that the caller
+ *   holds the mm semaphore
+ *
+ ****************************************************************************/
+
+void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+	int ndx = mm_size2ndx(node->size);
+	FAR struct mm_freenode_s *head = &heap->mm_nodelist[ndx];
+
+	node->blink = head;
+	node->flink = head->flink;
+	if (head->flink) {
+		head->flink->blink = node;
+	}
+	head->flink = node;
+
+	mm_tlsf_setbit(heap, ndx);
+}
+
+/****************************************************************************
+ * Name: mm_removefreechunk
+ *
+ * Description:
+ *   Remove a free chunk from its list.  The size of the chunk must be the
+ *   same as when it was added.  It is assumed that the caller holds the mm
+ *   semaphore
+ *
+ ****************************************************************************/
+
+void mm_removefreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+	int ndx;
+
+	DEBUGASSERT(node->blink);
+	node->blink->flink = node->flink;
+	if (node->flink) {
+		node->flink->blink = node->blink;
+		return;
+	}
+
+	ndx = mm_size2ndx(node->size);
+	if (!heap->mm_nodelist[ndx].flink) {
+		mm_tlsf_clearbit(heap, ndx);
+	}
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least size bytes, or return NULL.  The first
+ *   chunk of the list of size is taken if it is large enough, else the
+ *   first chunk of the next non-empty list, all of whose chunks are large
+ *   enough.  Only the last list, of sizes from MM_MAX_CHUNK << 1, is
+ *   searched.  It is assumed that the caller holds the mm semaphore
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap, size_t size)
+{
+	FAR struct mm_freenode_s *node;
+	uint32_t map;
+	int ndx = mm_size2ndx(size);
+	int fl;
+
+	node = heap->mm_nodelist[ndx].flink;
+	if (node && node->size >= size) {
+		return node;
+	}
+
+	if (ndx == MM_NNODES - 1) {
+		for (; node && node->size < size; node = node->flink) ;
+		return node;
+	}
+
+	/* Lists after ndx in its first level, then the first non-empty one of
+	 * a larger first level.
+	 */
+
+	ndx++;
+	fl = ndx >> MM_TLSF_SLI;
+	map = heap->mm_tlsf_slmap[fl] & (~0U << (ndx & MM_TLSF_SLMASK));
+	if (!map) {
+		map = heap->mm_tlsf_flmap & (~0U << (fl + 1));
+		if (!map) {
+			return NULL;
+		}
+		fl = MM_TLSF_FFS(map);
+		map = heap->mm_tlsf_slmap[fl];
+	}
+
+	return heap->mm_nodelist[(fl << MM_TLSF_SLI) + MM_TLSF_FFS(map)].flink;
+}
@@ -0,0 +1,179 @@
+/******************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/*
+ * Host converter of csv files into AI Framework binary datasets.
+ * Converted rows are read back with the batch reader and compared with the csv reader,
+ * and time taken by both readers is printed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "aifw/aifw_dataset_reader.h"
+
+#define BATCH_ROWS 256
+
+static double now_ms(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static int parse_type(const char *name, CSV_VALUE_DATA_TYPE_E *type, size_t *size)
+{
+	static const struct {
+		const char *name;
+		CSV_VALUE_DATA_TYPE_E type;
+		size_t size;
+	} types[] = {
+		{ "int8", INT8, 1 }, { "uint8", UINT8, 1 }, { "int16", INT16, 2 }, { "int32", INT32, 4 }, { "float32", FLOAT32, 4 },
+	};
+	size_t i;
+	for (i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+		if (strcmp(name, types[i].name) == 0) {
+			*type = types[i].type;
+			*size = types[i].size;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+/* Reads the csv once with the text reader and the dataset in batches, rows should be identical */
+static int verify(const char *csv, const char *dataset, CSV_VALUE_DATA_TYPE_E type, bool header, size_t rowSize)
+{
+	void *csvHandle = NULL;
+	void *datasetHandle = NULL;
+	char *csvRows = NULL;
+	uint32_t rows = 0;
+	uint32_t i;
+	double start;
+	double csvMs;
+	double datasetMs;
+	int ret = -1;
+
+	if (datasetInit(&datasetHandle, dataset, BATCH_ROWS) != AIFW_OK) {
+		fprintf(stderr, "Opening %s failed\n", dataset);
+		return -1;
+	}
+	getDatasetInfo(datasetHandle, NULL, NULL, &rows);
+	csvRows = malloc(rows * rowSize + 1);
+	if (!csvRows) {
+		fprintf(stderr, "Memory allocation failed\n");
+		goto done;
+	}
+
+	start = now_ms();
+	if (csvInit(&csvHandle, csv, type, header) != AIFW_OK) {
+		fprintf(stderr, "Opening %s failed\n", csv);
+		goto done;
+	}
+	for (i = 0; i < rows; i++) {
+		if (readCSVData(csvHandle, csvRows + i * rowSize) != AIFW_OK) {
+			fprintf(stderr, "csv ended at row %u\n", i);
+			goto done;
+		}
+	}
+	csvMs = now_ms() - start;
+
+	start = now_ms();
+	for (i = 0; i < rows;) {
+		void *batch;
+		uint16_t count;
+		if (readDatasetRows(datasetHandle, &batch, &count) != AIFW_OK) {
+			fprintf(stderr, "dataset ended at row %u\n", i);
+			goto done;
+		}
+		if (memcmp(batch, csvRows + i * rowSize, count * rowSize) != 0) {
+			fprintf(stderr, "rows %u to %u differ\n", i, i + count - 1);
+			goto done;
+		}
+		i += count;
+	}
+	datasetMs = now_ms() - start;
+
+	printf("%-10s %10s %10s\n", "rows", "csv ms", "dataset ms");
+	printf("%-10u %10.2f %10.2f\n", rows, csvMs, datasetMs);
+	ret = 0;
+
+done:
+	if (csvHandle) {
+		csvDeinit(&csvHandle);
+	}
+	datasetDeinit(&datasetHandle);
+	free(csvRows);
+	return ret;
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr, "Usage: %s [-t int8|uint8|int16|int32|float32] [-H] <input csv> <output dataset>\n", name);
+	fprintf(stderr, " -t    type of values, float32 by default\n");
+	fprintf(stderr, " -H    first line of the csv is a header\n");
+}
+
+int main(int argc, char *argv[])
+{
+	CSV_VALUE_DATA_TYPE_E type = FLOAT32;
+	size_t valueSize = sizeof(float);
+	bool header = false;
+	uint32_t rows = 0;
+	void *handle = NULL;
+	uint16_t columns = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "t:H")) != -1) {
+		switch (opt) {
+		case 't':
+			if (parse_type(optarg, &type, &valueSize) != 0) {
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+		case 'H':
+			header = true;
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (argc - optind != 2) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	AIFW_RESULT res = csvToDataset(argv[optind], argv[optind + 1], type, header, &rows);
+	if (res != AIFW_OK) {
+		fprintf(stderr, "Conversion failed, ret: %d\n", res);
+		return 1;
+	}
+	if (datasetInit(&handle, argv[optind + 1], 1) != AIFW_OK) {
+		fprintf(stderr, "Converted dataset can't be opened\n");
+		return 1;
+	}
+	getDatasetInfo(handle, NULL, &columns, NULL);
+	datasetDeinit(&handle);
+	printf("%s: %u rows of %u columns\n", argv[optind + 1], rows, columns);
+
+	return verify(argv[optind], argv[optind + 1], type, header, columns * valueSize) ? 1 : 0;
+}
@@ -1,6 +1,6 @@
 /******************************************************************
  *
- * Copyright 2019 Samsung Electronics All Rights Reserved.
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,26 +16,15 @@
  *
  ******************************************************************/
 
-#ifndef __PES_PACKET_H
-#define __PES_PACKET_H
+/* Host replacement of the debug macros used by media framework sources */
 
-#include <memory>
-#include "Mpeg2TsTypes.h"
-#include "Section.h"
+#ifndef __AUDIO_BENCH_DEBUG_H
+#define __AUDIO_BENCH_DEBUG_H
 
-class PESPacket : public Section
-{
-public:
-	// should always use this static method to create a new PESPacket instance
-	static std::shared_ptr<PESPacket> create(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size);
-	// constructor and destructor
-	PESPacket() {}
-	virtual ~PESPacket() {}
+#include <stdio.h>
 
-protected:
-	// parse length field from the given data
-	// return length value of the PES packet.
-	virtual uint16_t parseLengthField(uint8_t *pData, uint16_t size) override;
-};
+#define meddbg(format, ...)  fprintf(stderr, format, ##__VA_ARGS__)
+#define medwdbg(format, ...)
+#define medvdbg(format, ...)
 
-#endif /* __PES_PACKET_H */
+#endif /* __AUDIO_BENCH_DEBUG_H */
@@ -0,0 +1,27 @@
+/******************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/* Host replacement of the compiler definitions used by media framework sources */
+
+#ifndef __AUDIO_BENCH_TINYARA_COMPILER_H
+#define __AUDIO_BENCH_TINYARA_COMPILER_H
+
+#define inline_function __attribute__ ((always_inline, no_instrument_function))
+#define noinline_function __attribute__ ((noinline))
+
+#endif /* __AUDIO_BENCH_TINYARA_COMPILER_H */
@@ -0,0 +1,278 @@
+/******************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/*
+ * Host replay of the media playback pipeline with the framework statistics.
+ * Raw 16 bits PCM (a file, or a generated sweep) is read in chunks into a
+ * stream buffer, converted period by period to the card format and written
+ * to a null card, and the per-stage table of media_stats is printed.
+ * With -p the card consumes periods in real time, so that late periods are
+ * counted as output underruns like on a board.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <time.h>
+#include <media/media_stats.h>
+#include "samplerate.h"
+#include "rb.h"
+
+#define CHUNK_BYTES     4096
+#define BUFFER_BYTES    16384
+#define PERIOD_FRAMES   1024
+#define SWEEP_SECONDS   10
+#define PI              3.14159265358979
+
+struct replay_s {
+	FILE *file;
+	const int16_t *samples;
+	size_t size;
+	size_t offset;
+};
+
+static int16_t *make_sweep(int rate, int channels, size_t *size)
+{
+	int frames = rate * SWEEP_SECONDS;
+	int16_t *buf = malloc((size_t)frames * channels * sizeof(int16_t));
+	double phase = 0;
+	int i, c;
+
+	if (buf == NULL) {
+		return NULL;
+	}
+	for (i = 0; i < frames; i++) {
+		double freq = 100.0 + (rate / 2 - 200.0) * i / frames;
+		phase += 2 * PI * freq / rate;
+		for (c = 0; c < channels; c++) {
+			buf[i * channels + c] = (int16_t)(0.5 * 32767.0 * sin(phase));
+		}
+	}
+	*size = (size_t)frames * channels * sizeof(int16_t);
+	return buf;
+}
+
+/* Stands for InputDataSource::read() */
+static size_t source_read(struct replay_s *replay, void *buf, size_t size)
+{
+	uint32_t start = media_stats_now();
+	size_t len;
+
+	if (replay->file) {
+		len = fread(buf, 1, size, replay->file);
+	} else {
+		len = replay->size - replay->offset < size ? replay->size - replay->offset : size;
+		memcpy(buf, (const uint8_t *)replay->samples + replay->offset, len);
+		replay->offset += len;
+	}
+	if (len > 0) {
+		media_stats_record(MEDIA_STATS_SOURCE, start, len, 0);
+	}
+	return len;
+}
+
+static void wait_until(struct timespec *deadline)
+{
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL) != 0) {
+	}
+}
+
+static void usage(const char *name)
+{
+	printf("Usage: %s [-f file] [-r rate] [-c channels] [-o card_rate] [-p]\n", name);
+	printf(" -f    raw 16 bits PCM to replay, a sweep is generated if not given\n");
+	printf(" -r    sample rate of the input, default 16000\n");
+	printf(" -c    channels of the input, default 1\n");
+	printf(" -o    sample rate of the card, default 48000\n");
+	printf(" -p    consume periods in real time\n");
+}
+
+int main(int argc, char **argv)
+{
+	struct replay_s replay = { 0, };
+	const char *path = NULL;
+	int rate = 16000;
+	int channels = 1;
+	int card_rate = 48000;
+	int paced = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "f:r:c:o:p")) != -1) {
+		switch (opt) {
+		case 'f':
+			path = optarg;
+			break;
+		case 'r':
+			rate = atoi(optarg);
+			break;
+		case 'c':
+			channels = atoi(optarg);
+			break;
+		case 'o':
+			card_rate = atoi(optarg);
+			break;
+		case 'p':
+			paced = 1;
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (rate <= 0 || card_rate <= 0 || channels < 1 || channels > 2) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	if (path) {
+		replay.file = fopen(path, "rb");
+		if (replay.file == NULL) {
+			perror(path);
+			return 1;
+		}
+	} else {
+		replay.samples = make_sweep(rate, channels, &replay.size);
+		if (replay.samples == NULL) {
+			return 1;
+		}
+	}
+
+	rb_t stream;
+	if (!rb_init(&stream, BUFFER_BYTES)) {
+		return 1;
+	}
+
+	int frame_bytes = channels * sizeof(int16_t);
+	int in_frames = (int)((int64_t)PERIOD_FRAMES * rate / card_rate);
+	static uint8_t chunk[CHUNK_BYTES];
+	static int16_t in[PERIOD_FRAMES * 8 * 2];
+	static int16_t out[PERIOD_FRAMES * 2 * 2];
+	src_handle_t handle = NULL;
+	if (rate != card_rate) {
+		handle = src_init(sizeof(out));
+		if (handle == NULL) {
+			return 1;
+		}
+	}
+	if (in_frames < 1 || in_frames * frame_bytes > (int)sizeof(in)) {
+		printf("ratio %d/%d is not supported\n", rate, card_rate);
+		return 1;
+	}
+
+	struct timespec deadline = { 0, };
+	int eos = 0;
+	media_stats_reset();
+	media_stats_mark_start();
+
+	while (!eos || rb_used(&stream) > 0) {
+		// Fill the stream buffer as the input handler worker does
+		while (!eos && rb_avail(&stream) >= CHUNK_BYTES) {
+			size_t len = source_read(&replay, chunk, CHUNK_BYTES);
+			if (len == 0) {
+				eos = 1;
+				break;
+			}
+			rb_write(&stream, chunk, len);
+			media_stats_set_level(MEDIA_STATS_BUFFER, rb_used(&stream));
+		}
+
+		// Take one period, converting it to the card format stands for decoding
+		size_t got = rb_read(&stream, in, (size_t)in_frames * frame_bytes);
+		media_stats_set_level(MEDIA_STATS_BUFFER, rb_used(&stream));
+		if (got < (size_t)in_frames * frame_bytes && !eos) {
+			media_stats_xrun(MEDIA_STATS_BUFFER);
+		}
+		int frames = (int)(got / frame_bytes);
+		if (frames == 0) {
+			break;
+		}
+
+		uint32_t start = media_stats_now();
+		int out_frames = 0;
+		if (handle) {
+			// Resampler keeps input frames internally, drain it as the mixer does
+			int used = 0;
+			src_data_t data = { 0, };
+			do {
+				data.data_in = in + used * channels;
+				data.input_frames = frames - used;
+				data.origin_sample_rate = rate;
+				data.origin_sample_width = SAMPLE_WIDTH_16BITS;
+				data.origin_channel_num = channels;
+				data.data_out = out + out_frames * 2;
+				data.out_buf_length = sizeof(out) - out_frames * 2 * sizeof(int16_t);
+				data.desired_sample_rate = card_rate;
+				data.desired_sample_width = SAMPLE_WIDTH_16BITS;
+				data.desired_channel_num = 2;
+				if (src_simple(handle, &data) != SRC_ERR_NO_ERROR) {
+					break;
+				}
+				used += data.input_frames_used;
+				out_frames += data.output_frames_gen;
+			} while (used < frames || (data.output_frames_gen > 0 && data.out_buf_length > 0));
+		} else {
+			int i;
+			for (i = 0; i < frames; i++) {
+				out[i * 2] = in[i * channels];
+				out[i * 2 + 1] = in[i * channels + channels - 1];
+			}
+			out_frames = frames;
+		}
+		media_stats_record(MEDIA_STATS_DECODE, start, (size_t)out_frames * 2 * sizeof(int16_t), out_frames);
+
+		// Write to the null card, stands for start_audio_stream_out()
+		start = media_stats_now();
+		if (paced) {
+			// The card starts with the first period, a period later than its deadline is an underrun
+			struct timespec now;
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			if (deadline.tv_sec == 0) {
+				deadline = now;
+			} else if (now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec > deadline.tv_nsec)) {
+				media_stats_xrun(MEDIA_STATS_OUTPUT);
+				deadline = now;
+			}
+			wait_until(&deadline);
+			deadline.tv_nsec += (long)((int64_t)out_frames * 1000000000 / card_rate);
+			while (deadline.tv_nsec >= 1000000000) {
+				deadline.tv_nsec -= 1000000000;
+				deadline.tv_sec++;
+			}
+		}
+		media_stats_record(MEDIA_STATS_OUTPUT, start, (size_t)out_frames * 2 * sizeof(int16_t), out_frames);
+		media_stats_mark_output();
+	}
+
+	char table[1024];
+	media_stats_print(table, sizeof(table));
+	printf("%s", table);
+
+	if (handle) {
+		src_destroy(handle);
+	}
+	rb_free(&stream);
+	if (replay.file) {
+		fclose(replay.file);
+	} else {
+		free((void *)replay.samples);
+	}
+	return 0;
+}
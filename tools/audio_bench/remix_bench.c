@@ -0,0 +1,115 @@
+/******************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/*
+ * Host benchmark of the media framework channel remixer.
+ * Fused remix() with gain is compared with the baseline rechannel() of remix_baseline.c
+ * followed by a separate gain pass.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "remix.h"
+
+#define FRAMES      1024
+#define ROUNDS      500
+#define REPEATS     9
+#define GAIN        (REMIX_GAIN_UNITY * 3 / 4)
+
+int32_t baseline_rechannel(uint32_t in_layout, uint32_t out_layout, const int16_t *input, uint32_t in_frames, int16_t *output, uint32_t max_frames);
+
+// Frames are not known at compile time, as in the media framework
+static volatile uint32_t g_frames = FRAMES;
+static volatile uint16_t g_gain = GAIN;
+
+static double now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Time of the fastest of REPEATS runs, a host is rarely left alone for long
+#define BEST_NS_PER_FRAME(best, stmt) \
+	do { \
+		int _k; \
+		int _r; \
+		best = 1e30; \
+		for (_k = 0; _k < REPEATS; _k++) { \
+			double _t0 = now_ns(); \
+			for (_r = 0; _r < ROUNDS; _r++) { \
+				stmt; \
+			} \
+			double _t = (now_ns() - _t0) / ((double)ROUNDS * FRAMES); \
+			best = _t < best ? _t : best; \
+		} \
+	} while (0)
+
+static __attribute__((noinline)) void gain_pass(int16_t *buf, uint32_t samples, int32_t gain)
+{
+	uint32_t i;
+	for (i = 0; i < samples; i++) {
+		int32_t x = (buf[i] * gain + (REMIX_GAIN_UNITY / 2)) >> 14;
+		buf[i] = x > INT16_MAX ? INT16_MAX : (x < INT16_MIN ? INT16_MIN : x);
+	}
+}
+
+int main(void)
+{
+	static int16_t in[FRAMES * 6];
+	static int16_t out[FRAMES * 6];
+	uint32_t frames = g_frames;
+	uint16_t gain = g_gain;
+	int i, c, o;
+
+	for (i = 0; i < FRAMES * 6; i++) {
+		in[i] = (int16_t)((rand() % 32768) - 16384);
+	}
+
+	printf("%-8s %12s %12s %8s\n", "remix", "base ns/f", "fused ns/f", "maxdiff");
+	for (c = 1; c <= 6; c++) {
+		for (o = 1; o <= 2; o++) {
+			uint32_t in_layout = ch2layout(c);
+			uint32_t out_layout = ch2layout(o);
+			double base;
+			BEST_NS_PER_FRAME(base, (baseline_rechannel(in_layout, out_layout, in, frames, out, frames), gain_pass(out, frames * o, gain)));
+
+			static int16_t ref[FRAMES * 2];
+			for (i = 0; i < FRAMES * o; i++) {
+				ref[i] = out[i];
+			}
+
+			double fused;
+			BEST_NS_PER_FRAME(fused, remix(in_layout, out_layout, in, frames, out, frames, gain));
+
+			int maxdiff = 0;
+			for (i = 0; i < FRAMES * o; i++) {
+				int d = abs(ref[i] - out[i]);
+				maxdiff = d > maxdiff ? d : maxdiff;
+			}
+
+			char name[16];
+			snprintf(name, sizeof(name), "%d->%d", c, o);
+			printf("%-8s %12.2f %12.2f %8d\n", name, base, fused, maxdiff);
+		}
+	}
+
+	return 0;
+}
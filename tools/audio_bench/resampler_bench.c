@@ -0,0 +1,189 @@
+/******************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/*
+ * Host benchmark of the media framework sample rate converter.
+ * A sine sweep is converted with each engine, then quality (SNR of the
+ * converted tones) and time per output frame are reported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "samplerate.h"
+
+#define CHUNK_FRAMES    512
+#define TOTAL_FRAMES    (1 << 18)
+#define AMPLITUDE       (0.5 * 32767.0)
+#define PI              3.14159265358979
+
+static double now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+static uint64_t cycles(void)
+{
+	return __builtin_ia32_rdtsc();
+}
+#else
+static uint64_t cycles(void)
+{
+	return 0;
+}
+#endif
+
+/**
+ * Convert 'frames' frames of 'in' and return number of output frames.
+ */
+static int convert(int engine, int old_rate, int new_rate, int channels, const int16_t *in, int frames, int16_t *out, int out_frames, double *ns, uint64_t *cyc)
+{
+	src_handle_t handle = src_init(CHUNK_FRAMES * channels * sizeof(int16_t) * 2);
+	if (handle == NULL || src_set_engine(handle, engine) != SRC_ERR_NO_ERROR) {
+		return -1;
+	}
+
+	int used = 0;
+	int gen = 0;
+	double t0 = now_ns();
+	uint64_t c0 = cycles();
+	while (used < frames && gen < out_frames) {
+		src_data_t data = { 0, };
+		data.data_in = in + used * channels;
+		data.input_frames = (frames - used < CHUNK_FRAMES) ? frames - used : CHUNK_FRAMES;
+		data.origin_sample_rate = old_rate;
+		data.origin_sample_width = SAMPLE_WIDTH_16BITS;
+		data.origin_channel_num = channels;
+		data.data_out = out + gen * channels;
+		data.out_buf_length = (out_frames - gen) * channels * sizeof(int16_t);
+		data.desired_sample_rate = new_rate;
+		data.desired_sample_width = SAMPLE_WIDTH_16BITS;
+		data.desired_channel_num = channels;
+		if (src_simple(handle, &data) != SRC_ERR_NO_ERROR) {
+			break;
+		}
+		used += data.input_frames_used;
+		gen += data.output_frames_gen;
+		if (data.input_frames_used == 0 && data.output_frames_gen == 0) {
+			break;
+		}
+	}
+	*cyc = cycles() - c0;
+	*ns = now_ns() - t0;
+
+	src_destroy(handle);
+	return gen;
+}
+
+/**
+ * Signal to noise ratio of a converted tone, the tone is fitted by least squares
+ * so the result does not depend on the filter delay.
+ */
+static double tone_snr(const int16_t *out, int frames, int channels, double freq)
+{
+	double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0, yy = 0;
+	int skip = frames / 8;
+	int i;
+
+	for (i = skip; i < frames - skip; i++) {
+		double s = sin(2 * PI * freq * i);
+		double c = cos(2 * PI * freq * i);
+		double y = out[i * channels];
+		ss += s * s;
+		sc += s * c;
+		cc += c * c;
+		ys += y * s;
+		yc += y * c;
+		yy += y * y;
+	}
+
+	double det = ss * cc - sc * sc;
+	double a = (ys * cc - yc * sc) / det;
+	double b = (yc * ss - ys * sc) / det;
+	double signal = a * a * ss + 2 * a * b * sc + b * b * cc;
+	double noise = yy - signal;
+	return 10 * log10(signal / (noise > 1e-9 ? noise : 1e-9));
+}
+
+int main(int argc, char **argv)
+{
+	static const int rates[][2] = {
+		{ 44100, 48000 }, { 48000, 44100 }, { 16000, 48000 }, { 48000, 16000 }, { 22050, 16000 },
+	};
+	static const char *names[] = { "linear", "polyphase" };
+	static const double tones[] = { 440.0, 3000.0, 6000.0 };
+	int channels = (argc > 1) ? atoi(argv[1]) : 2;
+	int r, e, t, i;
+
+	if (channels != 1 && channels != 2) {
+		fprintf(stderr, "usage: %s [channels(1|2)]\n", argv[0]);
+		return 1;
+	}
+
+	int16_t *in = malloc(TOTAL_FRAMES * channels * sizeof(int16_t));
+	int16_t *out = malloc(TOTAL_FRAMES * 4 * channels * sizeof(int16_t));
+	if (in == NULL || out == NULL) {
+		return 1;
+	}
+
+	printf("%-14s %-10s %10s %10s %10s %12s %12s\n", "ratio", "engine", "snr@440", "snr@3k", "snr@6k", "ns/frame", "cycles/frame");
+	for (r = 0; r < (int)(sizeof(rates) / sizeof(rates[0])); r++) {
+		int old_rate = rates[r][0];
+		int new_rate = rates[r][1];
+		for (e = 0; e < 2; e++) {
+			double snr[3];
+			double ns_total = 0;
+			uint64_t cyc_total = 0;
+			int gen_total = 0;
+			for (t = 0; t < 3; t++) {
+				for (i = 0; i < TOTAL_FRAMES; i++) {
+					int16_t v = (int16_t)lrint(AMPLITUDE * sin(2 * PI * tones[t] * i / old_rate));
+					in[i * channels] = v;
+					if (channels == 2) {
+						in[i * channels + 1] = v;
+					}
+				}
+				double ns;
+				uint64_t cyc;
+				int gen = convert(e, old_rate, new_rate, channels, in, TOTAL_FRAMES, out, TOTAL_FRAMES * 4, &ns, &cyc);
+				if (gen <= 0) {
+					fprintf(stderr, "convert failed %d -> %d\n", old_rate, new_rate);
+					return 1;
+				}
+				snr[t] = tone_snr(out, gen, channels, tones[t] / new_rate);
+				ns_total += ns;
+				cyc_total += cyc;
+				gen_total += gen;
+			}
+			char ratio[32];
+			snprintf(ratio, sizeof(ratio), "%d->%d", old_rate, new_rate);
+			printf("%-14s %-10s %10.1f %10.1f %10.1f %12.2f %12.1f\n", ratio, names[e], snr[0], snr[1], snr[2],
+				   ns_total / gen_total, (double)cyc_total / gen_total);
+		}
+	}
+
+	free(in);
+	free(out);
+	return 0;
+}
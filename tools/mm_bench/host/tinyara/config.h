@@ -0,0 +1,38 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Configuration of the heap in the host benchmark, CONFIG_SMP_NCPUS and the
+ * options under test come from the Makefile.
+ */
+
+#ifndef __TOOLS_MM_BENCH_HOST_TINYARA_CONFIG_H
+#define __TOOLS_MM_BENCH_HOST_TINYARA_CONFIG_H
+
+#define CONFIG_ARCH_ARM 1
+#define CONFIG_BUILD_FLAT 1
+#define CONFIG_SMP 1
+#define CONFIG_MM_KERNEL_HEAP 1
+#define CONFIG_KMM_REGIONS 1
+#define CONFIG_KMM_NHEAPS 1
+#define CONFIG_MAX_TASKS 64
+#define CONFIG_HAVE_LONG_LONG 1
+
+#define FAR
+#define OK 0
+
+#endif
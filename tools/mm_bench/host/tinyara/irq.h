@@ -0,0 +1,31 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __TOOLS_MM_BENCH_HOST_TINYARA_IRQ_H
+#define __TOOLS_MM_BENCH_HOST_TINYARA_IRQ_H
+
+/* No interrupts on the host, a thread is never preempted by its own CPU */
+
+typedef int irqstate_t;
+
+#define irqsave()                 0
+#define irqrestore(f)             ((void)(f))
+#define enter_critical_section()  0
+#define leave_critical_section(f) ((void)(f))
+
+#endif
@@ -0,0 +1,54 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __TOOLS_MM_BENCH_HOST_TINYARA_SPINLOCK_H
+#define __TOOLS_MM_BENCH_HOST_TINYARA_SPINLOCK_H
+
+#include <stdint.h>
+#include <tinyara/irq.h>
+
+typedef uint8_t spinlock_t;
+
+#define SP_UNLOCKED 0
+#define SP_LOCKED   1
+
+#define spin_initialize(l, s) do { *(l) = (s); } while (0)
+
+static inline void spin_lock(volatile spinlock_t *lock)
+{
+	while (__atomic_test_and_set(lock, __ATOMIC_ACQUIRE)) ;
+}
+
+static inline void spin_unlock(volatile spinlock_t *lock)
+{
+	__atomic_clear(lock, __ATOMIC_RELEASE);
+}
+
+static inline irqstate_t spin_lock_irqsave(spinlock_t *lock)
+{
+	while (__atomic_test_and_set(lock, __ATOMIC_ACQUIRE)) ;
+	return 0;
+}
+
+static inline void spin_unlock_irqrestore(spinlock_t *lock, irqstate_t flags)
+{
+	(void)flags;
+	__atomic_clear(lock, __ATOMIC_RELEASE);
+}
+
+#endif
@@ -0,0 +1,298 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Host multithreaded benchmark of the heap of os/mm/mm_heap.
+ * Every thread runs as a task on CPU (thread % CONFIG_SMP_NCPUS), allocating and
+ * freeing small chunks at random, and hands some of its chunks to the next thread
+ * to be freed there, like buffers passed between Wi-Fi and audio tasks.
+ * Throughput and the semaphore contention counters of the heap are printed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <tinyara/mm/mm.h>
+
+#define SLOTS 256
+#define RING_SIZE 1024
+
+struct ring {
+	void *slot[RING_SIZE];
+	unsigned head;
+	unsigned tail;
+};
+
+struct worker {
+	pthread_t thread;
+	int index;
+	unsigned seed;
+	struct ring inbox;
+	long failed;
+	long handed;
+	long corrupted;
+};
+
+struct mm_heap_s g_kmmheap[CONFIG_KMM_NHEAPS];
+__thread int g_bench_cpu;
+static __thread pid_t g_bench_pid;
+
+static struct worker *g_workers;
+static int g_nthreads = CONFIG_SMP_NCPUS;
+static long g_ops = 1000000;
+static int g_handover = 10;
+static int g_maxsize = 256;
+static pthread_barrier_t g_barrier;
+
+pid_t bench_getpid(void)
+{
+	return g_bench_pid;
+}
+
+struct mm_heap_s *mm_get_heap(void *address)
+{
+	(void)address;
+	return g_kmmheap;
+}
+
+static double now_ms(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+/* Single producer, single consumer ring of chunks handed to a thread */
+static int ring_push(struct ring *ring, void *mem)
+{
+	unsigned head = ring->head;
+	if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == RING_SIZE) {
+		return -1;
+	}
+	ring->slot[head % RING_SIZE] = mem;
+	__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+	return 0;
+}
+
+static void *ring_pop(struct ring *ring)
+{
+	unsigned tail = ring->tail;
+	void *mem;
+	if (tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) {
+		return NULL;
+	}
+	mem = ring->slot[tail % RING_SIZE];
+	__atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+	return mem;
+}
+
+/* The first and the last byte of a chunk hold its size, checked when it is freed */
+static void tag(unsigned char *mem, size_t size)
+{
+	mem[0] = (unsigned char)size;
+	mem[size - 1] = (unsigned char)size;
+}
+
+static void release(struct worker *w, unsigned char *mem, size_t size)
+{
+	if (mem[0] != (unsigned char)size || mem[size - 1] != (unsigned char)size) {
+		w->corrupted++;
+	}
+	mm_free(g_kmmheap, mem);
+}
+
+static void drain_inbox(struct worker *w)
+{
+	void *mem;
+	while ((mem = ring_pop(&w->inbox)) != NULL) {
+		mm_free(g_kmmheap, mem);
+	}
+}
+
+static void *worker_main(void *arg)
+{
+	struct worker *w = arg;
+	struct worker *peer = &g_workers[(w->index + 1) % g_nthreads];
+	unsigned char *slots[SLOTS] = { NULL, };
+	size_t sizes[SLOTS];
+	long i;
+	int k;
+
+	g_bench_cpu = w->index % CONFIG_SMP_NCPUS;
+	g_bench_pid = w->index + 1;
+	pthread_barrier_wait(&g_barrier);
+
+	for (i = 0; i < g_ops; i++) {
+		drain_inbox(w);
+		k = rand_r(&w->seed) % SLOTS;
+		if (!slots[k]) {
+			sizes[k] = 1 + rand_r(&w->seed) % g_maxsize;
+			slots[k] = mm_malloc(g_kmmheap, sizes[k]);
+			if (slots[k]) {
+				tag(slots[k], sizes[k]);
+			} else {
+				w->failed++;
+			}
+			continue;
+		}
+		if (peer != w && (int)(rand_r(&w->seed) % 100) < g_handover && ring_push(&peer->inbox, slots[k]) == 0) {
+			w->handed++;
+		} else {
+			release(w, slots[k], sizes[k]);
+		}
+		slots[k] = NULL;
+	}
+
+	/* Nothing is handed over after all threads are here */
+	pthread_barrier_wait(&g_barrier);
+	for (k = 0; k < SLOTS; k++) {
+		if (slots[k]) {
+			release(w, slots[k], sizes[k]);
+		}
+	}
+	drain_inbox(w);
+	return NULL;
+}
+
+/* Walk the chunks of a heap, gives number of free bytes or -1 if they are inconsistent */
+static long check_heap(struct mm_heap_s *heap)
+{
+	struct mm_allocnode_s *node;
+	struct mm_allocnode_s *prev = NULL;
+	long freebytes = 0;
+
+	for (node = heap->mm_heapstart[0]; node < heap->mm_heapend[0]; node = (struct mm_allocnode_s *)((char *)node + node->size)) {
+		if (prev && (node->preceding & ~MM_ALLOC_BIT) != prev->size) {
+			return -1;
+		}
+		if (!(node->preceding & MM_ALLOC_BIT)) {
+			freebytes += node->size;
+		}
+		prev = node;
+	}
+	return freebytes;
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr, "Usage: %s [-t threads] [-n operations] [-r percent] [-s size] [-m KB]\n", name);
+	fprintf(stderr, " -t    threads, %d by default, thread i runs on CPU i %% %d\n", CONFIG_SMP_NCPUS, CONFIG_SMP_NCPUS);
+	fprintf(stderr, " -n    allocations and frees of each thread, 1000000 by default\n");
+	fprintf(stderr, " -r    percent of chunks freed by the next thread, 10 by default\n");
+	fprintf(stderr, " -s    largest allocation in bytes, 256 by default\n");
+	fprintf(stderr, " -m    heap size in KB, 1024 by default\n");
+}
+
+int main(int argc, char *argv[])
+{
+	size_t heapsize = 1024 * 1024;
+	void *heapmem;
+	long failed = 0;
+	long handed = 0;
+	long corrupted = 0;
+	double start;
+	double elapsed;
+	int opt;
+	int i;
+
+	while ((opt = getopt(argc, argv, "t:n:r:s:m:")) != -1) {
+		switch (opt) {
+		case 't':
+			g_nthreads = atoi(optarg);
+			break;
+		case 'n':
+			g_ops = atol(optarg);
+			break;
+		case 'r':
+			g_handover = atoi(optarg);
+			break;
+		case 's':
+			g_maxsize = atoi(optarg);
+			break;
+		case 'm':
+			heapsize = (size_t)atoi(optarg) * 1024;
+			break;
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (g_nthreads < 1 || g_ops < 1 || g_maxsize < 1 || heapsize == 0) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	heapmem = malloc(heapsize);
+	g_workers = calloc(g_nthreads, sizeof(struct worker));
+	if (!heapmem || !g_workers) {
+		fprintf(stderr, "Memory allocation failed\n");
+		return 1;
+	}
+	g_bench_pid = 0;
+	if (mm_initialize(g_kmmheap, heapmem, heapsize) != OK) {
+		fprintf(stderr, "Heap initialization failed\n");
+		return 1;
+	}
+
+	pthread_barrier_init(&g_barrier, NULL, g_nthreads + 1);
+	for (i = 0; i < g_nthreads; i++) {
+		g_workers[i].index = i;
+		g_workers[i].seed = i + 1;
+		pthread_create(&g_workers[i].thread, NULL, worker_main, &g_workers[i]);
+	}
+	pthread_barrier_wait(&g_barrier);
+	start = now_ms();
+	pthread_barrier_wait(&g_barrier);
+	elapsed = now_ms() - start;
+	for (i = 0; i < g_nthreads; i++) {
+		pthread_join(g_workers[i].thread, NULL);
+		failed += g_workers[i].failed;
+		handed += g_workers[i].handed;
+		corrupted += g_workers[i].corrupted;
+	}
+
+#ifdef CONFIG_MM_ARENAS
+	printf("Per CPU arenas of %d bytes, %d CPUs, %d threads\n", CONFIG_MM_ARENA_SIZE, CONFIG_SMP_NCPUS, g_nthreads);
+#elif defined(CONFIG_MM_SLAB)
+	printf("Single heap with slabs up to %d bytes, %d CPUs, %d threads\n", CONFIG_MM_SLAB_MAXSIZE, CONFIG_SMP_NCPUS, g_nthreads);
+#else
+	printf("Single heap, %d CPUs, %d threads\n", CONFIG_SMP_NCPUS, g_nthreads);
+#endif
+	printf("%-12s %10s %12s %10s %10s\n", "ops", "ms", "ops/ms", "failed", "handed");
+	printf("%-12ld %10.1f %12.0f %10ld %10ld\n", g_ops * g_nthreads, elapsed, g_ops * g_nthreads / elapsed, failed, handed);
+	printf("Heap: contended %u, free %ld of %zu bytes\n", g_kmmheap->mm_contended, check_heap(g_kmmheap), heapsize);
+#ifdef CONFIG_MM_ARENAS
+	for (i = 0; i < CONFIG_SMP_NCPUS; i++) {
+		struct mm_heap_s *arena = g_kmmheap->mm_arena[i];
+		if (arena) {
+			printf("Arena of CPU%d: contended %u, remote frees %u, free %ld of %zu bytes\n", i, arena->mm_contended, arena->mm_nremotefree, check_heap(arena), (size_t)arena->mm_heapsize);
+		}
+	}
+#endif
+
+	free(g_workers);
+	free(heapmem);
+	if (corrupted > 0) {
+		fprintf(stderr, "%ld chunks corrupted\n", corrupted);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,34 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Host stand-ins of the kernel services used by os/kernel/wdog.
+ * Interrupts are never taken, the benchmark calls wd_timer itself.
+ */
+
+#ifndef __TOOLS_WDOG_BENCH_HOST_BENCH_HOST_H
+#define __TOOLS_WDOG_BENCH_HOST_BENCH_HOST_H
+
+#include <sys/types.h>
+#include <errno.h>
+#include <time.h>
+#include <tinyara/config.h>
+#include <tinyara/irq.h>
+
+#define set_errno(e) do { errno = (e); } while (0)
+
+#endif
@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* The benchmark runs the ticked scheduler, the interval timer hooks of the
+ * tickless one do nothing.
+ */
+
+#ifndef __TOOLS_WDOG_BENCH_HOST_SCHED_SCHED_H
+#define __TOOLS_WDOG_BENCH_HOST_SCHED_SCHED_H
+
+#define sched_timer_cancel() (0)
+#define sched_timer_resume()
+#define sched_timer_reassess()
+
+#endif
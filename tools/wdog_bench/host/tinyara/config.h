@@ -0,0 +1,32 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __TOOLS_WDOG_BENCH_HOST_TINYARA_CONFIG_H
+#define __TOOLS_WDOG_BENCH_HOST_TINYARA_CONFIG_H
+
+#define CONFIG_MAX_WDOGPARMS 4
+#define CONFIG_PREALLOC_WDOGS 32
+#define CONFIG_WDOG_INTRESERVE 4
+#define CONFIG_SCHED_TICKSUPPRESS 1
+
+#define FAR
+#define CODE
+#define OK 0
+#define ERROR -1
+
+#endif
@@ -1,6 +1,6 @@
 /****************************************************************************
  *
- * Copyright 2023 Samsung Electronics All Rights Reserved.
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,44 +16,12 @@
  *
  ****************************************************************************/
 
-#pragma once
+#ifndef __TOOLS_WDOG_BENCH_HOST_TINYARA_KMALLOC_H
+#define __TOOLS_WDOG_BENCH_HOST_TINYARA_KMALLOC_H
 
 #include <stdlib.h>
-#include "stdio.h"
-#include "stdint.h"
-#include "sys/types.h"
 
-namespace aifw {
-
-/**
- * @class AIDataBufferNode
- * @brief Interface class for necessary fields of an AIDataBuffer node.
- */
-class AIDataBufferNode
-{
-public:
-	bool mIsEmpty;
-	float *mData;
-	AIDataBufferNode *mPrev;
-	AIDataBufferNode *mNext;
-
-	/**
-	 * @brief Construct the AIDataBufferNode class instance.
-	 */
-	AIDataBufferNode(uint16_t rowSize) :
-		mIsEmpty(true), mData(NULL), mPrev(NULL), mNext(NULL)
-	{
-		mData = (float *)calloc(rowSize, sizeof(float));
-	}
-
-	/**
-	 * @brief AIDataBufferNode destructor.
-	 */
-	~AIDataBufferNode()
-	{
-		free(mData);
-	}
-};
-
-} // namespace aifw
+#define kmm_malloc(s) malloc(s)
+#define kmm_free(p)   free(p)
 
+#endif
@@ -0,0 +1,453 @@
+/****************************************************************************
+ *
+ * Copyright 2024 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Host test and benchmark of the watchdogs of os/kernel/wdog.
+ * Every watchdog started is checked to expire exactly at its tick, or at the
+ * first tick after a suppressed period when it fell due during it, and
+ * wd_gettime is checked against the same reference.  The directed tests start
+ * watchdogs across the slot boundaries of every level of the timer wheel and
+ * beyond its span; the random test mixes starts, cancels, ticks and suppressed
+ * periods with watchdogs started while the suppressed ticks are pending.
+ * The benchmark then times wd_start, wd_cancel and wd_timer with many watchdogs
+ * active.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <tinyara/wdog.h>
+#include "wdog/wdog.h"
+
+/* The sorted list has no span, the same delays are used with it */
+
+#ifdef CONFIG_WDOG_WHEEL
+#define LEVELS CONFIG_WDOG_WHEEL_LEVELS
+#else
+#define LEVELS 4
+#endif
+
+#define SPAN ((uint32_t)1 << (5 * LEVELS))
+
+struct dog {
+	struct wdog_s wdog;
+	uint32_t due;
+	int active;
+	int restart;
+};
+
+static struct dog *g_dogs;
+static int g_ndogs;
+static uint32_t g_now;			/* Ticks since wd_initialize */
+static uint32_t g_ticked;		/* Tick of the last wd_timer */
+static long g_fired;
+static long g_errors;
+static unsigned int g_seed = 1;
+static uint32_t g_maxdelay = 10000;
+
+static void fail(const char *what, int index)
+{
+	if (g_errors++ < 10) {
+		printf("FAIL %s: watchdog %d due %u now %u last tick %u\n", what, index, g_dogs[index].due, g_now, g_ticked);
+	}
+}
+
+static double now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void dog_start(int index, int delay);
+
+static void dog_expired(int argc, uint32_t index, ...)
+{
+	struct dog *d = &g_dogs[index];
+
+	(void)argc;
+
+	if (!d->active) {
+		fail("expired while not active", index);
+	} else if ((int32_t)(d->due - g_now) > 0) {
+		fail("expired early", index);
+	} else if ((int32_t)(d->due - g_ticked) <= 0) {
+		/* Only watchdogs due in suppressed ticks may be late */
+
+		fail("expired late", index);
+	}
+
+	d->active = 0;
+	g_fired++;
+
+	if (d->restart) {
+		dog_start(index, rand_r(&g_seed) % g_maxdelay);
+	}
+}
+
+static void dog_start(int index, int delay)
+{
+	struct dog *d = &g_dogs[index];
+
+	if (wd_start(&d->wdog, delay, (wdentry_t)dog_expired, 1, (uint32_t)index) != OK) {
+		fail("wd_start", index);
+		return;
+	}
+
+	/* The tick in progress does not count */
+
+	d->due = g_now + (delay <= 0 ? 1 : delay + 1);
+	d->active = 1;
+}
+
+static void dog_cancel(int index)
+{
+	struct dog *d = &g_dogs[index];
+	int ret = wd_cancel(&d->wdog);
+
+	if ((ret == OK) != (d->active != 0)) {
+		fail("wd_cancel", index);
+	}
+
+	d->active = 0;
+}
+
+static void dog_check(int index)
+{
+	struct dog *d = &g_dogs[index];
+	int32_t remaining = (int32_t)(d->due - g_now);
+
+	/* Watchdogs due in pending suppressed ticks have no defined remaining time */
+
+	if (d->active && remaining > 0 && wd_gettime(&d->wdog) != remaining) {
+		fail("wd_gettime", index);
+	}
+}
+
+static void tick(void)
+{
+	int i;
+
+	g_now++;
+	wd_timer();
+	g_ticked = g_now;
+
+	for (i = 0; i < g_ndogs; i++) {
+		if (g_dogs[i].active && (int32_t)(g_dogs[i].due - g_now) <= 0) {
+			fail("missed", i);
+			g_dogs[i].active = 0;
+		}
+	}
+}
+
+/* Ticks suppressed in a sleep, reported on wakeup before the next tick */
+
+static void suppress(uint32_t ticks)
+{
+	wd_timer_nohz(ticks);
+	g_now += ticks;
+}
+
+static void run_until_idle(void)
+{
+	int i;
+
+	for (;;) {
+		for (i = 0; i < g_ndogs && !g_dogs[i].active; i++) {
+		}
+		if (i == g_ndogs) {
+			return;
+		}
+		tick();
+	}
+}
+
+static void reset(int ndogs)
+{
+	int i;
+
+	for (i = 0; i < g_ndogs; i++) {
+		if (g_dogs[i].active) {
+			dog_cancel(i);
+		}
+	}
+
+	free(g_dogs);
+	g_dogs = calloc(ndogs, sizeof(struct dog));
+	g_ndogs = ndogs;
+	for (i = 0; i < ndogs; i++) {
+		wd_static(&g_dogs[i].wdog);
+	}
+}
+
+/* Start watchdogs due around the slot boundaries of every level, with the
+ * current tick just before, at and just after a boundary, and with delays
+ * beyond the span of the wheel which wait in its last level.
+ */
+
+static void test_boundaries(void)
+{
+	static const int offsets[] = { -1, 0, 1, 31 };
+	int level;
+	int o;
+	int n;
+	uint32_t unit;
+	uint32_t gap;
+
+	reset(16);
+	for (level = 1; level <= LEVELS + 1; level++) {
+		unit = level <= LEVELS ? (uint32_t)1 << (5 * level) : 3 * SPAN;
+		for (o = 0; o < (int)(sizeof(offsets) / sizeof(offsets[0])); o++) {
+			/* Move to offsets[o] ticks after a boundary of the level, skipping
+			 * ticks in suppressed periods.
+			 */
+
+			gap = (uint32_t)(offsets[o] - (int32_t)g_now) & (unit - 1);
+			if (level > LEVELS) {
+				gap = (uint32_t)(offsets[o] - (int32_t)g_now) & (SPAN - 1);
+			}
+			if (gap > 1) {
+				suppress(gap - 1);
+			}
+			if (gap > 0) {
+				tick();
+			}
+
+			n = 0;
+			dog_start(n++, unit - 3);
+			dog_start(n++, unit - 2);
+			dog_start(n++, unit - 1);
+			dog_start(n++, unit);
+			dog_start(n++, unit + 1);
+			dog_start(n++, unit + 31);
+			dog_start(n++, unit + 32);
+			dog_start(n++, 2 * unit - 1);
+			dog_start(n++, 2 * unit + 7);
+			dog_start(n++, unit / 2);
+			dog_start(n++, 31);
+			dog_start(n++, 32);
+			for (n = 0; n < 12; n++) {
+				dog_check(n);
+			}
+
+			/* Cancel some after they moved down the wheel */
+
+			while ((int32_t)(g_dogs[3].due - g_now) > 40) {
+				tick();
+			}
+			dog_check(4);
+			dog_cancel(4);
+			run_until_idle();
+		}
+	}
+}
+
+/* Watchdogs started between a wakeup and the tick after it count their delay
+ * from the current tick, which includes the suppressed ticks.
+ */
+
+static void test_nohz(void)
+{
+	int i;
+
+	reset(8);
+	for (i = 0; i < 1000; i++) {
+		dog_start(0, 5);
+		dog_start(1, 100 + i);
+		suppress(1 + rand_r(&g_seed) % 3000);
+		dog_check(1);
+		dog_start(2, 0);
+		dog_start(3, 1 + rand_r(&g_seed) % 40);
+		dog_start(4, 1000 + rand_r(&g_seed) % 100000);
+		dog_check(3);
+		dog_check(4);
+		tick();
+		dog_check(4);
+		run_until_idle();
+	}
+}
+
+static void test_random(long ops)
+{
+	static const uint32_t near[] = { 0, 1, 2, 30, 31, 32 };
+	uint32_t delay;
+	long op;
+	int i;
+	int r;
+
+	reset(200);
+	for (op = 0; op < ops; op++) {
+		i = rand_r(&g_seed) % g_ndogs;
+		r = rand_r(&g_seed) % 100;
+		if (r < 35) {
+			switch (rand_r(&g_seed) % 4) {
+			case 0:
+				delay = rand_r(&g_seed) % 40;
+				break;
+			case 1:
+				delay = rand_r(&g_seed) % 5000;
+				break;
+			case 2:
+				delay = rand_r(&g_seed) % (2 * SPAN);
+				break;
+			default:
+				/* Just around a slot boundary of some level */
+
+				delay = ((uint32_t)1 << (5 * (1 + rand_r(&g_seed) % LEVELS))) - near[rand_r(&g_seed) % 6] + rand_r(&g_seed) % 3;
+				break;
+			}
+			g_dogs[i].restart = rand_r(&g_seed) % 4 == 0;
+			dog_start(i, (int)delay);
+		} else if (r < 45) {
+			dog_cancel(i);
+		} else if (r < 55) {
+			dog_check(i);
+		} else if (r < 95) {
+			tick();
+		} else {
+			suppress(1 + rand_r(&g_seed) % 3000);
+			dog_check(i);
+			if (rand_r(&g_seed) % 2) {
+				dog_start(i, rand_r(&g_seed) % 100);
+			}
+			tick();
+		}
+	}
+
+	for (i = 0; i < g_ndogs; i++) {
+		g_dogs[i].restart = 0;
+	}
+}
+
+static void bench(int nactive, long nops)
+{
+	double start;
+	double tstart;
+	double tcancel;
+	double ttick;
+	long i;
+	long nticks = nops;
+
+	reset(nactive);
+	g_maxdelay = 10000;
+	for (i = 0; i < nactive; i++) {
+		g_dogs[i].restart = 1;
+		dog_start(i, rand_r(&g_seed) % g_maxdelay);
+	}
+
+	/* Restart active watchdogs, as a timeout renewed on every packet */
+
+	start = now_ns();
+	for (i = 0; i < nops; i++) {
+		dog_start(rand_r(&g_seed) % nactive, rand_r(&g_seed) % g_maxdelay);
+	}
+	tstart = (now_ns() - start) / nops;
+
+	start = now_ns();
+	for (i = 0; i < nops; i++) {
+		dog_cancel(i % nactive);
+		if (i % nactive == nactive - 1) {
+			break;
+		}
+	}
+	tcancel = (now_ns() - start) / (i + 1);
+
+	for (i = 0; i < nactive; i++) {
+		dog_start(i, rand_r(&g_seed) % g_maxdelay);
+	}
+
+	g_fired = 0;
+	start = now_ns();
+	for (i = 0; i < nticks; i++) {
+		g_now++;
+		wd_timer();
+		g_ticked = g_now;
+	}
+	ttick = (now_ns() - start) / nticks;
+
+	printf("%6d active: wd_start %8.1f ns, wd_cancel %8.1f ns, wd_timer %8.1f ns/tick (%ld expired)\n", nactive, tstart, tcancel, ttick, g_fired);
+
+	for (i = 0; i < nactive; i++) {
+		g_dogs[i].restart = 0;
+	}
+	reset(0);
+}
+
+int main(int argc, char **argv)
+{
+	static const int actives[] = { 16, 256, 4096 };
+	long ops = 2000000;
+	long nbench = 200000;
+	int nactive = 0;
+	unsigned int i;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:s:a:b:")) != -1) {
+		switch (opt) {
+		case 'n':
+			ops = atol(optarg);
+			break;
+		case 's':
+			g_seed = atoi(optarg);
+			break;
+		case 'a':
+			nactive = atoi(optarg);
+			break;
+		case 'b':
+			nbench = atol(optarg);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-n operations] [-s seed] [-a active] [-b operations]\n", argv[0]);
+			return 1;
+		}
+	}
+
+#ifdef CONFIG_WDOG_WHEEL
+	printf("Timer wheel of %d levels, span %u ticks\n", LEVELS, SPAN);
+#else
+	printf("Sorted list\n");
+#endif
+
+	wd_initialize();
+
+	test_boundaries();
+	test_nohz();
+	test_random(ops);
+	reset(0);
+	printf("%s: %ld expired, %ld errors\n", g_errors ? "FAIL" : "PASS", g_fired, g_errors);
+	if (g_errors) {
+		return 1;
+	}
+
+	if (nbench <= 0) {
+		return 0;
+	}
+
+	if (nactive > 0) {
+		bench(nactive, nbench);
+	} else {
+		for (i = 0; i < sizeof(actives) / sizeof(actives[0]); i++) {
+			bench(actives[i], nbench);
+		}
+	}
+
+	return 0;
+}